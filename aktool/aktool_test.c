@@ -182,7 +182,8 @@
     aktool_error( _("incorrect creation of encryption key (code: %d)" ), ak_error_get_value( ));
     return exit_status;
   }
-  if(( error = oid->func.first.set_key( encryptionKey, iv+16, 32 )) != ak_error_ok ) {
+  if(( error = oid->func.first.set_key( encryptionKey, iv+16,
+                         ak_min( 32, (( ak_skey )encryptionKey)->key_size ))) != ak_error_ok ) {
     aktool_error( _("incorrect assigning encryption key value (code: %d)" ), error );
     goto exit;
   }
@@ -195,7 +196,8 @@
                                                                             ak_error_get_value( ));
         goto exit;
       }
-      if(( error = oid->func.second.set_key( authenticationKey, iv, 32 )) != ak_error_ok ) {
+      if(( error = oid->func.second.set_key( authenticationKey, iv,
+                     ak_min( 32, (( ak_skey )authenticationKey)->key_size ))) != ak_error_ok ) {
         aktool_error( _("incorrect assigning authentication key value (code: %d)" ), error );
         goto exit;
       }
@@ -420,6 +422,7 @@
   size_t j, i = 0, cnt = 0;
   double iter = 0, avg = 0, val = 0;
   ak_uint64 e[8], k[8];
+  struct verifykey pkey;
 
   if( ak_random_create_lcg( &generator ) != ak_error_ok ) return EXIT_FAILURE;
 
@@ -449,6 +452,46 @@
      if( j > 1 ) { iter += 1; avg += val; }
   }
   printf(_(" average speed: %10f sgn/sec.\n"), avg/iter );
+
+ /* второй тест - скорость проверки подписи */
+  if( ak_verifykey_create_from_signkey( &pkey, ctx ) != ak_error_ok ) {
+    ak_random_destroy( &generator );
+    return EXIT_FAILURE;
+  }
+  printf(_("curve: %s (%s) "), curve->name[0], curve->id[0] );
+  if( aktool_test_verbose ) printf("\n");
+
+  iter = avg = 0;
+  for( j = 1; j < 9; j++ ) {
+     i = cnt = j*100;
+     ak_random_ptr( &generator, e, 64 );
+     ak_random_ptr( &generator, k, 64 );
+     ak_signkey_sign_const_values( ctx, k, e, out );
+
+     timea = clock();
+     while( i ) {
+        if( ak_verifykey_verify_hash( &pkey, e, ctx->ctx.data.sctx.hsize, out ) != ak_true ) {
+          aktool_error(_("incorrect verification of digital signature"));
+          ak_verifykey_destroy( &pkey );
+          ak_random_destroy( &generator );
+          return EXIT_FAILURE;
+        }
+        i--;
+     }
+     timea = clock() - timea;
+     val = (cnt *(double) CLOCKS_PER_SEC )/(double) timea;
+     if( aktool_test_verbose ) {
+       printf(_("[count: %3lu, time = %fs, speed: %f sec., count: %f]\n"),
+       (long unsigned int)cnt,
+       (double) timea / (double) CLOCKS_PER_SEC,
+       (double) timea / (cnt *(double) CLOCKS_PER_SEC ),
+       val );
+     } else { printf("."); fflush( stdout ); }
+
+     if( j > 1 ) { iter += 1; avg += val; }
+  }
+  printf(_(" average speed: %10f vrf/sec.\n"), avg/iter );
+  ak_verifykey_destroy( &pkey );
   ak_random_destroy( &generator );
 
  return EXIT_SUCCESS;
@@ -108,6 +108,14 @@ check_c_source_compiles("
      return 0;
   }" AK_HAVE_SYSMMAN_H )
 
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  #include <sys/random.h>
+  int main( void ) {
+     char buffer[16];
+     return ( getrandom( buffer, sizeof( buffer ), 0 ) > 0 ) ? 0 : 1;
+  }" AK_HAVE_SYSRANDOM_H )
+
 # -------------------------------------------------------------------------------------------------- #
 check_c_source_compiles("
   #include <sys/stat.h>
@@ -139,6 +147,14 @@ if( AK_HAVE_SYSSOCKET_H )
       }" AK_HAVE_SYSUN_H )
 endif()
 
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  #include <sys/uio.h>
+  int main( void ) {
+     struct iovec iov = { 0, 0 };
+     return ( int ) iov.iov_len;
+  }" AK_HAVE_SYSUIO_H )
+
 # -------------------------------------------------------------------------------------------------- #
 check_c_source_compiles("
   #include <sys/select.h>
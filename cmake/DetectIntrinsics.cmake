@@ -35,6 +35,23 @@ if( AK_HAVE_BUILTIN_CLMULEPI64 )
     set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DAK_HAVE_BUILTIN_CLMULEPI64" )
 endif()
 
+# -------------------------------------------------------------------------------------------------- #
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  #include <wmmintrin.h>
+  int main( void ) {
+
+   __m128i a = _mm_setzero_si128(), b = _mm_setzero_si128();
+   a = _mm_aesenc_si128( a, b );
+   a = _mm_aesdeclast_si128( a, b );
+
+  return 0;
+ }" AK_HAVE_BUILTIN_AESENC )
+
+if( AK_HAVE_BUILTIN_AESENC )
+    set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DAK_HAVE_BUILTIN_AESENC" )
+endif()
+
 # -------------------------------------------------------------------------------------------------- #
 # -------------------------------------------------------------------------------------------------- #
 check_c_source_compiles("
@@ -53,3 +70,38 @@ check_c_source_compiles("
 if( AK_HAVE_BUILTIN_MM256_SLL )
     set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DAK_HAVE_BUILTIN_MM256_SLL" )
 endif()
+
+# -------------------------------------------------------------------------------------------------- #
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  int main( void ) {
+
+   __builtin_cpu_init();
+   if( __builtin_cpu_supports( \"avx2\" )) return 1;
+
+  return 0;
+ }" AK_HAVE_BUILTIN_CPU_SUPPORTS )
+
+if( AK_HAVE_BUILTIN_CPU_SUPPORTS )
+    set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DAK_HAVE_BUILTIN_CPU_SUPPORTS" )
+endif()
+
+# -------------------------------------------------------------------------------------------------- #
+# -------------------------------------------------------------------------------------------------- #
+check_c_source_compiles("
+  int main( void ) {
+    #if defined( __x86_64__ ) && defined( __SIZEOF_INT128__ )
+      unsigned long long lo, hi, t = 1, y = 2;
+      __asm__ (\"xor %0, %0; mulx %2, %0, %1; adcx %3, %0; adox %3, %1\"
+                                      : \"=&r\" (lo), \"=&r\" (hi) : \"r\" (y), \"r\" (t), \"d\" (y) : \"cc\" );
+      __builtin_cpu_init();
+      if( __builtin_cpu_supports( \"bmi2\" ) && __builtin_cpu_supports( \"adx\" )) return ( int )( lo+hi );
+      return 0;
+    #else
+      #error Unsupported architecture
+    #endif
+  }" AK_HAVE_BUILTIN_MULX_ADX )
+
+if( AK_HAVE_BUILTIN_MULX_ADX )
+    set( CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DAK_HAVE_BUILTIN_MULX_ADX" )
+endif()
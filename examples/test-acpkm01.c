@@ -0,0 +1,198 @@
+/* ----------------------------------------------------------------------------------------------- */
+/* Тестовый пример, проверяющий режим ctr-acpkm: контрольные примеры из рекомендаций
+   Р 1323565.1.017-2018 при различном количестве потоков, а также совпадение результатов
+   последовательной и многопоточной реализаций для данных, длина которых не кратна
+   длине секции или длине блока.
+
+   test-acpkm01.c                                                                                  */
+/* ----------------------------------------------------------------------------------------------- */
+
+ #include <time.h>
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+/* Kлюч (закомментированы значения, скопированные из текста рекомендаций )
+   88 99 AA BB CC DD EE FF 00 11 22 33 44 55 66 77 FE DC BA 98 76 54 32 10 01 23 45 67 89 AB CD EF */
+ static ak_uint8 keyAnnexA[32] = {
+     0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+     0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88 };
+
+/* Р 1323565.1.017-2018, пример А.1 (Кузнечик, длина секции 32 октета):
+   синхропосылка 12 34 56 78 90 AB CE F0, открытый текст и шифртекст из семи блоков */
+ static ak_uint8 iv_kuznechik[8] = { 0xf0, 0xce, 0xab, 0x90, 0x78, 0x56, 0x34, 0x12 };
+
+ static ak_uint8 plain_kuznechik[112] = {
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11,
+    0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00,
+    0x00, 0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11,
+    0x11, 0x00, 0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22,
+    0x22, 0x11, 0x00, 0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33,
+    0x33, 0x22, 0x11, 0x00, 0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44,
+    0x44, 0x33, 0x22, 0x11, 0x00, 0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55 };
+
+ static ak_uint8 cipher_kuznechik[112] = {
+    0xb8, 0xa1, 0xbd, 0x40, 0xa2, 0x5f, 0x7b, 0xd5, 0xdb, 0xd1, 0x0e, 0xc1, 0xbe, 0xd8, 0x95, 0xf1,
+    0xe4, 0xde, 0x45, 0x3c, 0xb3, 0xe4, 0x3c, 0xf3, 0x5d, 0x3e, 0xa1, 0xf6, 0x33, 0xe7, 0xee, 0x85,
+    0x00, 0xe8, 0x85, 0x5e, 0x27, 0x06, 0x17, 0x00, 0x55, 0x4c, 0x6f, 0x64, 0x8f, 0xeb, 0xce, 0x4b,
+    0x46, 0x50, 0x80, 0xd0, 0xaf, 0x34, 0x48, 0x3e, 0x39, 0x94, 0xd0, 0x68, 0xf5, 0x4d, 0x7c, 0x58,
+    0x6e, 0x89, 0x8a, 0x6b, 0x31, 0x6c, 0xfc, 0x1c, 0xe1, 0xec, 0xae, 0x86, 0x76, 0xf5, 0x30, 0xcf,
+    0x3e, 0x16, 0x23, 0x34, 0x74, 0x3b, 0x4f, 0x0c, 0x46, 0x36, 0x36, 0x81, 0xec, 0x07, 0xfd, 0xdf,
+    0x5d, 0xde, 0xd6, 0xfb, 0xe7, 0x21, 0xd2, 0x69, 0xd4, 0xc8, 0xfa, 0x82, 0xc2, 0xa9, 0x09, 0x64 };
+
+/* Р 1323565.1.017-2018, пример А.2 (Магма, длина секции 16 октетов):
+   синхропосылка 12 34 56 78, открытый текст и шифртекст из семи блоков
+   (блоки по 8 октетов развернуты так же, как в стандарте на блочные шифры) */
+ static ak_uint8 iv_magma[4] = { 0x78, 0x56, 0x34, 0x12 };
+
+ static ak_uint8 plain_magma[56] = {
+    0x00, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+    0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88,
+    0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99,
+    0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22 };
+
+ static ak_uint8 cipher_magma[56] = {
+    0xab, 0x4c, 0x1e, 0xeb, 0xee, 0x1d, 0xb8, 0x2a, 0xea, 0x94, 0x6b, 0xbd, 0xc4, 0x04, 0xe1, 0x68,
+    0x6b, 0x5b, 0x2e, 0x6c, 0xaf, 0x67, 0x2c, 0xc7, 0x2e, 0xb3, 0xf1, 0x70, 0x17, 0xb6, 0xaf, 0x0e,
+    0x82, 0x13, 0xed, 0x9e, 0x14, 0x71, 0xae, 0xa1, 0x6f, 0xec, 0x72, 0x06, 0x18, 0x67, 0xd4, 0xab,
+    0xc1, 0x72, 0xca, 0x3f, 0x5b, 0xf1, 0xa2, 0x84 };
+
+/* ----------------------------------------------------------------------------------------------- */
+/* проверяем контрольный пример: данные содержат несколько секций и неполную секцию,
+   поэтому при количестве потоков больше единицы используется многопоточная реализация */
+ static int test_vector( ak_bckey key, size_t section_size, ak_uint8 *plain, ak_uint8 *cipher,
+                                            size_t size, ak_uint8 *iv, size_t iv_size, int threads )
+{
+  int result = ak_false;
+  ak_uint8 out[112];
+
+  printf("%s (R 1323565.1.017-2018, threads: %d): ", key->key.oid->name[0], threads );
+  ak_libakrypt_set_option( "acpkm_threads", threads );
+
+  memset( out, 0, sizeof( out ));
+  if( ak_bckey_ctr_acpkm( key, plain, out, size, section_size, iv, iv_size ) != ak_error_ok ) {
+    printf("encryption error\n");
+    goto lab_exit;
+  }
+  if( !ak_ptr_is_equal_with_log( out, cipher, size )) {
+    printf("Wrong (encryption)\n");
+    goto lab_exit;
+  }
+ /* расшифровываем на месте */
+  if( ak_bckey_ctr_acpkm( key, out, out, size, section_size, iv, iv_size ) != ak_error_ok ) {
+    printf("decryption error\n");
+    goto lab_exit;
+  }
+  if( !ak_ptr_is_equal_with_log( out, plain, size )) {
+    printf("Wrong (decryption)\n");
+    goto lab_exit;
+  }
+  printf("Ok\n");
+  result = ak_true;
+
+  lab_exit:
+   ak_libakrypt_set_option( "acpkm_threads", 1 );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* сравниваем результаты шифрования с использованием одного и нескольких потоков */
+ static int test_threads( ak_bckey key, size_t section_size, size_t size, int threads )
+{
+  size_t i = 0;
+  int result = ak_false;
+  clock_t time_single, time_threads;
+  ak_uint8 iv[8] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+  ak_uint8 *in = malloc( size ), *out = malloc( size ), *out2 = malloc( size );
+
+  printf("%s (section: %u, data: %u, threads: %d): ", key->key.oid->name[0],
+                                        (unsigned int) section_size, (unsigned int) size, threads );
+  if(( in == NULL ) || ( out == NULL ) || ( out2 == NULL )) {
+    printf("incorrect memory allocation\n");
+    goto lab_exit;
+  }
+  for( i = 0; i < size; i++ ) in[i] = ( ak_uint8 )( 5*i + ( i >> 10 ));
+
+ /* последовательная реализация */
+  ak_libakrypt_set_option( "acpkm_threads", 1 );
+  time_single = clock();
+  if( ak_bckey_ctr_acpkm( key, in, out, size,
+                                         section_size, iv, key->bsize >> 1 ) != ak_error_ok ) {
+    printf("encryption error\n");
+    goto lab_exit;
+  }
+  time_single = clock() - time_single;
+
+ /* многопоточная реализация (при отсутствии поддержки потоков совпадает с последовательной) */
+  ak_libakrypt_set_option( "acpkm_threads", threads );
+  time_threads = clock();
+  if( ak_bckey_ctr_acpkm( key, in, out2, size,
+                                         section_size, iv, key->bsize >> 1 ) != ak_error_ok ) {
+    printf("encryption error\n");
+    goto lab_exit;
+  }
+  time_threads = clock() - time_threads;
+  if( memcmp( out, out2, size ) != 0 ) {
+    printf("Wrong (encryption)\n");
+    goto lab_exit;
+  }
+
+ /* расшифровываем на месте */
+  if( ak_bckey_ctr_acpkm( key, out2, out2, size,
+                                         section_size, iv, key->bsize >> 1 ) != ak_error_ok ) {
+    printf("decryption error\n");
+    goto lab_exit;
+  }
+  if( memcmp( in, out2, size ) != 0 ) {
+    printf("Wrong (decryption)\n");
+    goto lab_exit;
+  }
+  printf("Ok (%f sec, %f sec)\n", (double) time_single / (double) CLOCKS_PER_SEC,
+                                             (double) time_threads / (double) CLOCKS_PER_SEC );
+  result = ak_true;
+
+  lab_exit:
+   ak_libakrypt_set_option( "acpkm_threads", 1 );
+   if( in ) free( in );
+   if( out ) free( out );
+   if( out2 ) free( out2 );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  int threads = 0, error = EXIT_SUCCESS;
+  struct bckey key;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( NULL )) return ak_libakrypt_destroy();
+  ak_libakrypt_set_openssl_compability( ak_false );
+                                   /* контрольные примеры расчитаны для несовместимого режима */
+ /* алгоритм Кузнечик */
+  ak_bckey_create_kuznechik( &key );
+  ak_bckey_set_key( &key, keyAnnexA, sizeof( keyAnnexA ));
+  for( threads = 1; threads <= 4; threads++ )
+     if( test_vector( &key, 32, plain_kuznechik, cipher_kuznechik, sizeof( plain_kuznechik ),
+                              iv_kuznechik, sizeof( iv_kuznechik ), threads ) != ak_true )
+       error = EXIT_FAILURE;
+  if( test_threads( &key, 8192, 256*8192, 4 ) != ak_true ) error = EXIT_FAILURE;
+  if( test_threads( &key, 8192, 13*8192 + 117, 4 ) != ak_true ) error = EXIT_FAILURE;
+  if( test_threads( &key, 4096, 3*4096 + 16, 3 ) != ak_true ) error = EXIT_FAILURE;
+  ak_bckey_destroy( &key );
+
+ /* алгоритм Магма */
+  ak_bckey_create_magma( &key );
+  ak_bckey_set_key( &key, keyAnnexA, sizeof( keyAnnexA ));
+  for( threads = 1; threads <= 4; threads++ )
+     if( test_vector( &key, 16, plain_magma, cipher_magma, sizeof( plain_magma ),
+                                      iv_magma, sizeof( iv_magma ), threads ) != ak_true )
+       error = EXIT_FAILURE;
+  if( test_threads( &key, 1024, 9*1024 + 5, 4 ) != ak_true ) error = EXIT_FAILURE;
+  if( test_threads( &key, 1024, 1000*1024, 4 ) != ak_true ) error = EXIT_FAILURE;
+  ak_bckey_destroy( &key );
+
+  ak_libakrypt_destroy();
+ return error;
+}
@@ -0,0 +1,119 @@
+/* ----------------------------------------------------------------------------------------------- */
+/* Тестовый пример, проверяющий корректность работы режимов шифрования и выработки имитовставки,
+   зарегистрированных для блочного шифра AES: для каждого режима данные зашифровываются,
+   расшифровываются и сравниваются с исходными.
+
+   test-aes01.c                                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+ #define data_size (4096)
+
+/* проверяем один режим, заданный своим идентификатором */
+ int test_mode( ak_oid oid, ak_random generator )
+{
+  ak_bckey key = NULL, key2 = NULL;
+  int result = ak_false, error = ak_error_ok;
+  ak_uint8 keyval[32], iv[16], icode[16], icode2[16],
+           in[data_size], out[data_size], buffer[data_size];
+
+  ak_random_ptr( generator, keyval, sizeof( keyval ));
+  ak_random_ptr( generator, iv, sizeof( iv ));
+  ak_random_ptr( generator, in, sizeof( in ));
+  printf(" %s: ", oid->name[0] );
+
+  if(( key = ak_oid_new_object( oid )) == NULL ) goto exit;
+  if( ak_bckey_set_key( key, keyval, key->key.key_size ) != ak_error_ok ) goto exit;
+  if(( oid->mode == encrypt2k_mode ) || ( oid->mode == aead )) {
+    if(( key2 = ak_oid_new_second_object( oid )) == NULL ) goto exit;
+    if( ak_bckey_set_key( key2, keyval+32-key2->key.key_size,
+                                                  key2->key.key_size ) != ak_error_ok ) goto exit;
+  }
+
+  switch( oid->mode ) {
+    case encrypt_mode:
+      if(( error = oid->func.direct( key, in, out, sizeof( in ), iv, sizeof( iv ))) != ak_error_ok )
+        goto exit;
+      if(( error = oid->func.invert( key, out, buffer, sizeof( in ), iv, sizeof( iv ))) != ak_error_ok )
+        goto exit;
+      break;
+
+    case encrypt2k_mode:
+      if(( error = oid->func.direct( key, key2, in, out, sizeof( in ),
+                                                      iv, sizeof( iv ))) != ak_error_ok ) goto exit;
+      if(( error = oid->func.invert( key, key2, out, buffer, sizeof( in ),
+                                                      iv, sizeof( iv ))) != ak_error_ok ) goto exit;
+      break;
+
+    case aead:
+      if(( error = oid->func.direct( key, key2, iv, sizeof( iv ), in, out, sizeof( in ),
+                          iv, 12, icode, sizeof( icode ))) != ak_error_ok ) goto exit;
+      if(( error = oid->func.invert( key, key2, iv, sizeof( iv ), out, buffer, sizeof( in ),
+                          iv, 12, icode, sizeof( icode ))) != ak_error_ok ) goto exit;
+      break;
+
+    case mac:
+     /* имитовставка вычисляется дважды: по всем данным и по измененным данным */
+      if(( error = oid->func.direct( key, in, sizeof( in ),
+                                                  icode, sizeof( icode ))) != ak_error_ok ) goto exit;
+      in[0] ^= 0x01;
+      if(( error = oid->func.direct( key, in, sizeof( in ),
+                                                 icode2, sizeof( icode2 ))) != ak_error_ok ) goto exit;
+      in[0] ^= 0x01;
+      if( memcmp( icode, icode2, sizeof( icode )) == 0 ) goto exit;
+      memcpy( buffer, in, sizeof( in ));
+      memset( out, 0, sizeof( out ));
+      break;
+
+    default:
+      printf("skipped\n");
+      result = ak_true;
+      goto exit;
+  }
+
+  if(( memcmp( buffer, in, sizeof( in )) != 0 ) || ( memcmp( out, in, sizeof( in )) == 0 ))
+    goto exit;
+  printf("Ok\n");
+  result = ak_true;
+
+  exit:
+   if( !result ) printf("Wrong (code: %d)\n", error );
+   if( key ) ak_oid_delete_object( oid, key );
+   if( key2 ) ak_oid_delete_second_object( oid, key2 );
+ return result;
+}
+
+ int main( void )
+{
+  size_t count = 0;
+  struct random generator;
+  int error = EXIT_SUCCESS;
+  ak_oid oid = NULL;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( NULL )) return ak_libakrypt_destroy();
+  ak_random_create_lcg( &generator );
+
+ /* перебираем все режимы, зарегистрированные для AES */
+  oid = ak_oid_find_by_engine( block_cipher );
+  while( oid != NULL ) {
+    if(( oid->mode != algorithm ) && ( strstr( oid->name[0], "aes" ) != NULL )) {
+      if( test_mode( oid, &generator ) != ak_true ) error = EXIT_FAILURE;
+      count++;
+    }
+    oid = ak_oid_findnext_by_engine( oid, block_cipher );
+  }
+  if( count == 0 ) error = EXIT_FAILURE;
+
+ /* доступ к режиму по идентификатору NIST */
+  if(( oid = ak_oid_find_by_name( "id-aes256-CBC" )) == NULL ) error = EXIT_FAILURE;
+   else printf(" %s: found by name id-aes256-CBC\n", oid->name[0] );
+
+  ak_random_destroy( &generator );
+  ak_libakrypt_destroy();
+ return error;
+}
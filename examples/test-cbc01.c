@@ -0,0 +1,235 @@
+/* ----------------------------------------------------------------------------------------------- */
+/* Тестовый пример, проверяющий корректность и скорость расшифрования данных в режимах
+   простой замены с зацеплением (cbc) и гаммирования с обратной связью по шифртексту (cfb):
+   контрольные примеры ГОСТ Р 34.13-2015 с синхропосылками из нескольких блоков, а также
+   совпадение результатов однопоточного и многопоточного расшифрования.
+
+   test-cbc01.c                                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+
+ #include <time.h>
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+/* ГОСТ Р 34.13-2015, приложение А.1 (алгоритм Кузнечик); все значения развернуты так же,
+   как в стандарте на блочные шифры: в начале идут младшие октеты */
+ static ak_uint8 kuznechik_key[32] = {
+     0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+     0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88 };
+
+ static ak_uint8 kuznechik_in[64] = {
+     0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11,
+     0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00,
+     0x00, 0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11,
+     0x11, 0x00, 0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22 };
+
+/* синхропосылка из двух блоков для режимов cbc (А.1.4) и cfb (А.1.5) */
+ static ak_uint8 kuznechik_iv[32] = {
+     0x12, 0x01, 0xf0, 0xe5, 0xd4, 0xc3, 0xb2, 0xa1, 0xf0, 0xce, 0xab, 0x90, 0x78, 0x56, 0x34, 0x12,
+     0x19, 0x18, 0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x90, 0x89, 0x78, 0x67, 0x56, 0x45, 0x34, 0x23 };
+
+ static ak_uint8 kuznechik_outcbc[64] = {
+     0x27, 0xcc, 0x7d, 0x6d, 0x3d, 0x2e, 0xe5, 0x90, 0x4d, 0xfa, 0x85, 0xa0, 0xd4, 0x72, 0x99, 0x68,
+     0xac, 0xa5, 0x5e, 0x8d, 0x44, 0x8e, 0x1e, 0xaf, 0xa6, 0xec, 0x78, 0xb4, 0x61, 0xe6, 0x26, 0x28,
+     0xd0, 0x90, 0x9d, 0xf4, 0xb0, 0xe8, 0x40, 0x56, 0xe8, 0x99, 0x19, 0xe9, 0xf1, 0xab, 0x7b, 0xfe,
+     0x70, 0x39, 0xb6, 0x60, 0x15, 0x9a, 0x2d, 0x1a, 0x63, 0x5c, 0x89, 0x5a, 0x06, 0x88, 0x76, 0x16 };
+
+ static ak_uint8 kuznechik_outcfb[64] = {
+     0x95, 0xbd, 0x7a, 0x89, 0x5e, 0x79, 0x1f, 0xff, 0x24, 0x2b, 0x84, 0xb1, 0x59, 0x0a, 0x80, 0x81,
+     0xbf, 0x26, 0x93, 0x9d, 0x36, 0x21, 0xb5, 0x8f, 0xb4, 0xfa, 0x8c, 0x04, 0xa7, 0x47, 0x5b, 0xed,
+     0xb5, 0x38, 0xa2, 0x97, 0x4e, 0x26, 0x2d, 0x84, 0x38, 0x8d, 0xc6, 0x5c, 0xeb, 0xa8, 0xf2, 0x79,
+     0xd1, 0xf4, 0xfb, 0x44, 0xdd, 0xd9, 0x5b, 0xc7, 0xe6, 0x2d, 0x92, 0x4e, 0xcd, 0xbe, 0xfe, 0x4f };
+
+/* ГОСТ Р 34.13-2015, приложение А.2 (алгоритм Магма) */
+ static ak_uint8 magma_key[32] = {
+     0xff, 0xfe, 0xfd, 0xfc, 0xfb, 0xfa, 0xf9, 0xf8, 0xf7, 0xf6, 0xf5, 0xf4, 0xf3, 0xf2, 0xf1, 0xf0,
+     0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+
+ static ak_uint8 magma_in[32] = {
+     0x59, 0x0a, 0x13, 0x3c, 0x6b, 0xf0, 0xde, 0x92, 0x20, 0x9d, 0x18, 0xf8, 0x04, 0xc7, 0x54, 0xdb,
+     0x4c, 0x02, 0xa8, 0x67, 0x2e, 0xfb, 0x98, 0x4a, 0x41, 0x7e, 0xb5, 0x17, 0x9b, 0x40, 0x12, 0x89 };
+
+/* синхропосылка из трех блоков для режима cbc (А.2.4); первые два блока образуют
+   синхропосылку для режима cfb (А.2.5) */
+ static ak_uint8 magma_iv[24] = {
+     0xef, 0xcd, 0xab, 0x90, 0x78, 0x56, 0x34, 0x12, 0xf1, 0xde, 0xbc, 0x0a, 0x89, 0x67, 0x45, 0x23,
+     0x12, 0xef, 0xcd, 0xab, 0x90, 0x78, 0x56, 0x34 };
+
+ static ak_uint8 magma_outcbc[32] = {
+     0x19, 0x39, 0x68, 0xea, 0x5e, 0xb0, 0xd1, 0x96, 0xb9, 0x37, 0xb9, 0xab, 0x29, 0x61, 0xf7, 0xaf,
+     0x19, 0x00, 0xbc, 0xc4, 0xa1, 0xb4, 0x58, 0x50, 0x67, 0xe6, 0xd7, 0x7c, 0x1a, 0x8b, 0xb7, 0x20 };
+
+ static ak_uint8 magma_outcfb[32] = {
+     0x83, 0x3c, 0x90, 0x66, 0xe2, 0xe0, 0x37, 0xdb, 0x9c, 0x08, 0x9a, 0x1f, 0x4c, 0x64, 0x46, 0x0d,
+     0x8b, 0xd3, 0x15, 0x53, 0x03, 0xd2, 0xbd, 0x24, 0x05, 0x55, 0x07, 0x21, 0x14, 0x32, 0xc0, 0xbc };
+
+/* ----------------------------------------------------------------------------------------------- */
+/* проверяем контрольные примеры: зашифрование, расшифрование в отдельный буфер и на месте */
+ static int test_vectors( ak_bckey key, ak_uint8 *in, size_t size, ak_uint8 *iv,
+                   size_t cbc_iv_size, ak_uint8 *outcbc, size_t cfb_iv_size, ak_uint8 *outcfb )
+{
+  ak_uint8 out[64];
+
+  printf("%s (GOST R 34.13-2015): ", key->key.oid->name[0] );
+
+ /* режим простой замены с зацеплением */
+  ak_bckey_encrypt_cbc( key, in, out, size, iv, cbc_iv_size );
+  if( !ak_ptr_is_equal_with_log( out, outcbc, size )) {
+    printf("Wrong (cbc encryption)\n");
+    return ak_false;
+  }
+  ak_bckey_decrypt_cbc( key, outcbc, out, size, iv, cbc_iv_size );
+  if( !ak_ptr_is_equal_with_log( out, in, size )) {
+    printf("Wrong (cbc decryption)\n");
+    return ak_false;
+  }
+  memcpy( out, outcbc, size );
+  ak_bckey_decrypt_cbc( key, out, out, size, iv, cbc_iv_size );
+  if( !ak_ptr_is_equal_with_log( out, in, size )) {
+    printf("Wrong (cbc in-place decryption)\n");
+    return ak_false;
+  }
+
+ /* режим гаммирования с обратной связью по шифртексту */
+  ak_bckey_encrypt_cfb( key, in, out, size, iv, cfb_iv_size );
+  if( !ak_ptr_is_equal_with_log( out, outcfb, size )) {
+    printf("Wrong (cfb encryption)\n");
+    return ak_false;
+  }
+  ak_bckey_decrypt_cfb( key, outcfb, out, size, iv, cfb_iv_size );
+  if( !ak_ptr_is_equal_with_log( out, in, size )) {
+    printf("Wrong (cfb decryption)\n");
+    return ak_false;
+  }
+  memcpy( out, outcfb, size );
+  ak_bckey_decrypt_cfb( key, out, out, size, iv, cfb_iv_size );
+  if( !ak_ptr_is_equal_with_log( out, in, size )) {
+    printf("Wrong (cfb in-place decryption)\n");
+    return ak_false;
+  }
+
+  printf("Ok\n");
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* шифртекст вырабатывается последовательным зашифрованием, после чего сравниваются результаты
+   однопоточного и многопоточного расшифрования (в отдельный буфер и на месте) */
+ static int test_threads( ak_bckey key, size_t size, ak_uint8 *iv, size_t iv_size, int threads )
+{
+  size_t i = 0;
+  int result = ak_false;
+  clock_t time_single, time_threads;
+  ak_uint8 *in = malloc( size ), *out = malloc( size ), *out2 = malloc( size );
+
+  printf("%s (data: %u, iv: %u, threads: %d): ", key->key.oid->name[0],
+                                       (unsigned int) size, (unsigned int) iv_size, threads );
+  if(( in == NULL ) || ( out == NULL ) || ( out2 == NULL )) {
+    printf("incorrect memory allocation\n");
+    goto lab_exit;
+  }
+  for( i = 0; i < size; i++ ) in[i] = ( ak_uint8 )( 3*i + ( i >> 12 ));
+
+ /* режим простой замены с зацеплением */
+  ak_bckey_encrypt_cbc( key, in, out, size, iv, iv_size );
+  ak_libakrypt_set_option( "chain_decrypt_threads", 1 );
+  time_single = clock();
+  ak_bckey_decrypt_cbc( key, out, out2, size, iv, iv_size );
+  time_single = clock() - time_single;
+  if( memcmp( in, out2, size ) != 0 ) {
+    printf("Wrong (cbc decryption)\n");
+    goto lab_exit;
+  }
+  ak_libakrypt_set_option( "chain_decrypt_threads", threads );
+  memset( out2, 0, size );
+  time_threads = clock();
+  if( ak_bckey_decrypt_cbc( key, out, out2, size, iv, iv_size ) != ak_error_ok ) {
+    printf("cbc decryption error\n");
+    goto lab_exit;
+  }
+  time_threads = clock() - time_threads;
+  if( memcmp( in, out2, size ) != 0 ) {
+    printf("Wrong (cbc threaded decryption)\n");
+    goto lab_exit;
+  }
+  ak_bckey_decrypt_cbc( key, out, out, size, iv, iv_size );
+  if( memcmp( in, out, size ) != 0 ) {
+    printf("Wrong (cbc threaded in-place decryption)\n");
+    goto lab_exit;
+  }
+  printf("cbc: %f/%f sec, ", (double) time_single / (double) CLOCKS_PER_SEC,
+                                             (double) time_threads / (double) CLOCKS_PER_SEC );
+
+ /* режим гаммирования с обратной связью по шифртексту */
+  ak_bckey_encrypt_cfb( key, in, out, size, iv, iv_size );
+  ak_libakrypt_set_option( "chain_decrypt_threads", 1 );
+  time_single = clock();
+  ak_bckey_decrypt_cfb( key, out, out2, size, iv, iv_size );
+  time_single = clock() - time_single;
+  if( memcmp( in, out2, size ) != 0 ) {
+    printf("Wrong (cfb decryption)\n");
+    goto lab_exit;
+  }
+  ak_libakrypt_set_option( "chain_decrypt_threads", threads );
+  memset( out2, 0, size );
+  time_threads = clock();
+  if( ak_bckey_decrypt_cfb( key, out, out2, size, iv, iv_size ) != ak_error_ok ) {
+    printf("cfb decryption error\n");
+    goto lab_exit;
+  }
+  time_threads = clock() - time_threads;
+  if( memcmp( in, out2, size ) != 0 ) {
+    printf("Wrong (cfb threaded decryption)\n");
+    goto lab_exit;
+  }
+  ak_bckey_decrypt_cfb( key, out, out, size, iv, iv_size );
+  if( memcmp( in, out, size ) != 0 ) {
+    printf("Wrong (cfb threaded in-place decryption)\n");
+    goto lab_exit;
+  }
+  printf("cfb: %f/%f sec Ok\n", (double) time_single / (double) CLOCKS_PER_SEC,
+                                             (double) time_threads / (double) CLOCKS_PER_SEC );
+  result = ak_true;
+
+  lab_exit:
+   ak_libakrypt_set_option( "chain_decrypt_threads", 1 );
+   if( in ) free( in );
+   if( out ) free( out );
+   if( out2 ) free( out2 );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  struct bckey key;
+  int error = EXIT_SUCCESS;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( NULL )) return ak_libakrypt_destroy();
+  ak_libakrypt_set_openssl_compability( ak_false );
+                                   /* контрольные примеры расчитаны для несовместимого режима */
+ /* алгоритм Кузнечик: синхропосылка из двух блоков */
+  ak_bckey_create_kuznechik( &key );
+  ak_bckey_set_key( &key, kuznechik_key, sizeof( kuznechik_key ));
+  if( test_vectors( &key, kuznechik_in, sizeof( kuznechik_in ), kuznechik_iv, 32,
+                        kuznechik_outcbc, 32, kuznechik_outcfb ) != ak_true ) error = EXIT_FAILURE;
+  if( test_threads( &key, 1048576, kuznechik_iv, 16, 4 ) != ak_true ) error = EXIT_FAILURE;
+  if( test_threads( &key, 1048576 + 16*3, kuznechik_iv, 32, 3 ) != ak_true ) error = EXIT_FAILURE;
+  if( test_threads( &key, 16*1001, kuznechik_iv, 32, 4 ) != ak_true ) error = EXIT_FAILURE;
+  ak_bckey_destroy( &key );
+
+ /* алгоритм Магма: синхропосылка из трех (cbc) и двух (cfb) блоков */
+  ak_bckey_create_magma( &key );
+  ak_bckey_set_key( &key, magma_key, sizeof( magma_key ));
+  if( test_vectors( &key, magma_in, sizeof( magma_in ), magma_iv, 24,
+                                magma_outcbc, 16, magma_outcfb ) != ak_true ) error = EXIT_FAILURE;
+  if( test_threads( &key, 131072, magma_iv, 8, 4 ) != ak_true ) error = EXIT_FAILURE;
+  if( test_threads( &key, 131072 + 8*5, magma_iv, 24, 4 ) != ak_true ) error = EXIT_FAILURE;
+  ak_bckey_destroy( &key );
+
+  ak_libakrypt_destroy();
+ return error;
+}
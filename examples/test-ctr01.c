@@ -0,0 +1,232 @@
+/* ----------------------------------------------------------------------------------------------- */
+/* Тестовый пример, проверяющий корректность работы буффера предварительно выработанной гаммы:
+   контрольные примеры режима гаммирования из ГОСТ Р 34.13-2015, результат зашифрования
+   последовательности пакетов сравнивается с результатом функции ak_bckey_ctr(), проверяется
+   согласованность ресурса ключа, уничтожение использованной гаммы и ограничение размера
+   буффера, а также сравнивается время зашифрования коротких пакетов.
+
+   test-ctr01.c                                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+
+ #include <time.h>
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+ #define packets       (4096)
+ #define packet_size     (64)
+
+/* ГОСТ Р 34.13-2015, приложение А.1.2 (алгоритм Кузнечик): ключ, открытый текст,
+   синхропосылка и шифртекст */
+ static ak_uint8 keyAnnexA[32] = {
+     0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+     0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88 };
+
+ static ak_uint8 kuznechik_in[64] = {
+     0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11,
+     0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00,
+     0x00, 0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11,
+     0x11, 0x00, 0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22 };
+
+ static ak_uint8 kuznechik_iv[8] = { 0xf0, 0xce, 0xab, 0x90, 0x78, 0x56, 0x34, 0x12 };
+
+ static ak_uint8 kuznechik_out[64] = {
+     0xb8, 0xa1, 0xbd, 0x40, 0xa2, 0x5f, 0x7b, 0xd5, 0xdb, 0xd1, 0x0e, 0xc1, 0xbe, 0xd8, 0x95, 0xf1,
+     0xe4, 0xde, 0x45, 0x3c, 0xb3, 0xe4, 0x3c, 0xf3, 0x5d, 0x3e, 0xa1, 0xf6, 0x33, 0xe7, 0xee, 0x85,
+     0xa5, 0xa3, 0x64, 0x35, 0xf1, 0x77, 0xe8, 0xd5, 0xd3, 0x6e, 0x35, 0xe6, 0x8b, 0xe8, 0xea, 0xa5,
+     0x73, 0xba, 0xbd, 0x20, 0x58, 0xd1, 0xc6, 0xd1, 0xb6, 0xba, 0x0c, 0xf2, 0xb1, 0xfa, 0x91, 0xcb };
+
+/* ГОСТ Р 34.13-2015, приложение А.2.2 (алгоритм Магма) */
+ static ak_uint8 keyAnnexB[32] = {
+     0xff, 0xfe, 0xfd, 0xfc, 0xfb, 0xfa, 0xf9, 0xf8, 0xf7, 0xf6, 0xf5, 0xf4, 0xf3, 0xf2, 0xf1, 0xf0,
+     0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+
+ static ak_uint8 magma_in[32] = {
+     0x59, 0x0a, 0x13, 0x3c, 0x6b, 0xf0, 0xde, 0x92, 0x20, 0x9d, 0x18, 0xf8, 0x04, 0xc7, 0x54, 0xdb,
+     0x4c, 0x02, 0xa8, 0x67, 0x2e, 0xfb, 0x98, 0x4a, 0x41, 0x7e, 0xb5, 0x17, 0x9b, 0x40, 0x12, 0x89 };
+
+ static ak_uint8 magma_iv[4] = { 0x78, 0x56, 0x34, 0x12 };
+
+ static ak_uint8 magma_out[32] = {
+     0x3c, 0xb9, 0xb7, 0x97, 0x0c, 0x11, 0x98, 0x4e, 0x69, 0x5d, 0xe8, 0xd6, 0x93, 0x0d, 0x25, 0x3e,
+     0xef, 0xdb, 0xb2, 0x07, 0x88, 0x86, 0x6d, 0x13, 0x2d, 0xa1, 0x52, 0xab, 0x80, 0xb6, 0x8e, 0x56 };
+
+/* ----------------------------------------------------------------------------------------------- */
+/* зашифровываем контрольный пример пакетами длины в один и два блока */
+ static int test_vector( ak_bckey key, ak_uint8 *in, size_t size, ak_uint8 *iv, size_t iv_size,
+                                                              ak_uint8 *cipher, bool_t background )
+{
+  size_t offset = 0, len = 0;
+  struct ctr_reservoir rsv;
+  int result = ak_false;
+  ak_uint8 out[64];
+
+  if( ak_ctr_reservoir_create( &rsv, key, 4*key->bsize, background ) != ak_error_ok )
+    return ak_false;
+  if( ak_ctr_reservoir_set_iv( &rsv, iv, iv_size ) != ak_error_ok ) goto exit;
+
+  memset( out, 0, sizeof( out ));
+  while( offset < size ) {
+    len = ak_min((( offset/key->bsize )%2 + 1 )*key->bsize, size - offset );
+    if( ak_ctr_reservoir_xor( &rsv, in + offset, out + offset, len ) != ak_error_ok ) goto exit;
+    offset += len;
+  }
+  if( ak_ptr_is_equal_with_log( out, cipher, size )) result = ak_true;
+
+  exit:
+   ak_ctr_reservoir_destroy( &rsv );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* проверяем, что вне области неиспользованной гаммы буффер содержит только нули */
+ static bool_t test_wiped( ak_ctr_reservoir rsv )
+{
+  size_t i = 0;
+
+  for( i = rsv->count; i < rsv->size; i++ )
+     if( rsv->buffer[( rsv->head + i )%rsv->size] != 0 ) return ak_false;
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* зашифровываем последовательность пакетов двумя способами */
+ static int test_stream( ak_bckey key, ak_bckey key2, bool_t background )
+{
+  size_t i = 0, len = 0;
+  struct ctr_reservoir rsv;
+  int result = ak_false;
+  ak_uint8 iv[16], in[1024], out[1024], out2[1024];
+  ak_int64 resource = 0;
+
+  for( i = 0; i < sizeof( iv ); i++ ) iv[i] = ( ak_uint8 )( 0x3c + 5*i );
+  for( i = 0; i < sizeof( in ); i++ ) in[i] = ( ak_uint8 )( 7*i + ( i >> 8 ));
+  if( ak_ctr_reservoir_create( &rsv, key, 1000, background ) != ak_error_ok ) return ak_false;
+  if( rsv.size%key->bsize != 0 ) goto exit;
+
+ /* без синхропосылки гамма не вырабатывается */
+  if( ak_ctr_reservoir_xor( &rsv, in, out, key->bsize ) == ak_error_ok ) goto exit;
+  if( ak_ctr_reservoir_set_iv( &rsv, iv, key->bsize >> 1 ) != ak_error_ok ) goto exit;
+  if( ak_bckey_ctr( key2, NULL, NULL, 0, iv, key->bsize >> 1 ) != ak_error_ok ) goto exit;
+
+ /* ресурс ключа расходуется при выработке гаммы */
+  if( !background ) {
+    resource = key->key.resource.value.counter;
+    if( ak_ctr_reservoir_fill( &rsv ) != ak_error_ok ) goto exit;
+    if( resource - key->key.resource.value.counter != ( ak_int64 )( rsv.size/key->bsize ))
+      goto exit;
+  }
+
+ /* пакеты, длина которых кратна длине блока */
+  for( i = 0; i < 64; i++ ) {
+     len = key->bsize*(( 7*i + 3 )%( sizeof( in )/key->bsize ));
+     if( ak_ctr_reservoir_xor( &rsv, in, out, len ) != ak_error_ok ) goto exit;
+     if( ak_bckey_ctr( key2, in, out2, len, NULL, 0 ) != ak_error_ok ) goto exit;
+     if( memcmp( out, out2, len ) != 0 ) goto exit;
+     if( !background && !test_wiped( &rsv )) goto exit;
+  }
+ /* последний пакет с неполным блоком */
+  len = 3*key->bsize + 5;
+  if( ak_ctr_reservoir_xor( &rsv, in, out, len ) != ak_error_ok ) goto exit;
+  if( ak_bckey_ctr( key2, in, out2, len, NULL, 0 ) != ak_error_ok ) goto exit;
+  if( memcmp( out, out2, len ) != 0 ) goto exit;
+  if( !background && !test_wiped( &rsv )) goto exit;
+
+ /* после неполного блока продолжение невозможно */
+  if( ak_ctr_reservoir_xor( &rsv, in, out, key->bsize ) == ak_error_ok ) goto exit;
+  ak_ctr_reservoir_destroy( &rsv );
+
+ /* размер буффера ограничен */
+  if( ak_ctr_reservoir_create( &rsv, key, 1 << 20, ak_false ) != ak_error_ok ) return ak_false;
+  if( rsv.size > 65536 ) goto exit;
+  result = ak_true;
+
+  exit:
+   ak_ctr_reservoir_destroy( &rsv );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* сравниваем время зашифрования коротких пакетов */
+ static void test_latency( ak_bckey key, ak_bckey key2 )
+{
+  size_t i = 0;
+  struct ctr_reservoir rsv;
+  clock_t timea, timeb;
+  ak_uint8 iv[16], data[packet_size];
+
+  memset( iv, 0x11, sizeof( iv ));
+  memset( data, 0x22, sizeof( data ));
+  ak_bckey_ctr( key2, NULL, NULL, 0, iv, key2->bsize >> 1 );
+  timea = clock();
+  for( i = 0; i < packets; i++ ) ak_bckey_ctr( key2, data, data, packet_size, NULL, 0 );
+  timea = clock() - timea;
+
+  ak_ctr_reservoir_create( &rsv, key, packets*packet_size, ak_false );
+  ak_ctr_reservoir_set_iv( &rsv, iv, key->bsize >> 1 );
+  ak_ctr_reservoir_fill( &rsv );
+  timeb = clock();
+  for( i = 0; i < packets; i++ ) ak_ctr_reservoir_xor( &rsv, data, data, packet_size );
+  timeb = clock() - timeb;
+  ak_ctr_reservoir_destroy( &rsv );
+
+  printf(" %u packets of %u bytes: ctr %f sec, reservoir %f sec\n",
+         (unsigned int) packets, (unsigned int) packet_size,
+         (double) timea / (double) CLOCKS_PER_SEC, (double) timeb / (double) CLOCKS_PER_SEC );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* проверяем контрольный пример и буффер для одного ключа */
+ static int test_key( ak_function_bckey_create *create, ak_uint8 *keyval, ak_uint8 *in,
+                                       size_t size, ak_uint8 *iv, size_t iv_size, ak_uint8 *cipher )
+{
+  struct bckey key, key2;
+  int result = ak_true;
+
+  create( &key );
+  create( &key2 );
+  ak_bckey_set_key( &key, keyval, 32 );
+  ak_bckey_set_key( &key2, keyval, 32 );
+  printf("%s: ", key.key.oid->name[0] );
+
+  if(( test_vector( &key, in, size, iv, iv_size, cipher, ak_false ) != ak_true ) ||
+     ( test_vector( &key, in, size, iv, iv_size, cipher, ak_true ) != ak_true )) {
+    printf("Wrong (GOST R 34.13-2015)\n");
+    result = ak_false;
+  }
+  if( result && ( test_stream( &key, &key2, ak_false ) != ak_true )) {
+    printf("Wrong (on demand)\n");
+    result = ak_false;
+  }
+  if( result && ( test_stream( &key, &key2, ak_true ) != ak_true )) {
+    printf("Wrong (background)\n");
+    result = ak_false;
+  }
+  if( result ) {
+    printf("Ok\n");
+    test_latency( &key, &key2 );
+  }
+
+  ak_bckey_destroy( &key );
+  ak_bckey_destroy( &key2 );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  int error = EXIT_SUCCESS;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( NULL )) return ak_libakrypt_destroy();
+  ak_libakrypt_set_openssl_compability( ak_false );
+                                   /* контрольные примеры расчитаны для несовместимого режима */
+  if( test_key( ak_bckey_create_kuznechik, keyAnnexA, kuznechik_in, sizeof( kuznechik_in ),
+          kuznechik_iv, sizeof( kuznechik_iv ), kuznechik_out ) != ak_true ) error = EXIT_FAILURE;
+  if( test_key( ak_bckey_create_magma, keyAnnexB, magma_in, sizeof( magma_in ),
+                      magma_iv, sizeof( magma_iv ), magma_out ) != ak_true ) error = EXIT_FAILURE;
+
+  ak_libakrypt_destroy();
+ return error;
+}
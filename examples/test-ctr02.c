@@ -0,0 +1,116 @@
+/* ----------------------------------------------------------------------------------------------- */
+/* Тестовый пример, проверяющий корректность специализированной реализации режима гаммирования
+   для блочного шифра Кузнечик: результат функции ak_bckey_ctr() сравнивается с гаммой,
+   выработанной поблочным зашифрованием счетчика, в обоих режимах совместимости,
+   в том числе при переносах в старшие октеты счетчика. Те же проверки выполняются для
+   алгоритма AES, который использует общую реализацию режима для шифров с длиной блока 128 бит.
+
+   test-ctr02.c                                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+
+ #include <time.h>
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+ #define blocks_count  (70000)
+
+/* вырабатываем гамму, зашифровывая каждое значение счетчика */
+ void reference_ctr( ak_bckey key, ak_uint8 *iv, ak_uint8 *in, ak_uint8 *out,
+                                                                          size_t size, bool_t oc )
+{
+  size_t i = 0, j = 0;
+  ak_uint64 counter = 0;
+  ak_uint8 block[16], gamma[16];
+
+  for( i = 0; i < size; i += 16, counter++ ) {
+     if( oc ) {
+       memcpy( block, iv, 8 );
+       for( j = 0; j < 8; j++ ) block[15-j] = ( ak_uint8 )( counter >> 8*j );
+     } else {
+         for( j = 0; j < 8; j++ ) block[j] = ( ak_uint8 )( counter >> 8*j );
+         memcpy( block+8, iv, 8 );
+       }
+     key->encrypt( &key->key, block, gamma );
+     for( j = 0; ( j < 16 ) && ( i + j < size ); j++ ) {
+        if(( size - i < 16 ) && !oc ) out[i+j] = in[i+j] ^ gamma[16 - ( size - i ) + j];
+         else out[i+j] = in[i+j] ^ gamma[j];
+     }
+  }
+}
+
+ int test_mode( ak_function_create_object *create, size_t keysize, bool_t oc )
+{
+  struct bckey key;
+  struct random generator;
+  clock_t timea, timeb;
+  int result = ak_false;
+  size_t size = 16*blocks_count + 7;
+  ak_uint8 keyval[32], iv[8], *in = NULL, *out = NULL, *out2 = NULL;
+
+  ak_libakrypt_set_openssl_compability( oc );
+  ak_random_create_lcg( &generator );
+  ak_random_ptr( &generator, keyval, sizeof( keyval ));
+  ak_random_ptr( &generator, iv, sizeof( iv ));
+  create( &key );
+  ak_bckey_set_key( &key, keyval, keysize );
+  printf("%s, openssl_compability = %d: ", key.key.oid->name[0], oc );
+
+  if((( in = malloc( size )) == NULL ) || (( out = malloc( size )) == NULL ) ||
+                                                     (( out2 = malloc( size )) == NULL )) goto exit;
+  ak_random_ptr( &generator, in, size );
+
+  timea = clock();
+  reference_ctr( &key, iv, in, out, size, oc );
+  timea = clock() - timea;
+
+ /* один вызов */
+  timeb = clock();
+  if( ak_bckey_ctr( &key, in, out2, size, iv, sizeof( iv )) != ak_error_ok ) goto exit;
+  timeb = clock() - timeb;
+  if( memcmp( out, out2, size ) != 0 ) goto exit;
+
+ /* последовательность вызовов, начинающихся с произвольных значений младшего октета */
+  memset( out2, 0, size );
+  if( ak_bckey_ctr( &key, in, out2, 16*3, iv, sizeof( iv )) != ak_error_ok ) goto exit;
+  if( ak_bckey_ctr( &key, in+48, out2+48, 16*300, NULL, 0 ) != ak_error_ok ) goto exit;
+  if( ak_bckey_ctr( &key, in+4848, out2+4848, 16*1, NULL, 0 ) != ak_error_ok ) goto exit;
+  if( ak_bckey_ctr( &key, in+4864, out2+4864, size-4864, NULL, 0 ) != ak_error_ok ) goto exit;
+  if( memcmp( out, out2, size ) != 0 ) goto exit;
+
+  printf("Ok (reference %f sec, ctr %f sec)\n", (double) timea / (double) CLOCKS_PER_SEC,
+                                                       (double) timeb / (double) CLOCKS_PER_SEC );
+  result = ak_true;
+
+  exit:
+   if( !result ) printf("Wrong\n");
+   if( in ) free( in );
+   if( out ) free( out );
+   if( out2 ) free( out2 );
+   ak_bckey_destroy( &key );
+   ak_random_destroy( &generator );
+ return result;
+}
+
+ int main( void )
+{
+  int error = EXIT_SUCCESS, oc = 0;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( NULL )) return ak_libakrypt_destroy();
+  oc = ( int ) ak_libakrypt_get_option_by_name( "openssl_compability" );
+
+  if( test_mode( ( ak_function_create_object *) ak_bckey_create_kuznechik, 32, ak_false )
+                                                                != ak_true ) error = EXIT_FAILURE;
+  if( test_mode( ( ak_function_create_object *) ak_bckey_create_kuznechik, 32, ak_true )
+                                                                != ak_true ) error = EXIT_FAILURE;
+  if( test_mode( ( ak_function_create_object *) ak_bckey_create_aes128, 16, ak_false )
+                                                                != ak_true ) error = EXIT_FAILURE;
+  if( test_mode( ( ak_function_create_object *) ak_bckey_create_aes128, 16, ak_true )
+                                                                != ak_true ) error = EXIT_FAILURE;
+
+  ak_libakrypt_set_openssl_compability( oc );
+  ak_libakrypt_destroy();
+ return error;
+}
@@ -0,0 +1,271 @@
+/* ----------------------------------------------------------------------------------------------- */
+/* Тестовый пример, проверяющий корректность и скорость работы режима аутентифицированного
+   шифрования gcm: контрольные примеры 2, 3, 4, 6, 16 и 18 из описания режима (алгоритмы AES-128
+   и AES-256, в том числе синхропосылки длины 8 и 60 октетов), зашифрование и расшифрование
+   данных различной длины, расшифрование на месте, а также обнаружение изменений в шифртексте,
+   ассоциированных данных и имитовставке.
+
+   test-gcm01.c                                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+
+ #include <time.h>
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+/* D. McGrew, J. Viega, The Galois/Counter Mode of Operation, приложение B: общие для
+   контрольных примеров 3 - 18 ключ (для AES-128 используются первые 16 октетов),
+   открытый текст, ассоциированные данные и синхропосылки */
+ static ak_uint8 nist_key[32] = {
+     0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c, 0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+     0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c, 0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08 };
+
+ static ak_uint8 nist_plain[64] = {
+     0xd9, 0x31, 0x32, 0x25, 0xf8, 0x84, 0x06, 0xe5, 0xa5, 0x59, 0x09, 0xc5, 0xaf, 0xf5, 0x26, 0x9a,
+     0x86, 0xa7, 0xa9, 0x53, 0x15, 0x34, 0xf7, 0xda, 0x2e, 0x4c, 0x30, 0x3d, 0x8a, 0x31, 0x8a, 0x72,
+     0x1c, 0x3c, 0x0c, 0x95, 0x95, 0x68, 0x09, 0x53, 0x2f, 0xcf, 0x0e, 0x24, 0x49, 0xa6, 0xb5, 0x25,
+     0xb1, 0x6a, 0xed, 0xf5, 0xaa, 0x0d, 0xe6, 0x57, 0xba, 0x63, 0x7b, 0x39, 0x1a, 0xaf, 0xd2, 0x55 };
+
+ static ak_uint8 nist_adata[20] = {
+     0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+     0xab, 0xad, 0xda, 0xd2 };
+
+ static ak_uint8 nist_iv12[12] = {
+     0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88 };
+
+ static ak_uint8 nist_iv60[60] = {
+     0x93, 0x13, 0x22, 0x5d, 0xf8, 0x84, 0x06, 0xe5, 0x55, 0x90, 0x9c, 0x5a, 0xff, 0x52, 0x69, 0xaa,
+     0x6a, 0x7a, 0x95, 0x38, 0x53, 0x4f, 0x7d, 0xa1, 0xe4, 0xc3, 0x03, 0xd2, 0xa3, 0x18, 0xa7, 0x28,
+     0xc3, 0xc0, 0xc9, 0x51, 0x56, 0x80, 0x95, 0x39, 0xfc, 0xf0, 0xe2, 0x42, 0x9a, 0x6b, 0x52, 0x54,
+     0x16, 0xae, 0xdb, 0xf5, 0xa0, 0xde, 0x6a, 0x57, 0xa6, 0x37, 0xb3, 0x9b };
+
+/* номера контрольных примеров, длины ключей, синхропосылок, открытого текста
+   и ассоциированных данных */
+ #define nist_count (5)
+ static unsigned int nist_case[nist_count] = { 3, 4, 6, 16, 18 };
+ static size_t nist_key_size[nist_count] = { 16, 16, 16, 32, 32 };
+ static size_t nist_iv_size[nist_count] = { 12, 12, 60, 12, 60 };
+ static size_t nist_size[nist_count] = { 64, 60, 60, 60, 60 };
+ static size_t nist_adata_size[nist_count] = { 0, 20, 20, 20, 20 };
+
+ static ak_uint8 nist_cipher[nist_count][64] = {
+   { 0x42, 0x83, 0x1e, 0xc2, 0x21, 0x77, 0x74, 0x24, 0x4b, 0x72, 0x21, 0xb7, 0x84, 0xd0, 0xd4, 0x9c,
+     0xe3, 0xaa, 0x21, 0x2f, 0x2c, 0x02, 0xa4, 0xe0, 0x35, 0xc1, 0x7e, 0x23, 0x29, 0xac, 0xa1, 0x2e,
+     0x21, 0xd5, 0x14, 0xb2, 0x54, 0x66, 0x93, 0x1c, 0x7d, 0x8f, 0x6a, 0x5a, 0xac, 0x84, 0xaa, 0x05,
+     0x1b, 0xa3, 0x0b, 0x39, 0x6a, 0x0a, 0xac, 0x97, 0x3d, 0x58, 0xe0, 0x91, 0x47, 0x3f, 0x59, 0x85 },
+   { 0x42, 0x83, 0x1e, 0xc2, 0x21, 0x77, 0x74, 0x24, 0x4b, 0x72, 0x21, 0xb7, 0x84, 0xd0, 0xd4, 0x9c,
+     0xe3, 0xaa, 0x21, 0x2f, 0x2c, 0x02, 0xa4, 0xe0, 0x35, 0xc1, 0x7e, 0x23, 0x29, 0xac, 0xa1, 0x2e,
+     0x21, 0xd5, 0x14, 0xb2, 0x54, 0x66, 0x93, 0x1c, 0x7d, 0x8f, 0x6a, 0x5a, 0xac, 0x84, 0xaa, 0x05,
+     0x1b, 0xa3, 0x0b, 0x39, 0x6a, 0x0a, 0xac, 0x97, 0x3d, 0x58, 0xe0, 0x91 },
+   { 0x8c, 0xe2, 0x49, 0x98, 0x62, 0x56, 0x15, 0xb6, 0x03, 0xa0, 0x33, 0xac, 0xa1, 0x3f, 0xb8, 0x94,
+     0xbe, 0x91, 0x12, 0xa5, 0xc3, 0xa2, 0x11, 0xa8, 0xba, 0x26, 0x2a, 0x3c, 0xca, 0x7e, 0x2c, 0xa7,
+     0x01, 0xe4, 0xa9, 0xa4, 0xfb, 0xa4, 0x3c, 0x90, 0xcc, 0xdc, 0xb2, 0x81, 0xd4, 0x8c, 0x7c, 0x6f,
+     0xd6, 0x28, 0x75, 0xd2, 0xac, 0xa4, 0x17, 0x03, 0x4c, 0x34, 0xae, 0xe5 },
+   { 0x52, 0x2d, 0xc1, 0xf0, 0x99, 0x56, 0x7d, 0x07, 0xf4, 0x7f, 0x37, 0xa3, 0x2a, 0x84, 0x42, 0x7d,
+     0x64, 0x3a, 0x8c, 0xdc, 0xbf, 0xe5, 0xc0, 0xc9, 0x75, 0x98, 0xa2, 0xbd, 0x25, 0x55, 0xd1, 0xaa,
+     0x8c, 0xb0, 0x8e, 0x48, 0x59, 0x0d, 0xbb, 0x3d, 0xa7, 0xb0, 0x8b, 0x10, 0x56, 0x82, 0x88, 0x38,
+     0xc5, 0xf6, 0x1e, 0x63, 0x93, 0xba, 0x7a, 0x0a, 0xbc, 0xc9, 0xf6, 0x62 },
+   { 0x5a, 0x8d, 0xef, 0x2f, 0x0c, 0x9e, 0x53, 0xf1, 0xf7, 0x5d, 0x78, 0x53, 0x65, 0x9e, 0x2a, 0x20,
+     0xee, 0xb2, 0xb2, 0x2a, 0xaf, 0xde, 0x64, 0x19, 0xa0, 0x58, 0xab, 0x4f, 0x6f, 0x74, 0x6b, 0xf4,
+     0x0f, 0xc0, 0xc3, 0xb7, 0x80, 0xf2, 0x44, 0x45, 0x2d, 0xa3, 0xeb, 0xf1, 0xc5, 0xd8, 0x2c, 0xde,
+     0xa2, 0x41, 0x89, 0x97, 0x20, 0x0e, 0xf8, 0x2e, 0x44, 0xae, 0x7e, 0x3f }};
+
+ static ak_uint8 nist_tag[nist_count][16] = {
+   { 0x4d, 0x5c, 0x2a, 0xf3, 0x27, 0xcd, 0x64, 0xa6, 0x2c, 0xf3, 0x5a, 0xbd, 0x2b, 0xa6, 0xfa, 0xb4 },
+   { 0x5b, 0xc9, 0x4f, 0xbc, 0x32, 0x21, 0xa5, 0xdb, 0x94, 0xfa, 0xe9, 0x5a, 0xe7, 0x12, 0x1a, 0x47 },
+   { 0x61, 0x9c, 0xc5, 0xae, 0xff, 0xfe, 0x0b, 0xfa, 0x46, 0x2a, 0xf4, 0x3c, 0x16, 0x99, 0xd0, 0x50 },
+   { 0x76, 0xfc, 0x6e, 0xce, 0x0f, 0x4e, 0x17, 0x68, 0xcd, 0xdf, 0x88, 0x53, 0xbb, 0x2d, 0x55, 0x1b },
+   { 0xa4, 0x4a, 0x82, 0x66, 0xee, 0x1c, 0x8e, 0xb0, 0xc8, 0xb5, 0xd4, 0xcf, 0x5a, 0xe9, 0xf1, 0x9a }};
+
+/* константное значение ключа из ГОСТ Р 34.13-2015 */
+ static ak_uint8 keyAnnexA[32] = {
+     0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+     0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88 };
+
+/* ----------------------------------------------------------------------------------------------- */
+/* контрольный пример 2 из описания режима: нулевой ключ, нулевая синхропосылка */
+ static int test_nist_zero( void )
+{
+  struct bckey key;
+  int result = ak_false;
+  ak_uint8 zero[16], out[16], icode[16];
+  ak_uint8 cipher[16] = {
+     0x03, 0x88, 0xda, 0xce, 0x60, 0xb6, 0xa3, 0x92, 0xf3, 0x28, 0xc2, 0xb9, 0x71, 0xb2, 0xfe, 0x78 };
+  ak_uint8 tag[16] = {
+     0xab, 0x6e, 0x47, 0xd4, 0x2c, 0xec, 0x13, 0xbd, 0xf5, 0x3a, 0x67, 0xb2, 0x12, 0x57, 0xbd, 0xdf };
+
+  memset( zero, 0, sizeof( zero ));
+  ak_bckey_create_aes128( &key );
+  ak_bckey_set_key( &key, zero, 16 );
+  if( ak_bckey_encrypt_gcm( &key, NULL, NULL, 0, zero, out, 16,
+                                         zero, 12, icode, sizeof( icode )) == ak_error_ok ) {
+    if(( memcmp( out, cipher, 16 ) == 0 ) && ( memcmp( icode, tag, 16 ) == 0 )) result = ak_true;
+  }
+  printf("nist test case 2: %s\n", result ? "Ok" : "Wrong" );
+  ak_bckey_destroy( &key );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* контрольные примеры 3 - 18: зашифрование и расшифрование на месте */
+ static int test_nist( size_t idx )
+{
+  struct bckey key;
+  int result = ak_false;
+  ak_uint8 out[64], icode[16];
+  ak_uint8 *iv = ( nist_iv_size[idx] == 12 ) ? nist_iv12 : nist_iv60;
+
+  if( nist_key_size[idx] == 16 ) ak_bckey_create_aes128( &key );
+   else ak_bckey_create_aes256( &key );
+  ak_bckey_set_key( &key, nist_key, nist_key_size[idx] );
+  printf("nist test case %u (%s): ", nist_case[idx], key.key.oid->name[0] );
+
+  memset( out, 0, sizeof( out ));
+  memset( icode, 0, sizeof( icode ));
+  ak_bckey_encrypt_gcm( &key, &key, nist_adata, nist_adata_size[idx], nist_plain, out,
+                         nist_size[idx], iv, nist_iv_size[idx], icode, sizeof( icode ));
+  if( !ak_ptr_is_equal_with_log( out, nist_cipher[idx], nist_size[idx] )) {
+    printf("Wrong (encryption)\n");
+    goto lab_exit;
+  }
+  if( !ak_ptr_is_equal_with_log( icode, nist_tag[idx], sizeof( icode ))) {
+    printf("Wrong (integrity code)\n");
+    goto lab_exit;
+  }
+  if( ak_bckey_decrypt_gcm( &key, &key, nist_adata, nist_adata_size[idx], out, out,
+              nist_size[idx], iv, nist_iv_size[idx], icode, sizeof( icode )) != ak_error_ok ) {
+    printf("Wrong (integrity code checking)\n");
+    goto lab_exit;
+  }
+  if( !ak_ptr_is_equal_with_log( out, nist_plain, nist_size[idx] )) {
+    printf("Wrong (decryption)\n");
+    goto lab_exit;
+  }
+  printf("Ok\n");
+  result = ak_true;
+
+  lab_exit:
+   ak_bckey_destroy( &key );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* проверяем один набор данных */
+ static int test_gcm( ak_bckey key, ak_uint8 *adata, size_t adata_size,
+                           ak_uint8 *in, ak_uint8 *out, size_t size, ak_uint8 *iv, size_t iv_size )
+{
+  ak_uint8 icode[16], icode2[16];
+  ak_uint8 *buffer = malloc( size + 1 );
+  int result = ak_false;
+
+  if( buffer == NULL ) return ak_false;
+  if( ak_bckey_encrypt_gcm( key, key, adata, adata_size, in, out, size,
+                                      iv, iv_size, icode, sizeof( icode )) != ak_error_ok ) goto exit;
+ /* расшифрование на месте */
+  memcpy( buffer, out, size );
+  if( ak_bckey_decrypt_gcm( key, key, adata, adata_size, buffer, buffer, size,
+                                      iv, iv_size, icode, sizeof( icode )) != ak_error_ok ) goto exit;
+  if( memcmp( buffer, in, size ) != 0 ) goto exit;
+
+ /* изменения должны быть обнаружены */
+  memcpy( icode2, icode, sizeof( icode ));
+  icode2[15] ^= 0x01;
+  if( ak_bckey_decrypt_gcm( key, key, adata, adata_size, out, buffer, size,
+                                iv, iv_size, icode2, sizeof( icode2 )) == ak_error_ok ) goto exit;
+  if( adata_size > 0 ) {
+    adata[adata_size-1] ^= 0x01;
+    if( ak_bckey_decrypt_gcm( key, key, adata, adata_size, out, buffer, size,
+                                   iv, iv_size, icode, sizeof( icode )) == ak_error_ok ) goto exit;
+    adata[adata_size-1] ^= 0x01;
+  }
+  if( size > 0 ) {
+    out[size >> 1] ^= 0x10;
+    if( ak_bckey_decrypt_gcm( key, key, adata, adata_size, out, buffer, size,
+                                   iv, iv_size, icode, sizeof( icode )) == ak_error_ok ) goto exit;
+    out[size >> 1] ^= 0x10;
+  }
+  result = ak_true;
+
+  exit:
+   free( buffer );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* данные различной длины и синхропосылки различной длины (в том числе отличной от 12 октетов) */
+ static int test_sizes( ak_function_bckey_create *create, size_t key_size )
+{
+  size_t i = 0;
+  struct bckey key;
+  clock_t timea;
+  int result = ak_false;
+  ak_uint8 iv[64], adata[512], *in = NULL, *out = NULL;
+  size_t sizes[] = { 0, 1, 15, 16, 17, 127, 128, 129, 143, 255, 256, 257, 511, 512 },
+         big = 4*1048576;
+
+  create( &key );
+  ak_bckey_set_key( &key, keyAnnexA, key_size );
+  printf("%s: ", key.key.oid->name[0] );
+
+  if((( in = malloc( big )) == NULL ) || (( out = malloc( big )) == NULL )) {
+    printf("incorrect memory allocation\n");
+    goto exit;
+  }
+  for( i = 0; i < sizeof( iv ); i++ ) iv[i] = ( ak_uint8 )( 0x5a ^ 3*i );
+  for( i = 0; i < sizeof( adata ); i++ ) adata[i] = ( ak_uint8 )( 5*i + 1 );
+  for( i = 0; i < big; i++ ) in[i] = ( ak_uint8 )( 3*i + ( i >> 10 ));
+
+  for( i = 0; i < sizeof( sizes )/sizeof( size_t ); i++ ) {
+     if( test_gcm( &key, adata, sizes[i], in, out, sizes[ sizeof( sizes )/sizeof( size_t ) -1 -i ],
+                                                         iv, ( i%2 ) ? 12 : 1 + 9*i ) != ak_true ) {
+       printf("Wrong (adata: %u bytes)\n", (unsigned int) sizes[i] );
+       goto exit;
+     }
+  }
+
+ /* большой объем данных */
+  timea = clock();
+  if( test_gcm( &key, adata, sizeof( adata ), in, out, big, iv, 12 ) != ak_true ) {
+    printf("Wrong (%u bytes)\n", (unsigned int) big );
+    goto exit;
+  }
+  timea = clock() - timea;
+  printf("Ok (%f sec for %u MB)\n", (double) timea / (double) CLOCKS_PER_SEC,
+                                                                  (unsigned int)( big >> 20 ));
+  result = ak_true;
+
+  exit:
+   if( in ) free( in );
+   if( out ) free( out );
+   ak_bckey_destroy( &key );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  size_t i = 0;
+  int error = EXIT_SUCCESS;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( NULL )) return ak_libakrypt_destroy();
+  ak_libakrypt_set_openssl_compability( ak_false );
+
+ /* контрольные примеры */
+  if( test_nist_zero() != ak_true ) error = EXIT_FAILURE;
+  for( i = 0; i < nist_count; i++ ) if( test_nist( i ) != ak_true ) error = EXIT_FAILURE;
+  printf("gcm self test: ");
+  if( ak_libakrypt_test_gcm() != ak_true ) {
+    printf("Wrong\n");
+    error = EXIT_FAILURE;
+  } else printf("Ok\n");
+
+ /* данные различной длины */
+  if( test_sizes( ak_bckey_create_kuznechik, 32 ) != ak_true ) error = EXIT_FAILURE;
+  if( test_sizes( ak_bckey_create_aes128, 16 ) != ak_true ) error = EXIT_FAILURE;
+  if( test_sizes( ak_bckey_create_aes256, 32 ) != ak_true ) error = EXIT_FAILURE;
+
+  ak_libakrypt_destroy();
+ return error;
+}
@@ -0,0 +1,291 @@
+/* ----------------------------------------------------------------------------------------------- */
+/* Тестовый пример, проверяющий корректность работы режимов ctr, mgm и cmac для данных,
+   расположенных в последовательностях фрагментов (struct iovec): контрольные примеры
+   ГОСТ Р 34.13-2015 и Р 1323565.1.026-2019 обрабатываются при различных разбиениях данных
+   на фрагменты, после чего результат обработки фрагментированных данных различной длины
+   сравнивается с результатом обработки тех же данных, расположенных в памяти последовательно.
+
+   test-iov01.c                                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+ #define data_size   (1031)
+ #define max_count    (512)
+
+/* ГОСТ Р 34.13-2015, приложение А.1 (алгоритм Кузнечик): ключ, открытый текст,
+   синхропосылка и шифртекст режима гаммирования (А.1.2), имитовставка (А.1.6) */
+ static ak_uint8 keyAnnexA[32] = {
+     0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+     0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88 };
+
+ static ak_uint8 kuznechik_in[64] = {
+     0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11,
+     0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00,
+     0x00, 0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11,
+     0x11, 0x00, 0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22 };
+
+ static ak_uint8 kuznechik_ivctr[8] = { 0xf0, 0xce, 0xab, 0x90, 0x78, 0x56, 0x34, 0x12 };
+
+ static ak_uint8 kuznechik_outctr[64] = {
+     0xb8, 0xa1, 0xbd, 0x40, 0xa2, 0x5f, 0x7b, 0xd5, 0xdb, 0xd1, 0x0e, 0xc1, 0xbe, 0xd8, 0x95, 0xf1,
+     0xe4, 0xde, 0x45, 0x3c, 0xb3, 0xe4, 0x3c, 0xf3, 0x5d, 0x3e, 0xa1, 0xf6, 0x33, 0xe7, 0xee, 0x85,
+     0xa5, 0xa3, 0x64, 0x35, 0xf1, 0x77, 0xe8, 0xd5, 0xd3, 0x6e, 0x35, 0xe6, 0x8b, 0xe8, 0xea, 0xa5,
+     0x73, 0xba, 0xbd, 0x20, 0x58, 0xd1, 0xc6, 0xd1, 0xb6, 0xba, 0x0c, 0xf2, 0xb1, 0xfa, 0x91, 0xcb };
+
+ static ak_uint8 kuznechik_imito[8] = { 0xe3, 0xfb, 0x59, 0x60, 0x29, 0x4d, 0x6f, 0x33 };
+
+/* ГОСТ Р 34.13-2015, приложение А.2 (алгоритм Магма): ключ, открытый текст,
+   синхропосылка и шифртекст режима гаммирования (А.2.2), имитовставка (А.2.6) */
+ static ak_uint8 keyAnnexB[32] = {
+     0xff, 0xfe, 0xfd, 0xfc, 0xfb, 0xfa, 0xf9, 0xf8, 0xf7, 0xf6, 0xf5, 0xf4, 0xf3, 0xf2, 0xf1, 0xf0,
+     0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+
+ static ak_uint8 magma_in[32] = {
+     0x59, 0x0a, 0x13, 0x3c, 0x6b, 0xf0, 0xde, 0x92, 0x20, 0x9d, 0x18, 0xf8, 0x04, 0xc7, 0x54, 0xdb,
+     0x4c, 0x02, 0xa8, 0x67, 0x2e, 0xfb, 0x98, 0x4a, 0x41, 0x7e, 0xb5, 0x17, 0x9b, 0x40, 0x12, 0x89 };
+
+ static ak_uint8 magma_ivctr[4] = { 0x78, 0x56, 0x34, 0x12 };
+
+ static ak_uint8 magma_outctr[32] = {
+     0x3c, 0xb9, 0xb7, 0x97, 0x0c, 0x11, 0x98, 0x4e, 0x69, 0x5d, 0xe8, 0xd6, 0x93, 0x0d, 0x25, 0x3e,
+     0xef, 0xdb, 0xb2, 0x07, 0x88, 0x86, 0x6d, 0x13, 0x2d, 0xa1, 0x52, 0xab, 0x80, 0xb6, 0x8e, 0x56 };
+
+ static ak_uint8 magma_imito[4] = { 0x10, 0x72, 0x4e, 0x15 };
+
+/* режим mgm: ассоциированные данные, открытый текст и синхропосылка из Р 1323565.1.026-2019
+   (ключ keyAnnexA); для алгоритма Магма (ключ keyAnnexB) используются значения самотестирования
+   библиотеки */
+ static ak_uint8 mgm_adata[41] = {
+     0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+     0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0xea };
+
+ static ak_uint8 mgm_plain[67] = {
+     0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11,
+     0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00,
+     0x00, 0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11,
+     0x11, 0x00, 0x0a, 0xff, 0xee, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22,
+     0xcc, 0xbb, 0xaa };
+
+ static ak_uint8 mgm_kuznechik_iv[16] = {
+     0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11 };
+
+ static ak_uint8 mgm_kuznechik_cipher[67] = {
+     0xfc, 0x42, 0x9f, 0xe8, 0x3d, 0xa3, 0xb8, 0x55, 0x90, 0x6e, 0x95, 0x47, 0x81, 0x7b, 0x75, 0xa9,
+     0x39, 0x6b, 0xc1, 0xad, 0x9a, 0x06, 0xf7, 0xd3, 0x5b, 0xfd, 0xf9, 0x2b, 0x21, 0xd2, 0x75, 0x80,
+     0x1c, 0x85, 0xf6, 0xa9, 0x0e, 0x5d, 0x6b, 0x93, 0x85, 0xba, 0xa6, 0x15, 0x59, 0xb1, 0x7a, 0x49,
+     0xeb, 0x6d, 0xc7, 0x95, 0x06, 0x42, 0x94, 0xab, 0xd0, 0x83, 0xf8, 0xd3, 0xd4, 0x14, 0x0c, 0xc6,
+     0x52, 0x75, 0x2c };
+
+ static ak_uint8 mgm_kuznechik_icode[16] = {
+     0x4c, 0xdb, 0xfc, 0x29, 0x0e, 0xbb, 0xe8, 0x46, 0x5c, 0x4f, 0xc3, 0x40, 0x6f, 0x65, 0x5d, 0xcf };
+
+ static ak_uint8 mgm_magma_iv[8] = { 0x59, 0x0a, 0x13, 0x3c, 0x6b, 0xf0, 0xde, 0x92 };
+
+ static ak_uint8 mgm_magma_cipher[67] = {
+     0x3b, 0xa0, 0x9e, 0x5f, 0x6c, 0x06, 0x95, 0xc7, 0xae, 0x85, 0x91, 0x45, 0x42, 0x33, 0x11, 0x85,
+     0x5d, 0x78, 0x2b, 0xbf, 0xd6, 0x00, 0x2e, 0x1f, 0x7d, 0x8e, 0x9c, 0xbb, 0xb8, 0x70, 0x04, 0x94,
+     0x70, 0xdc, 0x7d, 0x1f, 0x73, 0xd3, 0x5d, 0x9a, 0x76, 0xa5, 0x6f, 0xce, 0x0a, 0xcb, 0x27, 0xec,
+     0xd5, 0x75, 0xbb, 0x6a, 0x64, 0x5c, 0xf6, 0x70, 0x4e, 0xc3, 0xb5, 0xbc, 0xc3, 0x37, 0xaa, 0x47,
+     0x9c, 0xbb, 0x03 };
+
+ static ak_uint8 mgm_magma_icode[8] = { 0x10, 0xfd, 0x10, 0xaa, 0x69, 0x80, 0x92, 0xa7 };
+
+/* ----------------------------------------------------------------------------------------------- */
+/* разбиваем область памяти на фрагменты (в том числе, пустые и однобайтовые); длины фрагментов
+   определяются параметром seed, что позволяет получать несовпадающие разбиения */
+ static size_t split( size_t seed, ak_uint8 *data, size_t size, struct iovec *iov )
+{
+  size_t len = 0, count = 0, offset = 0;
+
+  while(( offset < size ) && ( count < max_count - 1 )) {
+    len = ( seed + 7*count + ( count >> 2 )) % 37;
+    if( len > size - offset ) len = size - offset;
+    iov[count].iov_base = data + offset;
+    iov[count].iov_len = len;
+    offset += len; count++;
+  }
+  iov[count].iov_base = data + offset;
+  iov[count].iov_len = size - offset;
+ return ++count;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* проверяем контрольные примеры режимов ctr и cmac для разбиения с заданным параметром */
+ static int test_ctr_cmac( ak_bckey key, size_t seed, ak_uint8 *in, size_t size,
+                  ak_uint8 *iv, size_t iv_size, ak_uint8 *out, ak_uint8 *imito, size_t imito_size )
+{
+  size_t ic = 0, oc = 0;
+  ak_uint8 buffer[64], icode[16];
+  struct iovec iniov[max_count], outiov[max_count];
+
+  ic = split( seed, in, size, iniov );
+  oc = split( 3*seed + 5, buffer, size, outiov );
+
+  memset( buffer, 0, sizeof( buffer ));
+  if( ak_bckey_ctr_iov( key, iniov, ic, outiov, oc, iv, iv_size ) != ak_error_ok )
+    return ak_false;
+  if( !ak_ptr_is_equal_with_log( buffer, out, size )) return ak_false;
+
+  memset( icode, 0, sizeof( icode ));
+  if( ak_bckey_cmac_iov( key, iniov, ic, icode, imito_size ) != ak_error_ok ) return ak_false;
+  if( !ak_ptr_is_equal_with_log( icode, imito, imito_size )) return ak_false;
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* проверяем контрольный пример режима mgm для разбиения с заданным параметром:
+   зашифрование и расшифрование на месте */
+ static int test_mgm( ak_bckey key, size_t seed, ak_uint8 *iv, size_t iv_size,
+                                             ak_uint8 *cipher, ak_uint8 *imito, size_t imito_size )
+{
+  size_t ic = 0, oc = 0, ac = 0;
+  ak_uint8 buffer[67], icode[16];
+  struct iovec iniov[max_count], outiov[max_count], aiov[max_count];
+
+  ic = split( seed, mgm_plain, sizeof( mgm_plain ), iniov );
+  oc = split( 5*seed + 3, buffer, sizeof( buffer ), outiov );
+  ac = split( seed + 11, mgm_adata, sizeof( mgm_adata ), aiov );
+
+  memset( buffer, 0, sizeof( buffer ));
+  memset( icode, 0, sizeof( icode ));
+  if( ak_bckey_encrypt_mgm_iov( key, key, aiov, ac, iniov, ic, outiov, oc,
+                                         iv, iv_size, icode, imito_size ) != ak_error_ok )
+    return ak_false;
+  if( !ak_ptr_is_equal_with_log( buffer, cipher, sizeof( buffer ))) return ak_false;
+  if( !ak_ptr_is_equal_with_log( icode, imito, imito_size )) return ak_false;
+
+  if( ak_bckey_decrypt_mgm_iov( key, key, aiov, ac, outiov, oc, outiov, oc,
+                                         iv, iv_size, imito, imito_size ) != ak_error_ok )
+    return ak_false;
+  if( !ak_ptr_is_equal_with_log( buffer, mgm_plain, sizeof( buffer ))) return ak_false;
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* сравниваем результаты обработки фрагментированных и последовательно расположенных данных */
+ static int test_size( ak_bckey key, size_t seed, size_t size, size_t asize )
+{
+  size_t i = 0, ic = 0, oc = 0, ac = 0;
+  ak_uint8 iv[16], icode[16], icode2[16];
+  struct iovec iniov[max_count], outiov[max_count], aiov[max_count];
+  ak_uint8 in[data_size], adata[data_size], out[data_size], out2[data_size];
+
+  for( i = 0; i < sizeof( iv ); i++ ) iv[i] = ( ak_uint8 )( seed + 13*i );
+  for( i = 0; i < size; i++ ) in[i] = ( ak_uint8 )( 3*i + seed );
+  for( i = 0; i < asize; i++ ) adata[i] = ( ak_uint8 )( 5*i + 1 );
+  iv[key->bsize-1] &= 0x7f;
+
+  ic = split( seed, in, size, iniov );
+  oc = split( seed + 17, out2, size, outiov );
+  ac = split( seed + 29, adata, asize, aiov );
+
+ /* режим гаммирования */
+  if( ak_bckey_ctr( key, in, out, size, iv, key->bsize/2 ) != ak_error_ok ) return ak_false;
+  if( ak_bckey_ctr_iov( key, iniov, ic, outiov, oc, iv, key->bsize/2 ) != ak_error_ok )
+    return ak_false;
+  if( memcmp( out, out2, size ) != 0 ) return ak_false;
+
+ /* режим выработки имитовставки */
+  if( size > 0 ) {
+    if( ak_bckey_cmac( key, in, size, icode, key->bsize ) != ak_error_ok ) return ak_false;
+    if( ak_bckey_cmac_iov( key, iniov, ic, icode2, key->bsize ) != ak_error_ok ) return ak_false;
+    if( memcmp( icode, icode2, key->bsize ) != 0 ) return ak_false;
+  }
+
+ /* режим аутентифицированного шифрования */
+  if( ak_bckey_encrypt_mgm( key, key, adata, asize, in, out, size,
+                                       iv, key->bsize, icode, key->bsize ) != ak_error_ok )
+    return ak_false;
+  if( ak_bckey_encrypt_mgm_iov( key, key, aiov, ac, iniov, ic, outiov, oc,
+                                       iv, key->bsize, icode2, key->bsize ) != ak_error_ok )
+    return ak_false;
+  if( memcmp( out, out2, size ) != 0 ) return ak_false;
+  if( memcmp( icode, icode2, key->bsize ) != 0 ) return ak_false;
+
+ /* расшифрование на месте */
+  if( ak_bckey_decrypt_mgm_iov( key, key, aiov, ac, outiov, oc, outiov, oc,
+                                       iv, key->bsize, icode, key->bsize ) != ak_error_ok )
+    return ak_false;
+  if( memcmp( in, out2, size ) != 0 ) return ak_false;
+
+ /* изменения должны быть обнаружены */
+  if( asize > 0 ) {
+    adata[asize-1] ^= 0x01;
+    if( ak_bckey_decrypt_mgm_iov( key, key, aiov, ac, iniov, ic, outiov, oc,
+                                       iv, key->bsize, icode, key->bsize ) == ak_error_ok )
+      return ak_false;
+  }
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* данные различной длины для одного ключа */
+ static int test_sizes( ak_bckey key )
+{
+  size_t i = 0;
+  size_t sizes[] = { 0, 1, 7, 8, 9, 15, 16, 17, 63, 64, 65, 255, 256, 257, 1000, 1031 };
+
+  printf("%s (sizes): ", key->key.oid->name[0] );
+  for( i = 0; i < sizeof( sizes )/sizeof( size_t ); i++ ) {
+     if( test_size( key, i, sizes[i], sizes[ sizeof( sizes )/sizeof( size_t ) -1 -i ] ) != ak_true ) {
+       printf("Wrong (%u bytes)\n", (unsigned int) sizes[i] );
+       return ak_false;
+     }
+  }
+  printf("Ok\n");
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  size_t seed = 0;
+  struct bckey key;
+  int error = EXIT_SUCCESS;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( NULL )) return ak_libakrypt_destroy();
+  ak_libakrypt_set_openssl_compability( ak_false );
+                                   /* контрольные примеры расчитаны для несовместимого режима */
+ /* алгоритм Кузнечик */
+  ak_bckey_create_kuznechik( &key );
+  ak_bckey_set_key( &key, keyAnnexA, sizeof( keyAnnexA ));
+  printf("%s (GOST R 34.13-2015, R 1323565.1.026-2019): ", key.key.oid->name[0] );
+  for( seed = 0; seed < 37; seed += 4 ) {
+     if( test_ctr_cmac( &key, seed, kuznechik_in, sizeof( kuznechik_in ), kuznechik_ivctr,
+           sizeof( kuznechik_ivctr ), kuznechik_outctr, kuznechik_imito, 8 ) != ak_true ) break;
+     if( test_mgm( &key, seed, mgm_kuznechik_iv, sizeof( mgm_kuznechik_iv ),
+                              mgm_kuznechik_cipher, mgm_kuznechik_icode, 16 ) != ak_true ) break;
+  }
+  if( seed < 37 ) {
+    printf("Wrong (seed: %u)\n", (unsigned int) seed );
+    error = EXIT_FAILURE;
+  } else printf("Ok\n");
+  if( test_sizes( &key ) != ak_true ) error = EXIT_FAILURE;
+  ak_bckey_destroy( &key );
+
+ /* алгоритм Магма */
+  ak_bckey_create_magma( &key );
+  ak_bckey_set_key( &key, keyAnnexB, sizeof( keyAnnexB ));
+  printf("%s (GOST R 34.13-2015): ", key.key.oid->name[0] );
+  for( seed = 0; seed < 37; seed += 4 ) {
+     if( test_ctr_cmac( &key, seed, magma_in, sizeof( magma_in ), magma_ivctr,
+                           sizeof( magma_ivctr ), magma_outctr, magma_imito, 4 ) != ak_true ) break;
+     if( test_mgm( &key, seed, mgm_magma_iv, sizeof( mgm_magma_iv ),
+                                       mgm_magma_cipher, mgm_magma_icode, 8 ) != ak_true ) break;
+  }
+  if( seed < 37 ) {
+    printf("Wrong (seed: %u)\n", (unsigned int) seed );
+    error = EXIT_FAILURE;
+  } else printf("Ok\n");
+  if( test_sizes( &key ) != ak_true ) error = EXIT_FAILURE;
+  ak_bckey_destroy( &key );
+
+  ak_libakrypt_destroy();
+ return error;
+}
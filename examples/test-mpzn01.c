@@ -0,0 +1,168 @@
+/* ----------------------------------------------------------------------------------------------- */
+/* Тестовый пример, проверяющий корректность умножения, возведения в квадрат и обращения
+   в представлении Монтгомери (функции ak_mpzn_mul_montgomery(), ak_mpzn_sqr_montgomery(),
+   ak_mpzn_inverse_montgomery() и ak_mpzn_inverse_montgomery_var()) по модулям p и q
+   всех эллиптических кривых, известных библиотеке, а также по модулям вида 2^{64n} - c
+   и 2^{64n-1} + c с предельными значениями c. Результат умножения сравнивается с произведением, приведенным
+   по модулю с помощью последовательных сдвигов и вычитаний, результат обращения - со степенью
+   x^{p-2}, вычисленной функцией ak_mpzn_modpow_montgomery().
+
+   test-mpzn01.c                                                                                   */
+/* ----------------------------------------------------------------------------------------------- */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+ #define test_count (64)
+
+/* приводим число x длины 2size слов по модулю p "в столбик" */
+ void reference_rem( ak_uint64 *r, ak_uint64 *x, ak_uint64 *p, const size_t size )
+{
+  long long int i;
+  ak_uint64 top;
+  ak_mpzn512 t;
+
+  ak_mpzn_set_ui( r, size, 0 );
+  for( i = 128*size-1; i >= 0; i-- ) {
+     top = r[size-1] >> 63;
+     ak_mpzn_add( r, r, r, size );
+     r[0] ^= ( x[i>>6] >> ( i&0x3f ))&1;
+     if( top || ( ak_mpzn_cmp( r, p, size ) >= 0 )) {
+       ak_mpzn_sub( t, r, p, size );
+       ak_mpzn_set( r, t, size );
+     }
+  }
+}
+
+/* проверяем сравнение zr = xy (mod p), а также совпадение квадрата x с произведением xx */
+ bool_t test_value( ak_uint64 *x, ak_uint64 *y, ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+  ak_mpzn512 z, s, left, right;
+  ak_uint64 w[2*ak_mpzn512_size];
+
+  ak_mpzn_mul_montgomery( z, x, y, p, n0, size );
+  if( ak_mpzn_cmp( z, p, size ) >= 0 ) return ak_false;
+  memset( w, 0, sizeof( w ));
+  memcpy( w+size, z, size*sizeof( ak_uint64 ));
+  reference_rem( left, w, p, size );
+  ak_mpzn_mul( w, x, y, size );
+  reference_rem( right, w, p, size );
+  if( ak_mpzn_cmp( left, right, size ) != 0 ) return ak_false;
+
+  ak_mpzn_mul_montgomery( z, x, x, p, n0, size );
+  ak_mpzn_set( s, x, size );
+  ak_mpzn_sqr_montgomery( s, s, p, n0, size );
+  if( ak_mpzn_cmp( z, s, size ) != 0 ) return ak_false;
+ return ak_true;
+}
+
+/* проверяем совпадение обратных элементов, вычисленных тремя способами */
+ bool_t test_inverse( ak_uint64 *x, ak_uint64 *p, ak_uint64 n0, ak_uint64 *r2, const size_t size )
+{
+  ak_mpzn512 u, z, s;
+
+  if( r2 == NULL ) return ak_true;
+  ak_mpzn_set_ui( u, size, 2 );
+  ak_mpzn_sub( u, p, u, size );
+  ak_mpzn_modpow_montgomery( z, x, u, p, n0, size );
+  ak_mpzn_inverse_montgomery( s, x, p, n0, r2, size );
+  if( ak_mpzn_cmp( z, s, size ) != 0 ) return ak_false;
+  ak_mpzn_set( s, x, size );
+  ak_mpzn_inverse_montgomery_var( s, s, p, n0, r2, size );
+  if( ak_mpzn_cmp( z, s, size ) != 0 ) return ak_false;
+ return ak_true;
+}
+
+/* проверяем вычисления по заданному модулю */
+ bool_t test_modulo( ak_uint64 *p, ak_uint64 n0, ak_uint64 *r2,
+                                                          const size_t size, ak_random generator )
+{
+  size_t i;
+  ak_mpzn512 x, y, one;
+  bool_t result = ak_true;
+
+ /* граничные значения: 0, 1 и p-1 */
+  ak_mpzn_set_ui( x, size, 0 );
+  ak_mpzn_set_ui( one, size, 1 );
+  ak_mpzn_sub( y, p, one, size );
+  if( !test_value( x, y, p, n0, size )) result = ak_false;
+  if( !test_value( one, y, p, n0, size )) result = ak_false;
+  if( !test_value( y, y, p, n0, size )) result = ak_false;
+  if( !test_value( y, one, p, n0, size )) result = ak_false;
+  if( !test_inverse( x, p, n0, r2, size )) result = ak_false;
+  if( !test_inverse( one, p, n0, r2, size )) result = ak_false;
+  if( !test_inverse( y, p, n0, r2, size )) result = ak_false;
+
+ /* случайные значения */
+  for( i = 0; i < test_count; i++ ) {
+     ak_mpzn_set_random_modulo( x, p, size, generator );
+     ak_mpzn_set_random_modulo( y, p, size, generator );
+     if( !test_value( x, y, p, n0, size )) result = ak_false;
+     if( !test_inverse( x, p, n0, r2, size )) result = ak_false;
+  }
+ return result;
+}
+
+/* проверяем модули вида 2^{64size} - c и 2^{64size-1} + c (при истинном значении plus),
+   для которых используется специальная редукция */
+ bool_t test_special( const size_t size, ak_uint64 p0, bool_t plus, ak_random generator )
+{
+  int i;
+  ak_mpzn512 p;
+  ak_uint64 inv = p0;
+
+  if( plus ) {
+    memset( p, 0, sizeof( p ));
+    p[size-1] = 0x8000000000000000LL;
+  } else memset( p, 0xff, sizeof( p ));
+  p[0] = p0;
+ /* n0 = -p^{-1} mod 2^64 (метод Ньютона) */
+  for( i = 0; i < 6; i++ ) inv *= 2 - p0*inv;
+ /* модули не являются простыми, поэтому обращение не проверяется */
+ return test_modulo( p, ( ak_uint64 )0 - inv, NULL, size, generator );
+}
+
+ int main( void )
+{
+  size_t count = 0;
+  ak_wcurve wc = NULL;
+  struct random generator;
+  int error = EXIT_SUCCESS;
+  ak_oid oid = NULL;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( NULL )) return ak_libakrypt_destroy();
+  ak_random_create_lcg( &generator );
+
+ /* перебираем модули всех эллиптических кривых */
+  oid = ak_oid_find_by_engine( identifier );
+  while( oid != NULL ) {
+    if( oid->mode == wcurve_params ) {
+      wc = ( ak_wcurve ) oid->data;
+      printf(" %s: ", oid->name[0] );
+      if( test_modulo( wc->p, wc->n, wc->r2, wc->size, &generator ) &&
+          test_modulo( wc->q, wc->nq, wc->r2q, wc->size, &generator )) printf("Ok\n");
+       else { printf("Wrong\n"); error = EXIT_FAILURE; }
+      count++;
+    }
+    oid = ak_oid_findnext_by_engine( oid, identifier );
+  }
+  if( count == 0 ) error = EXIT_FAILURE;
+
+  printf(" special moduli: ");
+  if( test_special( ak_mpzn256_size, 0x0000000000000001LL, ak_false, &generator ) &&
+      test_special( ak_mpzn256_size, 0x8000000000000001LL, ak_false, &generator ) &&
+      test_special( ak_mpzn512_size, 0x0000000000000001LL, ak_false, &generator ) &&
+      test_special( ak_mpzn512_size, 0x8000000000000001LL, ak_false, &generator ) &&
+      test_special( ak_mpzn256_size, 0x0000000000000001LL, ak_true, &generator ) &&
+      test_special( ak_mpzn256_size, 0x7fffffffffffffffLL, ak_true, &generator ) &&
+      test_special( ak_mpzn512_size, 0x0000000000000001LL, ak_true, &generator ) &&
+      test_special( ak_mpzn512_size, 0x7fffffffffffffffLL, ak_true, &generator )) printf("Ok\n");
+   else { printf("Wrong\n"); error = EXIT_FAILURE; }
+
+  ak_random_destroy( &generator );
+  ak_libakrypt_destroy();
+ return error;
+}
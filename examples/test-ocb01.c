@@ -0,0 +1,219 @@
+/* ----------------------------------------------------------------------------------------------- */
+/* Тестовый пример, проверяющий корректность и скорость работы режима аутентифицированного
+   шифрования ocb: контрольные примеры RFC 7253 (алгоритм AES-128), зашифрование и расшифрование
+   данных различной длины алгоритмами Кузнечик и Магма, расшифрование на месте, а также
+   обнаружение изменений в шифртексте, ассоциированных данных и имитовставке.
+
+   test-ocb01.c                                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+
+ #include <time.h>
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+/* RFC 7253, приложение A: ключ K = 000102...0F, синхропосылка N = BBAA99887766554433221100
+   с измененным последним октетом; ассоциированные данные и открытый текст являются
+   началом последовательности 00 01 02 ... , шифртекст C содержит имитовставку длины 16 октетов */
+ static ak_uint8 rfc_key[16] = {
+     0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+
+ static ak_uint8 rfc_nonce[12] = {
+     0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00 };
+
+/* количество используемых примеров, последние октеты синхропосылок и длины данных */
+ #define rfc_count (8)
+ static ak_uint8 rfc_nonce_last[rfc_count] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x07, 0x0d, 0x0f };
+ static size_t rfc_adata_size[rfc_count] = { 0, 8, 8, 0, 16, 24, 40, 0 };
+ static size_t rfc_plain_size[rfc_count] = { 0, 8, 0, 8, 16, 24, 40, 40 };
+
+ static ak_uint8 rfc_cipher[rfc_count][56] = {
+   { 0x78, 0x54, 0x07, 0xbf, 0xff, 0xc8, 0xad, 0x9e, 0xdc, 0xc5, 0x52, 0x0a, 0xc9, 0x11, 0x1e, 0xe6 },
+   { 0x68, 0x20, 0xb3, 0x65, 0x7b, 0x6f, 0x61, 0x5a, 0x57, 0x25, 0xbd, 0xa0, 0xd3, 0xb4, 0xeb, 0x3a,
+     0x25, 0x7c, 0x9a, 0xf1, 0xf8, 0xf0, 0x30, 0x09 },
+   { 0x81, 0x01, 0x7f, 0x82, 0x03, 0xf0, 0x81, 0x27, 0x71, 0x52, 0xfa, 0xde, 0x69, 0x4a, 0x0a, 0x00 },
+   { 0x45, 0xdd, 0x69, 0xf8, 0xf5, 0xaa, 0xe7, 0x24, 0x14, 0x05, 0x4c, 0xd1, 0xf3, 0x5d, 0x82, 0x76,
+     0x0b, 0x2c, 0xd0, 0x0d, 0x2f, 0x99, 0xbf, 0xa9 },
+   { 0x57, 0x1d, 0x53, 0x5b, 0x60, 0xb2, 0x77, 0x18, 0x8b, 0xe5, 0x14, 0x71, 0x70, 0xa9, 0xa2, 0x2c,
+     0x3a, 0xd7, 0xa4, 0xff, 0x38, 0x35, 0xb8, 0xc5, 0x70, 0x1c, 0x1c, 0xce, 0xc8, 0xfc, 0x33, 0x58 },
+   { 0x1c, 0xa2, 0x20, 0x73, 0x08, 0xc8, 0x7c, 0x01, 0x07, 0x56, 0x10, 0x4d, 0x88, 0x40, 0xce, 0x19,
+     0x52, 0xf0, 0x96, 0x73, 0xa4, 0x48, 0xa1, 0x22, 0xc9, 0x2c, 0x62, 0x24, 0x10, 0x51, 0xf5, 0x73,
+     0x56, 0xd7, 0xf3, 0xc9, 0x0b, 0xb0, 0xe0, 0x7f },
+   { 0xd5, 0xca, 0x91, 0x74, 0x84, 0x10, 0xc1, 0x75, 0x1f, 0xf8, 0xa2, 0xf6, 0x18, 0x25, 0x5b, 0x68,
+     0xa0, 0xa1, 0x2e, 0x09, 0x3f, 0xf4, 0x54, 0x60, 0x6e, 0x59, 0xf9, 0xc1, 0xd0, 0xdd, 0xc5, 0x4b,
+     0x65, 0xe8, 0x62, 0x8e, 0x56, 0x8b, 0xad, 0x7a, 0xed, 0x07, 0xba, 0x06, 0xa4, 0xa6, 0x94, 0x83,
+     0xa7, 0x03, 0x54, 0x90, 0xc5, 0x76, 0x9e, 0x60 },
+   { 0x44, 0x12, 0x92, 0x34, 0x93, 0xc5, 0x7d, 0x5d, 0xe0, 0xd7, 0x00, 0xf7, 0x53, 0xcc, 0xe0, 0xd1,
+     0xd2, 0xd9, 0x50, 0x60, 0x12, 0x2e, 0x9f, 0x15, 0xa5, 0xdd, 0xbf, 0xc5, 0x78, 0x7e, 0x50, 0xb5,
+     0xcc, 0x55, 0xee, 0x50, 0x7b, 0xcb, 0x08, 0x4e, 0x47, 0x9a, 0xd3, 0x63, 0xac, 0x36, 0x6b, 0x95,
+     0xa9, 0x8c, 0xa5, 0xf3, 0x00, 0x0b, 0x14, 0x79 }};
+
+/* константное значение ключа из ГОСТ Р 34.13-2015 */
+ static ak_uint8 keyAnnexA[32] = {
+     0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+     0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88 };
+
+/* ----------------------------------------------------------------------------------------------- */
+/* проверяем контрольные примеры RFC 7253: зашифрование и расшифрование на месте */
+ static int test_rfc( void )
+{
+  size_t i = 0;
+  struct bckey key;
+  int result = ak_false;
+  ak_uint8 data[40], nonce[12], out[40], icode[16];
+
+  for( i = 0; i < sizeof( data ); i++ ) data[i] = ( ak_uint8 )i;
+  memcpy( nonce, rfc_nonce, sizeof( nonce ));
+
+  ak_bckey_create_aes128( &key );
+  ak_bckey_set_key( &key, rfc_key, sizeof( rfc_key ));
+  printf("RFC 7253 (%s): ", key.key.oid->name[0] );
+
+  for( i = 0; i < rfc_count; i++ ) {
+     nonce[11] = rfc_nonce_last[i];
+     memset( out, 0, sizeof( out ));
+     memset( icode, 0, sizeof( icode ));
+     ak_bckey_encrypt_ocb( &key, &key, data, rfc_adata_size[i], data, out, rfc_plain_size[i],
+                                                 nonce, sizeof( nonce ), icode, sizeof( icode ));
+     if( !ak_ptr_is_equal_with_log( out, rfc_cipher[i], rfc_plain_size[i] ) ||
+         !ak_ptr_is_equal_with_log( icode, rfc_cipher[i] + rfc_plain_size[i], sizeof( icode ))) {
+       printf("Wrong (encryption, nonce %02x)\n", rfc_nonce_last[i] );
+       goto lab_exit;
+     }
+     if( ak_bckey_decrypt_ocb( &key, &key, data, rfc_adata_size[i], out, out, rfc_plain_size[i],
+                                  nonce, sizeof( nonce ), icode, sizeof( icode )) != ak_error_ok ) {
+       printf("Wrong (integrity code, nonce %02x)\n", rfc_nonce_last[i] );
+       goto lab_exit;
+     }
+     if( !ak_ptr_is_equal_with_log( out, data, rfc_plain_size[i] )) {
+       printf("Wrong (decryption, nonce %02x)\n", rfc_nonce_last[i] );
+       goto lab_exit;
+     }
+  }
+  printf("Ok\n");
+  result = ak_true;
+
+  lab_exit:
+   ak_bckey_destroy( &key );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* проверяем один набор данных: расшифрование на месте и обнаружение изменений */
+ static int test_ocb( ak_bckey key, ak_uint8 *adata, size_t adata_size,
+                              ak_uint8 *in, ak_uint8 *out, size_t size, ak_uint8 *iv, size_t iv_size )
+{
+  ak_uint8 icode[16], icode2[16];
+  ak_uint8 *buffer = malloc( size + 1 );
+  int result = ak_false;
+
+  if( buffer == NULL ) return ak_false;
+  if( ak_bckey_encrypt_ocb( key, key, adata, adata_size, in, out, size,
+                                      iv, iv_size, icode, key->bsize ) != ak_error_ok ) goto exit;
+ /* расшифрование на месте */
+  memcpy( buffer, out, size );
+  if( ak_bckey_decrypt_ocb( key, key, adata, adata_size, buffer, buffer, size,
+                                      iv, iv_size, icode, key->bsize ) != ak_error_ok ) goto exit;
+  if( memcmp( buffer, in, size ) != 0 ) goto exit;
+
+ /* изменения должны быть обнаружены */
+  memcpy( icode2, icode, sizeof( icode ));
+  icode2[0] ^= 0x80;
+  if( ak_bckey_decrypt_ocb( key, key, adata, adata_size, out, buffer, size,
+                                iv, iv_size, icode2, key->bsize ) == ak_error_ok ) goto exit;
+  if( adata_size > 0 ) {
+    adata[adata_size-1] ^= 0x01;
+    if( ak_bckey_decrypt_ocb( key, key, adata, adata_size, out, buffer, size,
+                                   iv, iv_size, icode, key->bsize ) == ak_error_ok ) goto exit;
+    adata[adata_size-1] ^= 0x01;
+  }
+  if( size > 0 ) {
+    out[size >> 1] ^= 0x10;
+    if( ak_bckey_decrypt_ocb( key, key, adata, adata_size, out, buffer, size,
+                                   iv, iv_size, icode, key->bsize ) == ak_error_ok ) goto exit;
+    out[size >> 1] ^= 0x10;
+  }
+  result = ak_true;
+
+  exit:
+   free( buffer );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* данные различной длины, не кратной длине блока, и синхропосылки различной длины */
+ static int test_sizes( ak_bckey key )
+{
+  size_t i = 0, big = 1048576;
+  clock_t timea;
+  int result = ak_false;
+  ak_uint8 iv[16], adata[256], *in = NULL, *out = NULL;
+  size_t sizes[] = { 0, 1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 100, 255, 256 };
+
+  printf("%s: ", key->key.oid->name[0] );
+  if((( in = malloc( big )) == NULL ) || (( out = malloc( big )) == NULL )) {
+    printf("incorrect memory allocation\n");
+    goto exit;
+  }
+  for( i = 0; i < sizeof( iv ); i++ ) iv[i] = ( ak_uint8 )( 0xa5 ^ i );
+  for( i = 0; i < sizeof( adata ); i++ ) adata[i] = ( ak_uint8 )( 5*i + 1 );
+  for( i = 0; i < big; i++ ) in[i] = ( ak_uint8 )( 3*i + ( i >> 10 ));
+
+  for( i = 0; i < sizeof( sizes )/sizeof( size_t ); i++ ) {
+     if( test_ocb( key, adata, sizes[i], in, out, sizes[ sizeof( sizes )/sizeof( size_t ) -1 -i ],
+                                                          iv, key->bsize - 1 - ( i%3 )) != ak_true ) {
+       printf("Wrong (adata: %u bytes)\n", (unsigned int) sizes[i] );
+       goto exit;
+     }
+  }
+
+ /* большой объем данных */
+  timea = clock();
+  if( test_ocb( key, adata, sizeof( adata ), in, out, big, iv, 4 ) != ak_true ) {
+    printf("Wrong (%u bytes)\n", (unsigned int) big );
+    goto exit;
+  }
+  timea = clock() - timea;
+  printf("Ok (%f sec for %u MB)\n", (double) timea / (double) CLOCKS_PER_SEC,
+                                                                  (unsigned int)( big >> 20 ));
+  result = ak_true;
+
+  exit:
+   if( in ) free( in );
+   if( out ) free( out );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  struct bckey key;
+  int error = EXIT_SUCCESS;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( NULL )) return ak_libakrypt_destroy();
+  ak_libakrypt_set_openssl_compability( ak_false );
+
+ /* контрольные примеры */
+  if( test_rfc() != ak_true ) error = EXIT_FAILURE;
+  printf("ocb self test (kuznechik, magma): ");
+  if( ak_libakrypt_test_ocb() != ak_true ) {
+    printf("Wrong\n");
+    error = EXIT_FAILURE;
+  } else printf("Ok\n");
+
+ /* алгоритмы ГОСТ Р 34.12-2015 с длинами блоков 128 и 64 бита */
+  ak_bckey_create_kuznechik( &key );
+  ak_bckey_set_key( &key, keyAnnexA, sizeof( keyAnnexA ));
+  if( test_sizes( &key ) != ak_true ) error = EXIT_FAILURE;
+  ak_bckey_destroy( &key );
+
+  ak_bckey_create_magma( &key );
+  ak_bckey_set_key( &key, keyAnnexA, sizeof( keyAnnexA ));
+  if( test_sizes( &key ) != ak_true ) error = EXIT_FAILURE;
+  ak_bckey_destroy( &key );
+
+  ak_libakrypt_destroy();
+ return error;
+}
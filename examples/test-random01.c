@@ -47,6 +47,42 @@
  return retval;
 }
 
+#ifdef AK_HAVE_SYSRANDOM_H
+ #include <unistd.h>
+ #include <sys/wait.h>
+
+/* проверка того, что после вызова fork() родительский и дочерний процессы
+   не выдают одинаковые значения из буфера генератора */
+ int test_fork( void )
+{
+ pid_t pid;
+ int fd[2], retval = ak_true;
+ struct random generator;
+ ak_uint8 parent[32], child[32];
+
+  ak_random_create_getrandom( &generator );
+  ak_random_ptr( &generator, parent, 16 ); /* буфер заполнен и частично использован */
+  if( pipe( fd ) != 0 ) { ak_random_destroy( &generator ); return ak_false; }
+
+  if(( pid = fork()) == 0 ) {
+    ak_random_ptr( &generator, child, sizeof( child ));
+    if( write( fd[1], child, sizeof( child )) != sizeof( child )) _exit( EXIT_FAILURE );
+    _exit( EXIT_SUCCESS );
+  }
+  ak_random_ptr( &generator, parent, sizeof( parent ));
+  if( read( fd[0], child, sizeof( child )) != sizeof( child )) retval = ak_false;
+  waitpid( pid, NULL, 0 );
+  close( fd[0] ); close( fd[1] );
+
+  printf("getrandom after fork(): ");
+  if(( retval == ak_true ) && ( memcmp( parent, child, sizeof( child )) != 0 )) printf("Ok\n");
+   else { printf("Wrong\n"); retval = ak_false; }
+
+  ak_random_destroy( &generator );
+ return retval;
+}
+#endif
+
  int main( void )
 {
  int error = EXIT_SUCCESS;
@@ -58,6 +94,9 @@
    if( test_function( ak_random_create_lcg,
       "47b7ef2b729133a3e9853e0f4ffe040154a7622b7827e71bc6e48dff98c27f61" ) != ak_true )
      error = EXIT_FAILURE;
+   if( test_function( ak_random_create_xoshiro256,
+      "0dea74ba10b97d441295fa8f1138b21cee867420c8d680da5322e6cdaabac387" ) != ak_true )
+     error = EXIT_FAILURE;
 
 #ifdef _WIN32
  if( test_function( ak_random_create_winrtl, NULL ) != ak_true ) error = EXIT_FAILURE;
@@ -67,6 +106,18 @@
  if( test_function( ak_random_create_random, NULL ) != ak_true ) error = EXIT_FAILURE;
  if( test_function( ak_random_create_urandom, NULL ) != ak_true ) error = EXIT_FAILURE;
 #endif
+#ifdef AK_HAVE_SYSRANDOM_H
+ if( test_function( ak_random_create_getrandom, NULL ) != ak_true ) error = EXIT_FAILURE;
+ if( test_fork() != ak_true ) error = EXIT_FAILURE;
+#endif
+ if( test_function( ak_random_create_drbg,
+      "17f26e06fcea7a7ed0e6b3bed6a39ccb2137c1a36b38ec1cbd6d4ffbe6bcc536" ) != ak_true )
+   error = EXIT_FAILURE;
+
+ /* контрольные значения механизмов instantiate, reseed и generate генератора drbg */
+ printf("drbg self test: ");
+ if( ak_libakrypt_test_drbg() != ak_true ) { printf("Wrong\n"); error = EXIT_FAILURE; }
+  else printf("Ok\n");
 
  ak_libakrypt_destroy();
  return error;
@@ -14,6 +14,7 @@
   struct verifykey pk;
   struct random generator;
   int result = EXIT_SUCCESS;
+  unsigned int period = 0;
   ak_uint8 sign[128];
   ak_uint8 testkey[32] = {
     0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x27, 0x01, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
@@ -54,6 +55,27 @@
     printf("verify: Ok\n");
    else { printf("verify: Wrong\n"); result = EXIT_FAILURE; }
 
+ /* подписываем данные с использованием генератора, содержащегося в контексте ключа */
+  ak_signkey_sign_file( &sk, NULL, argv[0], sign, sizeof( sign ));
+  printf("sign:   %s\n", ak_ptr_to_hexstr( sign, ak_signkey_get_tag_size(&sk), ak_false ));
+  if( ak_verifykey_verify_file( &pk, argv[0], sign ) == ak_true )
+    printf("verify: Ok\n");
+   else { printf("verify: Wrong\n"); result = EXIT_FAILURE; }
+
+
+ /* подписываем короткие сообщения при различной периодичности смены маски ключа;
+    количество подписей превышает количество заранее вырабатываемых пар для смены маски */
+  for( period = 0; period < 4; period++ ) {
+     size_t i, bad = 0;
+     ak_signkey_set_remask_period( &sk, period );
+     for( i = 0; i < 100; i++ ) {
+        ak_signkey_sign_ptr( &sk, &generator, &i, sizeof( i ), sign, sizeof( sign ));
+        if( ak_verifykey_verify_ptr( &pk, &i, sizeof( i ), sign ) != ak_true ) bad++;
+     }
+     printf("remask period %u: %s\n", period, bad ? "Wrong" : "Ok" );
+     if( bad ) result = EXIT_FAILURE;
+  }
+
   ak_signkey_destroy( &sk );
   ak_verifykey_destroy( &pk );
 
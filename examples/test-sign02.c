@@ -0,0 +1,138 @@
+/* ----------------------------------------------------------------------------------------------- */
+/* Тестовый пример, проверяющий пакетную проверку электронных подписей: подписи, выработанные
+   на нескольких ключах и нескольких эллиптических кривых (часть из которых искажена),
+   проверяются функцией ak_verifykey_verify_hash_batch() и результаты сравниваются
+   с результатами функции ak_verifykey_verify_hash(), в том числе для ключей
+   с предвычисленными кратными точками (функция ak_verifykey_precompute()). Также проверяется,
+   что подписи со значениями r или s вне интервала [1, q-1] (в частности, нулевая подпись)
+   отвергаются обеими функциями.
+
+   test-sign02.c                                                                                   */
+/* ----------------------------------------------------------------------------------------------- */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+ #define keys_count   (3)
+ #define signs_count (24)
+
+ int main( void )
+{
+  size_t i;
+  struct random generator;
+  int error = EXIT_SUCCESS;
+  struct signkey sk[keys_count];
+  struct verifykey pk[keys_count];
+  ak_verifykey keys[signs_count];
+  ak_pointer hashes[signs_count], signs[signs_count];
+  bool_t results[signs_count], result = ak_false;
+  ak_uint8 hash[signs_count][64], sign[signs_count][128];
+  const char *curves[keys_count] = {
+    "id-tc26-gost-3410-2012-256-paramSetA",
+    "id-tc26-gost-3410-2012-512-paramSetC",
+    "id-tc26-gost-3410-2012-256-paramSetA"
+  };
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( NULL )) return ak_libakrypt_destroy();
+  ak_random_create_lcg( &generator );
+
+ /* создаем ключи */
+  for( i = 0; i < keys_count; i++ ) {
+     ak_signkey_create( sk+i, ( ak_wcurve ) ak_oid_find_by_name( curves[i] )->data );
+     ak_signkey_set_key_random( sk+i, &generator );
+     ak_verifykey_create_from_signkey( pk+i, sk+i );
+  }
+
+ /* вырабатываем подписи, каждую пятую подпись искажаем */
+  for( i = 0; i < signs_count; i++ ) {
+     size_t idx = ( i*7 )%keys_count, hsize = ak_signkey_get_tag_size( sk+idx )/2;
+     ak_random_ptr( &generator, hash[i], hsize );
+     ak_signkey_sign_hash( sk+idx, &generator, hash[i], hsize, sign[i], sizeof( sign[i] ));
+     if( i%5 == 0 ) sign[i][i%hsize] ^= 0x01;
+     keys[i] = pk+idx;
+     hashes[i] = hash[i];
+     signs[i] = sign[i];
+  }
+
+ /* проверяем подписи отдельно для каждой длины хеш-кода */
+  for( i = 0; i < 2; i++ ) {
+     size_t j, hsize = ( i == 0 ) ? 32 : 64;
+     result = ak_verifykey_verify_hash_batch( keys, hashes, hsize, signs, results, signs_count );
+     for( j = 0; j < signs_count; j++ ) {
+        if( keys[j]->wc->size*sizeof( ak_uint64 ) != hsize ) {
+          if( results[j] != ak_false ) error = EXIT_FAILURE;
+          continue;
+        }
+        if( results[j] != ak_verifykey_verify_hash( keys[j], hashes[j], hsize, signs[j] ))
+          error = EXIT_FAILURE;
+        if( results[j] != ( j%5 != 0 )) error = EXIT_FAILURE;
+     }
+     if( result != ak_false ) error = EXIT_FAILURE;
+  }
+
+ /* восстанавливаем искаженные подписи и проверяем подписи, выработанные
+    на двух различных ключах одной эллиптической кривой */
+  for( i = 0; i < signs_count; i++ ) {
+     size_t idx = ( i*7 )%keys_count, hsize = ak_signkey_get_tag_size( sk+idx )/2;
+     if( i%5 == 0 ) sign[i][i%hsize] ^= 0x01;
+     if( hsize != 32 ) { /* подпись, выработанная на 512-битной кривой, заменяется первой подписью */
+       keys[i] = keys[0]; hashes[i] = hashes[0]; signs[i] = signs[0];
+     }
+  }
+  if( ak_verifykey_verify_hash_batch( keys, hashes, 32, signs, results, signs_count ) != ak_true )
+    error = EXIT_FAILURE;
+
+ /* повторяем проверку с предвычисленными кратными точек открытых ключей */
+  if( ak_verifykey_precompute( pk, 0 ) != ak_error_ok ) error = EXIT_FAILURE;
+  if( ak_verifykey_precompute( pk+2, 3 ) != ak_error_ok ) error = EXIT_FAILURE;
+  if( ak_verifykey_verify_hash_batch( keys, hashes, 32, signs, results, signs_count ) != ak_true )
+    error = EXIT_FAILURE;
+  for( i = 0; i < signs_count; i++ )
+     if( ak_verifykey_verify_hash( keys[i], hashes[i], 32, signs[i] ) != ak_true )
+       error = EXIT_FAILURE;
+  sign[3][7] ^= 0x01;
+  if( ak_verifykey_verify_hash( keys[3], hashes[3], 32, signs[3] ) != ak_false )
+    error = EXIT_FAILURE;
+  if( ak_verifykey_verify_hash_batch( keys, hashes, 32, signs, results, signs_count ) != ak_false )
+    error = EXIT_FAILURE;
+  if( results[3] != ak_false ) error = EXIT_FAILURE;
+  sign[3][7] ^= 0x01;
+
+ /* подписи, у которых r или s не лежат в интервале [1, q-1], должны отвергаться:
+    нулевая подпись, s = q, r = q и подпись, все октеты которой равны 0xff */
+  for( i = 0; i < 4; i++ ) {
+     size_t j;
+     ak_uint8 bad[64];
+     ak_wcurve wc = keys[1]->wc;
+     ak_pointer saved = signs[1];
+
+     memcpy( bad, saved, sizeof( bad ));
+     switch( i ) {
+       case 0: memset( bad, 0, sizeof( bad )); break;
+       case 1: ak_mpzn_to_little_endian( wc->q, wc->size, bad, 32, ak_true ); break;
+       case 2: ak_mpzn_to_little_endian( wc->q, wc->size, bad+32, 32, ak_true ); break;
+       case 3: memset( bad, 0xff, sizeof( bad )); break;
+     }
+     signs[1] = bad;
+     if( ak_verifykey_verify_hash( keys[1], hashes[1], 32, signs[1] ) != ak_false )
+       error = EXIT_FAILURE;
+     if( ak_verifykey_verify_hash_batch( keys, hashes, 32, signs, results, signs_count ) != ak_false )
+       error = EXIT_FAILURE;
+     for( j = 0; j < signs_count; j++ )
+        if( results[j] != ( j != 1 )) error = EXIT_FAILURE;
+     signs[1] = saved;
+  }
+
+  printf(" batch verification: %s\n", error == EXIT_SUCCESS ? "Ok" : "Wrong" );
+
+  for( i = 0; i < keys_count; i++ ) {
+     ak_signkey_destroy( sk+i );
+     ak_verifykey_destroy( pk+i );
+  }
+  ak_random_destroy( &generator );
+  ak_libakrypt_destroy();
+ return error;
+}
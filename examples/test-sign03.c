@@ -0,0 +1,138 @@
+/* ----------------------------------------------------------------------------------------------- */
+/* Тестовый пример, проверяющий выработку электронной подписи с использованием набора
+   предварительно вычисленных значений (k, r): подписи, выработанные с использованием набора
+   (в том числе заполняемого в отдельном потоке), проверяются, значения r не должны повторяться,
+   в том числе в родительском и дочернем процессах после вызова fork(); также сравнивается
+   время выработки подписи.
+
+   test-sign03.c                                                                                   */
+/* ----------------------------------------------------------------------------------------------- */
+
+ #include <time.h>
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+ #define signs_count (80)
+
+/* вырабатываем и проверяем подписи, проверяем, что значения r не повторяются */
+ bool_t test_pool( const char *curve, const size_t size, const bool_t background )
+{
+  size_t i, j, lb;
+  struct signkey sk;
+  struct verifykey pk;
+  bool_t result = ak_false;
+  ak_uint8 hash[64], sign[signs_count][128];
+
+  printf(" %s (%u values, %s): ", curve, (unsigned int) size,
+                                                        background ? "background" : "on demand" );
+  if( ak_signkey_create_str( &sk, curve ) != ak_error_ok ) goto exit;
+  if( ak_signkey_set_key_random( &sk, NULL ) != ak_error_ok ) goto labsk;
+  if( ak_verifykey_create_from_signkey( &pk, &sk ) != ak_error_ok ) goto labsk;
+  if( ak_signkey_presign_create( &sk, size, background ) != ak_error_ok ) goto labpk;
+  if( !background && ( ak_signkey_presign_fill( &sk ) != ak_error_ok )) goto labpk;
+
+  lb = ak_signkey_get_tag_size( &sk ) >> 1;
+  for( i = 0; i < signs_count; i++ ) {
+     memset( hash, (int) i, sizeof( hash ));
+     if( ak_signkey_sign_hash( &sk, NULL, hash, lb, sign[i], sizeof( sign[i] )) != ak_error_ok )
+       goto labpk;
+     if( ak_verifykey_verify_hash( &pk, hash, lb, sign[i] ) != ak_true ) goto labpk;
+     for( j = 0; j < i; j++ ) if( memcmp( sign[i]+lb, sign[j]+lb, lb ) == 0 ) goto labpk;
+  }
+  result = ak_true;
+
+  labpk: ak_verifykey_destroy( &pk );
+  labsk: ak_signkey_destroy( &sk );
+  exit:
+   printf("%s\n", result ? "Ok" : "Wrong" );
+ return result;
+}
+
+#ifdef AK_HAVE_UNISTD_H
+ #include <unistd.h>
+ #include <sys/wait.h>
+
+/* проверка того, что после вызова fork() родительский и дочерний процессы
+   не используют одни и те же значения (k, r) */
+ bool_t test_fork( void )
+{
+  pid_t pid;
+  int fd[2];
+  struct signkey sk;
+  bool_t result = ak_true;
+  ak_uint8 hash[32], parent[64], child[64];
+
+  memset( hash, 0x11, sizeof( hash ));
+  ak_signkey_create_str( &sk, "cspa" );
+  ak_signkey_set_key_random( &sk, NULL );
+  ak_signkey_presign_create( &sk, 4, ak_false );
+  ak_signkey_presign_fill( &sk );
+  if( pipe( fd ) != 0 ) { ak_signkey_destroy( &sk ); return ak_false; }
+
+  fflush( stdout );
+  if(( pid = fork()) == 0 ) {
+    ak_signkey_sign_hash( &sk, NULL, hash, sizeof( hash ), child, sizeof( child ));
+    if( write( fd[1], child, sizeof( child )) != sizeof( child )) _exit( EXIT_FAILURE );
+    _exit( EXIT_SUCCESS );
+  }
+  ak_signkey_sign_hash( &sk, NULL, hash, sizeof( hash ), parent, sizeof( parent ));
+  if( read( fd[0], child, sizeof( child )) != sizeof( child )) result = ak_false;
+  waitpid( pid, NULL, 0 );
+  close( fd[0] ); close( fd[1] );
+
+  printf(" sign after fork(): ");
+  if(( result == ak_true ) && ( memcmp( parent+32, child+32, 32 ) != 0 )) printf("Ok\n");
+   else { printf("Wrong\n"); result = ak_false; }
+
+  ak_signkey_destroy( &sk );
+ return result;
+}
+#endif
+
+/* сравниваем время выработки подписи с использованием набора и без него */
+ void test_speed( void )
+{
+  size_t i;
+  clock_t t1, t2;
+  struct signkey sk;
+  ak_uint8 hash[32], sign[64];
+
+  memset( hash, 0x5a, sizeof( hash ));
+  ak_signkey_create_str( &sk, "cspa" );
+  ak_signkey_set_key_random( &sk, NULL );
+
+  t1 = clock();
+  for( i = 0; i < 256; i++ ) ak_signkey_sign_hash( &sk, NULL, hash, 32, sign, sizeof( sign ));
+  t1 = clock() - t1;
+
+  ak_signkey_presign_create( &sk, 256, ak_false );
+  ak_signkey_presign_fill( &sk );
+  t2 = clock();
+  for( i = 0; i < 256; i++ ) ak_signkey_sign_hash( &sk, NULL, hash, 32, sign, sizeof( sign ));
+  t2 = clock() - t2;
+
+  printf(" 256 signs: %f sec, with precomputed values %f sec\n",
+                        (double) t1/(double) CLOCKS_PER_SEC, (double) t2/(double) CLOCKS_PER_SEC );
+  ak_signkey_destroy( &sk );
+}
+
+ int main( void )
+{
+  int error = EXIT_SUCCESS;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( NULL )) return ak_libakrypt_destroy();
+
+  if( !test_pool( "cspa", 16, ak_false )) error = EXIT_FAILURE;
+  if( !test_pool( "cspa", 32, ak_true )) error = EXIT_FAILURE;
+  if( !test_pool( "id-tc26-gost-3410-2012-512-paramSetA", 32, ak_true )) error = EXIT_FAILURE;
+#ifdef AK_HAVE_UNISTD_H
+  if( !test_fork( )) error = EXIT_FAILURE;
+#endif
+  test_speed();
+
+  ak_libakrypt_destroy();
+ return error;
+}
@@ -0,0 +1,196 @@
+/* ----------------------------------------------------------------------------------------------- */
+/* Тестовый пример, проверяющий совпадение кратных образующей точки, вычисленных
+   с помощью лесенки Монтгомери (функция ak_wpoint_pow()) и с помощью предвычисленных
+   таблиц (функция ak_wpoint_pow_base()), а также совпадение сумм кратных точек, вычисленных
+   с помощью функции ak_wpoint_pow2(), для всех эллиптических кривых, известных библиотеке.
+   Для кривых, вычисления на которых выполняются в форме Эдвардса, результаты дополнительно
+   сравниваются с вычислениями по формулам для кривой в форме Вейерштрасса, в том числе
+   для точек, не принадлежащих подгруппе порядка q.
+
+   test-wpoint01.c                                                                                 */
+/* ----------------------------------------------------------------------------------------------- */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt-internal.h>
+
+ #define test_count (16)
+
+/* вычисляем [k]P методом "удвоение-сложение" по формулам для кривой в форме Вейерштрасса */
+ void reference_pow( ak_wpoint wq, ak_wpoint wp, ak_uint64 *k, ak_wcurve wc )
+{
+  long long int i;
+
+  ak_wpoint_set_as_unit( wq, wc );
+  for( i = 64*wc->size-1; i >= 0; i-- ) {
+     ak_wpoint_double( wq, wc );
+     if(( k[i>>6] >> ( i&0x3f ))&1 ) ak_wpoint_add( wq, wp, wc );
+  }
+}
+
+/* сравниваем две точки после приведения к аффинной форме */
+ bool_t test_equal( ak_wpoint wp, ak_wpoint wq, ak_wcurve wc )
+{
+  ak_wpoint_reduce( wp, wc );
+  ak_wpoint_reduce( wq, wc );
+  if( memcmp( wp->x, wq->x, wc->size*sizeof( ak_uint64 )) != 0 ) return ak_false;
+  if( memcmp( wp->y, wq->y, wc->size*sizeof( ak_uint64 )) != 0 ) return ak_false;
+  if( memcmp( wp->z, wq->z, wc->size*sizeof( ak_uint64 )) != 0 ) return ak_false;
+ return ak_true;
+}
+
+/* сравниваем результаты для одного значения k */
+ bool_t test_value( ak_uint64 *k, ak_wcurve wc )
+{
+  struct wpoint wp, wq, wr;
+
+  ak_wpoint_pow( &wp, &wc->point, k, wc->size, wc );
+  ak_wpoint_pow_base( &wq, k, wc->size, wc );
+  reference_pow( &wr, &wc->point, k, wc );
+
+  if( !test_equal( &wp, &wq, wc )) return ak_false;
+ return test_equal( &wp, &wr, wc );
+}
+
+/* сравниваем [k]P для произвольной точки P */
+ bool_t test_point( ak_wpoint wp, ak_uint64 *k, ak_wcurve wc )
+{
+  struct wpoint wq, wr;
+
+  ak_wpoint_pow( &wq, wp, k, wc->size, wc );
+  reference_pow( &wr, wp, k, wc );
+ return test_equal( &wq, &wr, wc );
+}
+
+/* для кривых Эдвардса проверяем точку T второго порядка и точку P + T */
+ bool_t test_torsion( ak_wcurve wc, ak_random generator )
+{
+  size_t i;
+  ak_mpzn512 k;
+  struct wpoint wt, ws;
+  bool_t result = ak_true;
+  const struct wcurve_edwards *ep = NULL;
+
+  for( ep = ak_wcurve_edwards_params; ep->wc != NULL; ep++ ) if( ep->wc == wc ) break;
+  if( ep->wc == NULL ) return ak_true;
+
+ /* точка T = (t, 0, 1) */
+  memcpy( wt.x, ep->t, wc->size*sizeof( ak_uint64 ));
+  ak_mpzn_set_ui( wt.y, wc->size, 0 );
+  ak_mpzn_set_ui( wt.z, wc->size, 1 );
+  if( !ak_wpoint_is_ok( &wt, wc )) return ak_false;
+  ak_wpoint_set_wpoint( &ws, &wc->point, wc );
+  ak_wpoint_add( &ws, &wt, wc );
+  if( ak_wpoint_check_order( &ws, wc )) result = ak_false;
+
+  for( i = 0; i < 4; i++ ) {
+     ak_mpzn_set_ui( k, wc->size, i );
+     if( !test_point( &wt, k, wc )) result = ak_false;
+     if( !test_point( &ws, k, wc )) result = ak_false;
+  }
+  if( !test_point( &ws, wc->q, wc )) result = ak_false;
+  for( i = 0; i < test_count; i++ ) {
+     ak_mpzn_set_random_modulo( k, wc->q, wc->size, generator );
+     if( !test_point( &wt, k, wc )) result = ak_false;
+     if( !test_point( &ws, k, wc )) result = ak_false;
+  }
+ return result;
+}
+
+/* сравниваем значения [k1]P + [k2]Q */
+ bool_t test_sum( ak_uint64 *k1, ak_wpoint wq, ak_uint64 *k2, ak_wcurve wc )
+{
+  struct wpoint wp, wt, ws;
+
+  ak_wpoint_pow( &wp, &wc->point, k1, wc->size, wc );
+  ak_wpoint_pow( &wt, wq, k2, wc->size, wc );
+  ak_wpoint_add( &wp, &wt, wc );
+  ak_wpoint_reduce( &wp, wc );
+  ak_wpoint_pow2( &ws, k1, wq, k2, wc->size, wc );
+  ak_wpoint_reduce( &ws, wc );
+
+  if( memcmp( wp.x, ws.x, wc->size*sizeof( ak_uint64 )) != 0 ) return ak_false;
+  if( memcmp( wp.y, ws.y, wc->size*sizeof( ak_uint64 )) != 0 ) return ak_false;
+  if( memcmp( wp.z, ws.z, wc->size*sizeof( ak_uint64 )) != 0 ) return ak_false;
+ return ak_true;
+}
+
+/* проверяем одну кривую */
+ bool_t test_curve( ak_oid oid, ak_random generator )
+{
+  size_t i;
+  struct wpoint wq;
+  ak_mpzn512 k, k2;
+  ak_wcurve wc = ( ak_wcurve ) oid->data;
+  bool_t result = ak_true;
+
+  printf(" %s: ", oid->name[0] );
+ /* граничные значения: 0, 1, 2, q-1, q-2 и 2^{64size}-1 */
+  ak_mpzn_set_ui( k, wc->size, 0 );
+  if( !test_value( k, wc )) result = ak_false;
+  ak_mpzn_set_ui( k, wc->size, 1 );
+  if( !test_value( k, wc )) result = ak_false;
+  ak_mpzn_set_ui( k, wc->size, 2 );
+  if( !test_value( k, wc )) result = ak_false;
+  ak_mpzn_sub( k, wc->q, k, wc->size );
+  if( !test_value( k, wc )) result = ak_false;
+  k[0]++;
+  if( !test_value( k, wc )) result = ak_false;
+  memset( k, 0xff, sizeof( k ));
+  if( !test_value( k, wc )) result = ak_false;
+
+ /* случайные значения */
+  for( i = 0; i < test_count; i++ ) {
+     ak_mpzn_set_random_modulo( k, wc->q, wc->size, generator );
+     if( !test_value( k, wc )) result = ak_false;
+  }
+
+ /* суммы кратных точек, в том числе с нулевыми и максимальными степенями */
+  ak_mpzn_set_random_modulo( k, wc->q, wc->size, generator );
+  ak_wpoint_pow( &wq, &wc->point, k, wc->size, wc );
+  ak_wpoint_reduce( &wq, wc );
+  ak_mpzn_set_ui( k, wc->size, 0 );
+  memset( k2, 0xff, sizeof( k2 ));
+  if( !test_sum( k, &wq, k2, wc )) result = ak_false;
+  if( !test_sum( k2, &wq, k, wc )) result = ak_false;
+  ak_mpzn_set_ui( k2, wc->size, 1 );
+  ak_mpzn_sub( k2, wc->q, k2, wc->size );
+  if( !test_sum( k2, &wq, k2, wc )) result = ak_false;
+  for( i = 0; i < test_count; i++ ) {
+     ak_mpzn_set_random_modulo( k, wc->q, wc->size, generator );
+     ak_mpzn_set_random_modulo( k2, wc->q, wc->size, generator );
+     if( !test_sum( k, &wq, k2, wc )) result = ak_false;
+  }
+  if( !test_torsion( wc, generator )) result = ak_false;
+
+  printf("%s\n", result ? "Ok" : "Wrong" );
+ return result;
+}
+
+ int main( void )
+{
+  size_t count = 0;
+  struct random generator;
+  int error = EXIT_SUCCESS;
+  ak_oid oid = NULL;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( NULL )) return ak_libakrypt_destroy();
+  ak_random_create_lcg( &generator );
+
+ /* перебираем все эллиптические кривые */
+  oid = ak_oid_find_by_engine( identifier );
+  while( oid != NULL ) {
+    if( oid->mode == wcurve_params ) {
+      if( test_curve( oid, &generator ) != ak_true ) error = EXIT_FAILURE;
+      count++;
+    }
+    oid = ak_oid_findnext_by_engine( oid, identifier );
+  }
+  if( count == 0 ) error = EXIT_FAILURE;
+
+  ak_random_destroy( &generator );
+  ak_libakrypt_destroy();
+ return error;
+}
@@ -0,0 +1,196 @@
+/* ----------------------------------------------------------------------------------------------- */
+/* Тестовый пример, проверяющий корректность и скорость шифрования последовательности секторов
+   в режиме xts: контрольные примеры стандарта IEEE Std 1619-2007 (алгоритм AES-128),
+   совпадение результатов секторного интерфейса с последовательными вызовами функции
+   ak_bckey_encrypt_xts() (в том числе при переходе номера сектора через 2^64), а также
+   совпадение результатов многопоточного и однопоточного шифрования.
+
+   test-xts01.c                                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+
+ #include <time.h>
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <libakrypt.h>
+
+/* количество секторов, используемых для тестирования */
+ #define sectors_count (64)
+
+/* IEEE Std 1619-2007, приложение B, векторы 1 - 3: ключи шифрования (Key1),
+   ключи преобразования номера сектора (Key2), номера секторов и шифртексты */
+ static ak_uint8 ieee_key1[3][16] = {
+   { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+   { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11 },
+   { 0xff, 0xfe, 0xfd, 0xfc, 0xfb, 0xfa, 0xf9, 0xf8, 0xf7, 0xf6, 0xf5, 0xf4, 0xf3, 0xf2, 0xf1, 0xf0 }};
+
+ static ak_uint8 ieee_key2[3][16] = {
+   { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+   { 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22 },
+   { 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22 }};
+
+ static ak_uint64 ieee_sector[3] = { 0, 0x3333333333LL, 0x3333333333LL };
+
+ static ak_uint8 ieee_plain[3] = { 0x00, 0x44, 0x44 }; /* открытый текст из 32-х одинаковых октетов */
+
+ static ak_uint8 ieee_cipher[3][32] = {
+   { 0x91, 0x7c, 0xf6, 0x9e, 0xbd, 0x68, 0xb2, 0xec, 0x9b, 0x9f, 0xe9, 0xa3, 0xea, 0xdd, 0xa6, 0x92,
+     0xcd, 0x43, 0xd2, 0xf5, 0x95, 0x98, 0xed, 0x85, 0x8c, 0x02, 0xc2, 0x65, 0x2f, 0xbf, 0x92, 0x2e },
+   { 0xc4, 0x54, 0x18, 0x5e, 0x6a, 0x16, 0x93, 0x6e, 0x39, 0x33, 0x40, 0x38, 0xac, 0xef, 0x83, 0x8b,
+     0xfb, 0x18, 0x6f, 0xff, 0x74, 0x80, 0xad, 0xc4, 0x28, 0x93, 0x82, 0xec, 0xd6, 0xd3, 0x94, 0xf0 },
+   { 0xaf, 0x85, 0x33, 0x6b, 0x59, 0x7a, 0xfc, 0x1a, 0x90, 0x0b, 0x2e, 0xb2, 0x1e, 0xc9, 0x49, 0xd2,
+     0x92, 0xdf, 0x4c, 0x04, 0x7e, 0x0b, 0x21, 0x53, 0x21, 0x86, 0xa5, 0x97, 0x1a, 0x22, 0x7a, 0x89 }};
+
+/* ключи, используемые для проверки секторного интерфейса */
+ static ak_uint8 ekeyval[32] = {
+     0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+     0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88 };
+ static ak_uint8 akeyval[32] = {
+     0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+     0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f };
+
+/* ----------------------------------------------------------------------------------------------- */
+/* проверяем контрольный пример: секторный интерфейс, интерфейс с синхропосылкой
+   (номер сектора в порядке little endian) и расшифрование на месте */
+ static int test_ieee( size_t idx )
+{
+  size_t j = 0;
+  struct bckey ekey, akey;
+  int result = ak_false;
+  ak_uint8 in[32], out[32], iv[16];
+
+  memset( in, ieee_plain[idx], sizeof( in ));
+  memset( iv, 0, sizeof( iv ));
+  for( j = 0; j < 8; j++ ) iv[j] = ( ak_uint8 )( ieee_sector[idx] >> 8*j );
+
+  ak_bckey_create_aes128( &ekey ); ak_bckey_set_key( &ekey, ieee_key1[idx], 16 );
+  ak_bckey_create_aes128( &akey ); ak_bckey_set_key( &akey, ieee_key2[idx], 16 );
+  printf("IEEE 1619 vector %u: ", (unsigned int)( idx + 1 ));
+
+  memset( out, 0, sizeof( out ));
+  ak_bckey_encrypt_xts_sectors( &ekey, &akey, in, out, sizeof( in ), ieee_sector[idx], 1 );
+  if( !ak_ptr_is_equal_with_log( out, ieee_cipher[idx], sizeof( out ))) {
+    printf("Wrong (sector encryption)\n");
+    goto lab_exit;
+  }
+  memset( out, 0, sizeof( out ));
+  ak_bckey_encrypt_xts( &ekey, &akey, in, out, sizeof( in ), iv, sizeof( iv ));
+  if( !ak_ptr_is_equal_with_log( out, ieee_cipher[idx], sizeof( out ))) {
+    printf("Wrong (encryption)\n");
+    goto lab_exit;
+  }
+  ak_bckey_decrypt_xts_sectors( &ekey, &akey, out, out, sizeof( out ), ieee_sector[idx], 1 );
+  if( !ak_ptr_is_equal_with_log( out, in, sizeof( out ))) {
+    printf("Wrong (decryption)\n");
+    goto lab_exit;
+  }
+  printf("Ok\n");
+  result = ak_true;
+
+  lab_exit:
+   ak_bckey_destroy( &ekey );
+   ak_bckey_destroy( &akey );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* сравниваем результат секторного интерфейса с последовательными вызовами ak_bckey_encrypt_xts()
+   и, при заданном количестве потоков, с результатом однопоточного шифрования */
+ static int test_sectors( ak_bckey ekey, ak_bckey akey, size_t sector_size,
+                                                             ak_uint64 first, ak_int64 threads )
+{
+  size_t i = 0, j = 0, size = sectors_count*sector_size;
+  ak_uint64 number;
+  clock_t time_single, time_sectors;
+  int result = ak_false;
+  ak_uint8 iv[8];
+  ak_uint8 *in = malloc( size ), *out = malloc( size ), *out2 = malloc( size );
+
+  printf("%s (sector size: %u, threads: %u): ", ekey->key.oid->name[0],
+                                             (unsigned int) sector_size, (unsigned int) threads );
+  if(( in == NULL ) || ( out == NULL ) || ( out2 == NULL )) {
+    printf("incorrect memory allocation\n");
+    goto lab_exit;
+  }
+  for( i = 0; i < size; i++ ) in[i] = ( ak_uint8 )( 7*i + ( i >> 8 ));
+
+ /* шифруем каждый сектор отдельно */
+  time_single = clock();
+  for( i = 0; i < sectors_count; i++ ) {
+     number = first + i;
+     for( j = 0; j < sizeof( iv ); j++ ) iv[j] = ( ak_uint8 )( number >> 8*j );
+     ak_bckey_encrypt_xts( ekey, akey, in + i*sector_size,
+                                               out + i*sector_size, sector_size, iv, sizeof( iv ));
+  }
+  time_single = clock() - time_single;
+
+ /* шифруем все сектора за один вызов */
+  ak_libakrypt_set_option( "xts_sector_threads", threads );
+  time_sectors = clock();
+  if( ak_bckey_encrypt_xts_sectors( ekey, akey, in, out2,
+                                        sector_size, first, sectors_count ) != ak_error_ok ) {
+    printf("encryption error\n");
+    goto lab_exit;
+  }
+  time_sectors = clock() - time_sectors;
+  if( memcmp( out, out2, size ) != 0 ) {
+    printf("Wrong (sector encryption)\n");
+    goto lab_exit;
+  }
+
+ /* расшифровываем на месте */
+  if( ak_bckey_decrypt_xts_sectors( ekey, akey, out2, out2,
+                                        sector_size, first, sectors_count ) != ak_error_ok ) {
+    printf("decryption error\n");
+    goto lab_exit;
+  }
+  if( memcmp( in, out2, size ) != 0 ) {
+    printf("Wrong (sector decryption)\n");
+    goto lab_exit;
+  }
+  printf("Ok (%f sec, %f sec)\n", (double) time_single / (double) CLOCKS_PER_SEC,
+                                             (double) time_sectors / (double) CLOCKS_PER_SEC );
+  result = ak_true;
+
+  lab_exit:
+   ak_libakrypt_set_option( "xts_sector_threads", 1 );
+   if( in ) free( in );
+   if( out ) free( out );
+   if( out2 ) free( out2 );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ int main( void )
+{
+  size_t i = 0;
+  struct bckey ekey, akey;
+  int error = EXIT_SUCCESS;
+
+ /* инициализируем библиотеку */
+  if( !ak_libakrypt_create( NULL )) return ak_libakrypt_destroy();
+
+ /* контрольные примеры */
+  for( i = 0; i < 3; i++ ) if( test_ieee( i ) != ak_true ) error = EXIT_FAILURE;
+
+ /* алгоритм Кузнечик: сектора различной длины, в том числе с переходом номера через 2^64 */
+  ak_bckey_create_kuznechik( &ekey ); ak_bckey_set_key( &ekey, ekeyval, sizeof( ekeyval ));
+  ak_bckey_create_kuznechik( &akey ); ak_bckey_set_key( &akey, akeyval, sizeof( akeyval ));
+  if( test_sectors( &ekey, &akey, 4096, 0, 1 ) != ak_true ) error = EXIT_FAILURE;
+  if( test_sectors( &ekey, &akey, 512, 0xfffffffffffffff0LL, 1 ) != ak_true ) error = EXIT_FAILURE;
+  if( test_sectors( &ekey, &akey, 4096, 3, 4 ) != ak_true ) error = EXIT_FAILURE;
+  if( test_sectors( &ekey, &akey, 512, 0xffffffffffffffe7LL, 7 ) != ak_true ) error = EXIT_FAILURE;
+  ak_bckey_destroy( &ekey );
+  ak_bckey_destroy( &akey );
+
+ /* алгоритм Магма: длина сектора кратна 8, но не кратна 16 октетам */
+  ak_bckey_create_magma( &ekey ); ak_bckey_set_key( &ekey, ekeyval, sizeof( ekeyval ));
+  ak_bckey_create_magma( &akey ); ak_bckey_set_key( &akey, akeyval, sizeof( akeyval ));
+  if( test_sectors( &ekey, &akey, 520, 7, 1 ) != ak_true ) error = EXIT_FAILURE;
+  if( test_sectors( &ekey, &akey, 520, 11, 4 ) != ak_true ) error = EXIT_FAILURE;
+  ak_bckey_destroy( &ekey );
+  ak_bckey_destroy( &akey );
+
+  ak_libakrypt_destroy();
+ return error;
+}
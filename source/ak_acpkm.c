@@ -7,6 +7,10 @@
 /* ----------------------------------------------------------------------------------------------- */
  #include <libakrypt-internal.h>
 
+#ifdef AK_HAVE_PTHREAD_H
+ #include <pthread.h>
+#endif
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \details Функция вычисляет новое значение секретного ключа в соответствии с соотношениями
     из раздела 4.1, см. Р 1323565.1.017—2018.
@@ -57,8 +61,12 @@
                                            __func__ , "incorrect block size of block cipher key" );
    }
 
- /* присваиваем ключу значение */
-  if(( error = ak_bckey_set_key( bkey, new_key, bkey->key.key_size )) != ak_error_ok )
+ /* присваиваем ключу значение; полная процедура присвоения используется только для
+    алгоритма Магма в режиме совместимости с openssl, поскольку требует переворота ключа */
+  if(( bkey->bsize == 8 ) && ( ak_libakrypt_get_option_by_name( "openssl_compability" ) == 1 ))
+    error = ak_bckey_set_key( bkey, new_key, bkey->key.key_size );
+   else error = ak_bckey_replace_key( bkey, new_key );
+  if( error != ak_error_ok )
     ak_error_message( error, __func__ , "can't replace key by new using acpkm" );
    else {
            bkey->key.resource.value.type = key_using_resource;
@@ -70,15 +78,15 @@
 
 /* ----------------------------------------------------------------------------------------------- */
 #ifdef AK_LITTLE_ENDIAN
-  #define acpkm_block64 {\
-              nkey.encrypt( &nkey.key, ctr, yaout );\
+  #define acpkm_block64( bk ) {\
+              (bk)->encrypt( &(bk)->key, ctr, yaout );\
               ctr[0] += 1;\
               ((ak_uint64 *) outptr)[0] = yaout[0] ^ ((ak_uint64 *) inptr)[0];\
               outptr++; inptr++;\
            }
 
-  #define acpkm_block128 {\
-              nkey.encrypt( &nkey.key, ctr, yaout );\
+  #define acpkm_block128( bk ) {\
+              (bk)->encrypt( &(bk)->key, ctr, yaout );\
               if(( ctr[0] += 1 ) == 0 ) ctr[1]++;\
               ((ak_uint64 *) outptr)[0] = yaout[0] ^ ((ak_uint64 *) inptr)[0];\
               ((ak_uint64 *) outptr)[1] = yaout[1] ^ ((ak_uint64 *) inptr)[1];\
@@ -86,15 +94,15 @@
            }
 
 #else
-  #define acpkm_block64 {\
-              nkey.encrypt( &nkey.key, ctr, yaout );\
+  #define acpkm_block64( bk ) {\
+              (bk)->encrypt( &(bk)->key, ctr, yaout );\
               ctr[0] = bswap_64( ctr[0] ); ctr[0] += 1; ctr[0] = bswap_64( ctr[0] );\
               ((ak_uint64 *) outptr)[0] = yaout[0] ^ ((ak_uint64 *) inptr)[0];\
               outptr++; inptr++;\
            }
 
-  #define acpkm_block128 {\
-              nkey.encrypt( &nkey.key, ctr, yaout );\
+  #define acpkm_block128( bk ) {\
+              (bk)->encrypt( &(bk)->key, ctr, yaout );\
               ctr[0] = bswap_64( ctr[0] ); ctr[0] += 1; ctr[0] = bswap_64( ctr[0] );\
               if( ctr[0] == 0 ) { \
                 ctr[1] = bswap_64( ctr[0] ); ctr[1] += 1; ctr[1] = bswap_64( ctr[0] );\
@@ -105,6 +113,181 @@
            }
 #endif
 
+#ifdef AK_HAVE_PTHREAD_H
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Максимальное количество потоков, используемых в режиме `CTR-ACPKM`. */
+ #define ak_acpkm_max_threads           (64)
+
+/*! \brief Структура, содержащая параметры обработки последовательности секций режима
+    `CTR-ACPKM` (передается в отдельный поток). */
+ typedef struct acpkm_sections {
+  /*! \brief Указатель на ключ первой обрабатываемой секции. */
+   ak_bckey key;
+  /*! \brief Указатель на входные данные первой секции. */
+   ak_uint64 *in;
+  /*! \brief Указатель на выходные данные первой секции. */
+   ak_uint64 *out;
+  /*! \brief Значение счетчика для первого блока первой секции. */
+   ak_uint64 ctr[2];
+  /*! \brief Количество блоков в одной секции. */
+   ssize_t seclen;
+  /*! \brief Количество полных секций. */
+   ssize_t sections;
+  /*! \brief Длина фрагмента данных, следующего за полными секциями (в октетах). */
+   ssize_t tail;
+  /*! \brief Код ошибки, возникшей при обработке секций. */
+   int error;
+ } *ak_acpkm_sections;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция увеличивает значение счетчика режима `CTR-ACPKM` на заданную величину. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_acpkm_ctr_add( ak_uint64 *ctr, const size_t bsize, const ak_uint64 count )
+{
+#ifdef AK_LITTLE_ENDIAN
+  ak_uint64 value = ctr[0];
+  if(( ctr[0] += count ) < value ) {
+    if( bsize == 16 ) ctr[1]++;
+  }
+#else
+  ak_uint64 value = bswap_64( ctr[0] ), sum = value + count;
+  ctr[0] = bswap_64( sum );
+  if(( sum < value ) && ( bsize == 16 )) ctr[1] = bswap_64( bswap_64( ctr[1] ) + 1 );
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция зашифровывает последовательность секций, начиная с ключа,
+    содержащегося в контексте, и изменяя его в процессе работы. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void *ak_acpkm_sections_thread( void *ptr )
+{
+  ssize_t i = 0, j = 0, seclen = 0;
+  ak_acpkm_sections ctx = ptr;
+  ak_bckey key = ctx->key;
+  ak_uint64 yaout[2], *inptr = ctx->in, *outptr = ctx->out, ctr[2];
+
+  ctr[0] = ctx->ctr[0]; ctr[1] = ctx->ctr[1];
+  for( i = 0; i < ctx->sections; i++ ) {
+     if( key->bsize == 8 ) { for( j = 0; j < ctx->seclen; j++ ) acpkm_block64( key ); }
+      else { for( j = 0; j < ctx->seclen; j++ ) acpkm_block128( key ); }
+    /* следующий ключ вычисляется только при наличии данных */
+     if(( i < ctx->sections - 1 ) || ( ctx->tail > 0 ))
+       if(( ctx->error = ak_bckey_next_acpkm_key( key )) != ak_error_ok ) return NULL;
+  }
+
+  if( ctx->tail > 0 ) {
+    ssize_t tail = ctx->tail;
+    if(( seclen = tail/( ssize_t )key->bsize ) > 0 ) {
+      if( key->bsize == 8 ) { for( j = 0; j < seclen; j++ ) acpkm_block64( key ); }
+       else { for( j = 0; j < seclen; j++ ) acpkm_block128( key ); }
+    }
+    if(( tail -= seclen*( ssize_t )key->bsize ) > 0 ) {
+      key->encrypt( &key->key, ctr, yaout );
+      for( j = 0; j < tail; j++ ) ((ak_uint8 *) outptr)[j] =
+                         ((ak_uint8 *)yaout)[(ssize_t)key->bsize-tail+j] ^ ((ak_uint8 *) inptr)[j];
+    }
+  }
+  memset( yaout, 0, sizeof( yaout ));
+ return NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Многопоточная реализация режима `CTR-ACPKM`.
+    \details Поскольку ключ каждой секции зависит только от ключа предыдущей секции,
+    последовательность ключей вычисляется заранее: текущий поток последовательно
+    вырабатывает ключи секций и сохраняет копии тех из них, с которых начинается обработка
+    данных каждым потоком. После этого непрерывные последовательности секций
+    зашифровываются независимо; результат совпадает с результатом последовательной
+    обработки.
+
+    \param nkey Ключ первой секции (изменяется в ходе работы функции).
+    \param inptr Указатель на входные данные.
+    \param outptr Указатель на выходные данные.
+    \param ctr Начальное значение счетчика.
+    \param seclen Количество блоков в одной секции.
+    \param sections Количество полных секций.
+    \param tail Длина фрагмента данных, следующего за полными секциями (в октетах).
+    \param count Количество потоков.
+    \return В случае успеха функция возвращает \ref ak_error_ok (ноль). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_bckey_ctr_acpkm_threads( ak_bckey nkey, ak_uint64 *inptr, ak_uint64 *outptr,
+                 ak_uint64 *ctr, ssize_t seclen, ssize_t sections, ssize_t tail, size_t count )
+{
+  struct bckey wkey;
+  int error = ak_error_ok;
+  pthread_t threads[ak_acpkm_max_threads];
+  struct bckey keys[ak_acpkm_max_threads];
+  struct acpkm_sections parts[ak_acpkm_max_threads];
+  bool_t started[ak_acpkm_max_threads], created[ak_acpkm_max_threads];
+  size_t idx = 0, units = ( size_t )sections + ( tail > 0 ? 1 : 0 ), part = 0, rest = 0, first = 0;
+  ssize_t s = 0, words = seclen*( ssize_t )( nkey->bsize >> 3 );
+
+  if( count > units ) count = units;
+  if( count > ak_acpkm_max_threads ) count = ak_acpkm_max_threads;
+  part = units/count; rest = units%count;
+  memset( created, 0, sizeof( created ));
+  memset( started, 0, sizeof( started ));
+
+ /* распределяем секции между потоками */
+  for( idx = 0; idx < count; idx++ ) {
+     size_t len = part + ( idx < rest ? 1 : 0 );
+     parts[idx].in = inptr + ( ssize_t )first*words;
+     parts[idx].out = outptr + ( ssize_t )first*words;
+     parts[idx].ctr[0] = ctr[0]; parts[idx].ctr[1] = ctr[1];
+     ak_acpkm_ctr_add( parts[idx].ctr, nkey->bsize, ( ak_uint64 )first*( ak_uint64 )seclen );
+     parts[idx].seclen = seclen;
+     parts[idx].tail = ( first + len > ( size_t )sections ) ? tail : 0;
+     parts[idx].sections = ( ssize_t )len - ( parts[idx].tail > 0 ? 1 : 0 );
+     parts[idx].error = ak_error_ok;
+     parts[idx].key = NULL;
+     first += len;
+  }
+
+ /* вычисляем последовательность ключей и сохраняем ключи начальных секций */
+  parts[0].key = nkey;
+  if(( error = ak_bckey_create_and_set_bckey( &wkey, nkey )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect key duplication" );
+  for( idx = 1, s = 0, first = part + ( rest > 0 ? 1 : 0 ); idx < count; idx++ ) {
+     while( s < ( ssize_t )first ) {
+       if(( error = ak_bckey_next_acpkm_key( &wkey )) != ak_error_ok ) {
+         ak_error_message( error, __func__, "incorrect generation of section key" );
+         goto labex;
+       }
+       s++;
+     }
+     if(( error = ak_bckey_create_and_set_bckey( keys+idx, &wkey )) != ak_error_ok ) {
+       ak_error_message( error, __func__, "incorrect key duplication" );
+       goto labex;
+     }
+     created[idx] = ak_true;
+     parts[idx].key = keys+idx;
+     first += part + ( idx < rest ? 1 : 0 );
+  }
+
+ /* запускаем потоки; если поток не создан, то секции обрабатываются текущим потоком */
+  for( idx = 1; idx < count; idx++ )
+     started[idx] = ( pthread_create( threads+idx, NULL,
+                                  ak_acpkm_sections_thread, parts+idx ) == 0 ) ? ak_true : ak_false;
+  ak_acpkm_sections_thread( parts );
+  for( idx = 1; idx < count; idx++ ) {
+     if( started[idx] ) pthread_join( threads[idx], NULL );
+      else ak_acpkm_sections_thread( parts+idx );
+  }
+  for( idx = 0; idx < count; idx++ )
+     if( parts[idx].error != ak_error_ok ) {
+       error = ak_error_message( parts[idx].error, __func__, "incorrect processing of sections" );
+       break;
+     }
+
+  labex:
+   for( idx = 1; idx < count; idx++ ) if( created[idx] ) ak_bckey_destroy( keys+idx );
+   ak_bckey_destroy( &wkey );
+ return error;
+}
+#endif
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! В режиме `ACPKM` для шифрования используется операция гаммирования - операция сложения
     открытого (зашифровываемого) текста с гаммой, вырабатываемой шифром, по модулю два.
@@ -148,6 +331,9 @@
   int error = ak_error_ok;
   ssize_t j = 0, sections = 0, tail = 0, seclen = 0, maxseclen = 0, mcount = 0;
   ak_uint64 yaout[2], *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out, ctr[2] = { 0, 0 };
+#ifdef AK_HAVE_PTHREAD_H
+  size_t threads = 1;
+#endif
 
  /* выполняем проверку размера входных данных */
   if( section_size%bkey->bsize != 0 )
@@ -210,11 +396,26 @@
  /* дальнейшие криптографические действия применяются к новому экземпляру ключа */
   sections = ( ssize_t )( size/section_size );
   tail = ( ssize_t )( size - ( size_t )( sections*seclen )*nkey.bsize );
+
+#ifdef AK_HAVE_PTHREAD_H
+ /* при наличии нескольких секций они могут обрабатываться параллельно
+    (кроме алгоритма Магма в режиме совместимости с openssl, где копирование ключа
+     сопровождается его переворотом) */
+  threads = ( size_t ) ak_libakrypt_get_option_by_name( "acpkm_threads" );
+  if(( threads > 1 ) && ( sections > 1 ) &&
+     !(( nkey.bsize == 8 ) && ( ak_libakrypt_get_option_by_name( "openssl_compability" ) == 1 ))) {
+    if(( error = ak_bckey_ctr_acpkm_threads( &nkey, inptr, outptr, ctr,
+                                            seclen, sections, tail, threads )) != ak_error_ok )
+      ak_error_message( error, __func__, "incorrect multithreaded encryption" );
+    goto labex;
+  }
+#endif
+
   if( sections > 0 ) {
     do{
        switch( nkey.bsize ) { /* обрабатываем одну секцию */
-         case 8: for( j = 0; j < seclen; j++ ) acpkm_block64; break;
-         case 16: for( j = 0; j < seclen; j++ ) acpkm_block128; break;
+         case 8: for( j = 0; j < seclen; j++ ) acpkm_block64( &nkey ); break;
+         case 16: for( j = 0; j < seclen; j++ ) acpkm_block128( &nkey ); break;
          default: ak_error_message( ak_error_wrong_block_cipher,
                                            __func__ , "incorrect block size of block cipher key" );
        }
@@ -230,8 +431,8 @@
   if( tail ) { /* теперь обрабатываем фрагмент данных, не кратный длине секции */
     if(( seclen = tail/(ssize_t)( nkey.bsize )) > 0 ) {
        switch( nkey.bsize ) { /* обрабатываем данные, кратные длине блока */
-         case 8: for( j = 0; j < seclen; j++ ) acpkm_block64; break;
-         case 16: for( j = 0; j < seclen; j++ ) acpkm_block128; break;
+         case 8: for( j = 0; j < seclen; j++ ) acpkm_block64( &nkey ); break;
+         case 16: for( j = 0; j < seclen; j++ ) acpkm_block128( &nkey ); break;
          default: ak_error_message( ak_error_wrong_block_cipher,
                                             __func__ , "incorrect block size of block cipher key" );
        }
@@ -0,0 +1,811 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Copyright (c) 2020 by Axel Kenzo, axelkenzo@mail.ru                                            */
+/*                                                                                                 */
+/*  Файл ak_aes.c                                                                                  */
+/*  - содержит реализацию алгоритма блочного шифрования AES (FIPS 197)                             */
+/*    с длинами ключа 128 и 256 бит                                                                */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <libakrypt-internal.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+ #ifdef AK_HAVE_BUILTIN_AESENC
+  #include <wmmintrin.h>
+ #endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Развернутые раундовые ключи и маски алгоритма AES.
+    \details Структура содержит две формы представления раундовых ключей: последовательности
+    октетов, используемые реализацией на основе инструкций AES-NI, и битовые срезы (bitslice),
+    используемые переносимой реализацией, время выполнения которой не зависит от
+    обрабатываемых данных. Все раундовые ключи хранятся в маскированном виде.                      */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct aes_expanded_keys {
+  /*! \brief Маскированные раундовые ключи зашифрования. */
+   ak_uint8 ekey[15][16];
+  /*! \brief Маски раундовых ключей зашифрования. */
+   ak_uint8 mkey[15][16];
+  /*! \brief Маскированные раундовые ключи расшифрования (в порядке их использования). */
+   ak_uint8 dkey[15][16];
+  /*! \brief Маски раундовых ключей расшифрования. */
+   ak_uint8 xkey[15][16];
+  /*! \brief Маскированные раундовые ключи в виде битовых срезов. */
+   ak_uint32 skey[15][8];
+  /*! \brief Маски раундовых ключей в виде битовых срезов. */
+   ak_uint32 smask[15][8];
+  /*! \brief Количество раундов алгоритма (10 или 14). */
+   size_t rounds;
+ } *ak_aes_expanded_keys;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                          переносимая реализация на битовых срезах                               */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Транспонирование битовой матрицы размера 8х8, записанной в 64-х битное слово. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline ak_uint64 ak_aes_transpose8( ak_uint64 x )
+{
+  ak_uint64 t;
+  t = ( x^( x >> 7 ))&0x00AA00AA00AA00AALL;  x ^= t^( t << 7 );
+  t = ( x^( x >> 14 ))&0x0000CCCC0000CCCCLL; x ^= t^( t << 14 );
+  t = ( x^( x >> 28 ))&0x00000000F0F0F0F0LL; x ^= t^( t << 28 );
+ return x;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция преобразует 16 октетов в восемь битовых срезов.
+    \details j-й бит i-го октета помещается в i-й бит j-го среза.                                 */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_aes_bitslice( const ak_uint8 *in, ak_uint32 *q )
+{
+  int i = 0;
+  ak_uint64 lo = 0, hi = 0;
+
+  for( i = 7; i >= 0; i-- ) {
+     lo = ( lo << 8 )^in[i];
+     hi = ( hi << 8 )^in[8+i];
+  }
+  lo = ak_aes_transpose8( lo );
+  hi = ak_aes_transpose8( hi );
+  for( i = 0; i < 8; i++ )
+     q[i] = ( ak_uint32 )((( lo >> ( i << 3 ))&0xFF )^((( hi >> ( i << 3 ))&0xFF ) << 8 ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция преобразует восемь битовых срезов в 16 октетов. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_aes_unbitslice( const ak_uint32 *q, ak_uint8 *out )
+{
+  int i = 0;
+  ak_uint64 lo = 0, hi = 0;
+
+  for( i = 7; i >= 0; i-- ) {
+     lo = ( lo << 8 )^( q[i]&0xFF );
+     hi = ( hi << 8 )^(( q[i] >> 8 )&0xFF );
+  }
+  lo = ak_aes_transpose8( lo );
+  hi = ak_aes_transpose8( hi );
+  for( i = 0; i < 8; i++ ) {
+     out[i] = ( ak_uint8 )( lo >> ( i << 3 ));
+     out[8+i] = ( ak_uint8 )( hi >> ( i << 3 ));
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Нелинейное преобразование SubBytes, вычисляемое для битовых срезов.
+    \details Используется схема Бояра-Перальты из 113 логических операций: обращение
+    в поле \f$ \mathbb F_{2^8} \f$ и аффинное преобразование вычисляются без обращения
+    к таблицам, что исключает зависимость времени вычислений от обрабатываемых данных.             */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_aes_bitslice_sbox( ak_uint32 *q )
+{
+  ak_uint32 x0, x1, x2, x3, x4, x5, x6, x7;
+  ak_uint32 y1, y2, y3, y4, y5, y6, y7, y8, y9, y10, y11, y12, y13, y14, y15, y16, y17, y18,
+            y19, y20, y21;
+  ak_uint32 z0, z1, z2, z3, z4, z5, z6, z7, z8, z9, z10, z11, z12, z13, z14, z15, z16, z17;
+  ak_uint32 t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15, t16, t17,
+            t18, t19, t20, t21, t22, t23, t24, t25, t26, t27, t28, t29, t30, t31, t32, t33,
+            t34, t35, t36, t37, t38, t39, t40, t41, t42, t43, t44, t45, t46, t47, t48, t49,
+            t50, t51, t52, t53, t54, t55, t56, t57, t58, t59, t60, t61, t62, t63, t64, t65,
+            t66, t67;
+  ak_uint32 s0, s1, s2, s3, s4, s5, s6, s7;
+
+  x0 = q[7]; x1 = q[6]; x2 = q[5]; x3 = q[4];
+  x4 = q[3]; x5 = q[2]; x6 = q[1]; x7 = q[0];
+
+ /* верхнее линейное преобразование */
+  y14 = x3 ^ x5;   y13 = x0 ^ x6;   y9 = x0 ^ x3;    y8 = x0 ^ x5;
+  t0 = x1 ^ x2;    y1 = t0 ^ x7;    y4 = y1 ^ x3;    y12 = y13 ^ y14;
+  y2 = y1 ^ x0;    y5 = y1 ^ x6;    y3 = y5 ^ y8;    t1 = x4 ^ y12;
+  y15 = t1 ^ x5;   y20 = t1 ^ x1;   y6 = y15 ^ x7;   y10 = y15 ^ t0;
+  y11 = y20 ^ y9;  y7 = x7 ^ y11;   y17 = y10 ^ y11; y19 = y10 ^ y8;
+  y16 = t0 ^ y11;  y21 = y13 ^ y16; y18 = x0 ^ y16;
+
+ /* нелинейная часть */
+  t2 = y12 & y15;  t3 = y3 & y6;    t4 = t3 ^ t2;    t5 = y4 & x7;
+  t6 = t5 ^ t2;    t7 = y13 & y16;  t8 = y5 & y1;    t9 = t8 ^ t7;
+  t10 = y2 & y7;   t11 = t10 ^ t7;  t12 = y9 & y11;  t13 = y14 & y17;
+  t14 = t13 ^ t12; t15 = y8 & y10;  t16 = t15 ^ t12; t17 = t4 ^ t14;
+  t18 = t6 ^ t16;  t19 = t9 ^ t14;  t20 = t11 ^ t16; t21 = t17 ^ y20;
+  t22 = t18 ^ y19; t23 = t19 ^ y21; t24 = t20 ^ y18; t25 = t21 ^ t22;
+  t26 = t21 & t23; t27 = t24 ^ t26; t28 = t25 & t27; t29 = t28 ^ t22;
+  t30 = t23 ^ t24; t31 = t22 ^ t26; t32 = t31 & t30; t33 = t32 ^ t24;
+  t34 = t23 ^ t33; t35 = t27 ^ t33; t36 = t24 & t35; t37 = t36 ^ t34;
+  t38 = t27 ^ t36; t39 = t29 & t38; t40 = t25 ^ t39; t41 = t40 ^ t37;
+  t42 = t29 ^ t33; t43 = t29 ^ t40; t44 = t33 ^ t37; t45 = t42 ^ t41;
+
+  z0 = t44 & y15;  z1 = t37 & y6;   z2 = t33 & x7;   z3 = t43 & y16;
+  z4 = t40 & y1;   z5 = t29 & y7;   z6 = t42 & y11;  z7 = t45 & y17;
+  z8 = t41 & y10;  z9 = t44 & y12;  z10 = t37 & y3;  z11 = t33 & y4;
+  z12 = t43 & y13; z13 = t40 & y5;  z14 = t29 & y2;  z15 = t42 & y9;
+  z16 = t45 & y14; z17 = t41 & y8;
+
+ /* нижнее линейное преобразование */
+  t46 = z15 ^ z16; t47 = z10 ^ z11; t48 = z5 ^ z13;  t49 = z9 ^ z10;
+  t50 = z2 ^ z12;  t51 = z2 ^ z5;   t52 = z7 ^ z8;   t53 = z0 ^ z3;
+  t54 = z6 ^ z7;   t55 = z16 ^ z17; t56 = z12 ^ t48; t57 = t50 ^ t53;
+  t58 = z4 ^ t46;  t59 = z3 ^ t54;  t60 = t46 ^ t57; t61 = z14 ^ t57;
+  t62 = t52 ^ t58; t63 = t49 ^ t58; t64 = z4 ^ t59;  t65 = t61 ^ t62;
+  t66 = z1 ^ t63;  s0 = t59 ^ t63;  s6 = t56 ^ ~t62; s7 = t48 ^ ~t60;
+  t67 = t64 ^ t65; s3 = t53 ^ t66;  s4 = t51 ^ t66;  s5 = t47 ^ t65;
+  s1 = t64 ^ ~s3;  s2 = t55 ^ ~t67;
+
+  q[7] = s0; q[6] = s1; q[5] = s2; q[4] = s3;
+  q[3] = s4; q[2] = s5; q[1] = s6; q[0] = s7;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Преобразование, обратное к аффинному преобразованию, используемому в SubBytes. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_aes_bitslice_affine_inverse( ak_uint32 *q )
+{
+  ak_uint32 q0 = ~q[0], q1 = ~q[1], q2 = q[2], q3 = q[3],
+            q4 = q[4], q5 = ~q[5], q6 = ~q[6], q7 = q[7];
+
+  q[7] = q1 ^ q4 ^ q6; q[6] = q0 ^ q3 ^ q5; q[5] = q7 ^ q2 ^ q4; q[4] = q6 ^ q1 ^ q3;
+  q[3] = q5 ^ q0 ^ q2; q[2] = q4 ^ q7 ^ q1; q[1] = q3 ^ q6 ^ q0; q[0] = q2 ^ q5 ^ q7;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Обратное нелинейное преобразование InvSubBytes.
+    \details Поскольку \f$ S^{-1}(x) = A^{-1}( S( A^{-1}(x) )) \f$, где \f$ A \f$ -
+    аффинное преобразование, обратное преобразование вычисляется той же схемой,
+    что и прямое.                                                                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_aes_bitslice_inv_sbox( ak_uint32 *q )
+{
+  ak_aes_bitslice_affine_inverse( q );
+  ak_aes_bitslice_sbox( q );
+  ak_aes_bitslice_affine_inverse( q );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Циклический сдвиг 16-ти битного среза вправо. */
+ #define ak_aes_ror16( w, n ) (((( w )&0xFFFF ) >> ( n ))^((( w ) << ( 16 - ( n )))&0xFFFF ))
+
+/*! \brief Перестановка строк состояния внутри столбца: на место r-й строки помещается (r+1)-я. */
+ #define ak_aes_rotrow( w ) (((( w ) >> 1 )&0x7777 )^((( w ) << 3 )&0x8888 ))
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Преобразование ShiftRows.
+    \details Бит среза с номером r+4c соответствует октету, расположенному в строке r
+    и столбце c состояния алгоритма; сдвиг строки r на r позиций влево есть циклический
+    сдвиг среза на 4r позиций вправо.                                                              */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_aes_bitslice_shift_rows( ak_uint32 *q )
+{
+  int i = 0;
+  for( i = 0; i < 8; i++ )
+     q[i] = ( q[i]&0x1111 )^( ak_aes_ror16( q[i], 4 )&0x2222 )^
+                                ( ak_aes_ror16( q[i], 8 )&0x4444 )^( ak_aes_ror16( q[i], 12 )&0x8888 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Преобразование InvShiftRows. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_aes_bitslice_inv_shift_rows( ak_uint32 *q )
+{
+  int i = 0;
+  for( i = 0; i < 8; i++ )
+     q[i] = ( q[i]&0x1111 )^( ak_aes_ror16( q[i], 12 )&0x2222 )^
+                                 ( ak_aes_ror16( q[i], 8 )&0x4444 )^( ak_aes_ror16( q[i], 4 )&0x8888 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Умножение всех элементов состояния на 2 в поле \f$ \mathbb F_{2^8} \f$. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_aes_bitslice_xtime( const ak_uint32 *p, ak_uint32 *q )
+{
+  ak_uint32 p7 = p[7];
+  q[7] = p[6]; q[6] = p[5]; q[5] = p[4]; q[4] = p[3]^p7;
+  q[3] = p[2]^p7; q[2] = p[1]; q[1] = p[0]^p7; q[0] = p7;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Преобразование MixColumns:
+    \f$ b_r = 2(a_r \oplus a_{r+1}) \oplus a_{r+1} \oplus a_{r+2} \oplus a_{r+3} \f$.             */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_aes_bitslice_mix_columns( ak_uint32 *q )
+{
+  int i = 0;
+  ak_uint32 a1[8], a2[8], t[8];
+
+  for( i = 0; i < 8; i++ ) {
+     a1[i] = ak_aes_rotrow( q[i] );
+     a2[i] = ak_aes_rotrow( a1[i] );
+     t[i] = q[i]^a1[i];
+     a2[i] ^= a1[i]^ak_aes_rotrow( a2[i] );
+  }
+  ak_aes_bitslice_xtime( t, q );
+  for( i = 0; i < 8; i++ ) q[i] ^= a2[i];
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Преобразование InvMixColumns.
+    \details Используется представление InvMixColumns в виде композиции преобразования
+    \f$ a_r \leftarrow a_r \oplus 4(a_r \oplus a_{r+2}) \f$ и преобразования MixColumns.           */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_aes_bitslice_inv_mix_columns( ak_uint32 *q )
+{
+  int i = 0;
+  ak_uint32 t[8], u[8];
+
+  for( i = 0; i < 8; i++ ) t[i] = q[i]^ak_aes_rotrow( ak_aes_rotrow( q[i] ));
+  ak_aes_bitslice_xtime( t, u );
+  ak_aes_bitslice_xtime( u, t );
+  for( i = 0; i < 8; i++ ) q[i] ^= t[i];
+  ak_aes_bitslice_mix_columns( q );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Сложение состояния с маскированным раундовым ключом и его маской. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_aes_bitslice_add_round_key( ak_uint32 *q,
+                                                         const ak_uint32 *k, const ak_uint32 *m )
+{
+  int i = 0;
+  for( i = 0; i < 8; i++ ) { q[i] ^= k[i]; q[i] ^= m[i]; }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция зашифрования одного блока информации алгоритмом AES
+    (переносимая реализация, время выполнения которой не зависит от обрабатываемых данных).       */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_aes_encrypt_bitslice( ak_skey skey, ak_pointer in, ak_pointer out )
+{
+  size_t r = 0;
+  ak_uint32 q[8];
+  ak_aes_expanded_keys ekeys = ( ak_aes_expanded_keys )skey->data;
+
+  ak_aes_bitslice( in, q );
+  ak_aes_bitslice_add_round_key( q, ekeys->skey[0], ekeys->smask[0] );
+  for( r = 1; r < ekeys->rounds; r++ ) {
+     ak_aes_bitslice_sbox( q );
+     ak_aes_bitslice_shift_rows( q );
+     ak_aes_bitslice_mix_columns( q );
+     ak_aes_bitslice_add_round_key( q, ekeys->skey[r], ekeys->smask[r] );
+  }
+  ak_aes_bitslice_sbox( q );
+  ak_aes_bitslice_shift_rows( q );
+  ak_aes_bitslice_add_round_key( q, ekeys->skey[r], ekeys->smask[r] );
+  ak_aes_unbitslice( q, out );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция расшифрования одного блока информации алгоритмом AES
+    (переносимая реализация, время выполнения которой не зависит от обрабатываемых данных).       */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_aes_decrypt_bitslice( ak_skey skey, ak_pointer in, ak_pointer out )
+{
+  size_t r = 0;
+  ak_uint32 q[8];
+  ak_aes_expanded_keys ekeys = ( ak_aes_expanded_keys )skey->data;
+
+  ak_aes_bitslice( in, q );
+  ak_aes_bitslice_add_round_key( q, ekeys->skey[ekeys->rounds], ekeys->smask[ekeys->rounds] );
+  for( r = ekeys->rounds - 1; r > 0; r-- ) {
+     ak_aes_bitslice_inv_shift_rows( q );
+     ak_aes_bitslice_inv_sbox( q );
+     ak_aes_bitslice_add_round_key( q, ekeys->skey[r], ekeys->smask[r] );
+     ak_aes_bitslice_inv_mix_columns( q );
+  }
+  ak_aes_bitslice_inv_shift_rows( q );
+  ak_aes_bitslice_inv_sbox( q );
+  ak_aes_bitslice_add_round_key( q, ekeys->skey[0], ekeys->smask[0] );
+  ak_aes_unbitslice( q, out );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                                 реализация на инструкциях AES-NI                                */
+/* ----------------------------------------------------------------------------------------------- */
+ #ifdef AK_HAVE_BUILTIN_AESENC
+/*! \brief Функция зашифрования одного блока информации алгоритмом AES
+    с использованием инструкций AES-NI.
+    \details Маска раундового ключа складывается с результатом выполнения инструкции aesenc,
+    поэтому раундовые ключи в немаскированном виде в процессе шифрования не возникают.             */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_aes_encrypt_aesni( ak_skey skey, ak_pointer in, ak_pointer out )
+{
+  size_t r = 0;
+  ak_aes_expanded_keys ekeys = ( ak_aes_expanded_keys )skey->data;
+  __m128i x = _mm_loadu_si128(( const __m128i *)in );
+
+  x = _mm_xor_si128( x, _mm_loadu_si128(( const __m128i *)ekeys->ekey[0] ));
+  x = _mm_xor_si128( x, _mm_loadu_si128(( const __m128i *)ekeys->mkey[0] ));
+  for( r = 1; r < ekeys->rounds; r++ ) {
+     x = _mm_aesenc_si128( x, _mm_loadu_si128(( const __m128i *)ekeys->ekey[r] ));
+     x = _mm_xor_si128( x, _mm_loadu_si128(( const __m128i *)ekeys->mkey[r] ));
+  }
+  x = _mm_aesenclast_si128( x, _mm_loadu_si128(( const __m128i *)ekeys->ekey[r] ));
+  x = _mm_xor_si128( x, _mm_loadu_si128(( const __m128i *)ekeys->mkey[r] ));
+  _mm_storeu_si128(( __m128i *)out, x );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция расшифрования одного блока информации алгоритмом AES
+    с использованием инструкций AES-NI (эквивалентный обратный шифр из FIPS 197).                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_aes_decrypt_aesni( ak_skey skey, ak_pointer in, ak_pointer out )
+{
+  size_t r = 0;
+  ak_aes_expanded_keys ekeys = ( ak_aes_expanded_keys )skey->data;
+  __m128i x = _mm_loadu_si128(( const __m128i *)in );
+
+  x = _mm_xor_si128( x, _mm_loadu_si128(( const __m128i *)ekeys->dkey[0] ));
+  x = _mm_xor_si128( x, _mm_loadu_si128(( const __m128i *)ekeys->xkey[0] ));
+  for( r = 1; r < ekeys->rounds; r++ ) {
+     x = _mm_aesdec_si128( x, _mm_loadu_si128(( const __m128i *)ekeys->dkey[r] ));
+     x = _mm_xor_si128( x, _mm_loadu_si128(( const __m128i *)ekeys->xkey[r] ));
+  }
+  x = _mm_aesdeclast_si128( x, _mm_loadu_si128(( const __m128i *)ekeys->dkey[r] ));
+  x = _mm_xor_si128( x, _mm_loadu_si128(( const __m128i *)ekeys->xkey[r] ));
+  _mm_storeu_si128(( __m128i *)out, x );
+}
+ #endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция проверяет возможность использования инструкций AES-NI.
+    \details Наличие инструкций проверяется во время выполнения программы, при первом
+    обращении к функции.                                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_aes_has_aesni( void )
+{
+#if defined( AK_HAVE_BUILTIN_AESENC ) && defined( AK_HAVE_BUILTIN_CPU_SUPPORTS )
+  static int aesni = -1;
+  if( aesni < 0 ) {
+    __builtin_cpu_init();
+    aesni = __builtin_cpu_supports( "aes" ) ? 1 : 0;
+  }
+  if( aesni ) return ak_true;
+#endif
+ return ak_false;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                                функции для работы с контекстом                                  */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция освобождает память, занимаемую развернутыми ключами алгоритма AES.
+    \param skey Указатель на контекст секретного ключа, содержащего развернутые
+    раундовые ключи и маски.
+    \return Функция возвращает \ref ak_error_ok в случае успеха.
+    В противном случае возвращается код ошибки.                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_aes_delete_keys( ak_skey skey )
+{
+  int error = ak_error_ok;
+
+ /* выполняем стандартные проверки */
+  if( skey == NULL ) return ak_error_message( ak_error_null_pointer,
+                                                 __func__ , "using a null pointer to secret key" );
+  if( skey->data != NULL ) {
+   /* теперь очистка и освобождение памяти */
+    if(( error = ak_ptr_wipe( skey->data, sizeof( struct aes_expanded_keys ),
+                                                             &skey->generator )) != ak_error_ok ) {
+      ak_error_message( error, __func__, "incorrect wiping an internal data" );
+      memset( skey->data, 0, sizeof( struct aes_expanded_keys ));
+    }
+    free( skey->data );
+    skey->data = NULL;
+  }
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция реализует развертку ключей для алгоритма AES.
+    \details Вырабатываются раундовые ключи для обеих реализаций алгоритма. Преобразование
+    SubWord вычисляется с помощью тех же битовых срезов, что и при шифровании, поэтому время
+    развертки ключа также не зависит от его значения.
+
+    \param skey Указатель на контекст секретного ключа, в который помещаются развернутые
+    раундовые ключи и маски.
+    \return Функция возвращает \ref ak_error_ok в случае успеха.
+    В противном случае возвращается код ошибки.                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_aes_schedule_keys( ak_skey skey )
+{
+  ak_uint32 q[8];
+  ak_uint8 rkey[15][16], word[16], rcon = 0x01;
+  size_t i = 0, j = 0, nk = 0, rounds = 0;
+  ak_aes_expanded_keys ekeys = NULL;
+
+ /* выполняем стандартные проверки */
+  if( skey == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                            "using a null pointer to secret key" );
+  if(( skey->key_size != 16 ) && ( skey->key_size != 32 ))
+    return ak_error_message( ak_error_wrong_key_length, __func__ ,
+                                                              "unsupported length of secret key" );
+ /* проверяем целостность ключа */
+  if( skey->check_icode( skey ) != ak_true ) return ak_error_message( ak_error_wrong_key_icode,
+                                                __func__ , "using key with wrong integrity code" );
+ /* при повторной развертке используется ранее выделенная память */
+  if( skey->data == NULL ) {
+    if(( skey->data = ak_aligned_malloc( sizeof( struct aes_expanded_keys ))) == NULL )
+      return ak_error_message( ak_error_out_of_memory, __func__ ,
+                                                             "wrong allocation of internal data" );
+  }
+  ekeys = ( ak_aes_expanded_keys )skey->data;
+  nk = skey->key_size >> 2;
+  ekeys->rounds = rounds = nk + 6;
+
+ /* снимаем маску с исходного ключа и вычисляем раундовые ключи согласно FIPS 197 */
+  for( i = 0; i < skey->key_size; i++ )
+     (( ak_uint8 *)rkey)[i] = skey->key[i]^skey->key[skey->key_size+i];
+  memset( word, 0, sizeof( word ));
+  for( i = nk; i < 4*( rounds+1 ); i++ ) {
+     ak_uint8 *wp = ( ak_uint8 *)rkey + 4*( i-1 ), *wn = ( ak_uint8 *)rkey + 4*i;
+
+     if(( i%nk == 0 ) || (( nk > 6 ) && ( i%nk == 4 ))) {
+       if( i%nk == 0 ) { /* RotWord */
+         word[0] = wp[1]; word[1] = wp[2]; word[2] = wp[3]; word[3] = wp[0];
+       } else memcpy( word, wp, 4 );
+      /* SubWord */
+       ak_aes_bitslice( word, q );
+       ak_aes_bitslice_sbox( q );
+       ak_aes_unbitslice( q, word );
+       if( i%nk == 0 ) {
+         word[0] ^= rcon;
+         rcon = ( ak_uint8 )(( rcon << 1 )^( 0x1B&( 0 - ( rcon >> 7 ))));
+       }
+     } else memcpy( word, wp, 4 );
+     for( j = 0; j < 4; j++ ) wn[j] = wn[j - 4*nk]^word[j];
+  }
+
+ /* за один вызов вырабатываем маски для всех форм представления раундовых ключей */
+  skey->generator.random( &skey->generator, ekeys->mkey, sizeof( ekeys->mkey ));
+  skey->generator.random( &skey->generator, ekeys->xkey, sizeof( ekeys->xkey ));
+  skey->generator.random( &skey->generator, ekeys->smask, sizeof( ekeys->smask ));
+
+  for( i = 0; i <= rounds; i++ ) {
+    /* ключи для прямого преобразования */
+     for( j = 0; j < 16; j++ ) ekeys->ekey[i][j] = rkey[i][j]^ekeys->mkey[i][j];
+     ak_aes_bitslice( rkey[i], q );
+     for( j = 0; j < 8; j++ ) ekeys->skey[i][j] = q[j]^ekeys->smask[i][j];
+
+    /* ключи для эквивалентного обратного преобразования */
+     ak_aes_bitslice( rkey[rounds-i], q );
+     if(( i > 0 ) && ( i < rounds )) ak_aes_bitslice_inv_mix_columns( q );
+     ak_aes_unbitslice( q, ekeys->dkey[i] );
+     for( j = 0; j < 16; j++ ) ekeys->dkey[i][j] ^= ekeys->xkey[i][j];
+  }
+
+  ak_ptr_wipe( rkey, sizeof( rkey ), &skey->generator );
+  ak_ptr_wipe( word, sizeof( word ), &skey->generator );
+  ak_ptr_wipe( q, sizeof( q ), &skey->generator );
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция инициализирует контекст ключа алгоритма AES с заданной длиной ключа.  */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_bckey_create_aes( ak_bckey bkey, const size_t key_size, const char *name )
+{
+  int error = ak_error_ok;
+
+  if( bkey == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                               "using null pointer to block cipher key context" );
+ /* создаем ключ алгоритма шифрования и определяем его методы */
+  if(( error = ak_bckey_create( bkey, key_size, 16 )) != ak_error_ok )
+    return ak_error_message( error, __func__, "wrong initalization of block cipher key context" );
+
+ /* устанавливаем OID алгоритма шифрования */
+  if(( bkey->key.oid = ak_oid_find_by_name( name )) == NULL ) {
+    ak_error_message_fmt( error = ak_error_get_value(), __func__,
+                                        "wrong search of predefined %s block cipher OID", name );
+    ak_bckey_destroy( bkey );
+    return error;
+  }
+
+ /* ресурс ключа устанавливается в момент присвоения ключа */
+
+ /* устанавливаем методы */
+  bkey->schedule_keys = ak_aes_schedule_keys;
+  bkey->delete_keys = ak_aes_delete_keys;
+ #ifdef AK_HAVE_BUILTIN_AESENC
+  if( ak_aes_has_aesni( )) {
+    bkey->encrypt = ak_aes_encrypt_aesni;
+    bkey->decrypt = ak_aes_decrypt_aesni;
+  }
+   else
+ #endif
+   {
+     bkey->encrypt = ak_aes_encrypt_bitslice;
+     bkey->decrypt = ak_aes_decrypt_bitslice;
+   }
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! После инициализации устанавливаются обработчики (функции класса). Однако само значение
+    ключу не присваивается - поле `bkey->key` остается неопределенным.
+    Реализация шифрования (на инструкциях AES-NI или переносимая) выбирается во время
+    выполнения программы.
+
+    \param bkey Контекст секретного ключа алгоритма блочного шифрования.
+    \return Функция возвращает код ошибки. В случаее успеха возвращается \ref ak_error_ok.         */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_create_aes128( ak_bckey bkey )
+{
+  return ak_bckey_create_aes( bkey, 16, "aes128" );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \copydetails ak_bckey_create_aes128()                                                          */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_create_aes256( ak_bckey bkey )
+{
+  return ak_bckey_create_aes( bkey, 32, "aes256" );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                                      функции тестирования                                       */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка заданной реализации алгоритма на одном блоке данных. */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_libakrypt_test_aes_kernel( ak_bckey bkey, ak_function_bckey *encrypt,
+              ak_function_bckey *decrypt, ak_uint8 *in, ak_uint8 *out, const char *description )
+{
+  ak_uint8 buffer[16];
+
+  encrypt( &bkey->key, in, buffer );
+  if( !ak_ptr_is_equal_with_log( buffer, out, 16 )) {
+    ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                                                  "the encryption test for %s is wrong", description );
+    return ak_false;
+  }
+  decrypt( &bkey->key, out, buffer );
+  if( !ak_ptr_is_equal_with_log( buffer, in, 16 )) {
+    ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                                                  "the decryption test for %s is wrong", description );
+    return ak_false;
+  }
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка алгоритма на примерах из FIPS 197 и NIST SP 800-38A для заданной длины ключа. */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_libakrypt_test_aes_complete( ak_function_bckey_create *create, const char *name,
+            ak_uint8 *key, ak_uint8 *in, ak_uint8 *out, ak_uint8 *skey, ak_uint8 *ecb_out )
+{
+  struct bckey bkey;
+  ak_uint8 buffer[64];
+  bool_t result = ak_false;
+  int error = ak_error_ok;
+
+ /* открытый текст из приложения F NIST SP 800-38A */
+  ak_uint8 ecb_in[64] = {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+    0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+    0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+
+  if(( error = create( &bkey )) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__, "incorrect initialization of %s secret key", name );
+    return ak_false;
+  }
+  if(( error = ak_bckey_set_key( &bkey, key, bkey.key.key_size )) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__, "incorrect assigning a constant value to %s key", name );
+    goto exit;
+  }
+
+ /* проверяем обе реализации алгоритма: переносимую и, при наличии, на инструкциях AES-NI */
+  if( !ak_libakrypt_test_aes_kernel( &bkey, ak_aes_encrypt_bitslice,
+                                       ak_aes_decrypt_bitslice, in, out, "bitsliced kernel" ))
+    goto exit;
+ #ifdef AK_HAVE_BUILTIN_AESENC
+  if( ak_aes_has_aesni( )) {
+    if( !ak_libakrypt_test_aes_kernel( &bkey, ak_aes_encrypt_aesni,
+                                              ak_aes_decrypt_aesni, in, out, "aes-ni kernel" ))
+      goto exit;
+  }
+ #endif
+  ak_bckey_destroy( &bkey );
+
+ /* теперь проверяем режим простой замены на данных из NIST SP 800-38A */
+  if(( error = create( &bkey )) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__, "incorrect initialization of %s secret key", name );
+    return ak_false;
+  }
+  if(( error = ak_bckey_set_key( &bkey, skey, bkey.key.key_size )) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__, "incorrect assigning a constant value to %s key", name );
+    goto exit;
+  }
+  if(( error = ak_bckey_encrypt_ecb( &bkey, ecb_in, buffer, sizeof( ecb_in ))) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__, "wrong ecb encryption with %s key", name );
+    goto exit;
+  }
+  if( !ak_ptr_is_equal_with_log( buffer, ecb_out, sizeof( buffer ))) {
+    ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                                            "the ecb mode encryption test for %s is wrong", name );
+    goto exit;
+  }
+  if(( error = ak_bckey_decrypt_ecb( &bkey, buffer, buffer, sizeof( buffer ))) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__, "wrong ecb decryption with %s key", name );
+    goto exit;
+  }
+  if( !ak_ptr_is_equal_with_log( buffer, ecb_in, sizeof( buffer ))) {
+    ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                                            "the ecb mode decryption test for %s is wrong", name );
+    goto exit;
+  }
+  result = ak_true;
+
+  exit:
+   ak_bckey_destroy( &bkey );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка режимов шифрования, реализованных в библиотеке, для алгоритма AES-128. */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_libakrypt_test_aes_modes( ak_uint8 *skey )
+{
+  struct bckey bkey;
+  ak_uint8 buffer[64], icode[16];
+  bool_t result = ak_false;
+  int error = ak_error_ok;
+
+ /* режим cbc, пример F.2.1 из NIST SP 800-38A */
+  ak_uint8 cbc_iv[16] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+  ak_uint8 cbc_in[32] = {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+    0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51 };
+  ak_uint8 cbc_out[32] = {
+    0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+    0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2 };
+
+ /* режим ocb, пример из приложения A RFC 7253 */
+  ak_uint8 ocb_key[16] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+  ak_uint8 ocb_iv[12] = {
+    0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x0f };
+  ak_uint8 ocb_in[40] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27 };
+  ak_uint8 ocb_out[40] = {
+    0x44, 0x12, 0x92, 0x34, 0x93, 0xc5, 0x7d, 0x5d, 0xe0, 0xd7, 0x00, 0xf7, 0x53, 0xcc, 0xe0, 0xd1,
+    0xd2, 0xd9, 0x50, 0x60, 0x12, 0x2e, 0x9f, 0x15, 0xa5, 0xdd, 0xbf, 0xc5, 0x78, 0x7e, 0x50, 0xb5,
+    0xcc, 0x55, 0xee, 0x50, 0x7b, 0xcb, 0x08, 0x4e };
+  ak_uint8 ocb_icode[16] = {
+    0x47, 0x9a, 0xd3, 0x63, 0xac, 0x36, 0x6b, 0x95, 0xa9, 0x8c, 0xa5, 0xf3, 0x00, 0x0b, 0x14, 0x79 };
+
+  if(( error = ak_bckey_create_aes128( &bkey )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect initialization of aes128 secret key" );
+
+  if(( error = ak_bckey_set_key( &bkey, skey, 16 )) != ak_error_ok ) {
+    ak_error_message( error, __func__, "incorrect assigning a constant value to aes128 key" );
+    goto exit;
+  }
+  if(( error = ak_bckey_encrypt_cbc( &bkey, cbc_in, buffer, sizeof( cbc_in ),
+                                                      cbc_iv, sizeof( cbc_iv ))) != ak_error_ok ) {
+    ak_error_message( error, __func__, "wrong cbc encryption with aes128 key" );
+    goto exit;
+  }
+  if( !ak_ptr_is_equal_with_log( buffer, cbc_out, sizeof( cbc_out ))) {
+    ak_error_message( ak_error_not_equal_data, __func__ ,
+                                                 "the cbc mode encryption test for aes128 is wrong" );
+    goto exit;
+  }
+  if(( error = ak_bckey_decrypt_cbc( &bkey, buffer, buffer, sizeof( cbc_out ),
+                                                      cbc_iv, sizeof( cbc_iv ))) != ak_error_ok ) {
+    ak_error_message( error, __func__, "wrong cbc decryption with aes128 key" );
+    goto exit;
+  }
+  if( !ak_ptr_is_equal_with_log( buffer, cbc_in, sizeof( cbc_in ))) {
+    ak_error_message( ak_error_not_equal_data, __func__ ,
+                                                 "the cbc mode decryption test for aes128 is wrong" );
+    goto exit;
+  }
+
+  if(( error = ak_bckey_set_key( &bkey, ocb_key, 16 )) != ak_error_ok ) {
+    ak_error_message( error, __func__, "incorrect assigning a constant value to aes128 key" );
+    goto exit;
+  }
+  if(( error = ak_bckey_encrypt_ocb( &bkey, &bkey, NULL, 0, ocb_in, buffer, sizeof( ocb_in ),
+                         ocb_iv, sizeof( ocb_iv ), icode, sizeof( icode ))) != ak_error_ok ) {
+    ak_error_message( error, __func__, "wrong ocb encryption with aes128 key" );
+    goto exit;
+  }
+  if( !ak_ptr_is_equal_with_log( buffer, ocb_out, sizeof( ocb_out ))) {
+    ak_error_message( ak_error_not_equal_data, __func__ ,
+                                                 "the ocb mode encryption test for aes128 is wrong" );
+    goto exit;
+  }
+  if( !ak_ptr_is_equal_with_log( icode, ocb_icode, sizeof( ocb_icode ))) {
+    ak_error_message( ak_error_not_equal_data, __func__ ,
+                                          "the value of ocb integrity code for aes128 is wrong" );
+    goto exit;
+  }
+  result = ak_true;
+
+  exit:
+   ak_bckey_destroy( &bkey );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_libakrypt_test_aes( void )
+{
+  int audit = ak_log_get_level();
+
+ /* примеры из приложения C FIPS 197 */
+  ak_uint8 fips_in[16] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+  ak_uint8 fips_key[32] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f };
+  ak_uint8 fips_out128[16] = {
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a };
+  ak_uint8 fips_out256[16] = {
+    0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf, 0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89 };
+
+ /* ключи и шифртексты из приложения F.1 NIST SP 800-38A */
+  ak_uint8 nist_key128[16] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+  ak_uint8 nist_key256[32] = {
+    0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+    0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+  ak_uint8 nist_out128[64] = {
+    0x3a, 0xd7, 0x7b, 0xb4, 0x0d, 0x7a, 0x36, 0x60, 0xa8, 0x9e, 0xca, 0xf3, 0x24, 0x66, 0xef, 0x97,
+    0xf5, 0xd3, 0xd5, 0x85, 0x03, 0xb9, 0x69, 0x9d, 0xe7, 0x85, 0x89, 0x5a, 0x96, 0xfd, 0xba, 0xaf,
+    0x43, 0xb1, 0xcd, 0x7f, 0x59, 0x8e, 0xce, 0x23, 0x88, 0x1b, 0x00, 0xe3, 0xed, 0x03, 0x06, 0x88,
+    0x7b, 0x0c, 0x78, 0x5e, 0x27, 0xe8, 0xad, 0x3f, 0x82, 0x23, 0x20, 0x71, 0x04, 0x72, 0x5d, 0xd4 };
+  ak_uint8 nist_out256[64] = {
+    0xf3, 0xee, 0xd1, 0xbd, 0xb5, 0xd2, 0xa0, 0x3c, 0x06, 0x4b, 0x5a, 0x7e, 0x3d, 0xb1, 0x81, 0xf8,
+    0x59, 0x1c, 0xcb, 0x10, 0xd4, 0x10, 0xed, 0x26, 0xdc, 0x5b, 0xa7, 0x4a, 0x31, 0x36, 0x28, 0x70,
+    0xb6, 0xed, 0x21, 0xb9, 0x9c, 0xa6, 0xf4, 0xf9, 0xf1, 0x53, 0xe7, 0xb1, 0xbe, 0xaf, 0xed, 0x1d,
+    0x23, 0x30, 0x4b, 0x7a, 0x39, 0xf9, 0xf3, 0xff, 0x06, 0x7d, 0x8d, 0x8f, 0x9e, 0x24, 0xec, 0xc7 };
+
+  if( audit >= ak_log_maximum ) ak_error_message( ak_error_ok, __func__ , ak_aes_has_aesni( ) ?
+                     "aes block cipher uses aes-ni instructions" : "aes block cipher uses bitslicing" );
+
+  if( !ak_libakrypt_test_aes_complete( ak_bckey_create_aes128, "aes128",
+                                fips_key, fips_in, fips_out128, nist_key128, nist_out128 )) {
+    ak_error_message( ak_error_get_value(), __func__, "incorrect testing of aes128 block cipher" );
+    return ak_false;
+  }
+  if( audit >= ak_log_maximum ) ak_error_message( ak_error_ok, __func__ ,
+                                                        "testing of aes128 block cipher is Ok" );
+
+  if( !ak_libakrypt_test_aes_complete( ak_bckey_create_aes256, "aes256",
+                                fips_key, fips_in, fips_out256, nist_key256, nist_out256 )) {
+    ak_error_message( ak_error_get_value(), __func__, "incorrect testing of aes256 block cipher" );
+    return ak_false;
+  }
+  if( audit >= ak_log_maximum ) ak_error_message( ak_error_ok, __func__ ,
+                                                        "testing of aes256 block cipher is Ok" );
+
+  if( !ak_libakrypt_test_aes_modes( nist_key128 )) {
+    ak_error_message( ak_error_get_value(), __func__,
+                                          "incorrect testing of encryption modes for aes128" );
+    return ak_false;
+  }
+  if( audit >= ak_log_maximum ) ak_error_message( ak_error_ok, __func__ ,
+                                       "testing of cbc and ocb modes for aes128 block cipher is Ok" );
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                                                                                       ak_aes.c  */
+/* ----------------------------------------------------------------------------------------------- */
@@ -4,7 +4,11 @@
 /*  Файл ak_bckey.c                                                                                */
 /*  - содержит реализацию общих функций для алгоритмов блочного шифрования.                        */
 /* ----------------------------------------------------------------------------------------------- */
- #include <libakrypt.h>
+ #include <libakrypt-internal.h>
+
+#ifdef AK_HAVE_PTHREAD_H
+ #include <pthread.h>
+#endif
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция устанавливает параметры алгоритма блочного шифрования, передаваемые в качестве
@@ -52,6 +56,7 @@
   bkey->ivector_size =  0;
   bkey->encrypt =       NULL;
   bkey->decrypt =       NULL;
+  bkey->ctr =           NULL;
   bkey->schedule_keys = NULL;
   bkey->delete_keys =   NULL;
 
@@ -86,6 +91,7 @@
   bkey->bsize =            0;
   bkey->encrypt =       NULL;
   bkey->decrypt =       NULL;
+  bkey->ctr =           NULL;
   bkey->schedule_keys = NULL;
   bkey->delete_keys =   NULL;
 
@@ -194,6 +200,40 @@
  return error;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция помещает в контекст ключа новое значение той же длины.
+    \details В отличие от функции ak_bckey_set_key(), функция не перераспределяет память
+    и не обращается к опциям библиотеки: новое значение записывается в уже выделенный буффер,
+    после чего вырабатываются новая маска и контрольная сумма, а раундовые ключи разворачиваются
+    в ранее выделенную память. Ресурс ключа устанавливается вызывающей функцией.
+    Функция используется при частой смене ключа, например, в преобразовании ACPKM и
+    генераторе drbg. Функция не выполняет переворот ключа алгоритма Магма, выполняемый
+    функцией ak_bckey_set_key() в режиме совместимости с openssl.
+
+    @param bkey Контекст ключа, значение которого было ранее установлено.
+    @param new_key Новое значение ключа длины `bkey->key.key_size` октетов.
+    @return Функция возвращает код ошибки. В случае успеха возвращается \ref ak_error_ok.          */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_replace_key( ak_bckey bkey, const ak_uint8 *new_key )
+{
+  int error = ak_error_ok;
+
+  memcpy( bkey->key.key, new_key, bkey->key.key_size );
+  memset( bkey->key.key + bkey->key.key_size, 0, bkey->key.key_size );
+  bkey->key.flags &= ( 0xFFFFFFFFFFFFFFFFLL ^ ak_key_flag_set_mask );
+
+  if(( error = bkey->key.set_mask( &bkey->key )) != ak_error_ok )
+    return ak_error_message( error, __func__ , "wrong secret key masking" );
+  if(( error = bkey->key.set_icode( &bkey->key )) != ak_error_ok )
+    return ak_error_message( error, __func__ , "wrong calculation of integrity code" );
+  if( bkey->schedule_keys != NULL ) {
+    if(( error = bkey->schedule_keys( &bkey->key )) != ak_error_ok )
+      return ak_error_message( error, __func__, "incorrect execution of key scheduling procedure" );
+  }
+
+ return ak_error_ok;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция присваивает контексту ключа алгоритма блочного шифрования случайное (псевдослучайное)
     значение, вырабатываемое заданным генератором случайных (псевдослучайных) чисел.
@@ -583,10 +623,18 @@
     break;
 
     case 16: /* шифр с длиной блока 128 бит (Кузнечик) */
+     /* специализированная реализация сама изменяет значение счетчика */
+      if(( bkey->ctr != NULL ) && ( blocks > 0 )) {
+        bkey->ctr( &bkey->key, bkey->ivector, inptr, outptr, ( size_t ) blocks );
+        inptr += 2*blocks; outptr += 2*blocks;
+        break;
+      }
+     /* значение счетчика хранится в том же порядке октетов, в котором оно записывается ниже;
+        это позволяет продолжать гаммирование при последовательных вызовах функции */
      #ifndef AK_LITTLE_ENDIAN
-      x = bswap_64( ((ak_uint64 *)bkey->ivector)[oc] );
+      x = oc ? ((ak_uint64 *)bkey->ivector)[oc] : bswap_64( ((ak_uint64 *)bkey->ivector)[oc] );
      #else
-      x = ((ak_uint64 *)bkey->ivector)[oc];
+      x = oc ? bswap_64( ((ak_uint64 *)bkey->ivector)[oc] ) : ((ak_uint64 *)bkey->ivector)[oc];
      #endif
 
       while( blocks > 0 ) {
@@ -639,6 +687,404 @@
  return error;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет суммарную длину фрагментов и проверяет, что фрагменты ненулевой длины
+    имеют определенные указатели.
+
+    @param iov Указатель на массив фрагментов; может принимать значение `NULL`,
+    если количество фрагментов равно нулю.
+    @param count Количество фрагментов.
+    @param size Указатель на переменную, в которую помещается суммарная длина фрагментов.
+
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_iov_length( const struct iovec *iov, const size_t count, size_t *size )
+{
+  size_t i = 0, total = 0;
+
+  if(( iov == NULL ) && ( count > 0 )) return ak_error_message( ak_error_null_pointer,
+                                                  __func__, "using null pointer to data fragments" );
+  for( i = 0; i < count; i++ ) {
+     if(( iov[i].iov_base == NULL ) && ( iov[i].iov_len > 0 ))
+       return ak_error_message_fmt( ak_error_null_pointer, __func__,
+                                           "using null pointer to data fragment %u", (unsigned int)i );
+     if(( total + iov[i].iov_len ) < total )
+       return ak_error_message( ak_error_wrong_length, __func__,
+                                                        "total length of fragments is very huge" );
+     total += iov[i].iov_len;
+  }
+  *size = total;
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param cursor Курсор, устанавливаемый на начало последовательности фрагментов.
+    \param iov Указатель на массив фрагментов.
+    \param count Количество фрагментов.                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_iov_cursor_set( ak_iov_cursor cursor, const struct iovec *iov, const size_t count )
+{
+  cursor->iov = iov;
+  cursor->count = count;
+  cursor->offset = 0;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция возвращает указатель на текущее положение курсора и количество октетов,
+    расположенных в памяти последовательно, начиная с этого положения.                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_uint8 *ak_iov_cursor_get( ak_iov_cursor cursor, size_t *size )
+{
+ /* пропускаем полностью обработанные фрагменты и фрагменты нулевой длины */
+  while(( cursor->count > 0 ) && ( cursor->offset >= cursor->iov->iov_len )) {
+    cursor->iov++; cursor->count--; cursor->offset = 0;
+  }
+  if( cursor->count == 0 ) { *size = 0; return NULL; }
+  *size = cursor->iov->iov_len - cursor->offset;
+
+ return (ak_uint8 *)cursor->iov->iov_base + cursor->offset;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция копирует данные между последовательностью фрагментов и областью памяти
+    и перемещает курсор.                                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_iov_cursor_copy( ak_iov_cursor cursor, ak_uint8 *buffer, size_t size, bool_t gather )
+{
+  size_t len = 0;
+  ak_uint8 *ptr = NULL;
+
+  while( size > 0 ) {
+    if(( ptr = ak_iov_cursor_get( cursor, &len )) == NULL )
+      return ak_error_message( ak_error_wrong_length, __func__, "unexpected end of data fragments" );
+    len = ak_min( len, size );
+    if( gather ) memcpy( buffer, ptr, len );
+      else memcpy( ptr, buffer, len );
+    cursor->offset += len; buffer += len; size -= len;
+  }
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param cursor Курсор последовательности фрагментов.
+    \param buffer Область памяти, в которую помещаются данные.
+    \param size Количество копируемых октетов.
+    \return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_iov_cursor_gather( ak_iov_cursor cursor, ak_uint8 *buffer, const size_t size )
+{
+ return ak_iov_cursor_copy( cursor, buffer, size, ak_true );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param cursor Курсор последовательности фрагментов.
+    \param buffer Область памяти, из которой копируются данные.
+    \param size Количество копируемых октетов.
+    \return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_iov_cursor_scatter( ak_iov_cursor cursor, const ak_uint8 *buffer, const size_t size )
+{
+ return ak_iov_cursor_copy( cursor, (ak_uint8 *) buffer, size, ak_false );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция последовательно передает данные, расположенные во фрагментах, функции обработки
+    непрерывной области памяти. Длина каждой передаваемой области кратна длине блока `bsize`,
+    за исключением, возможно, последней области. Если фрагменты содержат непрерывные участки,
+    длина которых больше или равна длине блока, то эти участки обрабатываются без копирования;
+    блоки, расположенные на границе фрагментов, собираются во временном буффере, а результат
+    их обработки раскладывается по выходным фрагментам. Таким образом, результат обработки
+    совпадает с результатом обработки тех же данных, расположенных в памяти последовательно.
+
+    @param in Курсор входных данных.
+    @param out Курсор выходных данных; может принимать значение `NULL` (в этом случае
+    функции обработки передается указатель `NULL` на выходные данные).
+    @param size Количество обрабатываемых октетов.
+    @param bsize Длина блока в октетах (не более 64 октетов).
+    @param func Функция обработки непрерывной области памяти.
+    @param ctx Указатель на параметры, передаваемые функции обработки.
+
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_iov_cursor_process( ak_iov_cursor in, ak_iov_cursor out, size_t size, const size_t bsize,
+                                                            ak_function_iov *func, ak_pointer ctx )
+{
+  ak_uint8 buffer[64];
+  int error = ak_error_ok;
+  size_t len = 0, olen = 0;
+  ak_uint8 *inptr = NULL, *outptr = NULL;
+
+  if(( bsize == 0 ) || ( bsize > sizeof( buffer )))
+    return ak_error_message( ak_error_wrong_length, __func__, "unexpected length of block" );
+
+  while( size > 0 ) {
+    if(( inptr = ak_iov_cursor_get( in, &len )) == NULL )
+      return ak_error_message( ak_error_wrong_length, __func__, "unexpected end of input fragments" );
+    if( out != NULL ) {
+      if(( outptr = ak_iov_cursor_get( out, &olen )) == NULL )
+        return ak_error_message( ak_error_wrong_length, __func__,
+                                                           "unexpected end of output fragments" );
+      len = ak_min( len, olen );
+    }
+    len = ak_min( len, size );
+
+    if( len >= bsize ) { /* непрерывный участок обрабатывается на месте */
+      len -= len%bsize;
+      if(( error = func( ctx, inptr, outptr, len )) != ak_error_ok ) break;
+      in->offset += len;
+      if( out != NULL ) out->offset += len;
+    } else { /* блок на границе фрагментов (или последний неполный блок) */
+       len = ak_min( bsize, size );
+       if(( error = ak_iov_cursor_gather( in, buffer, len )) != ak_error_ok ) break;
+       if(( error = func( ctx, buffer, out ? buffer : NULL, len )) != ak_error_ok ) break;
+       if( out != NULL )
+         if(( error = ak_iov_cursor_scatter( out, buffer, len )) != ak_error_ok ) break;
+      }
+    size -= len;
+  }
+  memset( buffer, 0, sizeof( buffer ));
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Параметры режима гаммирования, передаваемые функции обработки фрагмента. */
+ typedef struct bckey_ctr_iov {
+  /*! \brief Ключ алгоритма блочного шифрования. */
+   ak_bckey bkey;
+  /*! \brief Синхропосылка (используется только при обработке первого фрагмента). */
+   ak_pointer iv;
+  /*! \brief Длина синхропосылки в октетах. */
+   size_t iv_size;
+ } *ak_bckey_ctr_iov_ctx;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция зашифровывает непрерывный фрагмент данных в режиме гаммирования. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_bckey_ctr_iov_update( ak_pointer ptr, const ak_uint8 *in, ak_uint8 *out,
+                                                                                const size_t size )
+{
+  int error = ak_error_ok;
+  ak_bckey_ctr_iov_ctx ctx = ptr;
+
+  error = ak_bckey_ctr( ctx->bkey, (ak_pointer) in, out, size, ctx->iv, ctx->iv_size );
+  ctx->iv = NULL; ctx->iv_size = 0;
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция реализует режим гаммирования ГОСТ Р 34.13-2015 для данных, расположенных
+    в последовательности фрагментов (например, в цепочке буфферов сетевого пакета).
+    Разбиение входных и выходных данных на фрагменты может быть произвольным и не обязано
+    совпадать; результат зашифрования совпадает с результатом функции ak_bckey_ctr(),
+    примененной к тем же данным, расположенным в памяти последовательно.
+
+    @param bkey Ключ алгоритма блочного шифрования.
+    @param in Указатель на массив фрагментов входных данных.
+    @param in_count Количество фрагментов входных данных.
+    @param out Указатель на массив фрагментов выходных данных (может совпадать с `in`);
+    суммарная длина выходных фрагментов должна быть не меньше длины входных данных.
+    @param out_count Количество фрагментов выходных данных.
+    @param iv Указатель на синхропосылку; может принимать значение `NULL` для продолжения
+    зашифрования на ранее установленной синхропосылке.
+    @param iv_size Длина синхропосылки в байтах.
+
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_ctr_iov( ak_bckey bkey, const struct iovec *in, const size_t in_count,
+            const struct iovec *out, const size_t out_count, ak_pointer iv, const size_t iv_size )
+{
+  int error = ak_error_ok;
+  size_t size = 0, osize = 0;
+  struct iov_cursor icur, ocur;
+  struct bckey_ctr_iov ctx;
+
+  if( bkey == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                        "using null pointer to block cipher key" );
+  if(( error = ak_iov_length( in, in_count, &size )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect input fragments" );
+  if(( error = ak_iov_length( out, out_count, &osize )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect output fragments" );
+  if( osize < size ) return ak_error_message( ak_error_wrong_length, __func__,
+                                                      "total length of output fragments is small" );
+  ctx.bkey = bkey; ctx.iv = iv; ctx.iv_size = iv_size;
+
+ /* данные отсутствуют => только устанавливаем синхропосылку */
+  if( size == 0 ) return ak_bckey_ctr( bkey, NULL, NULL, 0, iv, iv_size );
+
+  ak_iov_cursor_set( &icur, in, in_count );
+  ak_iov_cursor_set( &ocur, out, out_count );
+  if(( error = ak_iov_cursor_process( &icur, &ocur, size, bkey->bsize,
+                                              ak_bckey_ctr_iov_update, &ctx )) != ak_error_ok )
+    ak_error_message( error, __func__, "incorrect encryption of data fragments" );
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество блоков, обрабатываемых за один проход при расшифровании
+    в режимах простой замены с зацеплением и гаммирования с обратной связью по шифртексту. */
+ #define ak_bckey_chain_batch_blocks    (8)
+/*! \brief Максимальное количество блоков в регистре синхропосылки (64 октета). */
+ #define ak_bckey_chain_max_register    (8)
+
+#ifdef AK_HAVE_PTHREAD_H
+/*! \brief Максимальное количество потоков, используемых для расшифрования. */
+ #define ak_bckey_chain_max_threads     (64)
+/*! \brief Минимальное количество блоков, обрабатываемых одним потоком. */
+ #define ak_bckey_chain_thread_blocks   (4096)
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Структура, содержащая параметры расшифрования непрерывной последовательности блоков
+    в режимах простой замены с зацеплением и гаммирования с обратной связью по шифртексту.
+
+    \details При расшифровании в обоих режимах открытый текст каждого блока зависит только
+    от уже известных блоков шифртекста, поэтому произвольные последовательности блоков
+    могут обрабатываться независимо друг от друга.                                                 */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct bckey_chain {
+  /*! \brief Ключ алгоритма блочного шифрования. */
+   ak_bckey bkey;
+  /*! \brief Указатель на первый расшифровываемый блок. */
+   ak_uint64 *in;
+  /*! \brief Указатель на область памяти для первого расшифрованного блока. */
+   ak_uint64 *out;
+  /*! \brief Количество расшифровываемых блоков. */
+   size_t blocks;
+  /*! \brief Количество блоков в регистре синхропосылки. */
+   size_t z;
+  /*! \brief Блоки шифртекста (или синхропосылки), предшествующие первому блоку. */
+   ak_uint64 reg[2*ak_bckey_chain_max_register];
+  /*! \brief Флаг режима: ak_true для режима гаммирования с обратной связью по шифртексту. */
+   bool_t cfb;
+ } *ak_bckey_chain;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция расшифровывает последовательность блоков в режимах простой замены
+    с зацеплением и гаммирования с обратной связью по шифртексту.
+
+    \details Блоки обрабатываются группами по \ref ak_bckey_chain_batch_blocks: сначала
+    выполняются независимые друг от друга преобразования блочного шифра, затем
+    результат складывается с соответствующими блоками. Перед записью результата шифртекст
+    группы копируется во внутренний буффер, поэтому допускается совпадение входного и
+    выходного буфферов. По окончании работы поле `reg` содержит последние `z` блоков
+    шифртекста.
+
+    \param ptr Указатель на структуру \ref bckey_chain.
+    \return Функция возвращает NULL.                                                               */
+/* ----------------------------------------------------------------------------------------------- */
+ static void *ak_bckey_chain_decrypt( void *ptr )
+{
+  ak_bckey_chain ctx = ptr;
+  ak_bckey bkey = ctx->bkey;
+  size_t i = 0, n = 0, done = 0, words = bkey->bsize >> 3;
+  ak_uint64 yaout[2*ak_bckey_chain_batch_blocks],
+            hist[2*( ak_bckey_chain_max_register + ak_bckey_chain_batch_blocks )];
+  ak_uint64 *inptr = ctx->in, *outptr = ctx->out;
+
+  memcpy( hist, ctx->reg, ctx->z*bkey->bsize );
+  while( done < ctx->blocks ) {
+    n = ak_min( ctx->blocks - done, ak_bckey_chain_batch_blocks );
+   /* запоминаем шифртекст: блок с номером j зависит от блока hist[j] */
+    memcpy( hist + ctx->z*words, inptr, n*bkey->bsize );
+    if( ctx->cfb ) {
+      for( i = 0; i < n; i++ ) bkey->encrypt( &bkey->key, hist + i*words, yaout + i*words );
+      for( i = 0; i < n*words; i++ ) outptr[i] = yaout[i] ^ hist[ctx->z*words + i];
+    } else {
+      for( i = 0; i < n; i++ ) bkey->decrypt( &bkey->key, hist + ( ctx->z + i )*words,
+                                                                                 yaout + i*words );
+      for( i = 0; i < n*words; i++ ) outptr[i] = yaout[i] ^ hist[i];
+    }
+    memmove( hist, hist + n*words, ctx->z*bkey->bsize );
+    inptr += n*words; outptr += n*words; done += n;
+  }
+  memcpy( ctx->reg, hist, ctx->z*bkey->bsize );
+ /* функция выполняется одновременно в нескольких потоках, поэтому генератор ключа
+    здесь не используется: он изменяется только в вызывающем потоке */
+  memset( yaout, 0, sizeof( yaout ));
+ return NULL;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция расшифровывает данные в режимах простой замены с зацеплением и
+    гаммирования с обратной связью по шифртексту, распределяя блоки между несколькими потоками.
+
+    \details Количество потоков определяется опцией `chain_decrypt_threads`; дополнительные
+    потоки используются только при наличии поддержки потоков и достаточно большом объеме
+    данных. Начальные значения регистров всех потоков вычисляются до начала расшифрования.
+
+    \param bkey Ключ алгоритма блочного шифрования.
+    \param in Указатель на шифртекст.
+    \param out Указатель на область памяти для открытого текста.
+    \param blocks Количество блоков.
+    \param iv Указатель на синхропосылку, содержащую `z` блоков.
+    \param z Количество блоков в синхропосылке.
+    \param cfb Флаг режима гаммирования с обратной связью по шифртексту.
+    \param reg Указатель на область памяти, в которую помещаются последние `z` блоков
+    шифртекста (может принимать значение NULL).                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_bckey_chain_decrypt_blocks( ak_bckey bkey, ak_uint64 *in, ak_uint64 *out,
+                    size_t blocks, ak_pointer iv, size_t z, bool_t cfb, ak_uint64 *reg )
+{
+  struct bckey_chain ctx;
+#ifdef AK_HAVE_PTHREAD_H
+  size_t j = 0, words = bkey->bsize >> 3, idx = 0, part = 0, rest = 0, first = 0,
+         count = ( size_t ) ak_libakrypt_get_option_by_name( "chain_decrypt_threads" );
+  pthread_t threads[ak_bckey_chain_max_threads];
+  struct bckey_chain parts[ak_bckey_chain_max_threads];
+  bool_t started[ak_bckey_chain_max_threads];
+
+  if( count > blocks/ak_bckey_chain_thread_blocks ) count = blocks/ak_bckey_chain_thread_blocks;
+  if( count > ak_bckey_chain_max_threads ) count = ak_bckey_chain_max_threads;
+  if( count > 1 ) {
+    part = blocks/count; rest = blocks%count;
+   /* формируем задания; начальные значения регистров вычисляются до начала расшифрования,
+                                          поскольку входные данные могут быть перезаписаны */
+    for( idx = 0; idx < count; idx++ ) {
+       parts[idx].bkey = bkey;
+       parts[idx].in = in + first*words;
+       parts[idx].out = out + first*words;
+       parts[idx].blocks = part + ( idx < rest ? 1 : 0 );
+       parts[idx].z = z;
+       parts[idx].cfb = cfb;
+       for( j = 0; j < z; j++ ) /* блок с номером first+j-z */
+          memcpy( parts[idx].reg + j*words, ( first + j < z ) ? (ak_uint64 *)iv + ( first + j )*words :
+                                                 in + ( first + j - z )*words, bkey->bsize );
+       first += parts[idx].blocks;
+    }
+    for( idx = 1; idx < count; idx++ )
+       started[idx] = ( pthread_create( threads+idx, NULL,
+                                    ak_bckey_chain_decrypt, parts+idx ) == 0 ) ? ak_true : ak_false;
+    ak_bckey_chain_decrypt( parts );
+    for( idx = 1; idx < count; idx++ ) {
+       if( started[idx] ) pthread_join( threads[idx], NULL );
+        else ak_bckey_chain_decrypt( parts+idx );
+    }
+    if( reg != NULL ) memcpy( reg, parts[count-1].reg, z*bkey->bsize );
+   /* все потоки завершены, генератор ключа используется только вызывающим потоком */
+    for( idx = 0; idx < count; idx++ ) ak_ptr_wipe( parts[idx].reg,
+                                                  sizeof( parts[idx].reg ), &bkey->key.generator );
+    return;
+  }
+#endif
+
+  ctx.bkey = bkey; ctx.in = in; ctx.out = out;
+  ctx.blocks = blocks; ctx.z = z; ctx.cfb = cfb;
+  memcpy( ctx.reg, iv, z*bkey->bsize );
+  ak_bckey_chain_decrypt( &ctx );
+  if( reg != NULL ) memcpy( reg, ctx.reg, z*bkey->bsize );
+  ak_ptr_wipe( ctx.reg, sizeof( ctx.reg ), &bkey->key.generator );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
  int ak_bckey_encrypt_cbc( ak_bckey bkey, ak_pointer in, ak_pointer out, size_t size,
                                                                     ak_pointer iv, size_t iv_size )
@@ -718,8 +1164,7 @@
                                                                     ak_pointer iv, size_t iv_size )
  {
   ak_int64 blocks = 0;
-  ak_uint64 yaout[2], z = iv_size / bkey->bsize;
-  ak_uint64 *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out, *ivector = (ak_uint64 *)bkey->ivector;
+  size_t z = iv_size / bkey->bsize;
   int error = ak_error_ok, oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
 
   if(( oc < 0 ) || ( oc > 1 )) return ak_error_message( ak_error_wrong_option, __func__,
@@ -749,38 +1194,13 @@
                                                              "incorrect length of initial value" );
    memcpy(bkey->ivector, iv, iv_size);
 
- /* теперь приступаем к расшифрованию данных */
-  switch( bkey->bsize ) {
-    case  8: /* шифр с длиной блока 64 бита */
-      while( blocks > 0 ) {
-          bkey->decrypt( &bkey->key, inptr, yaout );
-          if( z == 0 ) {
-              ivector = (ak_uint64 *)in;
-          }
-          *outptr = yaout[0] ^ *ivector; outptr++; ivector++;
-          inptr++;
-          --blocks;
-          --z;
-      }
-    break;
-
-    case 16: /* шифр с длиной блока 128 бит */
-      while( blocks > 0 ) {
-          bkey->decrypt( &bkey->key, inptr, yaout );
-          if( z == 0 ) {
-              ivector = (ak_uint64 *)in;
-          }
-          *outptr = yaout[0] ^ *ivector; outptr++; ivector++;
-          *outptr = yaout[1] ^ *ivector; outptr++; ivector++;
-          inptr+=2;
-          --blocks;
-          --z;
-      }
-
-    break;
-    default: return ak_error_message( ak_error_wrong_block_cipher,
+ /* теперь приступаем к расшифрованию данных:
+    каждый блок открытого текста зависит только от блоков шифртекста */
+  if(( bkey->bsize != 8 ) && ( bkey->bsize != 16 ))
+    return ak_error_message( ak_error_wrong_block_cipher,
                                           __func__ , "incorrect block size of block cipher key" );
-  }
+  ak_bckey_chain_decrypt_blocks( bkey, in, out, ( size_t )blocks, bkey->ivector, z, ak_false, NULL );
+
  /* перемаскируем ключ */
   if(( error = bkey->key.set_mask( &bkey->key )) != ak_error_ok )
     ak_error_message( error, __func__ , "wrong remasking of secret key" );
@@ -987,7 +1407,8 @@
    ak_int64 blocks = (ak_int64)( size/bkey->bsize ),
               tail = (ak_int64)( size%bkey->bsize );
    ak_uint8 *vecptr = NULL;
-   ak_uint64 yaout[2], *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out;
+   ak_uint64 yaout[2], *inptr = (ak_uint64 *)in, *outptr = (ak_uint64 *)out,
+                                                           reg[2*ak_bckey_chain_max_register];
    int error = ak_error_ok, oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
    unsigned long i = 0, z = iv_size / bkey->bsize; // во сколько раз синхрпосылка длиннее блока
 
@@ -1025,7 +1446,20 @@
       bkey->key.flags = ( bkey->key.flags&( ~ak_key_flag_not_ctr ))^ak_key_flag_not_ctr;
      }
 
-  /* обработка основного массива данных (кратного длине блока) */
+  /* обработка основного массива данных (кратного длине блока):
+     если регистр синхропосылки помещается во внутренний буффер, то блоки расшифровываются
+     независимо друг от друга, после чего в буффер помещаются последние блоки шифртекста */
+   if(( z > 0 ) && ( z*bkey->bsize <= sizeof( bkey->ivector )) &&
+                                           (( bkey->bsize == 8 ) || ( bkey->bsize == 16 ))) {
+     ak_bckey_chain_decrypt_blocks( bkey, inptr, outptr,
+                                           ( size_t )blocks, bkey->ivector, z, ak_true, reg );
+     for( i = 0; i < z; i++ ) memcpy( bkey->ivector + (( (unsigned long)blocks + i )%z )*bkey->bsize,
+                                                       reg + i*( bkey->bsize >> 3 ), bkey->bsize );
+     ak_ptr_wipe( reg, sizeof( reg ), &bkey->key.generator );
+     inptr += blocks*( ak_int64 )( bkey->bsize >> 3 );
+     outptr += blocks*( ak_int64 )( bkey->bsize >> 3 );
+     i = ( unsigned long )blocks%z;
+   } else
    switch( bkey->bsize ) {
      case  8: /* шифр с длиной блока 64 бита */
        while( blocks > 0 ) {
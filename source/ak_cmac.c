@@ -4,7 +4,7 @@
 /*  Файл ak_cmac.c                                                                                 */
 /*  - содержит реализацию общих функций для алгоритмов блочного шифрования.                        */
 /* ----------------------------------------------------------------------------------------------- */
- #include <libakrypt.h>
+ #include <libakrypt-internal.h>
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция вычисляет имитовставку от заданной области памяти фиксированного размера.
@@ -353,6 +353,67 @@
 
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция обновляет значение имитовставки непрерывным фрагментом данных. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_bckey_cmac_iov_update( ak_pointer bkey, const ak_uint8 *in, ak_uint8 *out,
+                                                                                const size_t size )
+{
+  (void) out;
+ return ak_bckey_cmac_update( bkey, (ak_pointer) in, size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет имитовставку согласно ГОСТ Р 34.13-2015 от данных, расположенных
+    в последовательности фрагментов (например, в цепочке буфферов сетевого пакета).
+    Результат совпадает с результатом функции ak_bckey_cmac(), примененной к тем же данным,
+    расположенным в памяти последовательно.
+
+    Все полные блоки, кроме последнего, обрабатываются функцией ak_bckey_cmac_update()
+    (непрерывные участки фрагментов - без копирования), последний блок собирается
+    во временном буффере и передается функции ak_bckey_cmac_finalize().
+
+   @param bkey Ключ алгоритма блочного шифрования, используемый для выработки имитовставки.
+   @param in Указатель на массив фрагментов входных данных.
+   @param count Количество фрагментов.
+   @param out Область памяти, куда будет помещен результат.
+   @param out_size Ожидаемый размер имитовставки.
+
+   @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+   возвращается \ref ak_error_ok (ноль)                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_cmac_iov( ak_bckey bkey, const struct iovec *in, const size_t count,
+                                                           ak_pointer out, const size_t out_size )
+{
+  ak_uint8 last[16];
+  struct iov_cursor cursor;
+  int error = ak_error_ok;
+  size_t size = 0, tail = 0;
+
+  if( bkey == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                        "using null pointer to block cipher key" );
+  if(( error = ak_iov_length( in, count, &size )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect input fragments" );
+  if( !size ) return ak_error_message( ak_error_zero_length, __func__,
+                                                                 "using a data with zero length" );
+  if( bkey->bsize > sizeof( last )) return ak_error_message( ak_error_wrong_block_cipher,
+                                                 __func__, "using key with very large block size" );
+ /* последний блок всегда существует */
+  if(( tail = size%bkey->bsize ) == 0 ) tail = bkey->bsize;
+
+  ak_iov_cursor_set( &cursor, in, count );
+  if(( error = ak_bckey_cmac_clean( bkey )) != ak_error_ok ) goto exit;
+  if(( error = ak_iov_cursor_process( &cursor, NULL, size - tail, bkey->bsize,
+                                        ak_bckey_cmac_iov_update, bkey )) != ak_error_ok ) goto exit;
+  if(( error = ak_iov_cursor_gather( &cursor, last, tail )) != ak_error_ok ) goto exit;
+  error = ak_bckey_cmac_finalize( bkey, last, tail, out, out_size );
+
+  exit:
+   if( error != ak_error_ok ) ak_error_message( error, __func__, "incorrect data fragments" );
+   memset( last, 0, sizeof( last ));
+ return error;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция реализует последовательную комбинацию режимов из ГОСТ Р 34.12-2015. В начале
     вычисляется имитовставка от объединения ассоциированных данных и
@@ -4,7 +4,7 @@
 /*  Файл ak_curves.с                                                                               */
 /*  - содержит реализацию функций для работы с эллиптическими кривыми.                             */
 /* ----------------------------------------------------------------------------------------------- */
- #include <libakrypt.h>
+ #include <libakrypt-internal.h>
 
 /* ----------------------------------------------------------------------------------------------- */
 #ifdef AK_HAVE_STRING_H
@@ -15,6 +15,14 @@
 #ifdef AK_HAVE_STRINGS_H
  #include <strings.h>
 #endif
+#ifdef AK_HAVE_STDLIB_H
+ #include <stdlib.h>
+#else
+ #error Library cannot be compiled without stdlib.h header
+#endif
+#ifdef AK_HAVE_PTHREAD_H
+ #include <pthread.h>
+#endif
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция вычисляет величину \f$\Delta \equiv -16(4a^3 + 27b^2) \pmod{p} \f$, зависящую
@@ -82,7 +90,7 @@
 /* ----------------------------------------------------------------------------------------------- */
  int ak_wcurve_check_order_parameters( ak_wcurve ec )
 {
-  ak_mpzn512 r, s, t;
+  ak_mpzn512 s, t;
   struct random generator;
 
   ak_random_create_lcg( &generator );
@@ -90,9 +98,7 @@
   ak_mpzn_rem( t, t, ec->q, ec->size );
   ak_random_destroy( &generator );
 
-  ak_mpzn_set_ui( r, ec->size, 2 );
-  ak_mpzn_sub( r, ec->q, r, ec->size );
-  ak_mpzn_modpow_montgomery( s, t, r, ec->q, ec->nq, ec->size );
+  ak_mpzn_inverse_montgomery_var( s, t, ec->q, ec->nq, ec->r2q, ec->size );
   ak_mpzn_mul_montgomery( t, s, t, ec->q, ec->nq, ec->size );
 
   ak_mpzn_mul_montgomery( t, t, ec->r2q, ec->q, ec->nq, ec->size );
@@ -250,9 +256,59 @@
  return ak_error_ok;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка соответствия параметров кривой Эдвардса параметрам кривой в форме Вейерштрасса.
+
+    Для \f$ e = 1 \f$ проверяются равенства \f$ 4s + d = 1 \f$, \f$ 6t - d = 1 \f$, а также
+    \f$ a = s^2 - 3t^2 \f$ и \f$ b = 2t^3 - ts^2 \f$.
+    \return Функция возвращает \ref ak_true, если все равенства выполнены.                        */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_wcurve_edwards_is_ok( const struct wcurve_edwards *ep )
+{
+  ak_wcurve ec = ( ak_wcurve )ep->wc;
+  ak_mpznmax d, s, t, u, v, one;
+
+  ak_mpzn_mul_montgomery( d, ( ak_uint64 * )ep->d, ec->r2, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( s, ( ak_uint64 * )ep->s, ec->r2, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( t, ( ak_uint64 * )ep->t, ec->r2, ec->p, ec->n, ec->size );
+  ak_mpzn_set_ui( one, ec->size, 0 );
+  ak_mpzn_sub( one, one, ec->p, ec->size );
+
+ /* 4s + d = 1 */
+  ak_mpzn_lshift_montgomery( u, s, ec->p, ec->size );
+  ak_mpzn_lshift_montgomery( u, u, ec->p, ec->size );
+  ak_mpzn_add_montgomery( u, u, d, ec->p, ec->size );
+  if( ak_mpzn_cmp( u, one, ec->size ) != 0 ) return ak_false;
+
+ /* 6t = 1 + d */
+  ak_mpzn_lshift_montgomery( u, t, ec->p, ec->size );
+  ak_mpzn_add_montgomery( v, u, t, ec->p, ec->size );
+  ak_mpzn_lshift_montgomery( v, v, ec->p, ec->size );
+  ak_mpzn_add_montgomery( u, one, d, ec->p, ec->size );
+  if( ak_mpzn_cmp( u, v, ec->size ) != 0 ) return ak_false;
+
+ /* a + 3t^2 = s^2 */
+  ak_mpzn_sqr_montgomery( u, t, ec->p, ec->n, ec->size );
+  ak_mpzn_lshift_montgomery( v, u, ec->p, ec->size );
+  ak_mpzn_add_montgomery( v, v, u, ec->p, ec->size );
+  ak_mpzn_add_montgomery( v, v, ec->a, ec->p, ec->size );
+  ak_mpzn_sqr_montgomery( d, s, ec->p, ec->n, ec->size );
+  if( ak_mpzn_cmp( v, d, ec->size ) != 0 ) return ak_false;
+
+ /* b + ts^2 = 2t^3 */
+  ak_mpzn_mul_montgomery( d, d, t, ec->p, ec->n, ec->size );
+  ak_mpzn_add_montgomery( d, d, ec->b, ec->p, ec->size );
+  ak_mpzn_mul_montgomery( u, u, t, ec->p, ec->n, ec->size );
+  ak_mpzn_lshift_montgomery( u, u, ec->p, ec->size );
+  if( ak_mpzn_cmp( u, d, ec->size ) != 0 ) return ak_false;
+
+ return ak_true;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Проверяются параметры всех эллиптических кривых, доступных через механизм OID.
-    Проверка производится путем вызова функции ak_wcurve_is_ok().
+    Проверка производится путем вызова функции ak_wcurve_is_ok(). Также проверяется
+    корректность параметров эквивалентных кривых Эдвардса.
 
     @return Возвращает ak_true в случае успешного тестирования. В случае возникновения
     ошибки функция возвращает ak_false. Код ошибки можеть быть получен с помощью вызова
@@ -262,6 +318,7 @@
 {
   ak_oid oid = NULL;
   bool_t result = ak_true;
+  const struct wcurve_edwards *ep = NULL;
   int reason = ak_error_ok, audit = ak_log_get_level();
 
   if( audit >= ak_log_maximum )
@@ -304,6 +361,18 @@
     oid = ak_oid_findnext_by_engine( oid, identifier );
   }
 
+ /* проверяем параметры кривых Эдвардса */
+  for( ep = ak_wcurve_edwards_params; ep->wc != NULL; ep++ ) {
+    if( !ak_wcurve_edwards_is_ok( ep )) {
+      ak_error_message( ak_error_curve_discriminant, __func__,
+                                        "incorrect parameters of equivalent Edwards curve" );
+      result = ak_false;
+      goto lab_exit;
+    }
+  }
+  if( audit > ak_log_standard )
+    ak_error_message( ak_error_ok, __func__ , "parameters of equivalent Edwards curves are Ok" );
+
  lab_exit:
   if( !result ) ak_error_message( ak_error_get_value(), __func__ ,
                                                           "incorrect testing Weierstrass curves" );
@@ -399,16 +468,16 @@
   ak_mpzn_add_montgomery( t, t, s, ec->p, ec->size ); // теперь в t величина (ax+bz)
 
   ak_mpzn_set( s, wp->z, ec->size );
-  ak_mpzn_mul_montgomery( s, s, s, ec->p, ec->n, ec->size );
+  ak_mpzn_sqr_montgomery( s, s, ec->p, ec->n, ec->size );
   ak_mpzn_mul_montgomery( t, t, s, ec->p, ec->n, ec->size ); // теперь в t величина (ax+bz)z^2
 
   ak_mpzn_set( s, wp->x, ec->size );
-  ak_mpzn_mul_montgomery( s, s, s, ec->p, ec->n, ec->size );
+  ak_mpzn_sqr_montgomery( s, s, ec->p, ec->n, ec->size );
   ak_mpzn_mul_montgomery( s, s, wp->x, ec->p, ec->n, ec->size );
   ak_mpzn_add_montgomery( t, t, s, ec->p, ec->size ); // теперь в t величина x^3 + (ax+bz)z^2
 
   ak_mpzn_set( s, wp->y, ec->size );
-  ak_mpzn_mul_montgomery( s, s, s, ec->p, ec->n, ec->size );
+  ak_mpzn_sqr_montgomery( s, s, ec->p, ec->n, ec->size );
   ak_mpzn_mul_montgomery( s, s, wp->z, ec->p, ec->n, ec->size ); // теперь в s величина x^3 + (ax+bz)z^2
 
   if( ak_mpzn_cmp( t, s, ec->size )) return ak_false;
@@ -451,8 +520,8 @@
    return;
  }
  // dbl-2007-bl
- ak_mpzn_mul_montgomery( u1, wp->x, wp->x, ec->p, ec->n, ec->size );
- ak_mpzn_mul_montgomery( u2, wp->z, wp->z, ec->p, ec->n, ec->size );
+ ak_mpzn_sqr_montgomery( u1, wp->x, ec->p, ec->n, ec->size );
+ ak_mpzn_sqr_montgomery( u2, wp->z, ec->p, ec->n, ec->size );
  ak_mpzn_lshift_montgomery( u4, u1, ec->p, ec->size );
  ak_mpzn_add_montgomery( u4, u4, u1, ec->p, ec->size );
  ak_mpzn_mul_montgomery( u3, u2, ec->a, ec->p, ec->n, ec->size );
@@ -464,7 +533,7 @@
  ak_mpzn_mul_montgomery( u7, u6, wp->x, ec->p, ec->n, ec->size ); // u7 = 8xy^2z
  ak_mpzn_lshift_montgomery( u1, u7, ec->p, ec->size );
  ak_mpzn_sub( u1, ec->p, u1, ec->size );
- ak_mpzn_mul_montgomery( u2, u3, u3, ec->p, ec->n, ec->size );
+ ak_mpzn_sqr_montgomery( u2, u3, ec->p, ec->n, ec->size );
  ak_mpzn_add_montgomery( u2, u2, u1, ec->p, ec->size );
  ak_mpzn_mul_montgomery( wp->x, u2, u4, ec->p, ec->n, ec->size );
  ak_mpzn_mul_montgomery( u6, u6, u5, ec->p, ec->n, ec->size );
@@ -473,7 +542,7 @@
  ak_mpzn_add_montgomery( u2, u2, u7, ec->p, ec->size );
  ak_mpzn_mul_montgomery( wp->y, u2, u3, ec->p, ec->n, ec->size );
  ak_mpzn_add_montgomery( wp->y, wp->y, u6, ec->p, ec->size );
- ak_mpzn_mul_montgomery( wp->z, u4, u4, ec->p, ec->n, ec->size );
+ ak_mpzn_sqr_montgomery( wp->z, u4, ec->p, ec->n, ec->size );
  ak_mpzn_mul_montgomery( wp->z, wp->z, u4, ec->p, ec->n, ec->size );
 }
 
@@ -540,11 +609,11 @@
   ak_mpzn_mul_montgomery( u3, wp1->z, wp2->z, ec->p, ec->n, ec->size );
   ak_mpzn_mul_montgomery( u4, wp2->y, wp1->z, ec->p, ec->n, ec->size );
   ak_mpzn_add_montgomery( u4, u4, u2, ec->p, ec->size );
-  ak_mpzn_mul_montgomery( u5, u4, u4, ec->p, ec->n, ec->size );
+  ak_mpzn_sqr_montgomery( u5, u4, ec->p, ec->n, ec->size );
   ak_mpzn_sub( u7, ec->p, u1, ec->size );
   ak_mpzn_mul_montgomery( wp1->x, wp2->x, wp1->z, ec->p, ec->n, ec->size );
   ak_mpzn_add_montgomery( wp1->x, wp1->x, u7, ec->p, ec->size );
-  ak_mpzn_mul_montgomery( u7, wp1->x, wp1->x, ec->p, ec->n, ec->size );
+  ak_mpzn_sqr_montgomery( u7, wp1->x, ec->p, ec->n, ec->size );
   ak_mpzn_mul_montgomery( u6, u7, wp1->x, ec->p, ec->n, ec->size);
   ak_mpzn_mul_montgomery( u1, u7, u1, ec->p, ec->n, ec->size );
   ak_mpzn_lshift_montgomery( u7, u1, ec->p, ec->size );
@@ -577,9 +646,7 @@
    return;
  }
 
- ak_mpzn_set_ui( u, ec->size, 2 );
- ak_mpzn_sub( u, ec->p, u, ec->size );
- ak_mpzn_modpow_montgomery( u, wp->z, u, ec->p, ec->n, ec->size ); // u <- z^{p-2} (mod p)
+ ak_mpzn_inverse_montgomery( u, wp->z, ec->p, ec->n, ec->r2, ec->size ); // u <- z^{-1} (mod p)
  ak_mpzn_mul_montgomery( u, u, one, ec->p, ec->n, ec->size );
 
  ak_mpzn_mul_montgomery( wp->x, wp->x, u, ec->p, ec->n, ec->size );
@@ -587,6 +654,309 @@
  ak_mpzn_set_ui( wp->z, ec->size, 1 );
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*           вычисления в расширенных координатах эквивалентной искривленной кривой Эдвардса        */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Точка искривленной кривой Эдвардса \f$ u^2 + v^2 = 1 + du^2v^2 \f$ в расширенных
+    координатах \f$ (X:Y:T:Z) \f$, где \f$ u = X/Z, v = Y/Z \f$ и \f$ T = XY/Z \f$.
+    Координаты точки хранятся в представлении Монтгомери.                                          */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct epoint {
+  /*! \brief X-координата точки */
+   ak_uint64 x[ak_mpzn512_size];
+  /*! \brief Y-координата точки */
+   ak_uint64 y[ak_mpzn512_size];
+  /*! \brief T-координата точки */
+   ak_uint64 t[ak_mpzn512_size];
+  /*! \brief Z-координата точки */
+   ak_uint64 z[ak_mpzn512_size];
+ } *ak_epoint;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Параметры кривой Эдвардса в представлении Монтгомери. */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct ecurve {
+  /*! \brief Коэффициент \f$ d \f$ кривой Эдвардса. */
+   ak_mpznmax d;
+  /*! \brief Константа \f$ s \f$ перехода между формами кривой. */
+   ak_mpznmax s;
+  /*! \brief Константа \f$ t \f$ перехода между формами кривой. */
+   ak_mpznmax t;
+ } *ak_ecurve;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Присвоение вычету значения единицы в представлении Монтгомери, т.е. \f$ r \pmod{p} \f$. */
+ static inline void ak_wcurve_set_montgomery_one( ak_uint64 *one, ak_wcurve ec )
+{
+  ak_mpzn_set_ui( one, ec->size, 0 );
+  ak_mpzn_sub( one, one, ec->p, ec->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычитание вычетов в представлении Монтгомери, \f$ r = a - b \pmod{p} \f$. */
+ static inline void ak_mpzn_sub_montgomery( ak_uint64 *r, ak_uint64 *a, ak_uint64 *b, ak_wcurve ec )
+{
+  ak_mpznmax u;
+
+  ak_mpzn_sub( u, ec->p, b, ec->size );
+  ak_mpzn_add_montgomery( r, a, u, ec->p, ec->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Поиск параметров кривой Эдвардса, эквивалентной заданной кривой в форме Вейерштрасса.
+
+    Кривая ищется в массиве ak_wcurve_edwards_params по значениям \f$ p, a, b \f$, поэтому
+    совпадение определяется и для копий контекстов кривых.
+    \return Функция возвращает \ref ak_true, если кривая найдена; в этом случае ее параметры
+    переводятся в представление Монтгомери и помещаются в `ed`.                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_wcurve_get_ecurve( ak_wcurve ec, ak_ecurve ed )
+{
+  const struct wcurve_edwards *ep = NULL;
+  size_t len = ec->size*sizeof( ak_uint64 );
+
+  for( ep = ak_wcurve_edwards_params; ep->wc != NULL; ep++ ) {
+     if( ep->wc->size != ec->size ) continue;
+     if( ep->wc != ec ) {
+       if( memcmp( ep->wc->p, ec->p, len ) != 0 ) continue;
+       if( memcmp( ep->wc->a, ec->a, len ) != 0 ) continue;
+       if( memcmp( ep->wc->b, ec->b, len ) != 0 ) continue;
+     }
+     ak_mpzn_mul_montgomery( ed->d, ( ak_uint64 * )ep->d, ec->r2, ec->p, ec->n, ec->size );
+     ak_mpzn_mul_montgomery( ed->s, ( ak_uint64 * )ep->s, ec->r2, ec->p, ec->n, ec->size );
+     ak_mpzn_mul_montgomery( ed->t, ( ak_uint64 * )ep->t, ec->r2, ec->p, ec->n, ec->size );
+     return ak_true;
+  }
+ return ak_false;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Присвоение точке кривой Эдвардса значения нейтрального элемента \f$ (0:1:0:1) \f$. */
+ static inline void ak_epoint_set_as_unit( ak_epoint ep, ak_wcurve ec )
+{
+  ak_mpzn_set_ui( ep->x, ec->size, 0 );
+  ak_mpzn_set_ui( ep->t, ec->size, 0 );
+  ak_wcurve_set_montgomery_one( ep->y, ec );
+  ak_wcurve_set_montgomery_one( ep->z, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Переход от точки \f$ (x:y:z) \f$ кривой в форме Вейерштрасса к точке кривой Эдвардса.
+
+    Используются соотношения \f$ u = (x-tz)/y \f$, \f$ v = (x - tz - sz)/(x - tz + sz) \f$.
+    Бесконечно удаленная точка переходит в нейтральный элемент \f$ (0:1:0:1) \f$, точка
+    второго порядка \f$ (t:0:1) \f$ - в точку \f$ (0:-1:0:1) \f$.                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_epoint_set_wpoint( ak_epoint ep, ak_wpoint wp, ak_ecurve ed, ak_wcurve ec )
+{
+  ak_mpznmax a1, a2, a3;
+
+  if( ak_mpzn_cmp_ui( wp->z, ec->size, 0 ) == ak_true ) {
+    ak_epoint_set_as_unit( ep, ec );
+    return;
+  }
+  if( ak_mpzn_cmp_ui( wp->y, ec->size, 0 ) == ak_true ) {
+    ak_epoint_set_as_unit( ep, ec );
+    ak_mpzn_sub( ep->y, ec->p, ep->y, ec->size );
+    return;
+  }
+
+  ak_mpzn_mul_montgomery( a3, ed->t, wp->z, ec->p, ec->n, ec->size );
+  ak_mpzn_sub_montgomery( a1, wp->x, a3, ec );                 // a1 = x - tz
+  ak_mpzn_mul_montgomery( a3, ed->s, wp->z, ec->p, ec->n, ec->size );
+  ak_mpzn_add_montgomery( a2, a1, a3, ec->p, ec->size );       // a2 = x - tz + sz
+  ak_mpzn_sub_montgomery( a3, a1, a3, ec );                    // a3 = x - tz - sz
+
+  ak_mpzn_mul_montgomery( ep->x, a1, a2, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( ep->t, a1, a3, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( ep->z, wp->y, a2, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( ep->y, wp->y, a3, ec->p, ec->n, ec->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Переход от точки кривой Эдвардса к точке \f$ (x:y:z) \f$ кривой в форме Вейерштрасса.
+
+    Используются соотношения \f$ x = s(1+v)/(1-v) + t \f$, \f$ y = s(1+v)/((1-v)u) \f$.          */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wpoint_set_epoint( ak_wpoint wp, ak_epoint ep, ak_ecurve ed, ak_wcurve ec )
+{
+  ak_mpznmax zp, zm, u;
+
+  if( ak_mpzn_cmp_ui( ep->x, ec->size, 0 ) == ak_true ) {
+    if( ak_mpzn_cmp( ep->y, ep->z, ec->size ) == 0 ) ak_wpoint_set_as_unit( wp, ec );
+     else {
+       memcpy( wp->x, ed->t, ec->size*sizeof( ak_uint64 ));
+       ak_mpzn_set_ui( wp->y, ec->size, 0 );
+       ak_wcurve_set_montgomery_one( wp->z, ec );
+     }
+    return;
+  }
+
+  ak_mpzn_add_montgomery( zp, ep->z, ep->y, ec->p, ec->size );  // zp = z + y
+  ak_mpzn_sub_montgomery( zm, ep->z, ep->y, ec );               // zm = z - y
+  ak_mpzn_mul_montgomery( zp, zp, ed->s, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( u, zm, ed->t, ec->p, ec->n, ec->size );
+  ak_mpzn_add_montgomery( u, u, zp, ec->p, ec->size );
+  ak_mpzn_mul_montgomery( wp->y, zp, ep->z, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( wp->z, zm, ep->x, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( wp->x, u, ep->x, ec->p, ec->n, ec->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Удвоение точки кривой Эдвардса (формулы dbl-2008-hwcd).
+
+    Формулы не содержат исключительных случаев и требуют выполнения четырех умножений
+    и четырех возведений в квадрат.                                                                */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_epoint_double( ak_epoint ep, ak_wcurve ec )
+{
+  ak_mpznmax a, b, c, e, f, g, h;
+
+  ak_mpzn_sqr_montgomery( a, ep->x, ec->p, ec->n, ec->size );
+  ak_mpzn_sqr_montgomery( b, ep->y, ec->p, ec->n, ec->size );
+  ak_mpzn_sqr_montgomery( c, ep->z, ec->p, ec->n, ec->size );
+  ak_mpzn_lshift_montgomery( c, c, ec->p, ec->size );           // c = 2z^2
+  ak_mpzn_add_montgomery( e, ep->x, ep->y, ec->p, ec->size );
+  ak_mpzn_sqr_montgomery( e, e, ec->p, ec->n, ec->size );
+  ak_mpzn_add_montgomery( g, a, b, ec->p, ec->size );           // g = a + b
+  ak_mpzn_sub_montgomery( e, e, g, ec );                        // e = (x+y)^2 - a - b
+  ak_mpzn_sub_montgomery( f, g, c, ec );                        // f = g - c
+  ak_mpzn_sub_montgomery( h, a, b, ec );                        // h = a - b
+
+  ak_mpzn_mul_montgomery( ep->x, e, f, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( ep->y, g, h, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( ep->t, e, h, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( ep->z, f, g, ec->p, ec->n, ec->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Завершение сложения точек кривой Эдвардса по известным значениям
+    \f$ A = X_1X_2, B = Y_1Y_2, C = dT_1T_2, D = Z_1Z_2 \f$ и \f$ E = (X_1+Y_1)(X_2+Y_2) \f$.   */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_epoint_add_finish( ak_epoint ep1, ak_uint64 *a, ak_uint64 *b,
+                                          ak_uint64 *c, ak_uint64 *d, ak_uint64 *e, ak_wcurve ec )
+{
+  ak_mpznmax f, g, h;
+
+  ak_mpzn_add_montgomery( h, a, b, ec->p, ec->size );
+  ak_mpzn_sub_montgomery( e, e, h, ec );                        // e = (x1+y1)(x2+y2) - a - b
+  ak_mpzn_sub_montgomery( f, d, c, ec );                        // f = d - c
+  ak_mpzn_add_montgomery( g, d, c, ec->p, ec->size );           // g = d + c
+  ak_mpzn_sub_montgomery( h, b, a, ec );                        // h = b - a
+
+  ak_mpzn_mul_montgomery( ep1->x, e, f, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( ep1->y, g, h, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( ep1->t, e, h, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( ep1->z, f, g, ec->p, ec->n, ec->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Прибавление к точке \f$ P_1 \f$ кривой Эдвардса точки \f$ P_2 \f$ (формулы add-2008-hwcd).
+
+    Поскольку коэффициент \f$ d \f$ не является квадратом, формулы сложения полны: они
+    корректны для любых точек кривой, в том числе совпадающих и противоположных, и не требуют
+    проверки исключительных случаев.                                                               */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_epoint_add( ak_epoint ep1, ak_epoint ep2, ak_ecurve ed, ak_wcurve ec )
+{
+  ak_mpznmax a, b, c, d, e, u;
+
+  ak_mpzn_mul_montgomery( a, ep1->x, ep2->x, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( b, ep1->y, ep2->y, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( c, ep1->t, ep2->t, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( c, c, ed->d, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( d, ep1->z, ep2->z, ec->p, ec->n, ec->size );
+  ak_mpzn_add_montgomery( e, ep1->x, ep1->y, ec->p, ec->size );
+  ak_mpzn_add_montgomery( u, ep2->x, ep2->y, ec->p, ec->size );
+  ak_mpzn_mul_montgomery( e, e, u, ec->p, ec->n, ec->size );
+  ak_epoint_add_finish( ep1, a, b, c, d, e, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Прибавление к точке кривой Эдвардса точки, заданной тройкой \f$ (u, v, duv) \f$
+    в представлении Монтгомери; по сравнению с функцией ak_epoint_add() экономятся два умножения. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_epoint_add_affine( ak_epoint ep1, ak_uint64 *u2, ak_uint64 *v2,
+                                                                   ak_uint64 *w2, ak_wcurve ec )
+{
+  ak_mpznmax a, b, c, e, u;
+
+  ak_mpzn_mul_montgomery( a, ep1->x, u2, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( b, ep1->y, v2, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( c, ep1->t, w2, ec->p, ec->n, ec->size );
+  ak_mpzn_add_montgomery( e, ep1->x, ep1->y, ec->p, ec->size );
+  ak_mpzn_add_montgomery( u, u2, v2, ec->p, ec->size );
+  ak_mpzn_mul_montgomery( e, e, u, ec->p, ec->n, ec->size );
+  ak_epoint_add_finish( ep1, a, b, c, ep1->z, e, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Одновременное приведение массива точек кривой Эдвардса к аффинной форме.
+
+    Для точки с номером \f$ i \f$ в массив `table` со смещением \f$ 3i\cdot size \f$ помещаются
+    значения \f$ u, v, duv \f$ в представлении Монтгомери, используемые функцией
+    ak_epoint_add_affine(). Для всех точек вычисляется только один обратный элемент.              */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_epoint_reduce_to_table( ak_uint64 *table, ak_epoint ep,
+                                              const size_t count, ak_ecurve ed, ak_wcurve ec )
+{
+  size_t i, size = ec->size;
+  ak_mpznmax u, inv;
+  ak_uint64 *prod = NULL, *cell = NULL;
+
+  if(( prod = malloc( count*size*sizeof( ak_uint64 ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+
+  memcpy( prod, ep[0].z, size*sizeof( ak_uint64 ));
+  for( i = 1; i < count; i++ )
+     ak_mpzn_mul_montgomery( prod + i*size, prod + (i-1)*size, ep[i].z, ec->p, ec->n, size );
+  ak_mpzn_inverse_montgomery( inv, prod + (count-1)*size, ec->p, ec->n, ec->r2, size );
+
+  for( i = count; i > 0; i-- ) {
+     if( i > 1 ) {
+       ak_mpzn_mul_montgomery( u, inv, prod + (i-2)*size, ec->p, ec->n, size );
+       ak_mpzn_mul_montgomery( inv, inv, ep[i-1].z, ec->p, ec->n, size );
+     } else memcpy( u, inv, size*sizeof( ak_uint64 ));
+     cell = table + 3*(i-1)*size;
+     ak_mpzn_mul_montgomery( cell, ep[i-1].x, u, ec->p, ec->n, size );
+     ak_mpzn_mul_montgomery( cell + size, ep[i-1].y, u, ec->p, ec->n, size );
+     ak_mpzn_mul_montgomery( cell + 2*size, ep[i-1].t, u, ec->p, ec->n, size );
+     ak_mpzn_mul_montgomery( cell + 2*size, cell + 2*size, ed->d, ec->p, ec->n, size );
+  }
+
+  free( prod );
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление кратной точки \f$ Q = [k]P \f$ на эквивалентной кривой Эдвардса.
+
+    Используется та же лесенка Монтгомери, что и в функции ak_wpoint_pow(), однако
+    вычисления выполняются с помощью полных формул сложения и удвоения.                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_epoint_pow( ak_wpoint wq, ak_wpoint wp, ak_uint64 *k, size_t size,
+                                                                   ak_ecurve ed, ak_wcurve ec )
+{
+  ak_uint64 uk = 0;
+  long long int i, j;
+  struct epoint Q, R;
+
+  ak_epoint_set_as_unit( &Q, ec );
+  ak_epoint_set_wpoint( &R, wp, ed, ec );
+
+  for( i = size-1; i >= 0; i-- ) {
+     uk = k[i];
+     for( j = 0; j < 64; j++ ) {
+       if( uk&0x8000000000000000LL ) { ak_epoint_add( &Q, &R, ed, ec ); ak_epoint_double( &R, ec ); }
+        else { ak_epoint_add( &R, &Q, ed, ec ); ak_epoint_double( &Q, ec ); }
+       uk <<= 1;
+     }
+  }
+  ak_wpoint_set_epoint( wq, &Q, ed, ec );
+  memset( &Q, 0, sizeof( struct epoint ));
+  memset( &R, 0, sizeof( struct epoint ));
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Для заданной точки \f$ P = (x:y:z) \f$ и заданного целого числа (вычета) \f$ k \f$
     функция вычисляет кратную точку \f$ Q \f$, удовлетворяющую
@@ -595,6 +965,11 @@
     При вычислении используется метод `лесенки Монтгомери`, выравнивающий время работы алгоритма
     вне зависимости от вида числа \f$ k \f$.
 
+    Для кривых, эквивалентных искривленным кривым Эдвардса (параметры ak_wcurve_edwards_params),
+    точка \f$ P \f$ переводится в расширенные координаты кривой Эдвардса, вычисления
+    выполняются с помощью полных формул сложения, после чего результат переводится
+    обратно в проективные координаты кривой в форме Вейерштрасса.
+
     \b Для \b информации:
      \li Функция не приводит результирующую точку \f$ Q \f$ к аффинной форме.
      \li Исходная точка \f$ P \f$ и результирующая точка \f$ Q \f$ могут совпадать.
@@ -612,6 +987,12 @@
   ak_uint64 uk = 0;
   long long int i, j;
   struct wpoint Q, R; /* две точки из лесенки Монтгомери */
+  struct ecurve ed;
+
+  if( ak_wcurve_get_ecurve( ec, &ed )) {
+    ak_epoint_pow( wq, wp, k, size, &ed, ec );
+    return;
+  }
 
  /* начальные значения для переменных */
   ak_wpoint_set_as_unit( &Q, ec );
@@ -652,6 +1033,858 @@
   return ak_mpzn_cmp_ui( ep.z, ec->size, 0 );
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*             вычисление кратных образующей точки с помощью предвычисленных таблиц               */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Ширина окна (в битах) при вычислении кратной образующей точки. */
+ #define ak_wcurve_table_width     (5)
+/*! \brief Количество точек таблицы, соответствующих одному окну. */
+ #define ak_wcurve_table_entries   (1 << ( ak_wcurve_table_width - 1 ))
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Таблица кратных образующей точки эллиптической кривой.
+
+    Для каждого окна с номером \f$ i \f$ в таблице хранятся аффинные координаты
+    (в представлении Монтгомери) точек \f$ [(2j+1)2^{wi}]P \f$, \f$ j = 0, \ldots, 2^{w-1}-1 \f$,
+    где \f$ w \f$ ширина окна. Для кривых, эквивалентных кривым Эдвардса, вместо пары \f$ (x, y) \f$
+    хранится тройка \f$ (u, v, duv) \f$ координат точки кривой Эдвардса.
+    Таблицы вычисляются один раз для каждой эллиптической кривой
+    и хранятся до вызова функции ak_libakrypt_destroy().
+
+    Таблица ищется по адресу контекста кривой, поэтому изменение параметров кривой,
+    расположенной по тому же адресу, не поддерживается. Для защиты от ошибок копия параметров
+    сравнивается с текущими значениями, и при их несовпадении вычисляется новая таблица.
+    Опубликованная таблица никогда не изменяется и не освобождается до завершения работы
+    с библиотекой, поскольку указатель на нее может использоваться другими потоками без
+    захвата мьютекса.                                                                              */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct wcurve_table {
+  /*! \brief Эллиптическая кривая, для образующей точки которой вычислена таблица. */
+   ak_wcurve wc;
+  /*! \brief Копия параметров кривой, используемая для контроля изменения контекста кривой. */
+   struct wcurve params;
+  /*! \brief Количество окон. */
+   size_t windows;
+  /*! \brief Координаты точек таблицы. */
+   ak_uint64 *points;
+  /*! \brief Следующая таблица в списке. */
+   struct wcurve_table *next;
+ } *ak_wcurve_table;
+
+/*! \brief Список вычисленных таблиц. */
+ static ak_wcurve_table ak_wcurve_tables = NULL;
+#ifdef AK_HAVE_PTHREAD_H
+/*! \brief Мьютекс, защищающий список вычисленных таблиц. */
+ static pthread_mutex_t ak_wcurve_tables_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка совпадения параметров эллиптической кривой с сохраненными в таблице. */
+ static bool_t ak_wcurve_table_is_equal( ak_wcurve_table tb, ak_wcurve ec )
+{
+  size_t len = ec->size*sizeof( ak_uint64 );
+
+  if( tb->params.size != ec->size ) return ak_false;
+  if( memcmp( tb->params.p, ec->p, len ) != 0 ) return ak_false;
+  if( memcmp( tb->params.a, ec->a, len ) != 0 ) return ak_false;
+  if( memcmp( tb->params.b, ec->b, len ) != 0 ) return ak_false;
+  if( memcmp( tb->params.point.x, ec->point.x, len ) != 0 ) return ak_false;
+  if( memcmp( tb->params.point.y, ec->point.y, len ) != 0 ) return ak_false;
+  if( memcmp( tb->params.point.z, ec->point.z, len ) != 0 ) return ak_false;
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Прибавление к точке \f$ P = (x_1:y_1:z_1) \f$ точки \f$ Q = (x_2:y_2:1) \f$,
+    заданной аффинными координатами в представлении Монтгомери.
+
+    Используются те же соотношения, что и в функции ak_wpoint_add(), в которых
+    положено \f$ z_2 = 1 \f$; это позволяет сэкономить три умножения.                             */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wpoint_add_affine( ak_wpoint wp1, ak_uint64 *x2, ak_uint64 *y2, ak_wcurve ec )
+{
+  ak_mpznmax u1, u2, u4, u5, u6, u7;
+
+  if( ak_mpzn_cmp_ui( wp1->z, ec->size, 0 ) == ak_true ) {
+    memcpy( wp1->x, x2, ec->size*sizeof( ak_uint64 ));
+    memcpy( wp1->y, y2, ec->size*sizeof( ak_uint64 ));
+    ak_wcurve_set_montgomery_one( wp1->z, ec );
+    return;
+  }
+  ak_mpzn_mul_montgomery( u7, x2, wp1->z, ec->p, ec->n, ec->size );
+  if( ak_mpzn_cmp( wp1->x, u7, ec->size ) == 0 ) { // случай совпадения х-координат точки
+    ak_mpzn_mul_montgomery( u2, y2, wp1->z, ec->p, ec->n, ec->size );
+    if( ak_mpzn_cmp( wp1->y, u2, ec->size ) == 0 ) ak_wpoint_double( wp1, ec );
+     else ak_wpoint_set_as_unit( wp1, ec );
+    return;
+  }
+
+  //add-1998-cmo-2 (z2 = 1)
+  ak_mpzn_sub( u2, ec->p, wp1->y, ec->size );
+  ak_mpzn_mul_montgomery( u4, y2, wp1->z, ec->p, ec->n, ec->size );
+  ak_mpzn_add_montgomery( u4, u4, u2, ec->p, ec->size );      // u4 = u = y2z1 - y1
+  ak_mpzn_sqr_montgomery( u5, u4, ec->p, ec->n, ec->size );
+  ak_mpzn_sub( u1, ec->p, wp1->x, ec->size );
+  ak_mpzn_add_montgomery( u7, u7, u1, ec->p, ec->size );      // u7 = v = x2z1 - x1
+  ak_mpzn_sqr_montgomery( u1, u7, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( u6, u1, u7, ec->p, ec->n, ec->size ); // u6 = v^3
+  ak_mpzn_mul_montgomery( u1, u1, wp1->x, ec->p, ec->n, ec->size ); // u1 = R = v^2x1
+  ak_mpzn_lshift_montgomery( u2, u1, ec->p, ec->size );
+  ak_mpzn_add_montgomery( u2, u2, u6, ec->p, ec->size );
+  ak_mpzn_sub( u2, ec->p, u2, ec->size );
+  ak_mpzn_mul_montgomery( u5, u5, wp1->z, ec->p, ec->n, ec->size );
+  ak_mpzn_add_montgomery( u5, u5, u2, ec->p, ec->size );      // u5 = A = u^2z1 - v^3 - 2R
+  ak_mpzn_mul_montgomery( u2, u6, wp1->y, ec->p, ec->n, ec->size );
+  ak_mpzn_sub( u2, ec->p, u2, ec->size );
+  ak_mpzn_mul_montgomery( wp1->z, u6, wp1->z, ec->p, ec->n, ec->size );
+  ak_mpzn_mul_montgomery( wp1->x, u7, u5, ec->p, ec->n, ec->size );
+  ak_mpzn_sub( u5, ec->p, u5, ec->size );
+  ak_mpzn_add_montgomery( u1, u1, u5, ec->p, ec->size );
+  ak_mpzn_mul_montgomery( wp1->y, u4, u1, ec->p, ec->n, ec->size );
+  ak_mpzn_add_montgomery( wp1->y, wp1->y, u2, ec->p, ec->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Прибавление к точке \f$ P = (x_1:y_1:z_1) \f$ точки \f$ Q = (x_2:y_2:1) \f$
+    с помощью полных формул сложения.
+
+    В отличие от функции ak_wpoint_add_affine() используются полные формулы
+    (Renes, Costello, Batina, 2016, алгоритм 2), которые дают верный результат для любой точки
+    \f$ P \f$ подгруппы нечетного порядка, в том числе для \f$ P = Q \f$, \f$ P = -Q \f$ и
+    бесконечно удаленной точки \f$ P \f$; точка \f$ Q \f$ не должна быть бесконечно удаленной.
+    Поэтому функция не содержит ветвлений, зависящих от координат точек, и используется
+    при вычислении кратной образующей точки для секретного значения кратности.
+    Формулы требуют 16 умножений вместо 11 в функции ak_wpoint_add_affine().                      */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wpoint_add_affine_complete( ak_wpoint wp1, ak_uint64 *x2, ak_uint64 *y2,
+                                                                                   ak_wcurve ec )
+{
+  size_t size = ec->size;
+  ak_mpznmax t0, t1, t2, t3, t4, t5, b3, x3, y3, z3;
+
+  ak_mpzn_lshift_montgomery( b3, ec->b, ec->p, size );
+  ak_mpzn_add_montgomery( b3, b3, ec->b, ec->p, size );          // b3 = 3b
+
+  ak_mpzn_mul_montgomery( t0, wp1->x, x2, ec->p, ec->n, size );
+  ak_mpzn_mul_montgomery( t1, wp1->y, y2, ec->p, ec->n, size );
+  ak_mpzn_add_montgomery( t3, x2, y2, ec->p, size );
+  ak_mpzn_add_montgomery( t4, wp1->x, wp1->y, ec->p, size );
+  ak_mpzn_mul_montgomery( t3, t3, t4, ec->p, ec->n, size );
+  ak_mpzn_add_montgomery( t4, t0, t1, ec->p, size );
+  ak_mpzn_sub( t4, ec->p, t4, size );
+  ak_mpzn_add_montgomery( t3, t3, t4, ec->p, size );             // t3 = x1y2 + x2y1
+  ak_mpzn_mul_montgomery( t4, x2, wp1->z, ec->p, ec->n, size );
+  ak_mpzn_add_montgomery( t4, t4, wp1->x, ec->p, size );         // t4 = x2z1 + x1
+  ak_mpzn_mul_montgomery( t5, y2, wp1->z, ec->p, ec->n, size );
+  ak_mpzn_add_montgomery( t5, t5, wp1->y, ec->p, size );         // t5 = y2z1 + y1
+
+  ak_mpzn_mul_montgomery( z3, ec->a, t4, ec->p, ec->n, size );
+  ak_mpzn_mul_montgomery( x3, b3, wp1->z, ec->p, ec->n, size );
+  ak_mpzn_add_montgomery( z3, x3, z3, ec->p, size );
+  ak_mpzn_sub( x3, ec->p, z3, size );
+  ak_mpzn_add_montgomery( x3, t1, x3, ec->p, size );
+  ak_mpzn_add_montgomery( z3, t1, z3, ec->p, size );
+  ak_mpzn_mul_montgomery( y3, x3, z3, ec->p, ec->n, size );
+  ak_mpzn_lshift_montgomery( t1, t0, ec->p, size );
+  ak_mpzn_add_montgomery( t1, t1, t0, ec->p, size );             // t1 = 3x1x2
+  ak_mpzn_mul_montgomery( t2, ec->a, wp1->z, ec->p, ec->n, size );
+  ak_mpzn_mul_montgomery( t4, b3, t4, ec->p, ec->n, size );
+  ak_mpzn_add_montgomery( t1, t1, t2, ec->p, size );
+  ak_mpzn_sub( t2, ec->p, t2, size );
+  ak_mpzn_add_montgomery( t2, t0, t2, ec->p, size );
+  ak_mpzn_mul_montgomery( t2, ec->a, t2, ec->p, ec->n, size );
+  ak_mpzn_add_montgomery( t4, t4, t2, ec->p, size );
+  ak_mpzn_mul_montgomery( t0, t1, t4, ec->p, ec->n, size );
+  ak_mpzn_add_montgomery( wp1->y, y3, t0, ec->p, size );
+  ak_mpzn_mul_montgomery( t0, t5, t4, ec->p, ec->n, size );
+  ak_mpzn_mul_montgomery( x3, t3, x3, ec->p, ec->n, size );
+  ak_mpzn_sub( t0, ec->p, t0, size );
+  ak_mpzn_add_montgomery( wp1->x, x3, t0, ec->p, size );
+  ak_mpzn_mul_montgomery( t0, t3, t1, ec->p, ec->n, size );
+  ak_mpzn_mul_montgomery( z3, t5, z3, ec->p, ec->n, size );
+  ak_mpzn_add_montgomery( wp1->z, z3, t0, ec->p, size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Одновременное приведение массива точек к аффинной форме.
+
+    Для всех точек вычисляется только один обратный элемент (метод Монтгомери).
+    Аффинные координаты точки с номером \f$ i \f$ помещаются в массив `table` со смещениями
+    \f$ 2i\cdot size \f$ и \f$ (2i+1)size \f$ в представлении Монтгомери. Все точки должны
+    быть отличны от бесконечно удаленной точки.                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_wpoint_reduce_to_table( ak_uint64 *table, ak_wpoint wp,
+                                                              const size_t count, ak_wcurve ec )
+{
+  size_t i, size = ec->size;
+  ak_mpznmax u, inv;
+  ak_uint64 *prod = NULL;
+
+  if(( prod = malloc( count*size*sizeof( ak_uint64 ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+
+ /* вычисляем произведения z-координат и обращаем последнее из них */
+  memcpy( prod, wp[0].z, size*sizeof( ak_uint64 ));
+  for( i = 1; i < count; i++ )
+     ak_mpzn_mul_montgomery( prod + i*size, prod + (i-1)*size, wp[i].z, ec->p, ec->n, size );
+  ak_mpzn_inverse_montgomery( inv, prod + (count-1)*size, ec->p, ec->n, ec->r2, size );
+
+ /* восстанавливаем обратные элементы к каждой z-координате и вычисляем аффинные координаты */
+  for( i = count-1; i > 0; i-- ) {
+     ak_mpzn_mul_montgomery( u, inv, prod + (i-1)*size, ec->p, ec->n, size );
+     ak_mpzn_mul_montgomery( inv, inv, wp[i].z, ec->p, ec->n, size );
+     ak_mpzn_mul_montgomery( table + 2*i*size, wp[i].x, u, ec->p, ec->n, size );
+     ak_mpzn_mul_montgomery( table + (2*i+1)*size, wp[i].y, u, ec->p, ec->n, size );
+  }
+  ak_mpzn_mul_montgomery( table, wp[0].x, inv, ec->p, ec->n, size );
+  ak_mpzn_mul_montgomery( table + size, wp[0].y, inv, ec->p, ec->n, size );
+
+  free( prod );
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление точек таблицы и приведение их к аффинной форме.
+    Если указатель `ed` отличен от NULL, точки таблицы переводятся на кривую Эдвардса.           */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_wcurve_table_compute( ak_uint64 *table, size_t windows, ak_ecurve ed, ak_wcurve ec )
+{
+  int error = ak_error_ok;
+  struct wpoint base, twice;
+  ak_wpoint wp = NULL;
+  ak_epoint ep = NULL;
+  size_t i, j, count = windows*ak_wcurve_table_entries;
+
+  if(( wp = malloc( count*sizeof( struct wpoint ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+
+ /* вычисляем точки [(2j+1)2^{wi}]P в проективной форме */
+  ak_wpoint_set_wpoint( &base, &ec->point, ec );
+  for( i = 0; i < windows; i++ ) {
+     ak_wpoint_set_wpoint( &twice, &base, ec );
+     ak_wpoint_double( &twice, ec );
+     ak_wpoint_set_wpoint( wp + i*ak_wcurve_table_entries, &base, ec );
+     for( j = 1; j < ak_wcurve_table_entries; j++ ) {
+        ak_wpoint_set_wpoint( wp + i*ak_wcurve_table_entries + j,
+                                                        wp + i*ak_wcurve_table_entries + j-1, ec );
+        ak_wpoint_add( wp + i*ak_wcurve_table_entries + j, &twice, ec );
+     }
+     for( j = 0; j < ak_wcurve_table_width; j++ ) ak_wpoint_double( &base, ec );
+  }
+  if( ed == NULL ) error = ak_wpoint_reduce_to_table( table, wp, count, ec );
+   else {
+     if(( ep = malloc( count*sizeof( struct epoint ))) == NULL ) {
+       free( wp );
+       return ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+     }
+     for( i = 0; i < count; i++ ) ak_epoint_set_wpoint( ep+i, wp+i, ed, ec );
+     error = ak_epoint_reduce_to_table( table, ep, count, ed, ec );
+     free( ep );
+   }
+
+  free( wp );
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Поиск (и, при необходимости, вычисление) таблицы кратных образующей точки кривой.
+    Указатель `ed` должен быть отличен от NULL для кривых, эквивалентных кривым Эдвардса.
+    \return Указатель на координаты точек таблицы или NULL в случае ошибки.                        */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_uint64 *ak_wcurve_table_get( ak_wcurve ec, ak_ecurve ed )
+{
+  ak_uint64 *points = NULL;
+  ak_wcurve_table tb = NULL;
+  size_t windows = ( 64*ec->size + ak_wcurve_table_width )/ak_wcurve_table_width;
+
+#ifdef AK_HAVE_PTHREAD_H
+  pthread_mutex_lock( &ak_wcurve_tables_mutex );
+#endif
+  for( tb = ak_wcurve_tables; tb != NULL; tb = tb->next )
+     if(( tb->wc == ec ) && ( ak_wcurve_table_is_equal( tb, ec ))) {
+       points = tb->points;
+       goto exlab;
+     }
+
+ /* таблица отсутствует или параметры кривой были изменены; во втором случае прежняя таблица
+    не освобождается, поскольку ее может использовать другой поток, получивший указатель ранее */
+  if(( points = malloc( ( ed == NULL ? 2 : 3 )*
+                         windows*ak_wcurve_table_entries*ec->size*sizeof( ak_uint64 ))) == NULL ) {
+    ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+    goto exlab;
+  }
+  if( ak_wcurve_table_compute( points, windows, ed, ec ) != ak_error_ok ) {
+    ak_error_message( ak_error_get_value(), __func__, "incorrect computation of points table" );
+    free( points );
+    points = NULL;
+    goto exlab;
+  }
+  if(( tb = malloc( sizeof( struct wcurve_table ))) == NULL ) {
+    ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+    free( points );
+    points = NULL;
+    goto exlab;
+  }
+  tb->wc = ec;
+  memcpy( &tb->params, ec, sizeof( struct wcurve ));
+  tb->windows = windows;
+  tb->points = points;
+  tb->next = ak_wcurve_tables;
+  ak_wcurve_tables = tb;
+
+  exlab:
+#ifdef AK_HAVE_PTHREAD_H
+  pthread_mutex_unlock( &ak_wcurve_tables_mutex );
+#endif
+ return points;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция освобождает память, занятую таблицами кратных образующих точек эллиптических кривых.
+    Вызывается при завершении работы с библиотекой.                                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wcurve_tables_destroy( void )
+{
+  ak_wcurve_table tb = NULL;
+
+#ifdef AK_HAVE_PTHREAD_H
+  pthread_mutex_lock( &ak_wcurve_tables_mutex );
+#endif
+  while(( tb = ak_wcurve_tables ) != NULL ) {
+    ak_wcurve_tables = tb->next;
+    free( tb->points );
+    free( tb );
+  }
+#ifdef AK_HAVE_PTHREAD_H
+  pthread_mutex_unlock( &ak_wcurve_tables_mutex );
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Извлечение из вычета \f$ k \f$ последовательности бит, начинающейся с бита `pos`. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline ak_uint64 ak_mpzn_get_bits( ak_uint64 *k, size_t size, size_t pos, size_t count )
+{
+  ak_uint64 v = 0;
+  size_t word = pos >> 6, offset = pos&0x3f;
+
+  if( word < size ) v = k[word] >> offset;
+  if(( offset + count > 64 ) && ( word+1 < size )) v ^= k[word+1] << ( 64 - offset );
+ return v&(( (ak_uint64)1 << count ) - 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Изменение знака вычета \f$ x \f$ при значении маски `sign`, состоящей из единиц. */
+ static inline void ak_mpzn_negate_masked( ak_uint64 *x, ak_uint64 sign, ak_wcurve ec )
+{
+  size_t l;
+  ak_uint64 nx[ak_mpzn512_size];
+
+  ak_mpzn_sub( nx, ec->p, x, ec->size );
+  for( l = 0; l < ec->size; l++ ) x[l] = ( x[l]&~sign )^( nx[l]&sign );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Выбор из окна таблицы точки \f$ [d]2^{wi}P \f$ для нечетного \f$ d \f$.
+
+    Для того, чтобы время выполнения и порядок обращения к памяти не зависели от значения \f$ d \f$,
+    функция просматривает все точки окна и выбирает нужную с помощью маски.
+    Если указатель `w` отличен от NULL, то окно содержит тройки координат точек кривой Эдвардса. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_wcurve_table_select( ak_uint64 *x, ak_uint64 *y, ak_uint64 *w,
+                                          ak_uint64 *window, ak_int64 digit, ak_wcurve ec )
+{
+  size_t j, l, size = ec->size, step = ( w == NULL ? 2 : 3 )*size;
+  ak_uint64 mask, sign = ( ak_uint64 )( digit >> 63 ),
+            idx = ((( ak_uint64 )digit ^ sign ) - sign ) >> 1;
+
+  memset( x, 0, size*sizeof( ak_uint64 ));
+  memset( y, 0, size*sizeof( ak_uint64 ));
+  if( w != NULL ) memset( w, 0, size*sizeof( ak_uint64 ));
+  for( j = 0; j < ak_wcurve_table_entries; j++ ) {
+     mask = ( ak_uint64 )0 - (((( ak_uint64 )j ^ idx ) - 1 ) >> 63 );
+     for( l = 0; l < size; l++ ) {
+        x[l] |= window[j*step + l]&mask;
+        y[l] |= window[j*step + size + l]&mask;
+     }
+     if( w != NULL )
+       for( l = 0; l < size; l++ ) w[l] |= window[j*step + 2*size + l]&mask;
+  }
+ /* для отрицательных значений d меняем знак y-координаты точки кривой в форме Вейерштрасса,
+    либо знаки u- и duv-координат точки кривой Эдвардса */
+  if( w == NULL ) ak_mpzn_negate_masked( y, sign, ec );
+   else {
+     ak_mpzn_negate_masked( x, sign, ec );
+     ak_mpzn_negate_masked( w, sign, ec );
+   }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление кратной образующей точки с помощью таблицы, содержащей точки кривой Эдвардса.
+
+    Последовательность цифр та же, что и в функции ak_wpoint_pow_base(); поскольку формулы сложения
+    на кривой Эдвардса полны, накопление суммы начинается с нейтрального элемента.                 */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_epoint_pow_base( ak_wpoint wq, ak_uint64 *k, size_t size,
+                                              ak_uint64 *table, ak_ecurve ed, ak_wcurve ec )
+{
+  ak_int64 digit;
+  struct epoint eq, er;
+  ak_mpznmax u, v, w;
+  ak_uint64 mask;
+  size_t i, l, windows = ( 64*size + ak_wcurve_table_width )/ak_wcurve_table_width,
+         step = 3*ak_wcurve_table_entries*ec->size;
+
+  ak_epoint_set_as_unit( &eq, ec );
+  for( i = windows; i > 0; i-- ) {
+     digit = ( ak_int64 )( ak_mpzn_get_bits( k, size,
+                        ( i-1 )*ak_wcurve_table_width, ak_wcurve_table_width+1 ) | 1 );
+     if( i < windows ) digit -= ( 1 << ak_wcurve_table_width );
+     ak_wcurve_table_select( u, v, w, table + ( i-1 )*step, digit, ec );
+     ak_epoint_add_affine( &eq, u, v, w, ec );
+  }
+
+ /* для четных k вычитаем образующую точку */
+  memcpy( &er, &eq, sizeof( struct epoint ));
+  ak_wcurve_table_select( u, v, w, table, -1, ec );
+  ak_epoint_add_affine( &er, u, v, w, ec );
+  mask = ( k[0]&1 ) - 1;
+  for( l = 0; l < size; l++ ) {
+     eq.x[l] = ( eq.x[l]&~mask )^( er.x[l]&mask );
+     eq.y[l] = ( eq.y[l]&~mask )^( er.y[l]&mask );
+     eq.t[l] = ( eq.t[l]&~mask )^( er.t[l]&mask );
+     eq.z[l] = ( eq.z[l]&~mask )^( er.z[l]&mask );
+  }
+  ak_wpoint_set_epoint( wq, &eq, ed, ec );
+
+  memset( &eq, 0, sizeof( struct epoint ));
+  memset( &er, 0, sizeof( struct epoint ));
+  memset( u, 0, sizeof( ak_mpznmax ));
+  memset( v, 0, sizeof( ak_mpznmax ));
+  memset( w, 0, sizeof( ak_mpznmax ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для заданного целого числа (вычета) \f$ k \f$ функция вычисляет кратную точку
+    \f$ Q = [k]P \f$, где \f$ P \f$ образующая точка эллиптической кривой.
+
+    В отличие от функции ak_wpoint_pow() используется таблица точек \f$ [(2j+1)2^{wi}]P \f$,
+    вычисляемая один раз для каждой кривой при первом обращении. Нечетное число \f$ k' = k | 1 \f$
+    записывается в виде \f$ k' = \sum_i d_i2^{wi} \f$ с нечетными цифрами
+    \f$ |d_i| < 2^w \f$, после чего кратная точка вычисляется как сумма выбранных из таблицы точек,
+    т.е. приблизительно за \f$ 64\cdot size/w \f$ сложений без удвоений.
+    Для четных \f$ k \f$ из результата вычитается точка \f$ P \f$; вычитание
+    выполняется всегда, а результат выбирается с помощью маски. Точки выбираются из таблицы
+    функцией ak_wcurve_table_select() с просмотром всего окна, а сложения выполняются
+    по полным формулам (функция ak_wpoint_add_affine_complete()), поэтому последовательность
+    операций над точками и порядок обращения к памяти таблицы не зависят от значения \f$ k \f$.
+    Финальное вычитание модуля в сложении и умножении вычетов выполняется с помощью маски;
+    исключением является общая реализация умножения Монтгомери, используемая при отсутствии
+    128-битного целого типа, в которой вычитание выполняется условно.
+
+    Для кривых, эквивалентных искривленным кривым Эдвардса, таблица содержит точки кривой Эдвардса,
+    а сложения выполняются по полным формулам в расширенных координатах.
+
+    Если размер \f$ k \f$ отличен от размера параметров кривой, или таблица не может быть
+    вычислена, то используется функция ak_wpoint_pow(). Таблица связывается с адресом
+    контекста `ec`; изменять параметры кривой по этому адресу после первого вызова функции
+    не следует (см. описание структуры \ref wcurve_table).
+
+    \b Для \b информации:
+     \li Функция не приводит результирующую точку \f$ Q \f$ к аффинной форме.
+
+    @param wq Точка \f$ Q \f$, в которую помещается результат.
+    @param k Степень кратности.
+    @param size Размер степени \f$ k \f$ в машинных словах.
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_pow_base( ak_wpoint wq, ak_uint64 *k, size_t size, ak_wcurve ec )
+{
+  ak_int64 digit;
+  struct wpoint wr;
+  ak_mpznmax x, y;
+  ak_uint64 mask, *table = NULL;
+  size_t i, l, windows, step = 2*ak_wcurve_table_entries*ec->size;
+  struct ecurve ed;
+  bool_t edwards = ak_wcurve_get_ecurve( ec, &ed );
+
+  if(( size != ec->size ) ||
+                        (( table = ak_wcurve_table_get( ec, edwards ? &ed : NULL )) == NULL )) {
+    ak_wpoint_pow( wq, &ec->point, k, size, ec );
+    return;
+  }
+  if( edwards ) {
+    ak_epoint_pow_base( wq, k, size, table, &ed, ec );
+    return;
+  }
+  windows = ( 64*size + ak_wcurve_table_width )/ak_wcurve_table_width;
+
+ /* старшая цифра всегда положительна */
+  digit = ( ak_int64 )( ak_mpzn_get_bits( k, size,
+                  ( windows-1 )*ak_wcurve_table_width, ak_wcurve_table_width+1 ) | 1 );
+  ak_wcurve_table_select( x, y, NULL, table + ( windows-1 )*step, digit, ec );
+  memcpy( wq->x, x, size*sizeof( ak_uint64 ));
+  memcpy( wq->y, y, size*sizeof( ak_uint64 ));
+  ak_wcurve_set_montgomery_one( wq->z, ec );
+
+ /* остальные цифры принимают значения из множества { -2^w+1, ..., -1, 1, ..., 2^w-1 } */
+  for( i = windows-1; i > 0; i-- ) {
+     digit = ( ak_int64 )( ak_mpzn_get_bits( k, size,
+                        ( i-1 )*ak_wcurve_table_width, ak_wcurve_table_width+1 ) | 1 )
+                                                            - ( 1 << ak_wcurve_table_width );
+     ak_wcurve_table_select( x, y, NULL, table + ( i-1 )*step, digit, ec );
+     ak_wpoint_add_affine_complete( wq, x, y, ec );
+  }
+
+ /* для четных k вычитаем образующую точку */
+  ak_wpoint_set_wpoint( &wr, wq, ec );
+  ak_wcurve_table_select( x, y, NULL, table, -1, ec );
+  ak_wpoint_add_affine_complete( &wr, x, y, ec );
+  mask = ( k[0]&1 ) - 1;
+  for( l = 0; l < size; l++ ) {
+     wq->x[l] = ( wq->x[l]&~mask )^( wr.x[l]&mask );
+     wq->y[l] = ( wq->y[l]&~mask )^( wr.y[l]&mask );
+     wq->z[l] = ( wq->z[l]&~mask )^( wr.z[l]&mask );
+  }
+
+  memset( &wr, 0, sizeof( struct wpoint ));
+  memset( x, 0, sizeof( ak_mpznmax ));
+  memset( y, 0, sizeof( ak_mpznmax ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Ширина окна при вычислении кратной точки, отличной от образующей, в функции ak_wpoint_pow2(). */
+ #define ak_wpoint_wnaf_width      (5)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Представление вычета \f$ k \f$ в несмежной форме с окном ширины \f$ w \f$ (wNAF).
+
+    Ненулевые цифры \f$ d_i \f$ представления нечетны и удовлетворяют неравенству
+    \f$ |d_i| < 2^{w-1} \f$; среди любых \f$ w \f$ последовательных цифр не более одной ненулевой.
+    Время работы функции зависит от значения \f$ k \f$.
+
+    @return Функция возвращает количество цифр представления (не более `64*size+1`).              */
+/* ----------------------------------------------------------------------------------------------- */
+ static size_t ak_mpzn_to_wnaf( ak_int8 *naf, ak_uint64 *k, size_t size, int w )
+{
+  ak_int64 digit;
+  ak_uint64 cy, t[ak_mpzn512_size+1];
+  size_t i, len = 0, top = size+1;
+
+  memcpy( t, k, size*sizeof( ak_uint64 ));
+  t[size] = 0;
+  while( top > 0 ) {
+    if( t[top-1] == 0 ) { top--; continue; }
+    digit = 0;
+    if( t[0]&1 ) {
+      digit = ( ak_int64 )( t[0]&(( (ak_uint64)1 << w ) - 1 ));
+      if( digit >= ( 1 << ( w-1 ))) digit -= ( 1 << w );
+     /* вычитаем цифру: для положительных значений заема не возникает */
+      if( digit > 0 ) t[0] -= ( ak_uint64 )digit;
+       else {
+         cy = ( ak_uint64 )( -digit );
+         for( i = 0; ( i <= size ) && cy; i++ ) {
+            t[i] += cy;
+            cy = ( t[i] < cy );
+         }
+       }
+    }
+    naf[len++] = ( ak_int8 )digit;
+    for( i = 0; i < size; i++ ) t[i] = ( t[i] >> 1 )^( t[i+1] << 63 );
+    t[size] >>= 1;
+  }
+ return len;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет нечетные кратные \f$ Q, [3]Q, \ldots, [2^{w-1}-1]Q \f$ заданной точки \f$ Q \f$,
+    а также противоположные им точки, используемые функцией ak_wpoint_pow2_odd_multiples().
+
+    @param tq Массив, в который помещаются \f$ 2^{w-1} \f$ точек: сначала \f$ 2^{w-2} \f$
+    нечетных кратных точки \f$ Q \f$, затем противоположные им точки.
+    @param wq Точка \f$ Q \f$.
+    @param width Ширина окна \f$ w \f$, не менее двух.
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_set_odd_multiples( ak_wpoint tq, ak_wpoint wq, const size_t width, ak_wcurve ec )
+{
+  size_t j, count = (size_t)1 << ( width-2 );
+  struct wpoint wt;
+
+  ak_wpoint_set_wpoint( tq, wq, ec );
+  ak_wpoint_set_wpoint( &wt, wq, ec );
+  ak_wpoint_double( &wt, ec );
+  for( j = 1; j < count; j++ ) {
+     ak_wpoint_set_wpoint( tq+j, tq+j-1, ec );
+     ak_wpoint_add( tq+j, &wt, ec );
+  }
+  for( j = 0; j < count; j++ ) {
+     ak_wpoint_set_wpoint( tq+count+j, tq+j, ec );
+     ak_mpzn_sub( tq[count+j].y, ec->p, tq[j].y, ec->size );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет аффинные координаты (в представлении Монтгомери) нечетных кратных
+    \f$ Q, [3]Q, \ldots, [2^{w-1}-1]Q \f$ заданной точки \f$ Q \f$, используемые
+    функцией ak_wpoint_pow2_affine_multiples(). В отличие от функции ak_wpoint_set_odd_multiples()
+    требуется одно обращение в поле, поэтому функцию имеет смысл использовать в случае,
+    когда вычисленные точки используются многократно.
+
+    Для кривых, эквивалентных кривым Эдвардса, для каждой точки сохраняется тройка
+    \f$ (u, v, duv) \f$ координат соответствующей точки кривой Эдвардса.
+
+    @param table Массив, в который помещаются координаты \f$ 2^{w-2} \f$ точек; под массив
+    должно быть выделено \f$ 3\cdot 2^{w-2}\cdot size \f$ машинных слов.
+    @param wq Точка \f$ Q \f$, отличная от бесконечно удаленной точки.
+    @param width Ширина окна \f$ w \f$, не менее двух.
+    @param ec Эллиптическая кривая, на которой происходят вычисления
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_wpoint_set_affine_multiples( ak_uint64 *table, ak_wpoint wq,
+                                                               const size_t width, ak_wcurve ec )
+{
+  size_t j, count = (size_t)1 << ( width-2 );
+  int error = ak_error_ok;
+  ak_wpoint tq = NULL;
+  ak_epoint eq = NULL;
+  struct ecurve ed;
+
+  if( ak_mpzn_cmp_ui( wq->z, ec->size, 0 ) == ak_true )
+    return ak_error_message( ak_error_curve_point, __func__, "using the point at infinity" );
+  if(( tq = malloc( 2*count*sizeof( struct wpoint ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+
+  ak_wpoint_set_odd_multiples( tq, wq, width, ec );
+  if( !ak_wcurve_get_ecurve( ec, &ed )) error = ak_wpoint_reduce_to_table( table, tq, count, ec );
+   else {
+     if(( eq = malloc( count*sizeof( struct epoint ))) == NULL ) {
+       free( tq );
+       return ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+     }
+     for( j = 0; j < count; j++ ) ak_epoint_set_wpoint( eq+j, tq+j, &ed, ec );
+     error = ak_epoint_reduce_to_table( table, eq, count, &ed, ec );
+     free( eq );
+   }
+
+  free( tq );
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Изменение знака точки кривой Эдвардса, заданной тройкой \f$ (u, v, duv) \f$. */
+ static inline void ak_epoint_negate_affine( ak_uint64 *nu, ak_uint64 *nw,
+                                                      ak_uint64 *u, ak_uint64 *w, ak_wcurve ec )
+{
+  ak_mpzn_sub( nu, ec->p, u, ec->size );
+  ak_mpzn_sub( nw, ec->p, w, ec->size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление точки \f$ R = [k_1]P + [k_2]Q \f$ методом Штрауса на кривой Эдвардса.
+
+    Используются те же представления \f$ k_1, k_2 \f$ в несмежной форме, что и в функции
+    ak_wpoint_pow2_tables(). Нечетные кратные точки \f$ Q \f$, заданные в проективных
+    координатах, переводятся на кривую Эдвардса один раз при вызове функции (если память
+    под них не может быть выделена, то перед каждым сложением).                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_epoint_pow2_tables( ak_wpoint wr, ak_uint64 *k1, ak_uint64 *table,
+                    ak_wpoint tq, ak_uint64 *aq, const size_t width, ak_uint64 *k2, size_t size,
+                                                                    ak_ecurve ed, ak_wcurve ec )
+{
+  struct epoint er, en;
+  ak_epoint eq = NULL;
+  ak_mpznmax u, w;
+  ak_int8 naf1[64*ak_mpzn512_size+1], naf2[64*ak_mpzn512_size+1];
+  size_t i, j, len1, len2, count = (size_t)1 << ( width-2 );
+
+  if(( tq != NULL ) && (( eq = malloc( count*sizeof( struct epoint ))) != NULL ))
+    for( j = 0; j < count; j++ ) ak_epoint_set_wpoint( eq+j, tq+j, ed, ec );
+  len1 = ak_mpzn_to_wnaf( naf1, k1, size, ak_wcurve_table_width+1 );
+  len2 = ak_mpzn_to_wnaf( naf2, k2, size, ( int )width );
+
+  ak_epoint_set_as_unit( &er, ec );
+  for( i = ( len1 > len2 ? len1 : len2 ); i > 0; i-- ) {
+     ak_epoint_double( &er, ec );
+     if(( i <= len1 ) && ( naf1[i-1] != 0 )) {
+       j = 3*size*(( size_t )( naf1[i-1] > 0 ? naf1[i-1] : -naf1[i-1] ) >> 1 );
+       if( naf1[i-1] > 0 ) ak_epoint_add_affine( &er, table + j, table + j + size,
+                                                                        table + j + 2*size, ec );
+        else {
+          ak_epoint_negate_affine( u, w, table + j, table + j + 2*size, ec );
+          ak_epoint_add_affine( &er, u, table + j + size, w, ec );
+        }
+     }
+     if(( i <= len2 ) && ( naf2[i-1] != 0 )) {
+       j = ( size_t )( naf2[i-1] > 0 ? naf2[i-1] : -naf2[i-1] ) >> 1;
+       if( tq != NULL ) {
+         if( eq != NULL ) memcpy( &en, eq+j, sizeof( struct epoint ));
+          else ak_epoint_set_wpoint( &en, tq+j, ed, ec );
+         if( naf2[i-1] < 0 ) {
+           ak_mpzn_sub( en.x, ec->p, en.x, size );
+           ak_mpzn_sub( en.t, ec->p, en.t, size );
+         }
+         ak_epoint_add( &er, &en, ed, ec );
+       } else {
+          j *= 3*size;
+          if( naf2[i-1] > 0 ) ak_epoint_add_affine( &er, aq + j, aq + j + size,
+                                                                           aq + j + 2*size, ec );
+           else {
+             ak_epoint_negate_affine( u, w, aq + j, aq + j + 2*size, ec );
+             ak_epoint_add_affine( &er, u, aq + j + size, w, ec );
+           }
+         }
+     }
+  }
+  ak_wpoint_set_epoint( wr, &er, ed, ec );
+
+  if( eq != NULL ) free( eq );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление точки \f$ R = [k_1]P + [k_2]Q \f$ методом Штрауса.
+
+    Нечетные кратные точки \f$ Q \f$ задаются либо в проективных координатах (массив `tq`),
+    либо в аффинных координатах (массив `aq`); второй из указателей должен быть равен NULL.        */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_wpoint_pow2_tables( ak_wpoint wr, ak_uint64 *k1, ak_wpoint tq, ak_uint64 *aq,
+                                      const size_t width, ak_uint64 *k2, size_t size, ak_wcurve ec )
+{
+  ak_mpznmax y;
+  struct wpoint wt;
+  struct epoint et;
+  struct ecurve ed;
+  ak_uint64 *table = NULL;
+  ak_int8 naf1[64*ak_mpzn512_size+1], naf2[64*ak_mpzn512_size+1];
+  size_t i, j, len1, len2, count = (size_t)1 << ( width-2 );
+  bool_t edwards = ak_wcurve_get_ecurve( ec, &ed );
+
+  if(( size != ec->size ) ||
+                        (( table = ak_wcurve_table_get( ec, edwards ? &ed : NULL )) == NULL )) {
+    if( tq != NULL ) ak_wpoint_set_wpoint( &wt, tq, ec );
+     else {
+       if( edwards ) { /* восстанавливаем точку кривой Эдвардса в расширенных координатах */
+         memcpy( et.x, aq, size*sizeof( ak_uint64 ));
+         memcpy( et.y, aq+size, size*sizeof( ak_uint64 ));
+         ak_mpzn_mul_montgomery( et.t, et.x, et.y, ec->p, ec->n, size );
+         ak_wcurve_set_montgomery_one( et.z, ec );
+         ak_wpoint_set_epoint( &wt, &et, &ed, ec );
+       } else {
+           memcpy( wt.x, aq, size*sizeof( ak_uint64 ));
+           memcpy( wt.y, aq+size, size*sizeof( ak_uint64 ));
+           ak_wcurve_set_montgomery_one( wt.z, ec );
+         }
+     }
+    ak_wpoint_pow( &wt, &wt, k2, size, ec );
+    ak_wpoint_pow( wr, &ec->point, k1, size, ec );
+    ak_wpoint_add( wr, &wt, ec );
+    return;
+  }
+  if( edwards ) {
+    ak_epoint_pow2_tables( wr, k1, table, tq, aq, width, k2, size, &ed, ec );
+    return;
+  }
+
+ /* для точки P используется окно шириной w+1, поскольку первое окно таблицы
+    содержит точки P, 3P, ..., (2^w-1)P */
+  len1 = ak_mpzn_to_wnaf( naf1, k1, size, ak_wcurve_table_width+1 );
+  len2 = ak_mpzn_to_wnaf( naf2, k2, size, ( int )width );
+
+  ak_wpoint_set_as_unit( wr, ec );
+  for( i = ( len1 > len2 ? len1 : len2 ); i > 0; i-- ) {
+     ak_wpoint_double( wr, ec );
+     if(( i <= len1 ) && ( naf1[i-1] != 0 )) {
+       j = ( size_t )( naf1[i-1] > 0 ? naf1[i-1] : -naf1[i-1] ) >> 1;
+       if( naf1[i-1] > 0 ) ak_wpoint_add_affine( wr, table + 2*j*size, table + (2*j+1)*size, ec );
+        else {
+          ak_mpzn_sub( y, ec->p, table + (2*j+1)*size, size );
+          ak_wpoint_add_affine( wr, table + 2*j*size, y, ec );
+        }
+     }
+     if(( i <= len2 ) && ( naf2[i-1] != 0 )) {
+       j = ( size_t )( naf2[i-1] > 0 ? naf2[i-1] : -naf2[i-1] ) >> 1;
+       if( tq != NULL ) ak_wpoint_add( wr, tq + ( naf2[i-1] > 0 ? j : count+j ), ec );
+        else {
+          if( naf2[i-1] > 0 ) ak_wpoint_add_affine( wr, aq + 2*j*size, aq + (2*j+1)*size, ec );
+           else {
+             ak_mpzn_sub( y, ec->p, aq + (2*j+1)*size, size );
+             ak_wpoint_add_affine( wr, aq + 2*j*size, y, ec );
+           }
+        }
+     }
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет точку \f$ R = [k_1]P + [k_2]Q \f$, где \f$ P \f$ образующая точка
+    эллиптической кривой, а нечетные кратные точки \f$ Q \f$ заранее вычислены
+    функцией ak_wpoint_set_odd_multiples(). Подробности см. в описании функции ak_wpoint_pow2().
+
+    @param wr Точка \f$ R \f$, в которую помещается результат.
+    @param k1 Степень кратности образующей точки \f$ P \f$.
+    @param tq Нечетные кратные точки \f$ Q \f$ и противоположные им точки.
+    @param width Ширина окна, с которой вычислены точки `tq`.
+    @param k2 Степень кратности точки \f$ Q \f$.
+    @param size Размер степеней \f$ k_1, k_2 \f$ в машинных словах.
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_pow2_odd_multiples( ak_wpoint wr, ak_uint64 *k1, ak_wpoint tq,
+                                      const size_t width, ak_uint64 *k2, size_t size, ak_wcurve ec )
+{
+  ak_wpoint_pow2_tables( wr, k1, tq, NULL, width, k2, size, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет точку \f$ R = [k_1]P + [k_2]Q \f$, где \f$ P \f$ образующая точка
+    эллиптической кривой, а аффинные координаты нечетных кратных точки \f$ Q \f$ заранее
+    вычислены функцией ak_wpoint_set_affine_multiples().
+
+    @param wr Точка \f$ R \f$, в которую помещается результат.
+    @param k1 Степень кратности образующей точки \f$ P \f$.
+    @param aq Аффинные координаты нечетных кратных точки \f$ Q \f$.
+    @param width Ширина окна, с которой вычислены точки `aq`.
+    @param k2 Степень кратности точки \f$ Q \f$.
+    @param size Размер степеней \f$ k_1, k_2 \f$ в машинных словах.
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_pow2_affine_multiples( ak_wpoint wr, ak_uint64 *k1, ak_uint64 *aq,
+                                      const size_t width, ak_uint64 *k2, size_t size, ak_wcurve ec )
+{
+  ak_wpoint_pow2_tables( wr, k1, NULL, aq, width, k2, size, ec );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для заданных целых чисел \f$ k_1, k_2 \f$ и точки \f$ Q \f$ функция вычисляет точку
+    \f$ R = [k_1]P + [k_2]Q \f$, где \f$ P \f$ образующая точка эллиптической кривой.
+
+    Используется метод Штрауса (Шамира): оба числа представляются в несмежной форме (wNAF),
+    после чего кратные точки вычисляются одновременно с помощью общей последовательности удвоений.
+    Нечетные кратные точки \f$ P \f$ берутся из таблицы, используемой функцией ak_wpoint_pow_base(),
+    нечетные кратные точки \f$ Q \f$ вычисляются при каждом вызове функции.
+
+    \warning Время работы функции зависит от значений \f$ k_1, k_2 \f$, поэтому функция
+    должна использоваться только для открытых данных, например, при проверке электронной подписи.
+
+    \b Для \b информации:
+     \li Функция не приводит результирующую точку \f$ R \f$ к аффинной форме.
+
+    @param wr Точка \f$ R \f$, в которую помещается результат.
+    @param k1 Степень кратности образующей точки \f$ P \f$.
+    @param wq Точка \f$ Q \f$.
+    @param k2 Степень кратности точки \f$ Q \f$.
+    @param size Размер степеней \f$ k_1, k_2 \f$ в машинных словах.
+    @param ec Эллиптическая кривая, на которой происходят вычисления                               */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_wpoint_pow2( ak_wpoint wr, ak_uint64 *k1, ak_wpoint wq, ak_uint64 *k2,
+                                                                      size_t size, ak_wcurve ec )
+{
+  struct wpoint tq[ 1 << ( ak_wpoint_wnaf_width-1 )];
+
+  ak_wpoint_set_odd_multiples( tq, wq, ak_wpoint_wnaf_width, ec );
+  ak_wpoint_pow2_odd_multiples( wr, k1, tq, ak_wpoint_wnaf_width, k2, size, ec );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*                                                                                    ak_curves.c  */
 /* ----------------------------------------------------------------------------------------------- */
@@ -0,0 +1,774 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Copyright (c) 2020 by Axel Kenzo, axelkenzo@mail.ru                                            */
+/*                                                                                                 */
+/*  Файл ak_gcm.c                                                                                  */
+/*  - содержит реализацию режима аутентифицированного шифрования GCM (NIST SP 800-38D)             */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <libakrypt-internal.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+#ifdef AK_HAVE_BUILTIN_CLMULEPI64
+ #include <wmmintrin.h>
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество блоков, для которых функция GHASH выполняет одно общее приведение
+    по модулю многочлена, порождающего поле.                                                       */
+ #define ak_gcm_aggregated_blocks          (8)
+
+/*! \brief Максимальная длина зашифровываемых данных в октетах: \f$ 2^{32} - 2 \f$ блока. */
+ #define ak_gcm_max_data_size   ( 0xFFFFFFFE0LL )
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Контекст режима `gcm`, содержащий промежуточные значения вычислений.
+    \details Элементы поля \f$ \mathbb F_{2^{128}} \f$ хранятся в порядке, используемом
+    функцией ak_gf128_mul(): i-й бит 128-битного целого числа является коэффициентом при
+    \f$ x^i \f$. Для перехода к строкам октетов, определенным в NIST SP 800-38D,
+    в каждом октете изменяется порядок следования битов.                                          */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct gcm_ctx {
+  /*! \brief Текущее значение функции GHASH. */
+   ak_uint64 sum[2];
+  /*! \brief Степени H^1, ..., H^8 элемента H = E( 0^128 ). */
+   ak_uint64 h[ak_gcm_aggregated_blocks][2];
+  /*! \brief Суммы половин степеней H, используемые при умножении по методу Карацубы. */
+   ak_uint64 hk[ak_gcm_aggregated_blocks];
+  /*! \brief Текущее значение счетчика. */
+   ak_uint128 counter;
+  /*! \brief Зашифрованное начальное значение счетчика E( J_0 ). */
+   ak_uint128 ej0;
+  /*! \brief Размер обработанных зашифровываемых/расшифровываемых данных в битах. */
+   ak_uint64 pbitlen;
+  /*! \brief Размер обработанных дополнительных данных в битах. */
+   ak_uint64 abitlen;
+  /*! \brief Флаги состояния контекста. */
+   ak_uint32 flags;
+} *ak_gcm_ctx;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Увеличение на единицу младших 32 бит счетчика (функция inc_32 из NIST SP 800-38D). */
+#ifdef AK_LITTLE_ENDIAN
+ #define ak_gcm_increment( x ) ( (x).w[3] = bswap_32( bswap_32( (x).w[3] ) + 1 ))
+#else
+ #define ak_gcm_increment( x ) ( (x).w[3]++ )
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция изменяет порядок следования битов в каждом октете 64-битного слова. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline ak_uint64 ak_gcm_reflect( ak_uint64 x )
+{
+  x = (( x >> 1 )&0x5555555555555555LL )|(( x&0x5555555555555555LL ) << 1 );
+  x = (( x >> 2 )&0x3333333333333333LL )|(( x&0x3333333333333333LL ) << 2 );
+ return (( x >> 4 )&0x0F0F0F0F0F0F0F0FLL )|(( x&0x0F0F0F0F0F0F0F0FLL ) << 4 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция преобразует блок данных в элемент поля \f$ \mathbb F_{2^{128}} \f$. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_gcm_load( ak_uint64 *x, const ak_uint8 *block )
+{
+  memcpy( x, block, 16 );
+#ifndef AK_LITTLE_ENDIAN
+  x[0] = bswap_64( x[0] ); x[1] = bswap_64( x[1] );
+#endif
+  x[0] = ak_gcm_reflect( x[0] ); x[1] = ak_gcm_reflect( x[1] );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция преобразует элемент поля \f$ \mathbb F_{2^{128}} \f$ в блок данных. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_gcm_store( ak_uint8 *block, const ak_uint64 *x )
+{
+  ak_uint64 y[2];
+
+  y[0] = ak_gcm_reflect( x[0] ); y[1] = ak_gcm_reflect( x[1] );
+#ifndef AK_LITTLE_ENDIAN
+  y[0] = bswap_64( y[0] ); y[1] = bswap_64( y[1] );
+#endif
+  memcpy( block, y, 16 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция формирует блок [ len(A) ]_64 || [ len(C) ]_64. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_gcm_lengths_block( ak_uint8 *block, const ak_uint64 alen, const ak_uint64 clen )
+{
+  size_t i = 0;
+
+  for( i = 0; i < 8; i++ ) {
+     block[7-i] = ( ak_uint8 )( alen >> ( i << 3 ));
+     block[15-i] = ( ak_uint8 )( clen >> ( i << 3 ));
+  }
+}
+
+#ifdef AK_HAVE_BUILTIN_CLMULEPI64
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция изменяет порядок следования битов в каждом октете 128-битного регистра. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline __m128i ak_gcm_reflect_m128( __m128i x )
+{
+  const __m128i m1 = _mm_set1_epi8( 0x55 ), m2 = _mm_set1_epi8( 0x33 ), m4 = _mm_set1_epi8( 0x0F );
+
+  x = _mm_or_si128( _mm_and_si128( _mm_srli_epi64( x, 1 ), m1 ),
+                                               _mm_slli_epi64( _mm_and_si128( x, m1 ), 1 ));
+  x = _mm_or_si128( _mm_and_si128( _mm_srli_epi64( x, 2 ), m2 ),
+                                               _mm_slli_epi64( _mm_and_si128( x, m2 ), 2 ));
+ return _mm_or_si128( _mm_and_si128( _mm_srli_epi64( x, 4 ), m4 ),
+                                               _mm_slli_epi64( _mm_and_si128( x, m4 ), 4 ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция обрабатывает восемь блоков данных с одним общим приведением по модулю.
+    \details Вычисляется значение
+    \f$ Y = (Y \oplus X_1)H^8 \oplus X_2H^7 \oplus \ldots \oplus X_8H \f$: произведения
+    вычисляются по методу Карацубы (три умножения PCLMULQDQ на блок) и складываются
+    без приведения; приведение 256-битной суммы выполняется один раз.                             */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_gcm_ghash_aggregated( ak_gcm_ctx ctx, const ak_uint8 *data )
+{
+  size_t i = 0;
+  ak_uint64 c[2], d[2], e[2], x3, D;
+  __m128i lo = _mm_setzero_si128(), hi = lo, mid = lo, am, hm,
+          sum = _mm_loadu_si128( (const __m128i *) ctx->sum );
+
+  for( i = 0; i < ak_gcm_aggregated_blocks; i++, data += 16 ) {
+     size_t k = ak_gcm_aggregated_blocks - 1 - i;
+
+     am = ak_gcm_reflect_m128( _mm_loadu_si128( (const __m128i *) data ));
+     if( i == 0 ) am = _mm_xor_si128( am, sum );
+     hm = _mm_loadu_si128( (const __m128i *) ctx->h[k] );
+     lo = _mm_xor_si128( lo, _mm_clmulepi64_si128( am, hm, 0x00 ));
+     hi = _mm_xor_si128( hi, _mm_clmulepi64_si128( am, hm, 0x11 ));
+     am = _mm_xor_si128( am, _mm_shuffle_epi32( am, 0x4E ));
+     hm = _mm_loadl_epi64( (const __m128i *)( ctx->hk + k ));
+     mid = _mm_xor_si128( mid, _mm_clmulepi64_si128( am, hm, 0x00 ));
+  }
+  _mm_storeu_si128( (__m128i *) c, lo );
+  _mm_storeu_si128( (__m128i *) d, hi );
+  _mm_storeu_si128( (__m128i *) e, mid );
+  e[0] ^= c[0]^d[0]; e[1] ^= c[1]^d[1];
+
+ /* приведение: c + e*x^64 + d*x^128 по модулю x^128 + x^7 + x^2 + x + 1 */
+  x3 = d[1];
+  D = d[0] ^ e[1] ^ ( x3 >> 63 ) ^ ( x3 >> 62 ) ^ ( x3 >> 57 );
+  ctx->sum[0] = c[0] ^ D ^ ( D << 1 ) ^ ( D << 2 ) ^ ( D << 7 );
+  ctx->sum[1] = c[1] ^ e[0] ^ x3 ^ ( x3 << 1 ) ^ ( x3 << 2 ) ^ ( x3 << 7 ) ^
+                                                          ( D >> 63 ) ^ ( D >> 62 ) ^ ( D >> 57 );
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция добавляет к значению GHASH заданное количество полных блоков данных.
+    \details При наличии команды PCLMULQDQ блоки обрабатываются группами по
+    \ref ak_gcm_aggregated_blocks, оставшиеся блоки - по схеме Горнера.                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_gcm_ghash_update( ak_gcm_ctx ctx, const ak_uint8 *data, size_t blocks )
+{
+  ak_uint64 x[2];
+
+#ifdef AK_HAVE_BUILTIN_CLMULEPI64
+  for( ; blocks >= ak_gcm_aggregated_blocks; blocks -= ak_gcm_aggregated_blocks ) {
+     ak_gcm_ghash_aggregated( ctx, data );
+     data += ( ak_gcm_aggregated_blocks << 4 );
+  }
+#endif
+  for( ; blocks > 0; blocks--, data += 16 ) {
+     ak_gcm_load( x, data );
+     x[0] ^= ctx->sum[0]; x[1] ^= ctx->sum[1];
+     ak_gf128_mul( ctx->sum, x, ctx->h[0] );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция добавляет к значению GHASH последний неполный блок данных,
+    дополненный нулями.                                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_gcm_ghash_tail( ak_gcm_ctx ctx, const ak_uint8 *data, const size_t tail )
+{
+  ak_uint8 temp[16];
+
+  memset( temp, 0, sizeof( temp ));
+  memcpy( temp, data, tail );
+  ak_gcm_ghash_update( ctx, temp, 1 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет значение H = E( 0^128 ) и его степени, а также начальное значение
+    счетчика J_0 и значение E( J_0 ).
+
+    @param ctx Контекст внутреннего состояния алгоритма
+    @param bkey Ключ блочного алгоритма шифрования с длиной блока 128 бит
+    @param iv Синхропосылка
+    @param iv_size Длина синхропосылки в байтах. Для синхропосылки длины 12 октетов
+    J_0 = IV || 0^31 || 1, для остальных длин значение J_0 вычисляется с помощью функции GHASH.
+
+    @return В случае успеха функция возвращает \ref ak_error_ok (ноль). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_gcm_context_clean( ak_gcm_ctx ctx, ak_bckey bkey,
+                                                      const ak_pointer iv, const size_t iv_size )
+{
+  size_t i = 0;
+  ak_uint8 temp[16];
+
+  if( ctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                      "using null pointer to internal gcm context");
+  if( bkey == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                           "using null pointer to block cipher key");
+  if( bkey->bsize != 16 ) return ak_error_message( ak_error_wrong_block_cipher, __func__ ,
+                                                        "incorrect block size of block cipher key" );
+ /* инициализация значением и ресурс */
+  if(( bkey->key.flags&ak_key_flag_set_key ) == 0 )
+    return ak_error_message( ak_error_key_value, __func__,
+                                         "using block cipher key context with undefined key value");
+  if( iv == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                            "using null pointer to initial vector");
+  if( !iv_size ) return ak_error_message( ak_error_zero_length, __func__,
+                                                            "using initial vector of zero length" );
+  if( bkey->key.resource.value.counter <= 2 )
+    return ak_error_message( ak_error_low_key_resource, __func__, "using key with low key resource");
+   else bkey->key.resource.value.counter -= 2;
+ /* обнуляем необходимое */
+  memset( ctx, 0, sizeof( struct gcm_ctx ));
+
+ /* вычисляем H и его степени */
+  memset( temp, 0, sizeof( temp ));
+  bkey->encrypt( &bkey->key, temp, temp );
+  ak_gcm_load( ctx->h[0], temp );
+  for( i = 1; i < ak_gcm_aggregated_blocks; i++ )
+     ak_gf128_mul( ctx->h[i], ctx->h[i-1], ctx->h[0] );
+  for( i = 0; i < ak_gcm_aggregated_blocks; i++ ) ctx->hk[i] = ctx->h[i][0]^ctx->h[i][1];
+
+ /* вычисляем J_0 */
+  if( iv_size == 12 ) {
+    memcpy( ctx->counter.b, iv, 12 );
+    ctx->counter.b[15] = 1;
+  } else {
+     ak_gcm_ghash_update( ctx, iv, iv_size >> 4 );
+     if( iv_size&0xf ) ak_gcm_ghash_tail( ctx, (ak_uint8 *)iv + ( iv_size&~(size_t)0xf ),
+                                                                                 iv_size&0xf );
+     ak_gcm_lengths_block( temp, 0, ( ak_uint64 )iv_size << 3 );
+     ak_gcm_ghash_update( ctx, temp, 1 );
+     ak_gcm_store( ctx->counter.b, ctx->sum );
+     ctx->sum[0] = ctx->sum[1] = 0;
+  }
+  bkey->encrypt( &bkey->key, ctx->counter.b, ctx->ej0.b );
+  ak_ptr_wipe( temp, sizeof( temp ), &bkey->key.generator );
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция обрабатывает очередной фрагмент ассоциированных данных. Если длина входных данных
+    не кратна длине блока, то это воспринимается как конец процесса обновления
+    (после этого вызов функции блокируется). Если данные кратны длине блока, то блокировки
+    не происходит -- блокировка происходит в момент вызова функции обработки
+    зашифровываемых данных.
+
+    @param ctx Контекст внутреннего состояния алгоритма
+    @param adata Указатель на ассоциированные данные
+    @param adata_size Длина ассоциированных данных в октетах
+
+    @return В случае успеха функция возвращает \ref ak_error_ok (ноль). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_gcm_context_authentication_update( ak_gcm_ctx ctx,
+                                                const ak_pointer adata, const size_t adata_size )
+{
+  size_t tail = adata_size&0xf;
+
+ /* проверка возможности обновления */
+  if( ctx->flags&ak_aead_assosiated_data_bit )
+    return ak_error_message( ak_error_wrong_block_cipher_function, __func__ ,
+                                                  "attemp to update previously closed gcm context");
+ /* ни чего не задано => ни чего не обрабатываем */
+  if(( adata == NULL ) || ( adata_size == 0 )) return ak_error_ok;
+
+  ak_gcm_ghash_update( ctx, adata, adata_size >> 4 );
+  if( tail ) {
+    ak_gcm_ghash_tail( ctx, (ak_uint8 *)adata + ( adata_size - tail ), tail );
+   /* закрываем добавление ассоциированных данных */
+    ak_aead_set_bit( ctx->flags, ak_aead_assosiated_data_bit );
+  }
+  ctx->abitlen += (( ak_uint64 )adata_size << 3 );
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция зашифровывает (расшифровывает) очередной фрагмент данных и добавляет шифртекст
+    к значению функции GHASH. Если длина входных данных не кратна длине блока, то это
+    воспринимается как конец процесса обновления (после этого вызов функции блокируется).
+
+    Блоки гаммы вырабатываются группами по \ref ak_gcm_aggregated_blocks, что позволяет
+    обрабатывать каждую группу шифртекста одним вызовом агрегированной функции GHASH.
+
+    @param ctx Контекст внутреннего состояния алгоритма
+    @param bkey Ключ блочного алгоритма шифрования
+    @param in Указатель на входные данные
+    @param out Указатель на выходные данные; может совпадать с указателем in
+    @param size Длина данных в октетах
+    @param encrypt Флаг зашифрования (ak_true) или расшифрования (ak_false) данных
+
+    @return В случае успеха функция возвращает \ref ak_error_ok (ноль). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_gcm_context_encryption_update( ak_gcm_ctx ctx, ak_bckey bkey,
+                          const ak_uint8 *in, ak_uint8 *out, const size_t size, bool_t encrypt )
+{
+  ak_int64 resource = 0;
+  size_t i = 0, count = 0, blocks = size >> 4, tail = size&0xf;
+  ak_uint64 gamma[ak_gcm_aggregated_blocks][2], x[2];
+
+ /* проверка возможности обновления */
+  if( ctx->flags&ak_aead_encrypted_data_bit )
+    return ak_error_message( ak_error_wrong_block_cipher_function, __func__ ,
+                                                  "attemp to update previously closed gcm context");
+ /* ассоциированные данные больше не принимаются */
+  ak_aead_set_bit( ctx->flags, ak_aead_assosiated_data_bit );
+  if( size == 0 ) return ak_error_ok;
+  if(( in == NULL ) || ( out == NULL ))
+    return ak_error_message( ak_error_null_pointer, __func__ , "using null pointer to data" );
+  if(( ak_uint64 )size > ak_gcm_max_data_size - ( ctx->pbitlen >> 3 ))
+    return ak_error_message( ak_error_wrong_length, __func__, "very large length of input data" );
+
+ /* проверка ресурса ключа */
+  if( bkey->key.resource.value.counter <= ( resource = ( ak_int64 )( blocks + ( tail > 0 ))))
+    return ak_error_message( ak_error_low_key_resource, __func__, "using key with low key resource");
+   else bkey->key.resource.value.counter -= resource;
+
+  for( ; blocks > 0; blocks -= count ) {
+     count = ak_min( blocks, ak_gcm_aggregated_blocks );
+     for( i = 0; i < count; i++ ) {
+        ak_gcm_increment( ctx->counter );
+        bkey->encrypt( &bkey->key, ctx->counter.b, gamma[i] );
+     }
+    /* при расшифровании значение GHASH вычисляется до того, как данные будут изменены */
+     if( !encrypt ) ak_gcm_ghash_update( ctx, in, count );
+     for( i = 0; i < count; i++, in += 16, out += 16 ) {
+        memcpy( x, in, 16 );
+        x[0] ^= gamma[i][0]; x[1] ^= gamma[i][1];
+        memcpy( out, x, 16 );
+     }
+     if( encrypt ) ak_gcm_ghash_update( ctx, out - ( count << 4 ), count );
+  }
+
+  if( tail ) {
+    ak_gcm_increment( ctx->counter );
+    bkey->encrypt( &bkey->key, ctx->counter.b, gamma[0] );
+    if( !encrypt ) ak_gcm_ghash_tail( ctx, in, tail );
+    for( i = 0; i < tail; i++ ) out[i] = in[i] ^ ((ak_uint8 *)gamma[0])[i];
+    if( encrypt ) ak_gcm_ghash_tail( ctx, out, tail );
+   /* закрываем добавление шифруемых данных */
+    ak_aead_set_bit( ctx->flags, ak_aead_encrypted_data_bit );
+  }
+  ctx->pbitlen += (( ak_uint64 )size << 3 );
+  ak_ptr_wipe( gamma, sizeof( gamma ), &bkey->key.generator );
+  ak_ptr_wipe( x, sizeof( x ), &bkey->key.generator );
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция завершает вычисления и возвращает значение имитовставки
+    T = GHASH( A || C || [ len(A) ]_64 || [ len(C) ]_64 ) xor E( J_0 ).
+
+    @param ctx Контекст внутреннего состояния алгоритма
+    @param out Указатель на область памяти, в которую помещается имитовставка
+    @param out_size Длина имитовставки в октетах; если значение больше 16,
+    то вырабатывается имитовставка длины 16 октетов
+
+    @return Функция возвращает \ref ak_error_ok в случае успешного завершения.
+    В противном случае, возвращается код ошибки.                                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_gcm_context_finalize( ak_gcm_ctx ctx, ak_pointer out, const size_t out_size )
+{
+  size_t i = 0;
+  ak_uint8 temp[16];
+
+  if( out == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                           "using null pointer to output buffer" );
+  if( out_size == 0 ) return ak_error_message( ak_error_zero_length, __func__,
+                                                      "unexpected zero length of integrity code" );
+ /* закрываем добавление данных */
+  ak_aead_set_bit( ctx->flags, ak_aead_assosiated_data_bit );
+  ak_aead_set_bit( ctx->flags, ak_aead_encrypted_data_bit );
+
+  ak_gcm_lengths_block( temp, ctx->abitlen, ctx->pbitlen );
+  ak_gcm_ghash_update( ctx, temp, 1 );
+  ak_gcm_store( temp, ctx->sum );
+  for( i = 0; i < 16; i++ ) temp[i] ^= ctx->ej0.b[i];
+  memcpy( out, temp, ak_min( out_size, 16 ));
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция выполняет зашифрование или расшифрование данных в режиме `gcm`. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_bckey_gcm( ak_pointer encryptionKey, ak_pointer authenticationKey,
+           const ak_pointer adata, const size_t adata_size, const ak_pointer in, ak_pointer out,
+                                   const size_t size, const ak_pointer iv, const size_t iv_size,
+                                     ak_pointer icode, const size_t icode_size, bool_t encrypt )
+{
+  struct gcm_ctx ctx;
+  ak_bckey bkey = NULL;
+  int error = ak_error_ok;
+
+ /* проверки ключей: режим использует один ключ, ключ имитозащиты используется
+                                               только в случае отсутствия ключа шифрования */
+  if(( encryptionKey == NULL ) && ( authenticationKey == NULL ))
+    return ak_error_message( ak_error_null_pointer, __func__ ,
+                               "using null pointers both to encryption and authentication keys" );
+  if(( encryptionKey != NULL ) && ( authenticationKey ) != NULL ) {
+    if( ((ak_bckey)encryptionKey)->bsize != ((ak_bckey)authenticationKey)->bsize )
+      return ak_error_message( ak_error_not_equal_data, __func__,
+                                                   "different block sizes for given secret keys");
+  }
+  if( encryptionKey != NULL ) bkey = encryptionKey;
+   else {
+     if(( in != NULL ) || ( out != NULL ) || ( size != 0 ))
+       return ak_error_message( ak_error_null_pointer, __func__ ,
+                                              "using null pointer to encryption key with data" );
+     bkey = authenticationKey;
+   }
+  if(( adata_size > 0 ) && ( adata == NULL ))
+    return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                          "using null pointer to associated data" );
+  if(( sizeof( size_t ) > 4 ) && (( adata_size << 3 ) >> 3 != adata_size ))
+    return ak_error_message( ak_error_wrong_length, __func__,
+                                                        "length of assosiated data is very huge");
+ /* проверяем целостность ключа */
+  if( bkey->key.check_icode( &bkey->key ) != ak_true )
+    return ak_error_message( ak_error_wrong_key_icode, __func__,
+                                                  "incorrect integrity code of secret key value" );
+ /* выполняем преобразования */
+  if(( error = ak_gcm_context_clean( &ctx, bkey, iv, iv_size )) != ak_error_ok ) {
+    ak_error_message( error, __func__, "incorrect initialization of internal gcm context" );
+    goto exit;
+  }
+  if(( error = ak_gcm_context_authentication_update( &ctx, adata, adata_size )) != ak_error_ok ) {
+    ak_error_message( error, __func__, "incorrect hashing of associated data" );
+    goto exit;
+  }
+  if(( error = ak_gcm_context_encryption_update( &ctx, bkey,
+                                                    in, out, size, encrypt )) != ak_error_ok ) {
+    ak_error_message( error, __func__, "incorrect encryption of plain data" );
+    goto exit;
+  }
+  if(( error = ak_gcm_context_finalize( &ctx, icode, icode_size )) != ak_error_ok )
+    ak_error_message( error, __func__, "incorrect finalize of integrity code" );
+
+  exit:
+   ak_ptr_wipe( &ctx, sizeof( struct gcm_ctx ), &bkey->key.generator );
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция реализует режим `gcm` (Galois/Counter Mode, NIST SP 800-38D) - режим шифрования
+    для блочного шифра с длиной блока 128 бит с одновременным вычислением имитовставки.
+    На вход функции подаются как данные, подлежащие зашифрованию, так и ассоциированные данные,
+    которые не зашифровываются. При этом имитовставка вычисляется для всех переданных
+    на вход функции данных.
+
+    Данные зашифровываются в режиме счетчика, имитовставка вычисляется с помощью функции GHASH
+    (умножение в поле \f$ \mathbb F_{2^{128}} \f$ на значение H = E( 0^128 )).
+    При наличии команды PCLMULQDQ функция GHASH обрабатывает данные группами
+    по восемь блоков с одним приведением по модулю на группу.
+
+    Режим `gcm` использует для шифрования и выработки имитовставки один ключ. Если заданы оба
+    ключа, то используется ключ шифрования. Если указатель на ключ шифрования равен `NULL`,
+    то вычисляется только имитовставка от ассоциированных данных (режим GMAC);
+    в этом случае указатели на зашифровываемые и зашифрованные данные \b должны быть равны `NULL`,
+    а длина данных \b должна быть равна нулю.
+
+    @param encryptionKey ключ шифрования, должен быть инициализирован перед вызовом функции;
+           может принимать значение NULL;
+    @param authenticationKey ключ имитозащиты, используется только в случае, если ключ
+           шифрования не задан; может принимать значение `NULL`;
+
+    @param adata указатель на ассоциированные (незашифровываемые) данные;
+    @param adata_size длина ассоциированных данных в байтах;
+    @param in указатель на зашифровываеме данные;
+    @param out указатель на зашифрованные данные; данный указатель может совпадать с указателем in;
+    @param size размер зашифровываемых данных в байтах;
+    @param iv указатель на синхропосылку;
+    @param iv_size длина синхропосылки в байтах; рекомендуемая длина равна 12 октетам;
+    @param icode указатель на область памяти, куда будет помещено значение имитовставки;
+           память должна быть выделена заранее;
+    @param icode_size ожидаемый размер имитовставки в байтах; если значение больше 16,
+           то вырабатывается имитовставка длины 16 октетов; в противном случае
+           возвращается запрашиваемое количество первых октетов имитовставки.
+
+   @return Функция возвращает \ref ak_error_ok в случае успешного завершения.
+   В противном случае, возвращается код ошибки.                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_encrypt_gcm( ak_pointer encryptionKey, ak_pointer authenticationKey,
+           const ak_pointer adata, const size_t adata_size, const ak_pointer in, ak_pointer out,
+                                   const size_t size, const ak_pointer iv, const size_t iv_size,
+                                                       ak_pointer icode, const size_t icode_size )
+{
+  int error = ak_error_ok;
+
+  if(( error = ak_bckey_gcm( encryptionKey, authenticationKey, adata, adata_size, in, out,
+                            size, iv, iv_size, icode, icode_size, ak_true )) != ak_error_ok )
+    ak_error_message( error, __func__, "incorrect encryption of plain data" );
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция реализует процедуру расшифрования с одновременной проверкой целостности зашифрованных
+    данных в режиме `gcm`. Требования к передаваемым параметрам аналогичны требованиям,
+    предъявляемым к параметрам функции ak_bckey_encrypt_gcm().
+
+    @param encryptionKey ключ шифрования, должен быть инициализирован перед вызовом функции;
+           может принимать значение `NULL`;
+    @param authenticationKey ключ имитозащиты, используется только в случае, если ключ
+           шифрования не задан; может принимать значение `NULL`;
+
+    @param adata указатель на ассоциированные (незашифровываемые) данные;
+    @param adata_size длина ассоциированных данных в байтах;
+    @param in указатель на расшифровываемые данные;
+    @param out указатель на область памяти, куда будут помещены расшифрованные данные;
+           данный указатель может совпадать с указателем in;
+    @param size размер зашифровываемых данных в байтах;
+    @param iv указатель на синхропосылку;
+    @param iv_size длина синхропосылки в байтах;
+    @param icode указатель на область памяти, в которой хранится значение имитовставки;
+    @param icode_size размер имитовставки в байтах; если значение больше 16,
+           то проверяются 16 октетов имитовставки.
+
+    @return Функция возвращает \ref ak_error_ok, если значение имитовтсавки совпало с
+            вычисленным в ходе выполнения функции значением; если значения не совпадают,
+            или в ходе выполнения функции возникла ошибка, то возвращается код ошибки.             */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_decrypt_gcm( ak_pointer encryptionKey, ak_pointer authenticationKey,
+           const ak_pointer adata, const size_t adata_size, const ak_pointer in, ak_pointer out,
+                                   const size_t size, const ak_pointer iv, const size_t iv_size,
+                                                       ak_pointer icode, const size_t icode_size )
+{
+  ak_uint8 icode2[16];
+  int error = ak_error_ok;
+
+  memset( icode2, 0, sizeof( icode2 ));
+  if( icode == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                             "using null pointer to integrity code" );
+  if(( error = ak_bckey_gcm( encryptionKey, authenticationKey, adata, adata_size, in, out,
+                          size, iv, iv_size, icode2, icode_size, ak_false )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect decryption of cipher data" );
+
+ /* сравниваем только вычисленную часть имитовставки */
+  if( ak_ptr_is_equal_with_log( icode2, icode, ak_min( icode_size, 16 ))) return ak_error_ok;
+ return ak_error_not_equal_data;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция проверяет зашифрование и расшифрование одного тестового примера. */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_libakrypt_test_gcm_example( ak_function_bckey_create *create, const char *name,
+             ak_uint8 *key, const size_t key_size, ak_uint8 *adata, const size_t adata_size,
+              ak_uint8 *plain, ak_uint8 *cipher, const size_t size, ak_uint8 *iv,
+                                const size_t iv_size, ak_uint8 *icode, const size_t icode_size )
+{
+  struct bckey bkey;
+  ak_uint8 out[128], icode2[16];
+  bool_t result = ak_false;
+  int error = ak_error_ok, audit = ak_log_get_level();
+
+  if(( error = create( &bkey )) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__, "incorrect initialization of %s secret key", name );
+    return ak_false;
+  }
+  if(( error = ak_bckey_set_key( &bkey, key, key_size )) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__, "incorrect assigning a constant value to %s key", name );
+    goto exit;
+  }
+
+ /* зашифрование */
+  memset( out, 0, sizeof( out ));
+  memset( icode2, 0, sizeof( icode2 ));
+  if(( error = ak_bckey_encrypt_gcm( &bkey, &bkey, adata, adata_size,
+                  plain, out, size, iv, iv_size, icode2, icode_size )) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__, "incorrect encryption with %s key", name );
+    goto exit;
+  }
+  if( !ak_ptr_is_equal_with_log( out, cipher, size )) {
+    ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                                                    "the encryption test for %s is wrong", name );
+    goto exit;
+  }
+  if( !ak_ptr_is_equal_with_log( icode2, icode, icode_size )) {
+    ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                                         "the value of integrity code for %s is wrong", name );
+    goto exit;
+  }
+
+ /* расшифрование на месте */
+  if(( error = ak_bckey_decrypt_gcm( &bkey, &bkey, adata, adata_size,
+                      out, out, size, iv, iv_size, icode, icode_size )) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__, "checking the integrity code for %s is wrong", name );
+    goto exit;
+  }
+  if( !ak_ptr_is_equal_with_log( out, plain, size )) {
+    ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                                                    "the decryption test for %s is wrong", name );
+    goto exit;
+  }
+
+  if( audit >= ak_log_maximum ) ak_error_message_fmt( ak_error_ok, __func__ ,
+                              "the full encryption, decryption & integrity test with %s is Ok", name );
+  result = ak_true;
+
+  exit:
+   ak_bckey_destroy( &bkey );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция сравнивает значения функции GHASH, вычисленные с агрегированным приведением
+    и по схеме Горнера.                                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_libakrypt_test_gcm_ghash( void )
+{
+  size_t i = 0;
+  struct gcm_ctx ctx;
+  ak_uint64 x[2], sum[2] = { 0, 0 };
+  ak_uint8 data[ 3*( ak_gcm_aggregated_blocks << 4 ) + 48 ];
+  const size_t blocks = sizeof( data ) >> 4;
+
+  memset( &ctx, 0, sizeof( struct gcm_ctx ));
+  for( i = 0; i < sizeof( data ); i++ ) data[i] = ( ak_uint8 )( 0x3B*i + 0x11 );
+  ctx.h[0][0] = 0x66E94BD4EF8A2C3BLL; ctx.h[0][1] = 0x884CFA59CA342B2ELL;
+  for( i = 1; i < ak_gcm_aggregated_blocks; i++ ) ak_gf128_mul( ctx.h[i], ctx.h[i-1], ctx.h[0] );
+  for( i = 0; i < ak_gcm_aggregated_blocks; i++ ) ctx.hk[i] = ctx.h[i][0]^ctx.h[i][1];
+
+  ak_gcm_ghash_update( &ctx, data, blocks );
+  for( i = 0; i < blocks; i++ ) {
+     ak_gcm_load( x, data + ( i << 4 ));
+     x[0] ^= sum[0]; x[1] ^= sum[1];
+     ak_gf128_mul( sum, x, ctx.h[0] );
+  }
+  if( !ak_ptr_is_equal_with_log( sum, ctx.sum, sizeof( sum ))) {
+    ak_error_message( ak_error_not_equal_data, __func__ ,
+                                               "the aggregated computation of ghash is wrong" );
+    return ak_false;
+  }
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \details Для алгоритма AES используются контрольные примеры 4, 6 и 16 из описания режима
+    (D. McGrew, J. Viega, The Galois/Counter Mode of Operation), для блочного шифра
+    Кузнечик - значения, вычисленные независимой реализацией режима, проверенной на указанных
+    контрольных примерах.
+
+    @return Функция возвращает ak_true в случае успешного тестирования. В противном случае
+    возвращается ak_false.                                                                         */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_libakrypt_test_gcm( void )
+{
+ /* константное значение ключа из ГОСТ Р 34.13-2015 */
+  ak_uint8 keyAnnexA[32] = {
+     0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+     0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88 };
+
+ /* открытый текст (модификация ГОСТ Р 34.13-2015, приложение А.1) */
+  ak_uint8 plain[67] = {
+     0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0x00, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11,
+     0x0A, 0xFF, 0xEE, 0xCC, 0xBB, 0xAA, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00,
+     0x00, 0x0A, 0xFF, 0xEE, 0xCC, 0xBB, 0xAA, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11,
+     0x11, 0x00, 0x0A, 0xFF, 0xEE, 0xCC, 0xBB, 0xAA, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22,
+     0xCC, 0xBB, 0xAA };
+
+ /* асссоциированные данные */
+  ak_uint8 associated[41] = {
+     0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+     0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0xEA };
+
+  ak_uint8 iv128[12] = {
+     0xBB, 0xAA, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00 };
+
+  ak_uint8 cipherKuznechik[67] = {
+     0xA9, 0xE9, 0x07, 0x47, 0x7E, 0x37, 0xD6, 0x57, 0xC1, 0x61, 0xAE, 0x0D, 0xBB, 0x19, 0xB0, 0xF3,
+     0xC4, 0xF8, 0xDB, 0x2F, 0x8D, 0x86, 0x28, 0xA9, 0x55, 0xF1, 0x90, 0xF8, 0xA3, 0xD2, 0xDF, 0x2B,
+     0x89, 0xA9, 0x0D, 0x1A, 0xC2, 0xEA, 0x2B, 0xC3, 0x38, 0xFF, 0xE3, 0x1C, 0x5B, 0x7C, 0x36, 0xAD,
+     0xC6, 0xAE, 0x12, 0x51, 0x11, 0x95, 0x3B, 0xA4, 0x06, 0x16, 0x38, 0xD5, 0x58, 0x73, 0xA9, 0x69,
+     0xEA, 0xB8, 0x2C };
+  ak_uint8 icodeKuznechik[16] = {
+     0x5C, 0x57, 0xF1, 0xA2, 0xF8, 0x0C, 0xAD, 0xCC, 0x20, 0xE7, 0xBA, 0x5F, 0x99, 0xCD, 0x4D, 0x28 };
+
+ /* контрольные примеры для AES */
+  ak_uint8 keyAES[32] = {
+     0xFE, 0xFF, 0xE9, 0x92, 0x86, 0x65, 0x73, 0x1C, 0x6D, 0x6A, 0x8F, 0x94, 0x67, 0x30, 0x83, 0x08,
+     0xFE, 0xFF, 0xE9, 0x92, 0x86, 0x65, 0x73, 0x1C, 0x6D, 0x6A, 0x8F, 0x94, 0x67, 0x30, 0x83, 0x08 };
+  ak_uint8 plainAES[60] = {
+     0xD9, 0x31, 0x32, 0x25, 0xF8, 0x84, 0x06, 0xE5, 0xA5, 0x59, 0x09, 0xC5, 0xAF, 0xF5, 0x26, 0x9A,
+     0x86, 0xA7, 0xA9, 0x53, 0x15, 0x34, 0xF7, 0xDA, 0x2E, 0x4C, 0x30, 0x3D, 0x8A, 0x31, 0x8A, 0x72,
+     0x1C, 0x3C, 0x0C, 0x95, 0x95, 0x68, 0x09, 0x53, 0x2F, 0xCF, 0x0E, 0x24, 0x49, 0xA6, 0xB5, 0x25,
+     0xB1, 0x6A, 0xED, 0xF5, 0xAA, 0x0D, 0xE6, 0x57, 0xBA, 0x63, 0x7B, 0x39 };
+  ak_uint8 associatedAES[20] = {
+     0xFE, 0xED, 0xFA, 0xCE, 0xDE, 0xAD, 0xBE, 0xEF, 0xFE, 0xED, 0xFA, 0xCE, 0xDE, 0xAD, 0xBE, 0xEF,
+     0xAB, 0xAD, 0xDA, 0xD2 };
+  ak_uint8 ivAES[12] = {
+     0xCA, 0xFE, 0xBA, 0xBE, 0xFA, 0xCE, 0xDB, 0xAD, 0xDE, 0xCA, 0xF8, 0x88 };
+  ak_uint8 ivAESlong[60] = {
+     0x93, 0x13, 0x22, 0x5D, 0xF8, 0x84, 0x06, 0xE5, 0x55, 0x90, 0x9C, 0x5A, 0xFF, 0x52, 0x69, 0xAA,
+     0x6A, 0x7A, 0x95, 0x38, 0x53, 0x4F, 0x7D, 0xA1, 0xE4, 0xC3, 0x03, 0xD2, 0xA3, 0x18, 0xA7, 0x28,
+     0xC3, 0xC0, 0xC9, 0x51, 0x56, 0x80, 0x95, 0x39, 0xFC, 0xF0, 0xE2, 0x42, 0x9A, 0x6B, 0x52, 0x54,
+     0x16, 0xAE, 0xDB, 0xF5, 0xA0, 0xDE, 0x6A, 0x57, 0xA6, 0x37, 0xB3, 0x9B };
+
+  ak_uint8 cipherAES128[60] = {
+     0x42, 0x83, 0x1E, 0xC2, 0x21, 0x77, 0x74, 0x24, 0x4B, 0x72, 0x21, 0xB7, 0x84, 0xD0, 0xD4, 0x9C,
+     0xE3, 0xAA, 0x21, 0x2F, 0x2C, 0x02, 0xA4, 0xE0, 0x35, 0xC1, 0x7E, 0x23, 0x29, 0xAC, 0xA1, 0x2E,
+     0x21, 0xD5, 0x14, 0xB2, 0x54, 0x66, 0x93, 0x1C, 0x7D, 0x8F, 0x6A, 0x5A, 0xAC, 0x84, 0xAA, 0x05,
+     0x1B, 0xA3, 0x0B, 0x39, 0x6A, 0x0A, 0xAC, 0x97, 0x3D, 0x58, 0xE0, 0x91 };
+  ak_uint8 icodeAES128[16] = {
+     0x5B, 0xC9, 0x4F, 0xBC, 0x32, 0x21, 0xA5, 0xDB, 0x94, 0xFA, 0xE9, 0x5A, 0xE7, 0x12, 0x1A, 0x47 };
+
+  ak_uint8 cipherAES128long[60] = {
+     0x8C, 0xE2, 0x49, 0x98, 0x62, 0x56, 0x15, 0xB6, 0x03, 0xA0, 0x33, 0xAC, 0xA1, 0x3F, 0xB8, 0x94,
+     0xBE, 0x91, 0x12, 0xA5, 0xC3, 0xA2, 0x11, 0xA8, 0xBA, 0x26, 0x2A, 0x3C, 0xCA, 0x7E, 0x2C, 0xA7,
+     0x01, 0xE4, 0xA9, 0xA4, 0xFB, 0xA4, 0x3C, 0x90, 0xCC, 0xDC, 0xB2, 0x81, 0xD4, 0x8C, 0x7C, 0x6F,
+     0xD6, 0x28, 0x75, 0xD2, 0xAC, 0xA4, 0x17, 0x03, 0x4C, 0x34, 0xAE, 0xE5 };
+  ak_uint8 icodeAES128long[16] = {
+     0x61, 0x9C, 0xC5, 0xAE, 0xFF, 0xFE, 0x0B, 0xFA, 0x46, 0x2A, 0xF4, 0x3C, 0x16, 0x99, 0xD0, 0x50 };
+
+  ak_uint8 cipherAES256[60] = {
+     0x52, 0x2D, 0xC1, 0xF0, 0x99, 0x56, 0x7D, 0x07, 0xF4, 0x7F, 0x37, 0xA3, 0x2A, 0x84, 0x42, 0x7D,
+     0x64, 0x3A, 0x8C, 0xDC, 0xBF, 0xE5, 0xC0, 0xC9, 0x75, 0x98, 0xA2, 0xBD, 0x25, 0x55, 0xD1, 0xAA,
+     0x8C, 0xB0, 0x8E, 0x48, 0x59, 0x0D, 0xBB, 0x3D, 0xA7, 0xB0, 0x8B, 0x10, 0x56, 0x82, 0x88, 0x38,
+     0xC5, 0xF6, 0x1E, 0x63, 0x93, 0xBA, 0x7A, 0x0A, 0xBC, 0xC9, 0xF6, 0x62 };
+  ak_uint8 icodeAES256[16] = {
+     0x76, 0xFC, 0x6E, 0xCE, 0x0F, 0x4E, 0x17, 0x68, 0xCD, 0xDF, 0x88, 0x53, 0xBB, 0x2D, 0x55, 0x1B };
+
+  int audit = ak_log_get_level();
+
+  if( ak_libakrypt_test_gcm_ghash() != ak_true ) return ak_false;
+  if( ak_libakrypt_test_gcm_example( ak_bckey_create_aes128, "aes128", keyAES, 16,
+        associatedAES, sizeof( associatedAES ), plainAES, cipherAES128, sizeof( plainAES ),
+                        ivAES, sizeof( ivAES ), icodeAES128, sizeof( icodeAES128 )) != ak_true )
+    return ak_false;
+  if( ak_libakrypt_test_gcm_example( ak_bckey_create_aes128, "aes128", keyAES, 16,
+        associatedAES, sizeof( associatedAES ), plainAES, cipherAES128long, sizeof( plainAES ),
+            ivAESlong, sizeof( ivAESlong ), icodeAES128long, sizeof( icodeAES128long )) != ak_true )
+    return ak_false;
+  if( ak_libakrypt_test_gcm_example( ak_bckey_create_aes256, "aes256", keyAES, 32,
+        associatedAES, sizeof( associatedAES ), plainAES, cipherAES256, sizeof( plainAES ),
+                        ivAES, sizeof( ivAES ), icodeAES256, sizeof( icodeAES256 )) != ak_true )
+    return ak_false;
+  if( ak_libakrypt_test_gcm_example( ak_bckey_create_kuznechik, "kuznechik", keyAnnexA, 32,
+        associated, sizeof( associated ), plain, cipherKuznechik, sizeof( plain ),
+                  iv128, sizeof( iv128 ), icodeKuznechik, sizeof( icodeKuznechik )) != ak_true )
+    return ak_false;
+
+  if( audit >= ak_log_maximum )
+    ak_error_message( ak_error_ok, __func__ , "testing gcm mode ended successfully" );
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                                                                                       ak_gcm.c  */
+/* ----------------------------------------------------------------------------------------------- */
@@ -1,572 +1,1256 @@
+/* ----------------------------------------------------------------------------------------------- */
 /*  Файл ak_keccak.c                                                                               */
-/*  - содержит реализацию алгоритмов SHA3-224, SHA3-256, SHA3-384, SHA3-512.
-    Основано на документации NIST https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf         */
-/* ----------------------------------------------------------------------------------------------- */
-
-#include <libakrypt.h>
-
-//Набор констант. Применяются на шаге IOTA
-static const ak_uint64 keccak_rc[24] = {
-        0x0000000000000001,
-        0x0000000000008082,
-        0x800000000000808A,
-        0x8000000080008000,
-        0x000000000000808B,
-        0x0000000080000001,
-        0x8000000080008081,
-        0x8000000000008009,
-        0x000000000000008A,
-        0x0000000000000088,
-        0x0000000080008009,
-        0x000000008000000A,
-        0x000000008000808B,
-        0x800000000000008B,
-        0x8000000000008089,
-        0x8000000000008003,
-        0x8000000000008002,
-        0x8000000000000080,
-        0x000000000000800A,
-        0x800000008000000A,
-        0x8000000080008081,
-        0x8000000000008080,
-        0x0000000080000001,
-        0x8000000080008008
-};
-
-
-/* ----------------------------------------------------------------------------------------------- */
-/*! \brief Вычисление модуля - на случай, когда a < 0. Применяется на шаге THETA                   */
-/* ----------------------------------------------------------------------------------------------- */
-static int mod(int a, int b) {
-
-    int c;
-    if (a >= 0) c = a % b;
-    else {
-        c = (a / b) * (-1);
-        c = b * (c + 1);
-        c = c + a;
-    }
-    return c;
+/*  - содержит реализацию губки Keccak, функций хеширования SHA3-224, SHA3-256, SHA3-384, SHA3-512, */
+/*    а также функций с расширяемым выходом SHAKE128, SHAKE256 и cSHAKE.                           */
+/*    Основано на документации NIST https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf       */
+/*    и NIST SP 800-185 https://doi.org/10.6028/NIST.SP.800-185                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <libakrypt-internal.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+#ifdef AK_HAVE_STRING_H
+ #include <string.h>
+#else
+ #error Library cannot be compiled without string.h header
+#endif
+#ifdef AK_HAVE_BUILTIN_MM256_SLL
+ #include <immintrin.h>
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Константы, применяемые на шаге ι (IOTA) перестановки Keccak-f[1600]. */
+ static const ak_uint64 keccak_rc[24] = {
+        0x0000000000000001LL, 0x0000000000008082LL, 0x800000000000808ALL, 0x8000000080008000LL,
+        0x000000000000808BLL, 0x0000000080000001LL, 0x8000000080008081LL, 0x8000000000008009LL,
+        0x000000000000008ALL, 0x0000000000000088LL, 0x0000000080008009LL, 0x000000008000000ALL,
+        0x000000008000808BLL, 0x800000000000008BLL, 0x8000000000008089LL, 0x8000000000008003LL,
+        0x8000000000008002LL, 0x8000000000000080LL, 0x000000000000800ALL, 0x800000008000000ALL,
+        0x8000000080008081LL, 0x8000000000008080LL, 0x0000000080000001LL, 0x8000000080008008LL
+ };
+
+/*! \brief Величины циклических сдвигов, применяемые на шаге ρ (RO). Значения перечислены
+    в порядке обхода слов состояния, задаваемого шагом π (PI). */
+ static const ak_uint8 keccak_rho[24] = {
+         1,  3,  6, 10, 15, 21, 28, 36, 45, 55,  2, 14, 27, 41, 56,  8, 25, 43, 62, 18, 39, 61, 20, 44
+ };
+
+/*! \brief Индексы слов состояния в порядке обхода, задаваемого шагом π (PI). */
+ static const ak_uint8 keccak_pi[24] = {
+        10,  7, 11, 17, 18,  3,  5, 16,  8, 21, 24,  4, 15, 23, 19, 13, 12,  2, 20, 14, 22,  9,  6,  1
+ };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Циклический сдвиг 64-х битного слова влево. */
+ #define ak_keccak_rotl( x, n ) ((( x ) << ( n )) | (( x ) >> ( 64 - ( n ))))
+
+/*! \brief Доступ к октету с номером i внутреннего состояния губки. */
+#ifdef AK_LITTLE_ENDIAN
+ #define ak_keccak_byte( st, i ) ((( ak_uint8 *)( st ))[( i )])
+#else
+ #define ak_keccak_byte( st, i ) ((( ak_uint8 *)( st ))[( i )^7])
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Перестановка Keccak-f[1600]. */
+/*! Функция реализует 24 раунда преобразования, каждый из которых состоит из последовательного
+    применения шагов θ, ρ, π, χ и ι (см. FIPS 202, раздел 3.2). Шаги ρ и π объединены и
+    выполняются за один проход по словам состояния.
+
+    @param st Указатель на внутреннее состояние губки, состоящее из 25 64-х битных слов.            */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_keccak_permutation( ak_uint64 *st )
+{
+  int i, j, r;
+  ak_uint64 t, bc[5];
+
+  for( r = 0; r < 24; r++ ) {
+    /* шаг θ */
+     for( i = 0; i < 5; i++ ) bc[i] = st[i] ^ st[i+5] ^ st[i+10] ^ st[i+15] ^ st[i+20];
+     for( i = 0; i < 5; i++ ) {
+        t = bc[(i+4)%5] ^ ak_keccak_rotl( bc[(i+1)%5], 1 );
+        for( j = 0; j < 25; j += 5 ) st[j+i] ^= t;
+     }
+    /* шаги ρ и π */
+     t = st[1];
+     for( i = 0; i < 24; i++ ) {
+        j = keccak_pi[i];
+        bc[0] = st[j];
+        st[j] = ak_keccak_rotl( t, keccak_rho[i] );
+        t = bc[0];
+     }
+    /* шаг χ */
+     for( j = 0; j < 25; j += 5 ) {
+        for( i = 0; i < 5; i++ ) bc[i] = st[j+i];
+        for( i = 0; i < 5; i++ ) st[j+i] ^= ( ~bc[(i+1)%5] ) & bc[(i+2)%5];
+     }
+    /* шаг ι */
+     st[0] ^= keccak_rc[r];
+  }
 }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Циклический сдвиг. Применяется на шагах THETA, RO.                                      */
+/*! \brief Сложение блока входных данных длины rate с внутренним состоянием губки. */
 /* ----------------------------------------------------------------------------------------------- */
-static ak_uint64 rotation(ak_uint64 x, int numBits) {
-    return ((x << numBits) | (x >> (64 - numBits)));
+ static inline void ak_keccak_xor_block( ak_uint64 *st, const ak_uint8 *in, const size_t rate )
+{
+  size_t i = 0;
+#ifdef AK_LITTLE_ENDIAN
+  ak_uint64 w;
+  for( i = 0; i < ( rate >> 3 ); i++ ) {
+     memcpy( &w, in + ( i << 3 ), sizeof( ak_uint64 ));
+     st[i] ^= w;
+  }
+#else
+  for( i = 0; i < rate; i++ ) ak_keccak_byte( st, i ) ^= in[i];
+#endif
 }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Первый шаг функции перестановки алгоритма - θ, THETA. Описание:
-  https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf 3.2.1 Specification of θ стр. 11-12.    */
+/*! \brief Впитывание одного октета с учетом текущей позиции внутри блока. */
 /* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_keccak_absorb_byte( ak_keccak kctx, const ak_uint8 value )
+{
+  ak_keccak_byte( kctx->st, kctx->pos ) ^= value;
+  if( ++kctx->pos == kctx->rate ) {
+    ak_keccak_permutation( kctx->st );
+    kctx->pos = 0;
+  }
+}
 
-static inline void Theta(ak_uint64 A[5][5]) {
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Дополнение последнего блока и перевод губки в режим выработки выходных данных. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_keccak_pad( ak_keccak kctx )
+{
+  ak_keccak_byte( kctx->st, kctx->pos ) ^= kctx->padding;
+  ak_keccak_byte( kctx->st, kctx->rate - 1 ) ^= 0x80;
+  ak_keccak_permutation( kctx->st );
+  kctx->pos = 0;
+  kctx->squeezing = ak_true;
+}
 
-    int x, y;
-    ak_uint64 C[5];
-    ak_uint64 D[5];
-    for (x = 0; x < 5; x++) {
-        C[x] = A[x][0] ^ A[x][1] ^ A[x][2] ^ A[x][3] ^ A[x][4];
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Выработка выходных данных без каких-либо проверок. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_keccak_squeeze_internal( ak_keccak kctx, ak_uint8 *out, size_t size )
+{
+  size_t len = 0;
+
+  if( !kctx->squeezing ) ak_keccak_pad( kctx );
+  while( size > 0 ) {
+    if( kctx->pos == kctx->rate ) {
+      ak_keccak_permutation( kctx->st );
+      kctx->pos = 0;
     }
-
-    for (x = 0; x < 5; x++) {
-        D[x] = C[mod(x - 1, 5)] ^ rotation(C[mod(x + 1, 5)], 1);
+    len = ak_min( size, kctx->rate - kctx->pos );
+   #ifdef AK_LITTLE_ENDIAN
+    memcpy( out, ( ak_uint8 *)kctx->st + kctx->pos, len );
+    kctx->pos += len;
+   #else
+    { size_t i = 0;
+      for( i = 0; i < len; i++ ) out[i] = ak_keccak_byte( kctx->st, kctx->pos++ );
     }
+   #endif
+    out += len;
+    size -= len;
+  }
+}
 
-    for (x = 0; x < 5; x++) {
-        for (y = 0; y < 5; y++) {
-            A[x][y] = A[x][y] ^ D[x];
-        }
-    }
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Впитывание натурального числа в формате left_encode (NIST SP 800-185, раздел 2.3.1). */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_keccak_absorb_left_encode( ak_keccak kctx, const ak_uint64 value )
+{
+  int i, n = 1;
+  while(( n < 8 ) && ( value >> ( n << 3 ))) n++;
+
+  ak_keccak_absorb_byte( kctx, ( ak_uint8 )n );
+  for( i = n-1; i >= 0; i-- ) ak_keccak_absorb_byte( kctx, ( ak_uint8 )( value >> ( i << 3 )));
 }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Второй шаг функции перестановки алгоритма -  ρ, RO. Описание:
-  https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf 3.2.2 Specification of ρ стр. 12-13.    */
+/*! \brief Дополнение впитанных данных нулями до длины, кратной размеру блока (bytepad). */
 /* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_keccak_absorb_zero_pad( ak_keccak kctx )
+{
+  if( kctx->pos != 0 ) {
+    ak_keccak_permutation( kctx->st );
+    kctx->pos = 0;
+  }
+}
 
-static inline void Ro(ak_uint64 A[5][5]) {
-    int x = 1;
-    int y = 0;
-    int x1;
-    for (int t = 0; t < 24; t++) {
-        A[x][y] = rotation(A[x][y], ((t + 1) * (t + 2) / 2) % 64);
-        x1 = x;
-        x = y;
-        y = mod(2 * x1 + 3 * y, 5);
-    }
+/* ----------------------------------------------------------------------------------------------- */
+/*! @param kctx Контекст губки Keccak.
+    @param value Впитываемое натуральное число.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_keccak_absorb_right_encode( ak_keccak kctx, const size_t value )
+{
+  int i, n = 1;
+  ak_uint64 val = ( ak_uint64 )value;
+
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                          "using null pointer to keccak context" );
+  if( kctx->squeezing ) return ak_error_message( ak_error_not_ready, __func__,
+                                                 "absorbing data into squeezing keccak context" );
+  while(( n < 8 ) && ( val >> ( n << 3 ))) n++;
+  for( i = n-1; i >= 0; i-- ) ak_keccak_absorb_byte( kctx, ( ak_uint8 )( val >> ( i << 3 )));
+  ak_keccak_absorb_byte( kctx, ( ak_uint8 )n );
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция впитывает строку bytepad( encode_string( K ), rate ), где K - значение секретного
+    ключа. Маска снимается непосредственно в момент сложения ключа с внутренним состоянием губки,
+    поэтому ключ в явном виде во временной памяти не появляется.
+
+    @param kctx Контекст губки Keccak.
+    @param skey Контекст секретного ключа, значение которого должно быть установлено.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_keccak_absorb_skey( ak_keccak kctx, ak_skey skey )
+{
+  size_t idx = 0;
+
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                          "using null pointer to keccak context" );
+  if( skey == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                      "using null pointer to secret key context" );
+  if( kctx->squeezing ) return ak_error_message( ak_error_not_ready, __func__,
+                                                 "absorbing data into squeezing keccak context" );
+  ak_keccak_absorb_left_encode( kctx, kctx->rate );
+  ak_keccak_absorb_left_encode( kctx, (( ak_uint64 )skey->key_size ) << 3 );
+  for( idx = 0; idx < skey->key_size; idx++ )
+     ak_keccak_absorb_byte( kctx, skey->key[idx] ^ skey->key[idx + skey->key_size] );
+  ak_keccak_absorb_zero_pad( kctx );
+
+ return ak_error_ok;
 }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Третий шаг функции перестановки алгоритма - π, PI. Описание:
-  https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf 3.2.3 Specification of π стр. 14.       */
+/*! \brief Инициализация полей контекста губки Keccak. */
 /* ----------------------------------------------------------------------------------------------- */
+ static int ak_keccak_create( ak_keccak kctx, const size_t rate,
+                                                  const size_t hsize, ak_uint8 padding, bool_t xof )
+{
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                          "using null pointer to keccak context" );
+  memset( kctx->st, 0, sizeof( kctx->st ));
+  kctx->rate = rate;
+  kctx->hsize = hsize;
+  kctx->pos = 0;
+  kctx->padding = padding;
+  kctx->xof = xof;
+  kctx->squeezing = ak_false;
+
+ return ak_error_ok;
+}
 
-static inline void Pi(ak_uint64 A[5][5]) {
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция инициализирует контекст функции SHAKE128 с расширяемым выходом (FIPS 202, раздел 6.2).
+    Размер блока входных данных составляет 168 октетов.
 
-    int x, y;
-    ak_uint64 A1[5][5];
-    for (x = 0; x < 5; x++) {
-        for (y = 0; y < 5; y++) {
-            A1[x][y] = A[x][y];
-        }
-    }
+    @param kctx Контекст губки Keccak.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_keccak_create_shake128( ak_keccak kctx )
+{ return ak_keccak_create( kctx, 168, 32, 0x1f, ak_true ); }
 
-    for (x = 0; x < 5; x++) {
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция инициализирует контекст функции SHAKE256 с расширяемым выходом (FIPS 202, раздел 6.2).
+    Размер блока входных данных составляет 136 октетов.
 
-        for (y = 0; y < 5; y++) {
-            A[x][y] = A1[mod(x + 3 * y, 5)][x];
-        }
+    @param kctx Контекст губки Keccak.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_keccak_create_shake256( ak_keccak kctx )
+{ return ak_keccak_create( kctx, 136, 64, 0x1f, ak_true ); }
 
-    }
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция инициализирует контекст функции cSHAKE (NIST SP 800-185, раздел 3) и впитывает
+    строку bytepad( encode_string( N ) || encode_string( S ), rate ). Если обе строки пусты,
+    то, в соответствии со стандартом, функция cSHAKE совпадает с функцией SHAKE.
+
+    @param kctx Контекст губки Keccak.
+    @param rate Размер блока входных данных: 168 октетов для cSHAKE128 и 136 октетов для cSHAKE256.
+    @param name Имя функции (строка N).
+    @param name_size Длина имени функции в октетах.
+    @param custom Строка настройки (строка S).
+    @param custom_size Длина строки настройки в октетах.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_keccak_create_cshake( ak_keccak kctx, const size_t rate, const ak_pointer name,
+                      const size_t name_size, const ak_pointer custom, const size_t custom_size )
+{
+  int error = ak_error_ok;
+
+  if(( rate != 168 ) && ( rate != 136 )) return ak_error_message( ak_error_wrong_length,
+                                                   __func__, "using unsupported keccak rate value" );
+  if(( name_size != 0 ) && ( name == NULL )) return ak_error_message( ak_error_null_pointer,
+                                                     __func__, "using null pointer to function name" );
+  if(( custom_size != 0 ) && ( custom == NULL )) return ak_error_message( ak_error_null_pointer,
+                                                __func__, "using null pointer to customization string" );
+  if(( name_size == 0 ) && ( custom_size == 0 ))
+    return ak_keccak_create( kctx, rate, rate == 168 ? 32 : 64, 0x1f, ak_true );
+
+  if(( error = ak_keccak_create( kctx, rate,
+                                        rate == 168 ? 32 : 64, 0x04, ak_true )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect creation of keccak context" );
+
+  ak_keccak_absorb_left_encode( kctx, rate );
+  ak_keccak_absorb_left_encode( kctx, (( ak_uint64 )name_size ) << 3 );
+  ak_keccak_absorb( kctx, name, name_size );
+  ak_keccak_absorb_left_encode( kctx, (( ak_uint64 )custom_size ) << 3 );
+  ak_keccak_absorb( kctx, custom, custom_size );
+  ak_keccak_absorb_zero_pad( kctx );
+
+ return ak_error_ok;
 }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Четвертый шаг функции перестановки алгоритма - χ, CHI. Описание:
-  https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf 3.2.4 Specification of χ стр. 15.       */
+/*! @param kctx Контекст губки Keccak.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
 /* ----------------------------------------------------------------------------------------------- */
+ int ak_keccak_destroy( ak_keccak kctx )
+{
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                       "destroying null pointer to keccak context" );
+  memset( kctx, 0, sizeof( struct keccak ));
+ return ak_error_ok;
+}
 
-static inline void Chi(ak_uint64 A[5][5]) {
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция обнуляет внутреннее состояние губки и переводит ее в режим впитывания данных.
+    \note Для контекстов cSHAKE строка настройки после очистки должна быть впитана повторно.
 
-    int x, y;
-    ak_uint64 A1[5][5];
-    for (x = 0; x < 5; x++) {
-        for (y = 0; y < 5; y++) {
-            A1[x][y] = A[x][y];
-        }
-    }
+    @param kctx Контекст губки Keccak.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_keccak_clean( ak_keccak kctx )
+{
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                          "using null pointer to keccak context" );
+  memset( kctx->st, 0, sizeof( kctx->st ));
+  kctx->pos = 0;
+  kctx->squeezing = ak_false;
+
+ return ak_error_ok;
+}
 
-    for (x = 0; x < 5; x++) {
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция может вызываться многократно с данными произвольной длины до первого вызова функции
+    ak_keccak_squeeze().
+
+    @param kctx Контекст губки Keccak.
+    @param in Указатель на впитываемые данные.
+    @param size Размер впитываемых данных (в октетах).
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_keccak_absorb( ak_keccak kctx, const ak_pointer in, const size_t size )
+{
+  size_t offset = 0;
+  ak_uint8 *ptr = ( ak_uint8 *) in;
+
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                          "using null pointer to keccak context" );
+  if( kctx->squeezing ) return ak_error_message( ak_error_not_ready, __func__,
+                                                 "absorbing data into squeezing keccak context" );
+  if( !size ) return ak_error_ok;
+  if( in == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                               "using null pointer to input data" );
+ /* дополняем ранее начатый блок */
+  while(( kctx->pos != 0 ) && ( offset < size )) ak_keccak_absorb_byte( kctx, ptr[offset++] );
+
+ /* обрабатываем полные блоки */
+  while( size - offset >= kctx->rate ) {
+    ak_keccak_xor_block( kctx->st, ptr + offset, kctx->rate );
+    ak_keccak_permutation( kctx->st );
+    offset += kctx->rate;
+  }
+
+ /* хвост оставляем во внутреннем состоянии */
+  while( offset < size ) ak_keccak_absorb_byte( kctx, ptr[offset++] );
+
+ return ak_error_ok;
+}
 
-        for (y = 0; y < 5; y++) {
-            A[x][y] = A1[x][y] ^ ((~A1[mod((x + 1), 5)][y]) & A1[mod((x + 2), 5)][y]);
-        }
+/* ----------------------------------------------------------------------------------------------- */
+/*! При первом вызове функция дополняет впитанные данные и переводит губку в режим выработки
+    выходной последовательности. Последовательные вызовы функции вырабатывают последовательные
+    фрагменты одной и той же выходной последовательности, то есть результат не зависит от того,
+    какими фрагментами запрашиваются выходные данные.
+
+    @param kctx Контекст губки Keccak.
+    @param out Указатель на область памяти, в которую помещаются выходные данные.
+    @param size Размер вырабатываемых данных (в октетах).
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_keccak_squeeze( ak_keccak kctx, ak_pointer out, const size_t size )
+{
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                          "using null pointer to keccak context" );
+  if( !size ) return ak_error_ok;
+  if( out == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                              "using null pointer to output data" );
+  if( !kctx->xof && ( kctx->squeezing || ( size > kctx->hsize )))
+    return ak_error_message( ak_error_wrong_length, __func__,
+                                  "using fixed length hash function with a huge output length" );
+  ak_keccak_squeeze_internal( kctx, out, size );
+
+ return ak_error_ok;
+}
 
-    }
+/* ----------------------------------------------------------------------------------------------- */
+/*                     Функции итерационного сжатия для класса hash                                */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_hash_context_keccak_clean( ak_pointer kctx )
+{
+  if( kctx == NULL ) return ak_error_null_pointer;
+ return ak_keccak_clean( ( ak_keccak ) kctx );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Пятый шаг функции перестановки алгоритма - ι, IOTA. Описание:
-  https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf 3.2.4 Specification of ι стр. 15-16. 
-  Значения rc вычислены отдельно и сохранены в массиве ak_uint64 keccak_rc[24].                    */
+ static int ak_hash_context_keccak_update( ak_pointer ctx, const ak_pointer in, const size_t size )
+{
+  size_t offset = 0;
+  ak_keccak kctx = ( ak_keccak ) ctx;
+
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                 "using null pointer to internal keccak context" );
+  if(( !size ) || ( in == NULL )) return ak_error_ok;
+  if( size%kctx->rate ) return ak_error_message( ak_error_wrong_length, __func__,
+                                      "data length is not a multiple of the length of the block" );
+  do{
+     ak_keccak_xor_block( kctx->st, ( ak_uint8 *)in + offset, kctx->rate );
+     ak_keccak_permutation( kctx->st );
+     offset += kctx->rate;
+  } while( offset < size );
+
+ return ak_error_ok;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
+ static int ak_hash_context_keccak_finalize( ak_pointer ctx,
+                   const ak_pointer in, const size_t size, ak_pointer out, const size_t out_size )
+{
+  ak_keccak kctx = ( ak_keccak ) ctx;
+  struct keccak kx; /* структура для хранения копии текущего состояния контекста */
+
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                 "using null pointer to internal keccak context" );
+  if( out == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                   "using null pointer to externl result buffer" );
+  if( size >= kctx->rate ) return ak_error_message( ak_error_wrong_length, __func__,
+                                                                      "input length is too huge" );
+ /* при финализации мы изменяем копию существующей структуры */
+  memcpy( &kx, kctx, sizeof( struct keccak ));
+  ak_keccak_absorb( &kx, in, size );
+
+ /* для функций с расширяемым выходом вырабатываем столько данных, сколько запрошено */
+  ak_keccak_squeeze_internal( &kx, out, kx.xof ? out_size : ak_min( kx.hsize, out_size ));
+  memset( &kx, 0, sizeof( struct keccak ));
+
+ return ak_error_ok;
+}
 
-static inline void Iota(ak_uint64 A[5][5], int i) {
-    A[0][0] = A[0][0] ^ keccak_rc[i];
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Общая часть инициализации контекстов функций хеширования семейства SHA-3. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_hash_create_keccak( ak_hash hctx, const char *name,
+                                 const size_t rate, const size_t hsize, ak_uint8 padding, bool_t xof )
+{
+  int error = ak_error_ok;
+  if( hctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                            "using null pointer to hash context" );
+  if(( hctx->oid = ak_oid_find_by_name( name )) == NULL )
+    return ak_error_message_fmt( ak_error_wrong_oid, __func__,
+                                                 "incorrect internal search of %s identifier", name );
+  if(( error = ak_keccak_create( &hctx->data.kctx, rate, hsize, padding, xof )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect initialization of keccak context" );
+
+  if(( error = ak_mac_create( &hctx->mctx, rate, &hctx->data.kctx,
+                                             ak_hash_context_keccak_clean,
+                                             ak_hash_context_keccak_update,
+                                             ak_hash_context_keccak_finalize )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect initialization of internal mac context" );
+
+ return error;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция инициализирует контекст алгоритма бесключевого хеширования SHA3-224 (FIPS 202).
 
+    @param hctx Контекст функции хеширования
+    @return Функция возвращает код ошибки или \ref ak_error_ok (в случае успеха)                   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_create_sha3_224( ak_hash hctx )
+{ return ak_hash_create_keccak( hctx, "sha3-224", 144, 28, 0x06, ak_false ); }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Функция "трансформирует" исходный блок сообщения, состоящий из последовательности байт, 
-  (суммарно 200 элементов = 1600 бит) в трехмерный массив 5х5х64 бит, т.е. ak_uint64 [5][5], для 
-  дальнейшего применения функции перестановки алгоритма                                            */
+/*! Функция инициализирует контекст алгоритма бесключевого хеширования SHA3-256 (FIPS 202).
+
+    @param hctx Контекст функции хеширования
+    @return Функция возвращает код ошибки или \ref ak_error_ok (в случае успеха)                   */
 /* ----------------------------------------------------------------------------------------------- */
-static inline void three_dimensional_array(ak_keccak sha, ak_uint64 A[5][5]) {
-    int x, y, z;
-    int bn = 199; 
-    for (x = 4; x >= 0; x--) {
+ int ak_hash_create_sha3_256( ak_hash hctx )
+{ return ak_hash_create_keccak( hctx, "sha3-256", 136, 32, 0x06, ak_false ); }
 
-        for (y = 4; y >= 0; y--) {
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция инициализирует контекст алгоритма бесключевого хеширования SHA3-384 (FIPS 202).
 
-            for (z = 0; z < 8; z++) {
-                A[y][x] = ((A[y][x] << 8) | (sha.block[bn]));
-                bn -= 1;
-            }
+    @param hctx Контекст функции хеширования
+    @return Функция возвращает код ошибки или \ref ak_error_ok (в случае успеха)                   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_create_sha3_384( ak_hash hctx )
+{ return ak_hash_create_keccak( hctx, "sha3-384", 104, 48, 0x06, ak_false ); }
 
-        }
-    }
-}
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция инициализирует контекст алгоритма бесключевого хеширования SHA3-512 (FIPS 202).
 
+    @param hctx Контекст функции хеширования
+    @return Функция возвращает код ошибки или \ref ak_error_ok (в случае успеха)                   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_create_sha3_512( ak_hash hctx )
+{ return ak_hash_create_keccak( hctx, "sha3-512", 72, 64, 0x06, ak_false ); }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Функция заполняет промежуточный блок в 1600 бит                                         */
+/*! Функция инициализирует контекст функции SHAKE128 как функции хеширования с длиной хеш-кода
+    256 бит (см. RFC 8702). При вызове ak_hash_finalize() вырабатывается столько
+    выходных данных, сколько запрошено; первые 32 октета совпадают с хеш-кодом.
+
+    @param hctx Контекст функции хеширования
+    @return Функция возвращает код ошибки или \ref ak_error_ok (в случае успеха)                   */
 /* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_create_shake128( ak_hash hctx )
+{ return ak_hash_create_keccak( hctx, "shake128", 168, 32, 0x1f, ak_true ); }
 
-static inline void block_filling(ak_keccak *sha, unsigned long long int N, int bl) {
-    int i;
-    for (i = 0; i < 200; i++) {
-        if (i < bl) {
-            if (sha->bn == sha->msg_size) sha->block[i] = 0x06; //байт = 0x06 добавляется как только сообщение закончилось. Обоснование:
-                                                                   //https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf стр. 28, Table 6.
-            if (sha->bn < sha->msg_size) sha->block[i] = sha->msg[sha->bn]; //пока сообщение не закончилось, считываем его байты и записываем в блок
-            if (sha->bn > sha->msg_size) sha->block[i] = 0x00; //если сообщение закончилось и удалось записать единичный байт, остальные элементы будут равны 0х00
-            sha->bn++;
-            if (N == 1) sha->block[bl-1] = 0x80; //1 добавляется к концу сообщения только когда остается последний блок в 1600 бит
-            if ((N==1)&(sha->msg_size % bl == (bl - 1))) sha->block[bl - 1] = 0x86; //случай, когда сообщение кончилось и не хватает одного байта для заполнения блока
-        }
-        else sha->block[i] = 0x00; //все байты от bl до 200 зануляются
-    }
-}
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция инициализирует контекст функции SHAKE256 как функции хеширования с длиной хеш-кода
+    512 бит (см. RFC 8702). При вызове ak_hash_finalize() вырабатывается столько
+    выходных данных, сколько запрошено; первые 64 октета совпадают с хеш-кодом.
+
+    @param hctx Контекст функции хеширования
+    @return Функция возвращает код ошибки или \ref ak_error_ok (в случае успеха)                   */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_hash_create_shake256( ak_hash hctx )
+{ return ak_hash_create_keccak( hctx, "shake256", 136, 64, 0x1f, ak_true ); }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Функция применяет операцию XOR "исключающее или". Применяется после формирования итогового
-  блока на каждом этапе цикла: блок, полученный ранее XOR новый блок из нового куска сообщения     */
+/*                Одновременное вычисление четырех независимых экземпляров губки                   */
 /* ----------------------------------------------------------------------------------------------- */
-static inline void xor_block(ak_keccak* sha) {
-    int i;
-    for (i = 0; i < 200; i++) {
-        sha->block[i] = sha->block[i] ^ sha->res[i];
-        sha->res[i] = 0x00;
-    }
+/*! \brief Чтение 64-х битного слова, записанного в порядке little endian. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline ak_uint64 ak_keccak_load64( const ak_uint8 *in )
+{
+  ak_uint64 w = 0;
+#ifdef AK_LITTLE_ENDIAN
+  memcpy( &w, in, sizeof( ak_uint64 ));
+#else
+  int i = 0;
+  for( i = 7; i >= 0; i-- ) w = ( w << 8 )^in[i];
+#endif
+ return w;
 }
 
-
 /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Функция обновляет результирующий блок sha->res, который применяется для xor_block       */
+/*! \brief Перестановка Keccak-f[1600] для четырех состояний, реализация без векторных инструкций.
+    \details Состояния хранятся "по столбцам": элемент st[i][j] содержит слово с индексом i
+    состояния с номером j.                                                                         */
 /* ----------------------------------------------------------------------------------------------- */
-static inline void res_update(ak_keccak* sha, ak_uint64 A[5][5]) {
-    int x, y, z;
-    int i = 0;
-    for (x = 0; x < 5; x++) {
+ static void ak_keccak_permutation_x4_generic( ak_uint64 (*st)[4] )
+{
+  int i, j;
+  ak_uint64 lane[25];
+
+  for( j = 0; j < 4; j++ ) {
+     for( i = 0; i < 25; i++ ) lane[i] = st[i][j];
+     ak_keccak_permutation( lane );
+     for( i = 0; i < 25; i++ ) st[i][j] = lane[i];
+  }
+  memset( lane, 0, sizeof( lane ));
+}
 
-        for (y = 0; y < 5; y++) {
+#ifdef AK_HAVE_BUILTIN_MM256_SLL
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Циклический сдвиг влево четырех 64-х битных слов, содержащихся в регистре ymm. */
+ #define ak_keccak_rotl_x4( x, n ) _mm256_or_si256( _mm256_sll_epi64( x, _mm_cvtsi32_si128( n )),\
+                                                  _mm256_srl_epi64( x, _mm_cvtsi32_si128( 64-( n ))))
 
-            for (z = 0; z < 8; z++) {
-                sha->block[i] = 0x00;
-                sha->res[i] = A[y][x] >> z * 8;
-                i = i + 1;
-            }
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Перестановка Keccak-f[1600] для четырех состояний с использованием инструкций AVX2.
+    \details Каждое слово состояния хранится в отдельном регистре ymm, элементы которого
+    соответствуют четырем независимым экземплярам губки. Порядок шагов раунда в точности
+    совпадает с функцией ak_keccak_permutation().                                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_keccak_permutation_x4_avx2( ak_uint64 (*st)[4] )
+{
+  int i, j, r;
+  __m256i a[25], bc[5], t;
+
+  for( i = 0; i < 25; i++ ) a[i] = _mm256_loadu_si256( (__m256i *) st[i] );
+  for( r = 0; r < 24; r++ ) {
+    /* шаг θ */
+     for( i = 0; i < 5; i++ )
+        bc[i] = _mm256_xor_si256( _mm256_xor_si256( a[i], a[i+5] ),
+                         _mm256_xor_si256( _mm256_xor_si256( a[i+10], a[i+15] ), a[i+20] ));
+     for( i = 0; i < 5; i++ ) {
+        t = _mm256_xor_si256( bc[(i+4)%5], _mm256_or_si256(
+                  _mm256_slli_epi64( bc[(i+1)%5], 1 ), _mm256_srli_epi64( bc[(i+1)%5], 63 )));
+        for( j = 0; j < 25; j += 5 ) a[j+i] = _mm256_xor_si256( a[j+i], t );
+     }
+    /* шаги ρ и π */
+     t = a[1];
+     for( i = 0; i < 24; i++ ) {
+        j = keccak_pi[i];
+        bc[0] = a[j];
+        a[j] = ak_keccak_rotl_x4( t, keccak_rho[i] );
+        t = bc[0];
+     }
+    /* шаг χ */
+     for( j = 0; j < 25; j += 5 ) {
+        for( i = 0; i < 5; i++ ) bc[i] = a[j+i];
+        for( i = 0; i < 5; i++ )
+           a[j+i] = _mm256_xor_si256( a[j+i], _mm256_andnot_si256( bc[(i+1)%5], bc[(i+2)%5] ));
+     }
+    /* шаг ι */
+     a[0] = _mm256_xor_si256( a[0], _mm256_set1_epi64x( ( long long int ) keccak_rc[r] ));
+  }
+  for( i = 0; i < 25; i++ ) _mm256_storeu_si256( (__m256i *) st[i], a[i] );
+}
+#endif
 
-        }
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Тип функции, реализующей перестановку Keccak-f[1600] для четырех состояний. */
+ typedef void ( ak_function_keccak_permutation_x4 )( ak_uint64 (*)[4] );
 
-    }
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Выбор реализации перестановки для четырех состояний.
+    \details Наличие инструкций AVX2 проверяется во время выполнения программы, при первом
+    обращении к функции; при их отсутствии используется реализация без векторных инструкций.       */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_function_keccak_permutation_x4 *ak_keccak_get_permutation_x4( void )
+{
+#if defined( AK_HAVE_BUILTIN_MM256_SLL ) && defined( AK_HAVE_BUILTIN_CPU_SUPPORTS )
+  static int avx2 = -1;
+  if( avx2 < 0 ) {
+    __builtin_cpu_init();
+    avx2 = __builtin_cpu_supports( "avx2" ) ? 1 : 0;
+  }
+  if( avx2 ) return ak_keccak_permutation_x4_avx2;
+#endif
+ return ak_keccak_permutation_x4_generic;
 }
 
-
 /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Непосредственно функция хеширования, которая записывает в sha.res итоговый блок, из     
-  которого вычленяется итоговый хеш нужной длины                                                   */
-/* ----------------------------------------------------------------------------------------------- */
-int ak_sha3_function(ak_keccak sha, ak_uint8 answer[]) {
-    
-    unsigned long long int N; //На сколько блоков будет разбито сообщение
-    int bl;                   //
-    ak_uint64 A[5][5] = { 0 };
-    int r;
-
-    switch ( sha.ftype ) {    //Инициализация нужной функции хеширования: SHA-224, 256, 384, 512?
-    case 512:
-        bl = 72;              //Соответствующая SHA-512 длина блока (изымаемая из сообщения) в 576 бит 
-                              //подробнее https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf 
-                              //стр. 22: "Table 3: Input block sizes for HMAC".
-
-        N = 1 + sha.msg_size / bl; //Если нельзя добавить ни одного байта от сообщения в блок => 
-                                   //нужно увеличить количество блоков на 1
-        break;
-    case 384:
-        bl = 104;
-        N = 1 + sha.msg_size / bl;
-        break;
-    case 256:
-        bl = 136;
-        N = 1 + sha.msg_size / bl;
-        break;
-    case 224:
-        bl = 144;
-        N = 1 + sha.msg_size / bl;
-        break;
-    default:
-        return(-1);
+/*! \brief Одновременная обработка четырех независимых сообщений.
+    \details Функция впитывает блоки всех четырех сообщений (включая последний, дополненный
+    блок) до тех пор, пока блоки есть у каждого из сообщений, используя перестановку для
+    четырех состояний. Оставшиеся блоки более длинных сообщений обрабатываются
+    обычной реализацией губки. Если все сообщения закончились одновременно, то выходные данные
+    также вырабатываются для четырех состояний одновременно.
+
+    Результат работы функции в точности совпадает с результатом последовательной обработки
+    каждого сообщения функциями ak_keccak_absorb() и ak_keccak_squeeze().                          */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_keccak_x4( const size_t rate, const size_t hsize, const ak_uint8 padding,
+                          const bool_t xof, const ak_pointer in[4], const size_t size[4],
+                                                    ak_pointer out[4], const size_t out_size )
+{
+  const ak_uint8 *ptr = NULL;
+  struct keccak kx[4];
+  ak_uint8 tail[4][168];
+  ak_uint64 st[25][4];
+  bool_t together = ak_true;
+  size_t i, j, k, len, common, offset, blocks[4];
+  ak_function_keccak_permutation_x4 *permutation = ak_keccak_get_permutation_x4();
+
+  if(( in == NULL ) || ( size == NULL ) || ( out == NULL ))
+    return ak_error_message( ak_error_null_pointer, __func__, "using null pointer to arrays" );
+  for( j = 0; j < 4; j++ ) {
+     if(( in[j] == NULL ) && ( size[j] != 0 )) return ak_error_message( ak_error_null_pointer,
+                                                     __func__, "using null pointer to input data" );
+     if( out[j] == NULL ) return ak_error_message( ak_error_null_pointer,
+                                                    __func__, "using null pointer to output data" );
+  }
+
+ /* формируем дополненные последние блоки и вычисляем количество общих блоков */
+  common = (size_t)-1;
+  for( j = 0; j < 4; j++ ) {
+     ak_keccak_create( &kx[j], rate, hsize, padding, xof );
+     blocks[j] = size[j]/rate;
+     memset( tail[j], 0, rate );
+     if( size[j]%rate ) memcpy( tail[j], ( ak_uint8 *)in[j] + blocks[j]*rate, size[j]%rate );
+     tail[j][size[j]%rate] ^= padding;
+     tail[j][rate-1] ^= 0x80;
+     common = ak_min( common, blocks[j]+1 );
+  }
+
+ /* впитываем общие блоки */
+  memset( st, 0, sizeof( st ));
+  for( k = 0; k < common; k++ ) {
+     for( j = 0; j < 4; j++ ) {
+        ptr = ( k < blocks[j] ) ? ( ak_uint8 *)in[j] + k*rate : tail[j];
+        for( i = 0; i < ( rate >> 3 ); i++ ) st[i][j] ^= ak_keccak_load64( ptr + ( i << 3 ));
+     }
+     permutation( st );
+  }
+
+ /* дорабатываем более длинные сообщения */
+  for( j = 0; j < 4; j++ ) {
+     for( i = 0; i < 25; i++ ) kx[j].st[i] = st[i][j];
+     if( blocks[j]+1 == common ) kx[j].squeezing = ak_true;
+       else {
+         together = ak_false;
+         ak_keccak_absorb( &kx[j], ( ak_uint8 *)in[j] + common*rate, size[j] - common*rate );
+       }
+  }
+
+  if( together ) { /* выработка выходных данных для четырех состояний одновременно */
+    offset = 0;
+    while( offset < out_size ) {
+      if( offset ) {
+        permutation( st );
+        for( j = 0; j < 4; j++ ) for( i = 0; i < 25; i++ ) kx[j].st[i] = st[i][j];
+      }
+      len = ak_min( rate, out_size - offset );
+      for( j = 0; j < 4; j++ ) {
+         kx[j].pos = 0;
+         ak_keccak_squeeze_internal( &kx[j], ( ak_uint8 *)out[j] + offset, len );
+      }
+      offset += len;
     }
+  } else
+     for( j = 0; j < 4; j++ ) ak_keccak_squeeze_internal( &kx[j], out[j], out_size );
 
-    //После инициализации параметров нужной функции хеширования выполняется Keccak
-    while(N > 0) {
-        block_filling(&sha, N, bl);
-        xor_block(&sha);
-        three_dimensional_array(sha, A);
-
-        //Функция перестановок алгоритма
-        for (r = 0; r < 24; r++) {
-            Theta(A);
-            Ro(A);
-            Pi(A);
-            Chi(A);
-            Iota(A, r);
-        }
-        res_update(&sha, A);
-        N--;
-    }
+  memset( kx, 0, sizeof( kx ));
+  memset( tail, 0, sizeof( tail ));
+  memset( st, 0, sizeof( st ));
 
-    //Запись итогового хеша в массив байтов для дальнейшей работы с ним при необходимости
-    for (r = 0; r < sha.ftype / 8; r++) answer[r] = sha.res[r];
-   
-    return ak_error_ok;
+ return ak_error_ok;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет хеш-коды SHA-3 для четырех независимых сообщений произвольной длины.
+    При наличии поддержки процессором инструкций AVX2 перестановка Keccak-f[1600] вычисляется
+    для всех четырех состояний одновременно. Результат совпадает с результатом функции
+    ak_hash_ptr() для контекстов, созданных функциями ak_hash_create_sha3_xxx().
+
+    @param hsize Длина хеш-кода в октетах: 28, 32, 48 или 64 (SHA3-224, SHA3-256, SHA3-384
+    или SHA3-512 соответственно).
+    @param in Массив из четырех указателей на сообщения.
+    @param size Массив из четырех длин сообщений (в октетах).
+    @param out Массив из четырех указателей на области памяти, в которые помещаются хеш-коды;
+    размер каждой области должен быть не менее hsize октетов.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_keccak_sha3_x4( const size_t hsize, const ak_pointer in[4], const size_t size[4],
+                                                                                 ak_pointer out[4] )
+{
+  switch( hsize ) {
+    case 28: return ak_keccak_x4( 144, 28, 0x06, ak_false, in, size, out, 28 );
+    case 32: return ak_keccak_x4( 136, 32, 0x06, ak_false, in, size, out, 32 );
+    case 48: return ak_keccak_x4( 104, 48, 0x06, ak_false, in, size, out, 48 );
+    case 64: return ak_keccak_x4(  72, 64, 0x06, ak_false, in, size, out, 64 );
+    default: break;
+  }
+ return ak_error_message( ak_error_wrong_length, __func__, "using unsupported length of hash code" );
+}
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! @param in Массив из четырех указателей на сообщения.
+    @param size Массив из четырех длин сообщений (в октетах).
+    @param out Массив из четырех указателей на области памяти для выходных данных.
+    @param out_size Длина вырабатываемой выходной последовательности для каждого из сообщений.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_keccak_shake128_x4( const ak_pointer in[4], const size_t size[4],
+                                                          ak_pointer out[4], const size_t out_size )
+{ return ak_keccak_x4( 168, 32, 0x1f, ak_true, in, size, out, out_size ); }
 
-/*! \brief Константы-ответы для проведения тестирования работоспособности SHA-512, 384, 256, 224.
-  Первые два массива с хешем - примеры из Википедии, третий - опубликованный NIST, четвертый -
-  сгенерирован вручную с онлайн сервиса                                                         */
-
-//--------------------------------------SHA-512-------------------------------------------------
-static ak_uint8 lazy_dog_512[64] = {
-    0x01, 0xde, 0xdd, 0x5d, 0xe4, 0xef, 0x14, 0x64, 0x24, 0x45, 0xba, 0x5f, 0x5b, 0x97, 0xc1, 0x5e,
-    0x47, 0xb9, 0xad, 0x93, 0x13, 0x26, 0xe4, 0xb0, 0x72, 0x7c, 0xd9, 0x4c, 0xef, 0xc4, 0x4f, 0xff,
-    0x23, 0xf0, 0x7b, 0xf5, 0x43, 0x13, 0x99, 0x39, 0xb4, 0x91, 0x28, 0xca, 0xf4, 0x36, 0xdc, 0x1b,
-    0xde, 0xe5, 0x4f, 0xcb, 0x24, 0x02, 0x3a, 0x08, 0xd9, 0x40, 0x3f, 0x9b, 0x4b, 0xf0, 0xd4, 0x50
-};
+/* ----------------------------------------------------------------------------------------------- */
+/*! @param in Массив из четырех указателей на сообщения.
+    @param size Массив из четырех длин сообщений (в октетах).
+    @param out Массив из четырех указателей на области памяти для выходных данных.
+    @param out_size Длина вырабатываемой выходной последовательности для каждого из сообщений.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_keccak_shake256_x4( const ak_pointer in[4], const size_t size[4],
+                                                          ak_pointer out[4], const size_t out_size )
+{ return ak_keccak_x4( 136, 64, 0x1f, ak_true, in, size, out, out_size ); }
 
-static ak_uint8 lazy_dog_512_point[64] = {
+/* ----------------------------------------------------------------------------------------------- */
+/*                          Функции тестирования алгоритмов работы                                 */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Тестовые значения SHA-3: первые два примера из Википедии, третий опубликован NIST
+   (сообщение из 200 октетов 0xA3), четвертый получен с помощью сторонней реализации. */
+ static ak_uint8 sha3_online_message[71] =
+              "absdaudwuwdhawfLsiefdifhdshgfefsefSdhfdsfhyytrtytghshdhfghrhwhsjjfjJerz";
+
+/*--------------------------------------SHA3-512-------------------------------------------------*/
+ static ak_uint8 lazy_dog_512[64] = {
+   0x01, 0xde, 0xdd, 0x5d, 0xe4, 0xef, 0x14, 0x64, 0x24, 0x45, 0xba, 0x5f, 0x5b, 0x97, 0xc1, 0x5e,
+   0x47, 0xb9, 0xad, 0x93, 0x13, 0x26, 0xe4, 0xb0, 0x72, 0x7c, 0xd9, 0x4c, 0xef, 0xc4, 0x4f, 0xff,
+   0x23, 0xf0, 0x7b, 0xf5, 0x43, 0x13, 0x99, 0x39, 0xb4, 0x91, 0x28, 0xca, 0xf4, 0x36, 0xdc, 0x1b,
+   0xde, 0xe5, 0x4f, 0xcb, 0x24, 0x02, 0x3a, 0x08, 0xd9, 0x40, 0x3f, 0x9b, 0x4b, 0xf0, 0xd4, 0x50
+ };
+
+ static ak_uint8 lazy_dog_512_point[64] = {
    0x18, 0xf4, 0xf4, 0xbd, 0x41, 0x96, 0x03, 0xf9, 0x55, 0x38, 0x83, 0x70, 0x03, 0xd9, 0xd2, 0x54,
    0xc2, 0x6c, 0x23, 0x76, 0x55, 0x65, 0x16, 0x22, 0x47, 0x48, 0x3f, 0x65, 0xc5, 0x03, 0x03, 0x59,
    0x7b, 0xc9, 0xce, 0x4d, 0x28, 0x9f, 0x21, 0xd1, 0xc2, 0xf1, 0xf4, 0x58, 0x82, 0x8e, 0x33, 0xdc,
-   0x44, 0x21, 0x00, 0x33, 0x1b, 0x35, 0xe7, 0xeb, 0x03, 0x1b ,0x5d, 0x38, 0xba, 0x64, 0x60, 0xf8
-};
+   0x44, 0x21, 0x00, 0x33, 0x1b, 0x35, 0xe7, 0xeb, 0x03, 0x1b, 0x5d, 0x38, 0xba, 0x64, 0x60, 0xf8
+ };
 
-static ak_uint8 nist1600_512[64] = {
+ static ak_uint8 nist1600_512[64] = {
    0xe7, 0x6d, 0xfa, 0xd2, 0x20, 0x84, 0xa8, 0xb1, 0x46, 0x7f, 0xcf, 0x2f, 0xfa, 0x58, 0x36, 0x1b,
    0xec, 0x76, 0x28, 0xed, 0xf5, 0xf3, 0xfd, 0xc0, 0xe4, 0x80, 0x5d, 0xc4, 0x8c, 0xae, 0xec, 0xa8,
    0x1b, 0x7c, 0x13, 0xc3, 0x0a, 0xdf, 0x52, 0xa3, 0x65, 0x95, 0x84, 0x73, 0x9a, 0x2d, 0xf4, 0x6b,
    0xe5, 0x89, 0xc5, 0x1c, 0xa1, 0xa4, 0xa8, 0x41, 0x6d, 0xf6, 0x54, 0x5a, 0x1c, 0xe8, 0xba, 0x00
-};
+ };
 
-static ak_uint8 online_512[64] = {
+ static ak_uint8 online_512[64] = {
    0xd0, 0xae, 0x2c, 0xd5, 0x16, 0xd3, 0xf1, 0x72, 0xb0, 0xd3, 0x8e, 0x5f, 0x6e, 0x03, 0x70, 0xb7,
    0x8a, 0x43, 0x75, 0x99, 0xeb, 0xf4, 0x52, 0x9f, 0x1d, 0x56, 0xd1, 0x12, 0x8f, 0x3f, 0x73, 0xb7,
    0xb2, 0x41, 0x5f, 0x78, 0xa4, 0x2b, 0x64, 0x8e, 0xfe, 0xdc, 0x30, 0xba, 0x43, 0x68, 0x2f, 0x17,
    0x9c, 0xab, 0x6a, 0xd7, 0x3d, 0x85, 0xa3, 0x7e, 0x18, 0x50, 0xcf, 0x10, 0xbe, 0xd9, 0xa2, 0xf8
-};
-//--------------------------------------SHA-384-------------------------------------------------
-static ak_uint8 lazy_dog_384[48] = {
+ };
+
+/*--------------------------------------SHA3-384-------------------------------------------------*/
+ static ak_uint8 lazy_dog_384[48] = {
    0x70, 0x63, 0x46, 0x5e, 0x08, 0xa9, 0x3b, 0xce, 0x31, 0xcd, 0x89, 0xd2, 0xe3, 0xca, 0x8f, 0x60,
    0x24, 0x98, 0x69, 0x6e, 0x25, 0x35, 0x92, 0xed, 0x26, 0xf0, 0x7b, 0xf7, 0xe7, 0x03, 0xcf, 0x32,
    0x85, 0x81, 0xe1, 0x47, 0x1a, 0x7b, 0xa7, 0xab, 0x11, 0x9b, 0x1a, 0x9e, 0xbd, 0xf8, 0xbe, 0x41
-};
+ };
 
-static ak_uint8 lazy_dog_384_point[48] = {
+ static ak_uint8 lazy_dog_384_point[48] = {
    0x1a, 0x34, 0xd8, 0x16, 0x95, 0xb6, 0x22, 0xdf, 0x17, 0x8b, 0xc7, 0x4d, 0xf7, 0x12, 0x4f, 0xe1,
    0x2f, 0xac, 0x0f, 0x64, 0xba, 0x52, 0x50, 0xb7, 0x8b, 0x99, 0xc1, 0x27, 0x3d, 0x4b, 0x08, 0x01,
    0x68, 0xe1, 0x06, 0x52, 0x89, 0x4e, 0xca, 0xd5, 0xf1, 0xf4, 0xd5, 0xb9, 0x65, 0x43, 0x7f, 0xb9
-};
+ };
 
-static ak_uint8 nist1600_384[48] = {
+ static ak_uint8 nist1600_384[48] = {
    0x18, 0x81, 0xde, 0x2c, 0xa7, 0xe4, 0x1e, 0xf9, 0x5d, 0xc4, 0x73, 0x2b, 0x8f, 0x5f, 0x00, 0x2b,
    0x18, 0x9c, 0xc1, 0xe4, 0x2b, 0x74, 0x16, 0x8e, 0xd1, 0x73, 0x26, 0x49, 0xce, 0x1d, 0xbc, 0xdd,
    0x76, 0x19, 0x7a, 0x31, 0xfd, 0x55, 0xee, 0x98, 0x9f, 0x2d, 0x70, 0x50, 0xdd, 0x47, 0x3e, 0x8f
-};
+ };
 
-static ak_uint8 online_384[48] = {
+ static ak_uint8 online_384[48] = {
    0x73, 0x82, 0x9f, 0x17, 0xe2, 0x25, 0x75, 0x86, 0x51, 0x11, 0xb3, 0x42, 0x3c, 0xb2, 0xcb, 0x9b,
    0x74, 0x1c, 0xec, 0x2e, 0x5d, 0x70, 0x2e, 0x37, 0x31, 0x99, 0x1f, 0xc9, 0xfd, 0x53, 0x66, 0x88,
    0xca, 0x6d, 0x6e, 0xce, 0x71, 0x8b, 0x95, 0x92, 0x28, 0x59, 0x2e, 0x48, 0x0f, 0xb8, 0xc8, 0x46
-};
-//--------------------------------------SHA-256-------------------------------------------------
-static ak_uint8 lazy_dog_256[32] = {
+ };
+
+/*--------------------------------------SHA3-256-------------------------------------------------*/
+ static ak_uint8 lazy_dog_256[32] = {
    0x69, 0x07, 0x0d, 0xda, 0x01, 0x97, 0x5c, 0x8c, 0x12, 0x0c, 0x3a, 0xad, 0xa1, 0xb2, 0x82, 0x39,
    0x4e, 0x7f, 0x03, 0x2f, 0xa9, 0xcf, 0x32, 0xf4, 0xcb, 0x22, 0x59, 0xa0, 0x89, 0x7d, 0xfc, 0x04
-};
+ };
 
-static ak_uint8 lazy_dog_256_point[32] = {
+ static ak_uint8 lazy_dog_256_point[32] = {
    0xa8, 0x0f, 0x83, 0x9c, 0xd4, 0xf8, 0x3f, 0x6c, 0x3d, 0xaf, 0xc8, 0x7f, 0xea, 0xe4, 0x70, 0x04,
    0x5e, 0x4e, 0xb0, 0xd3, 0x66, 0x39, 0x7d, 0x5c, 0x6c, 0xe3, 0x4b, 0xa1, 0x73, 0x9f, 0x73, 0x4d
-};
+ };
 
-static ak_uint8 nist1600_256[32] = {
+ static ak_uint8 nist1600_256[32] = {
    0x79, 0xf3, 0x8a, 0xde, 0xc5, 0xc2, 0x03, 0x07, 0xa9, 0x8e, 0xf7, 0x6e, 0x83, 0x24, 0xaf, 0xbf,
    0xd4, 0x6c, 0xfd, 0x81, 0xb2, 0x2e, 0x39, 0x73, 0xc6, 0x5f, 0xa1, 0xbd, 0x9d, 0xe3, 0x17, 0x87
-};
-
-static ak_uint8 online_256[32] = {
-  0x07, 0x23, 0x8f, 0x99, 0x26, 0xe3, 0xd8, 0x66, 0x30, 0x1e, 0x3c, 0x51, 0x67, 0xea, 0xeb, 0x9a,
-  0x3b, 0x8b, 0x13, 0xba, 0xd6, 0x66, 0x0e, 0x49, 0xb0, 0xb0, 0x23, 0x33, 0x6e, 0x17, 0x34, 0x26
-};
-//--------------------------------------SHA-224-------------------------------------------------
-static ak_uint8 lazy_dog_224[28] = {
-  0xd1, 0x5d, 0xad, 0xce, 0xaa, 0x4d, 0x5d, 0x7b, 0xb3, 0xb4, 0x8f, 0x44, 0x64, 0x21, 0xd5, 0x42,
-  0xe0, 0x8a, 0xd8, 0x88, 0x73, 0x05, 0xe2, 0x8d, 0x58, 0x33, 0x57, 0x95
-};
-
-static ak_uint8 lazy_dog_224_point[28] = {
-  0x2d, 0x07, 0x08, 0x90, 0x38, 0x33, 0xaf, 0xab, 0xdd, 0x23, 0x2a, 0x20, 0x20, 0x11, 0x76, 0xe8,
-  0xb5, 0x8c, 0x5b, 0xe8, 0xa6, 0xfe, 0x74, 0x26, 0x5a, 0xc5, 0x4d, 0xb0
-};
-
-static ak_uint8 nist1600_224[28] = {
-  0x93, 0x76, 0x81, 0x6a, 0xba, 0x50, 0x3f, 0x72, 0xf9, 0x6c, 0xe7, 0xeb, 0x65, 0xac, 0x09, 0x5d,
-  0xee, 0xe3, 0xbe, 0x4b, 0xf9, 0xbb, 0xc2, 0xa1, 0xcb, 0x7e, 0x11, 0xe0
-};
-
-static ak_uint8 online_224[28] = {
-   0xed, 0xa4, 0x87, 0xbe, 0xbf, 0xf3, 0xf4, 0x93, 0xad, 0xb0, 0x91, 0x6a, 0x14, 0xcc, 0x1b, 0xbf, 
+ };
+
+ static ak_uint8 online_256[32] = {
+   0x07, 0x23, 0x8f, 0x99, 0x26, 0xe3, 0xd8, 0x66, 0x30, 0x1e, 0x3c, 0x51, 0x67, 0xea, 0xeb, 0x9a,
+   0x3b, 0x8b, 0x13, 0xba, 0xd6, 0x66, 0x0e, 0x49, 0xb0, 0xb0, 0x23, 0x33, 0x6e, 0x17, 0x34, 0x26
+ };
+
+/*--------------------------------------SHA3-224-------------------------------------------------*/
+ static ak_uint8 lazy_dog_224[28] = {
+   0xd1, 0x5d, 0xad, 0xce, 0xaa, 0x4d, 0x5d, 0x7b, 0xb3, 0xb4, 0x8f, 0x44, 0x64, 0x21, 0xd5, 0x42,
+   0xe0, 0x8a, 0xd8, 0x88, 0x73, 0x05, 0xe2, 0x8d, 0x58, 0x33, 0x57, 0x95
+ };
+
+ static ak_uint8 lazy_dog_224_point[28] = {
+   0x2d, 0x07, 0x08, 0x90, 0x38, 0x33, 0xaf, 0xab, 0xdd, 0x23, 0x2a, 0x20, 0x20, 0x11, 0x76, 0xe8,
+   0xb5, 0x8c, 0x5b, 0xe8, 0xa6, 0xfe, 0x74, 0x26, 0x5a, 0xc5, 0x4d, 0xb0
+ };
+
+ static ak_uint8 nist1600_224[28] = {
+   0x93, 0x76, 0x81, 0x6a, 0xba, 0x50, 0x3f, 0x72, 0xf9, 0x6c, 0xe7, 0xeb, 0x65, 0xac, 0x09, 0x5d,
+   0xee, 0xe3, 0xbe, 0x4b, 0xf9, 0xbb, 0xc2, 0xa1, 0xcb, 0x7e, 0x11, 0xe0
+ };
+
+ static ak_uint8 online_224[28] = {
+   0xed, 0xa4, 0x87, 0xbe, 0xbf, 0xf3, 0xf4, 0x93, 0xad, 0xb0, 0x91, 0x6a, 0x14, 0xcc, 0x1b, 0xbf,
    0xde, 0x40, 0x5a, 0xe8, 0x98, 0x2c, 0x31, 0x9c, 0x8f, 0xc0, 0x3a, 0x05
-};
-
+ };
+
+/*--------------------------------------SHAKE----------------------------------------------------*/
+/*! \brief Значение SHAKE128 от пустой строки, длина выхода 256 бит (NIST). */
+ static ak_uint8 shake128_empty[32] = {
+   0x7f, 0x9c, 0x2b, 0xa4, 0xe8, 0x8f, 0x82, 0x7d, 0x61, 0x60, 0x45, 0x50, 0x76, 0x05, 0x85, 0x3e,
+   0xd7, 0x3b, 0x80, 0x93, 0xf6, 0xef, 0xbc, 0x88, 0xeb, 0x1a, 0x6e, 0xac, 0xfa, 0x66, 0xef, 0x26
+ };
+
+/*! \brief Значение SHAKE256 от пустой строки, длина выхода 512 бит (NIST). */
+ static ak_uint8 shake256_empty[64] = {
+   0x46, 0xb9, 0xdd, 0x2b, 0x0b, 0xa8, 0x8d, 0x13, 0x23, 0x3b, 0x3f, 0xeb, 0x74, 0x3e, 0xeb, 0x24,
+   0x3f, 0xcd, 0x52, 0xea, 0x62, 0xb8, 0x1b, 0x82, 0xb5, 0x0c, 0x27, 0x64, 0x6e, 0xd5, 0x76, 0x2f,
+   0xd7, 0x5d, 0xc4, 0xdd, 0xd8, 0xc0, 0xf2, 0x00, 0xcb, 0x05, 0x01, 0x9d, 0x67, 0xb5, 0x92, 0xf6,
+   0xfc, 0x82, 0x1c, 0x49, 0x47, 0x9a, 0xb4, 0x86, 0x40, 0x29, 0x2e, 0xac, 0xb3, 0xb7, 0xc4, 0xbe
+ };
+
+/*! \brief Последние 32 октета выхода длины 4096 бит функции SHAKE128 от сообщения
+    из 200 октетов 0xA3 (NIST, Cryptographic Standards and Guidelines, Example Values). */
+ static ak_uint8 shake128_nist1600_tail[32] = {
+   0x44, 0xc9, 0xfb, 0x35, 0x9f, 0xd5, 0x6a, 0xc0, 0xa9, 0xa7, 0x5a, 0x74, 0x3c, 0xff, 0x68, 0x62,
+   0xf1, 0x7d, 0x72, 0x59, 0xab, 0x07, 0x52, 0x16, 0xc0, 0x69, 0x95, 0x11, 0x64, 0x3b, 0x64, 0x39
+ };
+
+/*! \brief Последние 32 октета выхода длины 4096 бит функции SHAKE256 от сообщения
+    из 200 октетов 0xA3 (NIST, Cryptographic Standards and Guidelines, Example Values). */
+ static ak_uint8 shake256_nist1600_tail[32] = {
+   0x6a, 0x1a, 0x9d, 0x78, 0x46, 0x43, 0x6e, 0x4d, 0xca, 0x57, 0x28, 0xb6, 0xf7, 0x60, 0xee, 0xf0,
+   0xca, 0x92, 0xbf, 0x0b, 0xe5, 0x61, 0x5e, 0x96, 0x95, 0x9d, 0x76, 0x71, 0x97, 0xa0, 0xbe, 0xeb
+ };
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Мини-функция для проведения тестов. Сравнивает получившийся хеш-массив с хеш-ответом    */
+/*! \brief Проверка одного тестового примера для функции хеширования. */
 /* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_libakrypt_test_sha3_example( ak_hash ctx, const ak_pointer in,
+                                          const size_t size, ak_uint8 *value, const char *message )
+{
+  int error = ak_error_ok;
+  ak_uint8 out[64];
+  size_t tag = ak_hash_get_tag_size( ctx );
+
+  memset( out, 0, sizeof( out ));
+  if(( error = ak_hash_ptr( ctx, in, size, out, tag )) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__ , "invalid calculation of %s code", ctx->oid->name[0] );
+    return ak_false;
+  }
+  if( ak_ptr_is_equal_with_log( out, value, tag ) != ak_true ) {
+    ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                                                "the %s test for %s is wrong", message, ctx->oid->name[0] );
+    return ak_false;
+  }
+  if( ak_log_get_level() >= ak_log_maximum )
+    ak_error_message_fmt( ak_error_ok, __func__ , "the %s test for %s is Ok", message, ctx->oid->name[0] );
+
+ return ak_true;
+}
 
-static int comparation(ak_uint8 answer[], ak_uint8 result[], int arraysize) {
-    int i;
-    for (i = 0; i < arraysize; i++) {
-        if (result[i] != answer[i]) {
-            printf("%s\n", "ERROR, TEST NOT PASSED");
-            exit(0);
+/* ----------------------------------------------------------------------------------------------- */
+/*!  @return Если тестирование прошло успешно возвращается \ref ak_true (истина). В противном
+     случае возвращается \ref ak_false.                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_libakrypt_test_sha3( void )
+{
+  size_t i;
+  ak_uint32 steps;
+  struct hash ctx;
+  struct random rnd;
+  int error = ak_error_ok;
+  bool_t result = ak_true;
+  size_t len, offset;
+  int audit = ak_log_get_level();
+  ak_uint8 nist1600[200], buffer[512], out[64], out2[64], *ptr = buffer;
+
+  int ( *create[4] )( ak_hash ) = {
+    ak_hash_create_sha3_224, ak_hash_create_sha3_256,
+    ak_hash_create_sha3_384, ak_hash_create_sha3_512 };
+  ak_uint8 *values[4][4] = {
+    { lazy_dog_224, lazy_dog_224_point, nist1600_224, online_224 },
+    { lazy_dog_256, lazy_dog_256_point, nist1600_256, online_256 },
+    { lazy_dog_384, lazy_dog_384_point, nist1600_384, online_384 },
+    { lazy_dog_512, lazy_dog_512_point, nist1600_512, online_512 }};
+
+  memset( nist1600, 0xa3, sizeof( nist1600 ));
+  if(( error = ak_random_create_lcg( &rnd )) != ak_error_ok ) {
+    ak_error_message( error, __func__ , "wrong creation of random generator" );
+    return ak_false;
+  }
+  ak_random_ptr( &rnd, buffer, sizeof( buffer ));
+
+  for( i = 0; i < 4; i++ ) {
+    if(( error = create[i]( &ctx )) != ak_error_ok ) {
+      ak_error_message( error, __func__ , "wrong initialization of sha3 context" );
+      result = ak_false;
+      goto lab_exit;
+    }
+    if(( result = ak_libakrypt_test_sha3_example( &ctx,
+                 "The quick brown fox jumps over the lazy dog", 43,
+                                            values[i][0], "\"lazy dog\"" )) != ak_true ) goto lab_free;
+    if(( result = ak_libakrypt_test_sha3_example( &ctx,
+                 "The quick brown fox jumps over the lazy dog.", 44,
+                                 values[i][1], "\"lazy dog with point\"" )) != ak_true ) goto lab_free;
+    if(( result = ak_libakrypt_test_sha3_example( &ctx, nist1600, sizeof( nist1600 ),
+                                   values[i][2], "NIST 1600-bit message" )) != ak_true ) goto lab_free;
+    if(( result = ak_libakrypt_test_sha3_example( &ctx, sha3_online_message,
+               sizeof( sha3_online_message ), values[i][3], "third party" )) != ak_true ) goto lab_free;
+
+   /* тестирование алгоритма хеширования фрагментами произвольной длины */
+    ak_hash_ptr( &ctx, buffer, sizeof( buffer ), out, sizeof( out ));
+    steps = 0;
+    ptr = buffer;
+    offset = sizeof( buffer );
+    ak_hash_clean( &ctx );
+    do{
+        ak_random_ptr( &rnd, &len, sizeof( len )); len = ak_min( len%211, offset );
+        if( len > 0 ) {
+          ak_hash_update( &ctx, ptr, len );
+          ptr += len;
+          offset -= len;
+          ++steps;
         }
+    } while( offset );
+    memset( out2, 0, sizeof( out2 ));
+    ak_hash_finalize( &ctx, NULL, 0, out2, sizeof( out2 ));
+
+    if(( result = ak_ptr_is_equal_with_log( out, out2, ak_hash_get_tag_size( &ctx ))) != ak_true ) {
+      ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                    "the random walk test for %s with %u steps is wrong", ctx.oid->name[0], steps );
+      goto lab_free;
     }
-    printf("%s\n", "OK, TEST PASSED");
-    return ak_error_ok;
+    if( audit >= ak_log_maximum )
+      ak_error_message_fmt( ak_error_ok, __func__ ,
+                       "the random walk test for %s with %u steps is Ok", ctx.oid->name[0], steps );
+    ak_hash_destroy( &ctx );
+  }
+
+ lab_exit:
+  ak_random_destroy( &rnd );
+ return result;
+
+ lab_free:
+  ak_hash_destroy( &ctx );
+  ak_random_destroy( &rnd );
+ return result;
 }
 
-
 /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Тестирование работоспособности функций хеширования SHA-512, SHA-384, SHA-256, SHA-224   */
-/* ----------------------------------------------------------------------------------------------- */
-int ak_sha3_tests() {
-
-    int i;
-
-    //Следующие два примера из Википедии https://ru.wikipedia.org/wiki/SHA-3#%D0%A2%D0%B5%D1%81%D1%82%D0%BE%D0%B2%D1%8B%D0%B5_%D0%B2%D0%B5%D0%BA%D1%82%D0%BE%D1%80%D1%8B
-    ak_uint8 lazy_dog[43] = "The quick brown fox jumps over the lazy dog"; 
-    ak_uint8 lazy_dog_point[44] = "The quick brown fox jumps over the lazy dog.";
-
-    ak_uint8 nist1600[200]; //200 байтов со значением 0хА3 - 4-ый пример (Secure Hashing -> FIPS 202 - SHA-3 Standard)
-                            // https://csrc.nist.gov/projects/cryptographic-standards-and-guidelines/example-values
-    for (i = 0; i < 200; i++) nist1600[i] = 0xA3;
+/*!  Помимо тестовых примеров NIST функция проверяет, что выходная последовательность,
+     вырабатываемая фрагментами случайной длины (squeeze-on-demand), совпадает с последовательностью,
+     выработанной за один вызов.
 
-    //Следующий пример - случайный набор символов. Проверка - онлайн генератор https://emn178.github.io/online-tools/sha3_512.html 
-    //Соответсвенный выбор нужной функции хеширования на сайте
-    ak_uint8 online[71] = "absdaudwuwdhawfLsiefdifhdshgfefsefSdhfdsfhyytrtytghshdhfghrhwhsjjfjJerz";
+     @return Если тестирование прошло успешно возвращается \ref ak_true (истина). В противном
+     случае возвращается \ref ak_false.                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_libakrypt_test_shake( void )
+{
+  size_t i;
+  ak_uint32 steps;
+  struct hash ctx;
+  struct keccak kctx;
+  struct random rnd;
+  int error = ak_error_ok;
+  bool_t result = ak_true;
+  size_t len, offset;
+  int audit = ak_log_get_level();
+  ak_uint8 nist1600[200], out[512], out2[512], *ptr = NULL;
+
+  int ( *create[2] )( ak_hash ) = { ak_hash_create_shake128, ak_hash_create_shake256 };
+  int ( *xcreate[2] )( ak_keccak ) = { ak_keccak_create_shake128, ak_keccak_create_shake256 };
+  ak_uint8 *empty[2] = { shake128_empty, shake256_empty };
+  ak_uint8 *tail[2] = { shake128_nist1600_tail, shake256_nist1600_tail };
+
+  memset( nist1600, 0xa3, sizeof( nist1600 ));
+  if(( error = ak_random_create_lcg( &rnd )) != ak_error_ok ) {
+    ak_error_message( error, __func__ , "wrong creation of random generator" );
+    return ak_false;
+  }
+
+  for( i = 0; i < 2; i++ ) {
+   /* тестовые примеры с фиксированной длиной выхода, вычисляемые с помощью класса hash */
+    if(( error = create[i]( &ctx )) != ak_error_ok ) {
+      ak_error_message( error, __func__ , "wrong initialization of shake context" );
+      result = ak_false;
+      goto lab_exit;
+    }
+    result = ak_libakrypt_test_sha3_example( &ctx, "", 0, empty[i], "zero length vector" );
+    if( result == ak_true ) {
+      memset( out, 0, sizeof( out ));
+      ak_hash_ptr( &ctx, nist1600, sizeof( nist1600 ), out, sizeof( out ));
+      if(( result = ak_ptr_is_equal_with_log( out + 480, tail[i], 32 )) != ak_true )
+        ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                     "the NIST 4096-bit output test for %s is wrong", ctx.oid->name[0] );
+       else if( audit >= ak_log_maximum )
+         ak_error_message_fmt( ak_error_ok, __func__ ,
+                     "the NIST 4096-bit output test for %s is Ok", ctx.oid->name[0] );
+    }
+    ak_hash_destroy( &ctx );
+    if( result != ak_true ) goto lab_exit;
+
+   /* выработка выходной последовательности фрагментами произвольной длины */
+    xcreate[i]( &kctx );
+    ptr = nist1600;
+    offset = sizeof( nist1600 );
+    do{
+        ak_random_ptr( &rnd, &len, sizeof( len )); len = ak_min( len%97, offset );
+        ak_keccak_absorb( &kctx, ptr, len );
+        ptr += len;
+        offset -= len;
+    } while( offset );
+
+    steps = 0;
+    ptr = out2;
+    offset = sizeof( out2 );
+    do{
+        ak_random_ptr( &rnd, &len, sizeof( len )); len = ak_min( len%211, offset );
+        if( len > 0 ) {
+          if(( error = ak_keccak_squeeze( &kctx, ptr, len )) != ak_error_ok ) {
+            ak_error_message( error, __func__ , "incorrect squeezing of keccak context" );
+            result = ak_false;
+            break;
+          }
+          ptr += len;
+          offset -= len;
+          ++steps;
+        }
+    } while( offset );
+    ak_keccak_destroy( &kctx );
+    if( result != ak_true ) goto lab_exit;
+
+    if(( result = ak_ptr_is_equal_with_log( out, out2, sizeof( out ))) != ak_true ) {
+      ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                                   "the squeeze-on-demand test with %u steps is wrong", steps );
+      goto lab_exit;
+    }
+    if( audit >= ak_log_maximum )
+      ak_error_message_fmt( ak_error_ok, __func__ ,
+                                      "the squeeze-on-demand test with %u steps is Ok", steps );
+  }
+
+ lab_exit:
+  ak_random_destroy( &rnd );
+ return result;
+}
 
+/* ----------------------------------------------------------------------------------------------- */
+/*!  Функция сравнивает результаты многопоточной (4-way) реализации губки с результатами
+     последовательной обработки сообщений, в том числе для сообщений различной длины.
 
-    //Инициализация структуры
-    ak_uint8 answer[64];
-    ak_keccak sha;
-    sha.bn = 0;
-    for (i = 0; i < 200; i++) {
-        sha.block[i] = 0;
-        sha.res[i] = 0;
+     @return Если тестирование прошло успешно возвращается \ref ak_true (истина). В противном
+     случае возвращается \ref ak_false.                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_libakrypt_test_keccak_x4( void )
+{
+  size_t i, j, t;
+  struct hash ctx;
+  struct random rnd;
+  int error = ak_error_ok;
+  bool_t result = ak_true;
+  int audit = ak_log_get_level();
+#ifdef AK_HAVE_BUILTIN_MM256_SLL
+  ak_uint64 st[25][4], st2[25][4];
+#endif
+  ak_uint8 data[4][512], out[4][400], out2[400];
+  ak_pointer in[4] = { data[0], data[1], data[2], data[3] };
+  ak_pointer outs[4] = { out[0], out[1], out[2], out[3] };
+
+ /* длины сообщений: одинаковое и различное количество блоков, граничные значения длин */
+  size_t lengths[4][4] = {
+    {   0,   0,   0,   0 },
+    { 500, 500, 500, 500 },
+    {   0, 135, 136, 137 },
+    { 511,  72,   1, 336 }};
+  size_t hsizes[4] = { 28, 32, 48, 64 };
+  int ( *create[4] )( ak_hash ) = {
+    ak_hash_create_sha3_224, ak_hash_create_sha3_256,
+    ak_hash_create_sha3_384, ak_hash_create_sha3_512 };
+
+  if(( error = ak_random_create_lcg( &rnd )) != ak_error_ok ) {
+    ak_error_message( error, __func__ , "wrong creation of random generator" );
+    return ak_false;
+  }
+  ak_random_ptr( &rnd, data, sizeof( data ));
+
+#ifdef AK_HAVE_BUILTIN_MM256_SLL
+ /* сравниваем векторную и обычную реализации перестановки */
+  if( ak_keccak_get_permutation_x4() == ak_keccak_permutation_x4_avx2 ) {
+    ak_random_ptr( &rnd, st, sizeof( st ));
+    memcpy( st2, st, sizeof( st ));
+    ak_keccak_permutation_x4_avx2( st );
+    ak_keccak_permutation_x4_generic( st2 );
+    if(( result = ak_ptr_is_equal_with_log( st, st2, sizeof( st ))) != ak_true ) {
+      ak_error_message( ak_error_not_equal_data, __func__ ,
+                                            "the avx2 implementation of permutation is wrong" );
+      goto lab_exit;
     }
-
-    printf("%s\n", "-----------------------------SHA-512 TESTING-----------------------------");
-    //4 теста для SHA-512
-    sha.ftype = 512;
-
-    sha.msg = lazy_dog;
-    sha.msg_size = sizeof(lazy_dog);
-    printf("%s\n", "SHA-512 TEST 1: The quick brown fox jumps over the lazy dog");
-    ak_sha3_function(sha, answer);
-    comparation(lazy_dog_512, answer, 64);
-
-    sha.msg = lazy_dog_point;
-    sha.msg_size = sizeof(lazy_dog_point);
-    printf("%s\n", "SHA-512 TEST 2: The quick brown fox jumps over the lazy dog.");
-    ak_sha3_function(sha, answer);
-    comparation(lazy_dog_512_point, answer, 64);
-
-    sha.msg = nist1600;
-    sha.msg_size = sizeof(nist1600);
-    printf("%s\n", "SHA-512 TEST 3: 200 bytes = 0xA3");
-    ak_sha3_function(sha, answer);
-    comparation(nist1600_512, answer, 64);
-
-    sha.msg = online;
-    sha.msg_size = sizeof(online);
-    printf("%s\n", "SHA-512 TEST 4: absdaudwuwdhawfLsiefdifhdshgfefsefSdhfdsfhyytrtytghshdhfghrhwhsjjfjJerz");
-    ak_sha3_function(sha, answer);
-    comparation(online_512, answer, 64);
-
-    printf("%s\n", "-----------------------------SHA-384 TESTING-----------------------------");
-    //4 теста для SHA-384
-    sha.ftype = 384;
-
-    sha.msg = lazy_dog;
-    sha.msg_size = sizeof(lazy_dog);
-    printf("%s\n", "SHA-384 TEST 1: The quick brown fox jumps over the lazy dog");
-    ak_sha3_function(sha, answer);
-    comparation(lazy_dog_384, answer, 48);
-
-    sha.msg = lazy_dog_point;
-    sha.msg_size = sizeof(lazy_dog_point);
-    printf("%s\n", "SHA-384 TEST 2: The quick brown fox jumps over the lazy dog.");
-    ak_sha3_function(sha, answer);
-    comparation(lazy_dog_384_point, answer, 48);
-
-    sha.msg = nist1600;
-    sha.msg_size = sizeof(nist1600);
-    printf("%s\n", "SHA-384 TEST 3: 200 bytes = 0xA3");
-    ak_sha3_function(sha, answer);
-    comparation(nist1600_384, answer, 48);
-
-    sha.msg = online;
-    sha.msg_size = sizeof(online);
-    printf("%s\n", "SHA-384 TEST 4: absdaudwuwdhawfLsiefdifhdshgfefsefSdhfdsfhyytrtytghshdhfghrhwhsjjfjJerz");
-    ak_sha3_function(sha, answer);
-    comparation(online_384, answer, 48);
-
-    printf("%s\n", "-----------------------------SHA-256 TESTING-----------------------------");
-    //4 теста для SHA-256
-    sha.ftype = 256;
-
-    sha.msg = lazy_dog;
-    sha.msg_size = sizeof(lazy_dog);
-    printf("%s\n", "SHA-256 TEST 1: The quick brown fox jumps over the lazy dog");
-    ak_sha3_function(sha, answer);
-    comparation(lazy_dog_256, answer, 32);
-
-    sha.msg = lazy_dog_point;
-    sha.msg_size = sizeof(lazy_dog_point);
-    printf("%s\n", "SHA-256 TEST 2: The quick brown fox jumps over the lazy dog.");
-    ak_sha3_function(sha, answer);
-    comparation(lazy_dog_256_point, answer, 32);
-
-    sha.msg = nist1600;
-    sha.msg_size = sizeof(nist1600);
-    printf("%s\n", "SHA-256 TEST 3: 200 bytes = 0xA3");
-    ak_sha3_function(sha, answer);
-    comparation(nist1600_256, answer, 32);
-
-    sha.msg = online;
-    sha.msg_size = sizeof(online);
-    printf("%s\n", "SHA-256 TEST 4: absdaudwuwdhawfLsiefdifhdshgfefsefSdhfdsfhyytrtytghshdhfghrhwhsjjfjJerz");
-    ak_sha3_function(sha, answer);
-    comparation(online_256, answer, 32);
-
-    printf("%s\n", "-----------------------------SHA-224 TESTING-----------------------------");
-    //4 теста для SHA-224
-    sha.ftype = 224;
-
-    sha.msg = lazy_dog;
-    sha.msg_size = sizeof(lazy_dog);
-    printf("%s\n", "SHA-224 TEST 1: The quick brown fox jumps over the lazy dog");
-    ak_sha3_function(sha, answer);
-    comparation(lazy_dog_224, answer, 28);
-
-    sha.msg = lazy_dog_point;
-    sha.msg_size = sizeof(lazy_dog_point);
-    printf("%s\n", "SHA-224 TEST 2: The quick brown fox jumps over the lazy dog.");
-    ak_sha3_function(sha, answer);
-    comparation(lazy_dog_224_point, answer, 28);
-
-    sha.msg = nist1600;
-    sha.msg_size = sizeof(nist1600);
-    printf("%s\n", "SHA-224 TEST 3: 200 bytes = 0xA3");
-    ak_sha3_function(sha, answer);
-    comparation(nist1600_224, answer, 28);
-
-    sha.msg = online;
-    sha.msg_size = sizeof(online);
-    printf("%s\n", "SHA-224 TEST 4: absdaudwuwdhawfLsiefdifhdshgfefsefSdhfdsfhyytrtytghshdhfghrhwhsjjfjJerz");
-    ak_sha3_function(sha, answer);
-    comparation(online_224, answer, 28);
-
-    //for (int i = 0; i < 64; i++) printf("%0x\n", answer[i]);
-
-
-    return ak_error_ok;
+    if( audit >= ak_log_maximum )
+      ak_error_message( ak_error_ok, __func__ , "the avx2 implementation of permutation is Ok" );
+  }
+#endif
+
+ /* сравниваем результаты функций SHA-3 */
+  for( i = 0; i < 4; i++ ) {
+     if(( error = create[i]( &ctx )) != ak_error_ok ) {
+       ak_error_message( error, __func__ , "wrong initialization of sha3 context" );
+       result = ak_false;
+       goto lab_exit;
+     }
+     for( t = 0; t < 4; t++ ) {
+        ak_keccak_sha3_x4( hsizes[i], in, lengths[t], outs );
+        for( j = 0; j < 4; j++ ) {
+           ak_hash_ptr( &ctx, data[j], lengths[t][j], out2, hsizes[i] );
+           if(( result = ak_ptr_is_equal_with_log( out[j], out2, hsizes[i] )) != ak_true ) {
+             ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                       "the 4-way test for %s with message length %u is wrong",
+                                                ctx.oid->name[0], (unsigned int) lengths[t][j] );
+             ak_hash_destroy( &ctx );
+             goto lab_exit;
+           }
+        }
+     }
+     if( audit >= ak_log_maximum )
+       ak_error_message_fmt( ak_error_ok, __func__ , "the 4-way test for %s is Ok",
+                                                                               ctx.oid->name[0] );
+     ak_hash_destroy( &ctx );
+  }
+
+ /* сравниваем результаты функций SHAKE, длина выхода превышает размер блока */
+  for( i = 0; i < 2; i++ ) {
+     if(( error = ( i ? ak_hash_create_shake256 : ak_hash_create_shake128 )( &ctx ))
+                                                                              != ak_error_ok ) {
+       ak_error_message( error, __func__ , "wrong initialization of shake context" );
+       result = ak_false;
+       goto lab_exit;
+     }
+     for( t = 0; t < 4; t++ ) {
+        if( i ) ak_keccak_shake256_x4( in, lengths[t], outs, sizeof( out2 ));
+          else ak_keccak_shake128_x4( in, lengths[t], outs, sizeof( out2 ));
+        for( j = 0; j < 4; j++ ) {
+           ak_hash_ptr( &ctx, data[j], lengths[t][j], out2, sizeof( out2 ));
+           if(( result = ak_ptr_is_equal_with_log( out[j], out2, sizeof( out2 ))) != ak_true ) {
+             ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                       "the 4-way test for %s with message length %u is wrong",
+                                                ctx.oid->name[0], (unsigned int) lengths[t][j] );
+             ak_hash_destroy( &ctx );
+             goto lab_exit;
+           }
+        }
+     }
+     if( audit >= ak_log_maximum )
+       ak_error_message_fmt( ak_error_ok, __func__ , "the 4-way test for %s is Ok",
+                                                                               ctx.oid->name[0] );
+     ak_hash_destroy( &ctx );
+  }
+
+ lab_exit:
+  ak_random_destroy( &rnd );
+ return result;
 }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Мини-функция для вывода результата хеширования на консоль: выводит байты, разделенные 
-   между собой пробелом                                                                            */
+/*                                                                                    ak_keccak.c  */
 /* ----------------------------------------------------------------------------------------------- */
-/*
-void ak_sha3_get_hash(ak_keccak sha, ak_uint8 answer[]) {
-    ak_sha3_function(sha, answer);
-    int i;
-    for(i=0; i< sha.ftype / 8; i++) printf("%0x\", answer[i]);
-}
-*/
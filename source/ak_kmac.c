@@ -0,0 +1,587 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Copyright (c) 2020 by Axel Kenzo, axelkenzo@mail.ru                                            */
+/*                                                                                                 */
+/*  Файл ak_kmac.с                                                                                 */
+/*  - содержит реализацию алгоритмов выработки имитовставки KMAC128 и KMAC256 (NIST SP 800-185).  */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <libakrypt-internal.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+#ifdef AK_HAVE_STRING_H
+ #include <string.h>
+#else
+ #error Library cannot be compiled without string.h header
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Очистка контекста алгоритма kmac.
+    \details Функция возвращает губку в состояние, полученное после впитывания имени функции и
+    строки настройки, после чего впитывает значение секретного ключа.
+    \param ctx Контекст алгоритма KMAC выработки имитовставки.
+    \return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_kmac_internal_clean( ak_pointer ctx )
+{
+  int error = ak_error_ok;
+  ak_kmac kctx = ( ak_kmac ) ctx;
+
+  if( ctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                      "using a null pointer to kmac key context" );
+ /* проверяем наличие ключа и его ресурс */
+  if( !((kctx->key.flags)&ak_key_flag_set_key )) return ak_error_message( ak_error_key_value,
+                                               __func__ , "using kmac key with unassigned value" );
+  if( kctx->key.resource.value.counter <= 0 ) return ak_error_message( ak_error_low_key_resource,
+                                            __func__, "using kmac key context with low resource" );
+
+ /* восстанавливаем начальное состояние губки и впитываем ключ */
+  memcpy( kctx->kctx.st, kctx->iv, sizeof( kctx->iv ));
+  kctx->kctx.pos = 0;
+  kctx->kctx.squeezing = ak_false;
+  if(( error = ak_keccak_absorb_skey( &kctx->kctx, &kctx->key )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect absorbing of secret key" );
+
+ /* перемаскируем ключ и меняем его ресурс */
+  kctx->key.set_mask( &kctx->key );
+  kctx->key.resource.value.counter--; /* мы использовали ключ один раз */
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Обновление состояния контекста сжимающего отображения.
+    \param ctx Контекст алгоритма KMAC выработки имитовставки.
+    \param data Указатель на обрабатываемые данные.
+    \param size Длина обрабатываемых данных (в байтах); длина должна быть кратна длине блока
+    обрабатываемых данных
+    \return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_kmac_internal_update( ak_pointer ctx, const ak_pointer in, const size_t size )
+{
+  ak_kmac kctx = ( ak_kmac ) ctx;
+
+  if( ctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                      "using a null pointer to kmac key context" );
+  if( !size ) return ak_error_message( ak_error_zero_length, __func__ ,
+                                                      "using zero length for authenticated data" );
+  if( size%kctx->mctx.bsize ) return ak_error_message( ak_error_wrong_length, __func__ ,
+                                                                  "using data with wrong length" );
+ /* проверяем наличие ключа */
+  if( !((kctx->key.flags)&ak_key_flag_set_key )) return ak_error_message( ak_error_key_value,
+                                               __func__ , "using kmac key with unassigned value" );
+
+ return ak_keccak_absorb( &kctx->kctx, in, size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Обновление состояния и вычисление результата применения сжимающего отображения.
+    \details Функция впитывает хвост данных и значение right_encode( L ), где L - длина
+    имитовставки в битах, после чего вырабатывает имитовставку. Внутреннее состояние контекста
+    не изменяется.
+    \param ctx Контекст алгоритма KMAC выработки имитовставки.
+    \param data Блок входных данных; длина блока должна быть менее, чем длина блока
+           обрабатываемых данных
+    \param size Длина блока обрабатываемых данных
+    \param out Указатель на область памяти, куда будет помещен результат.
+    \return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_kmac_internal_finalize( ak_pointer ctx,
+                    const ak_pointer in, const size_t size, ak_pointer out, const size_t out_size )
+{
+  int error = ak_error_ok;
+  ak_kmac kctx = ( ak_kmac ) ctx;
+  struct keccak kx; /* копия текущего состояния губки */
+
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                          "using a null pointer to kmac context" );
+  if( out == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                   "using null pointer to externl result buffer" );
+  if( size >= kctx->mctx.bsize ) return ak_error_message( ak_error_zero_length,
+                                          __func__ , "using wrong length for authenticated data" );
+  if( !((kctx->key.flags)&ak_key_flag_set_key )) return ak_error_message( ak_error_key_value,
+                                               __func__ , "using kmac key with unassigned value" );
+
+  memcpy( &kx, &kctx->kctx, sizeof( struct keccak ));
+  if(( error = ak_keccak_absorb( &kx, in, size )) != ak_error_ok ) {
+    ak_error_message( error, __func__ , "wrong updating of finalized data" );
+    goto lab_exit;
+  }
+  if(( error = ak_keccak_absorb_right_encode( &kx, kx.hsize << 3 )) != ak_error_ok ) {
+    ak_error_message( error, __func__ , "wrong absorbing of output length" );
+    goto lab_exit;
+  }
+  if(( error = ak_keccak_squeeze( &kx, out, ak_min( kx.hsize, out_size ))) != ak_error_ok )
+    ak_error_message( error, __func__ , "wrong squeezing of integrity code" );
+
+ lab_exit:
+  memset( &kx, 0, sizeof( struct keccak ));
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Общая часть инициализации контекстов KMAC128 и KMAC256.
+    \param kctx Контекст алгоритма KMAC выработки имитовставки.
+    \param name Имя алгоритма, используемое для поиска OID.
+    \param rate Размер блока входных данных губки (в октетах).
+    \return В случае успешного завершения функция возвращает \ref ak_error_ok. В случае
+    возникновения ошибки возвращеется ее код.                                                      */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_kmac_create( ak_kmac kctx, const char *name, const size_t rate )
+{
+  ak_oid oid = NULL;
+  int error = ak_error_ok;
+
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                            "using null pointer to kmac context" );
+  if(( oid = ak_oid_find_by_name( name )) == NULL )
+    return ak_error_message_fmt( ak_error_wrong_oid, __func__,
+                                                 "incorrect internal search of %s identifier", name );
+ /* инициализируем губку без строки настройки */
+  if(( error = ak_kmac_set_customization( kctx, NULL, 0 )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect initialization of keccak context" );
+
+ /* инициализируем контекст сжимающего отображения */
+  if(( error = ak_mac_create(
+                 &kctx->mctx, /* контекст */
+                 rate, /* размер входного блока совпадает с размером блока губки */
+                 kctx, /* указатель на объек, которым будут оперировать функции */
+                 ak_kmac_internal_clean,
+                 ak_kmac_internal_update,
+                 ak_kmac_internal_finalize )) != ak_error_ok ) {
+    ak_keccak_destroy( &kctx->kctx );
+    return ak_error_message( error, __func__, "invalid creation of mac function context" );
+  }
+  kctx->mctx.bsize = rate;
+
+ /* инициализируем контекст секретного ключа */
+  if(( error = ak_skey_create( &kctx->key, kctx->kctx.hsize )) != ak_error_ok ) {
+    ak_kmac_destroy( kctx );
+    return ak_error_message( error, __func__, "wrong creation of secret key context" );
+  }
+ /* доопределяем oid ключа */
+  kctx->key.oid = oid;
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param kctx Контекст алгоритма KMAC выработки имитовставки.
+    \return В случае успешного завершения функций возвращает \ref ak_error_ok. В случае
+    возникновения ошибки возвращеется ее код.                                                      */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_kmac_create_kmac128( ak_kmac kctx )
+{
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                            "using null pointer to kmac context" );
+  kctx->kctx.rate = 168;
+ return ak_kmac_create( kctx, "kmac128", 168 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param kctx Контекст алгоритма KMAC выработки имитовставки.
+    \return В случае успешного завершения функций возвращает \ref ak_error_ok. В случае
+    возникновения ошибки возвращеется ее код.                                                      */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_kmac_create_kmac256( ak_kmac kctx )
+{
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                            "using null pointer to kmac context" );
+  kctx->kctx.rate = 136;
+ return ak_kmac_create( kctx, "kmac256", 136 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param kctx Контекст алгоритма KMAC выработки имитовставки.
+    \param oid Идентификатор алгоритма KMAC.
+    \return В случае успешного завершения функция возвращает \ref ak_error_ok. В случае
+    возникновения ошибки возвращеется ее код.                                                      */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_kmac_create_oid( ak_kmac kctx, ak_oid oid )
+{
+  int error = ak_error_ok;
+
+ /* выполняем проверку */
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                            "using null pointer to kmac context" );
+  if( oid == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                          "using null pointer to kmac function OID" );
+ /* проверяем, что OID от правильного алгоритма выработки */
+  if( oid->engine != mac_function )
+    return ak_error_message( ak_error_oid_engine, __func__ , "using oid with wrong engine" );
+ /* проверяем, что OID от алгоритма, а не от параметров */
+  if( oid->mode != algorithm )
+    return ak_error_message( ak_error_oid_mode, __func__ , "using oid with wrong mode" );
+ /* проверяем, что производящая функция определена */
+  if( oid->func.first.create == NULL )
+    return ak_error_message( ak_error_undefined_function, __func__ ,
+                                                          "using oid with undefined constructor" );
+ /* инициализируем контекст */
+  if(( error = (( ak_function_hash_create *)oid->func.first.create )( kctx )) != ak_error_ok )
+      return ak_error_message( error, __func__, "invalid creation of kmac function context");
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param kctx Контекст алгоритма KMAC выработки имитовставки.
+    \return В случае успешного завершения функций возвращает \ref ak_error_ok. В случае
+    возникновения ошибки возвращеется ее код.                                                      */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_kmac_destroy( ak_kmac kctx )
+{
+  int error = ak_error_ok;
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                            "using null pointer to kmac context" );
+  if(( error = ak_keccak_destroy( &kctx->kctx )) != ak_error_ok )
+    ak_error_message( error, __func__, "incorrect destroying of keccak context" );
+  if(( error = ak_skey_destroy( &kctx->key )) != ak_error_ok )
+    ak_error_message( error, __func__, "incorrect destroying of secret key context" );
+  if(( error = ak_mac_destroy( &kctx->mctx )) != ak_error_ok )
+    ak_error_message( error, __func__, "incorrect destroying of mac context" );
+  memset( kctx->iv, 0, sizeof( kctx->iv ));
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция устанавливает строку настройки S (customization string) алгоритма KMAC и вычисляет
+    состояние губки, не зависящее от ключа. После вызова функции контекст должен быть очищен,
+    например, вызовом функции ak_kmac_clean().
+
+    \param kctx Контекст алгоритма KMAC выработки имитовставки.
+    \param custom Строка настройки; может принимать значение NULL, если длина строки равна нулю.
+    \param size Длина строки настройки (в октетах).
+    \return В случае успеха возвращается значение \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_kmac_set_customization( ak_kmac kctx, const ak_pointer custom, const size_t size )
+{
+  int error = ak_error_ok;
+
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                            "using null pointer to kmac context" );
+  if(( error = ak_keccak_create_cshake( &kctx->kctx,
+                                     kctx->kctx.rate, "KMAC", 4, custom, size )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect absorbing of customization string" );
+  memcpy( kctx->iv, kctx->kctx.st, sizeof( kctx->iv ));
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param kctx Контекст алгоритма KMAC выработки имитовставки.
+    К моменту вызова функции контекст должен быть инициализирован.
+    \param ptr Указатель на данные, которые будут интерпретироваться в качестве значения ключа.
+    \param size Размер данных, на которые указывает `ptr` (размер в байтах). Длина ключа
+    может быть произвольной.
+
+    \return В случае успеха возвращается значение \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_kmac_set_key( ak_kmac kctx, const ak_pointer ptr, const size_t size )
+{
+  int error = ak_error_ok;
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                            "using null pointer to kmac context" );
+  if(( error = ak_skey_set_key( &kctx->key, ptr, size )) != ak_error_ok )
+    return ak_error_message( error, __func__ , "incorrect assigning a secret key value" );
+
+ /* устанавливаем ресурс ключа */
+  if(( error = ak_skey_set_resource_values( &kctx->key,
+                          key_using_resource, "kmac_key_count_resource", 0, 0 )) != ak_error_ok )
+    ak_error_message( error, __func__, "incorrect assigning \"kmac_key_count_resource\" option" );
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param kctx Контекст алгоритма KMAC выработки имитовставки. К моменту вызова функции контекст
+    должен быть инициализирован.
+    \param generator Контекст генератора псевдо-случайных чисел.
+
+    @return В случае успеха возвращается значение \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_kmac_set_key_random( ak_kmac kctx, ak_random generator )
+{
+  int error = ak_error_ok;
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                        "using null pointer to kmac context" );
+  if(( error = ak_skey_set_key_random( &kctx->key, generator )) != ak_error_ok )
+    return ak_error_message( error, __func__ , "incorrect assigning a secret key value" );
+
+ /* устанавливаем ресурс ключа */
+  if(( error = ak_skey_set_resource_values( &kctx->key,
+                          key_using_resource, "kmac_key_count_resource", 0, 0 )) != ak_error_ok )
+    ak_error_message( error, __func__, "incorrect assigning \"kmac_key_count_resource\" option" );
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param kctx Контекст алгоритма KMAC выработки имитовставки.
+    \return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_kmac_clean( ak_kmac kctx )
+{
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                         "cleaning null pointer to kmac context" );
+ return ak_mac_clean( &kctx->mctx );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param kctx Контекст алгоритма KMAC выработки имитовставки.
+    \param in Указатель на входные данные для которых вычисляется имитовставка.
+    \param size Размер входных данных в байтах.
+
+    @return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_kmac_update( ak_kmac kctx, const ak_pointer in, const size_t size )
+{
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                         "updating null pointer to kmac context" );
+ return ak_mac_update( &kctx->mctx, in, size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param kctx Контекст алгоритма KMAC выработки имитовставки.
+    \param in Указатель на входные данные для которых вычисляется имитовставка.
+    \param size Размер входных данных в байтах.
+    \param out Область памяти, куда будет помещен результат. Память должна быть заранее выделена.
+    Размер выделяемой памяти должен быть не менее значения, возвращаемого функцией
+    ak_kmac_get_tag_size().
+    \param out_size Размер области памяти (в октетах), в которую будет помещен результат.
+
+    \return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_kmac_finalize( ak_kmac kctx, const ak_pointer in, const size_t size,
+                                                           ak_pointer out, const size_t out_size )
+{
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                       "finalizing null pointer to kmac context" );
+ return ak_mac_finalize( &kctx->mctx, in, size, out, out_size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param kctx Контекст алгоритма KMAC выработки имитовставки.
+    \param in Указатель на входные данные для которых вычисляется имитовставка.
+    \param size Размер входных данных в байтах.
+    \param out Область памяти, куда будет помещен результат. Память должна быть заранее выделена.
+    \param out_size Размер области памяти (в октетах), в которую будет помещен результат.
+
+    \return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_kmac_ptr( ak_kmac kctx, const ak_pointer in, const size_t size,
+                                                           ak_pointer out, const size_t out_size )
+{
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                            "using null pointer to kmac context" );
+ return ak_mac_ptr( &kctx->mctx, in, size, out, out_size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param kctx Контекст алгоритма KMAC выработки имитовставки.
+    \param filename Имя файла, для котрого вычисляется имитовставка.
+    \param out Область памяти, куда будет помещен результат. Память должна быть заранее выделена.
+    \param out_size Размер области памяти (в октетах), в которую будет помещен результат.
+
+    \return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_kmac_file( ak_kmac kctx, const char * filename, ak_pointer out, const size_t out_size )
+{
+  if( kctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                            "using null pointer to kmac context" );
+ return ak_mac_file( &kctx->mctx, filename, out, out_size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param kctx Контекст алгоритма KMAC выработки имитовставки.
+    \return Функция возвращает длину имитовставки в октетах. В случае возникновения ошибки,
+    возвращается ноль. Код ошибки может быть получен с помощью вызова функции ak_error_get_value().*/
+/* ----------------------------------------------------------------------------------------------- */
+ size_t ak_kmac_get_tag_size( ak_kmac kctx )
+{
+  if( kctx == NULL ) {
+    ak_error_message( ak_error_null_pointer, __func__, "using null pointer to kmac context" );
+    return 0;
+  }
+
+ return kctx->kctx.hsize;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \param kctx Контекст алгоритма KMAC выработки имитовставки.
+    \return Функция возвращает длину блока в октетах. В случае возникновения ошибки,
+    возвращается ноль. Код ошибки может быть получен с помощью вызова функции ak_error_get_value().*/
+/* ----------------------------------------------------------------------------------------------- */
+ size_t ak_kmac_get_block_size( ak_kmac kctx )
+{
+  if( kctx == NULL ) {
+    ak_error_message( ak_error_null_pointer, __func__, "using null pointer to kmac context" );
+    return 0;
+  }
+
+ return kctx->mctx.bsize;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                          Функции тестирования алгоритмов работы                                 */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Строка настройки из примеров NIST (KMAC_samples.pdf). */
+ static const char *kmac_tagged_application = "My Tagged Application";
+
+/*! \brief Результаты вычисления KMAC128, примеры 1-3 (NIST, KMAC_samples.pdf). */
+ static ak_uint8 kmac128_sample[3][32] = {
+  { 0xe5, 0x78, 0x0b, 0x0d, 0x3e, 0xa6, 0xf7, 0xd3, 0xa4, 0x29, 0xc5, 0x70, 0x6a, 0xa4, 0x3a, 0x00,
+    0xfa, 0xdb, 0xd7, 0xd4, 0x96, 0x28, 0x83, 0x9e, 0x31, 0x87, 0x24, 0x3f, 0x45, 0x6e, 0xe1, 0x4e },
+  { 0x3b, 0x1f, 0xba, 0x96, 0x3c, 0xd8, 0xb0, 0xb5, 0x9e, 0x8c, 0x1a, 0x6d, 0x71, 0x88, 0x8b, 0x71,
+    0x43, 0x65, 0x1a, 0xf8, 0xba, 0x0a, 0x70, 0x70, 0xc0, 0x97, 0x9e, 0x28, 0x11, 0x32, 0x4a, 0xa5 },
+  { 0x1f, 0x5b, 0x4e, 0x6c, 0xca, 0x02, 0x20, 0x9e, 0x0d, 0xcb, 0x5c, 0xa6, 0x35, 0xb8, 0x9a, 0x15,
+    0xe2, 0x71, 0xec, 0xc7, 0x60, 0x07, 0x1d, 0xfd, 0x80, 0x5f, 0xaa, 0x38, 0xf9, 0x72, 0x92, 0x30 }
+ };
+
+/*! \brief Результаты вычисления KMAC256, примеры 4-6 (NIST, KMAC_samples.pdf). */
+ static ak_uint8 kmac256_sample[3][64] = {
+  { 0x20, 0xc5, 0x70, 0xc3, 0x13, 0x46, 0xf7, 0x03, 0xc9, 0xac, 0x36, 0xc6, 0x1c, 0x03, 0xcb, 0x64,
+    0xc3, 0x97, 0x0d, 0x0c, 0xfc, 0x78, 0x7e, 0x9b, 0x79, 0x59, 0x9d, 0x27, 0x3a, 0x68, 0xd2, 0xf7,
+    0xf6, 0x9d, 0x4c, 0xc3, 0xde, 0x9d, 0x10, 0x4a, 0x35, 0x16, 0x89, 0xf2, 0x7c, 0xf6, 0xf5, 0x95,
+    0x1f, 0x01, 0x03, 0xf3, 0x3f, 0x4f, 0x24, 0x87, 0x10, 0x24, 0xd9, 0xc2, 0x77, 0x73, 0xa8, 0xdd },
+  { 0x75, 0x35, 0x8c, 0xf3, 0x9e, 0x41, 0x49, 0x4e, 0x94, 0x97, 0x07, 0x92, 0x7c, 0xee, 0x0a, 0xf2,
+    0x0a, 0x3f, 0xf5, 0x53, 0x90, 0x4c, 0x86, 0xb0, 0x8f, 0x21, 0xcc, 0x41, 0x4b, 0xcf, 0xd6, 0x91,
+    0x58, 0x9d, 0x27, 0xcf, 0x5e, 0x15, 0x36, 0x9c, 0xbb, 0xff, 0x8b, 0x9a, 0x4c, 0x2e, 0xb1, 0x78,
+    0x00, 0x85, 0x5d, 0x02, 0x35, 0xff, 0x63, 0x5d, 0xa8, 0x25, 0x33, 0xec, 0x6b, 0x75, 0x9b, 0x69 },
+  { 0xb5, 0x86, 0x18, 0xf7, 0x1f, 0x92, 0xe1, 0xd5, 0x6c, 0x1b, 0x8c, 0x55, 0xdd, 0xd7, 0xcd, 0x18,
+    0x8b, 0x97, 0xb4, 0xca, 0x4d, 0x99, 0x83, 0x1e, 0xb2, 0x69, 0x9a, 0x83, 0x7d, 0xa2, 0xe4, 0xd9,
+    0x70, 0xfb, 0xac, 0xfd, 0xe5, 0x00, 0x33, 0xae, 0xa5, 0x85, 0xf1, 0xa2, 0x70, 0x85, 0x10, 0xc3,
+    0x2d, 0x07, 0x88, 0x08, 0x01, 0xbd, 0x18, 0x28, 0x98, 0xfe, 0x47, 0x68, 0x76, 0xfc, 0x89, 0x65 }
+ };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление и проверка одного примера NIST для алгоритма KMAC. */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_libakrypt_test_kmac_sample( ak_kmac kctx, const char *custom,
+                             const ak_pointer in, const size_t size, ak_uint8 *value, int number )
+{
+  ak_uint8 out[64];
+  int error = ak_error_ok;
+  size_t tag = ak_kmac_get_tag_size( kctx );
+
+  if(( error = ak_kmac_set_customization( kctx, ( ak_pointer )custom,
+                                           custom == NULL ? 0 : strlen( custom ))) != ak_error_ok ) {
+    ak_error_message( error, __func__ , "incorrect assigning of customization string" );
+    return ak_false;
+  }
+  memset( out, 0, sizeof( out ));
+  if(( error = ak_kmac_ptr( kctx, in, size, out, sizeof( out ))) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__ , "incorrect calculation of %s code",
+                                                                     kctx->key.oid->name[0] );
+    return ak_false;
+  }
+  if( ak_ptr_is_equal_with_log( out, value, tag ) != ak_true ) {
+    ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                          "the sample #%d from NIST SP 800-185 for %s is wrong",
+                                                             number, kctx->key.oid->name[0] );
+    return ak_false;
+  }
+  if( ak_log_get_level() >= ak_log_maximum )
+    ak_error_message_fmt( ak_error_ok, __func__ , "the sample #%d from NIST SP 800-185 for %s is Ok",
+                                                             number, kctx->key.oid->name[0] );
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*!  @return Если тестирование прошло успешно возвращается \ref ak_true (истина). В противном
+     случае возвращается \ref ak_false.                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_libakrypt_test_kmac( void )
+{
+  size_t i;
+  ak_uint32 steps;
+  struct kmac kctx;
+  struct random rnd;
+  int error = ak_error_ok;
+  bool_t result = ak_true;
+  size_t len, offset;
+  int audit = ak_log_get_level();
+  ak_uint8 key[32], data[200], out[64], out2[64], *ptr = NULL;
+
+  for( i = 0; i < sizeof( key ); i++ ) key[i] = ( ak_uint8 )( 0x40 + i );
+  for( i = 0; i < sizeof( data ); i++ ) data[i] = ( ak_uint8 ) i;
+
+ /* примеры 1-3 для KMAC128 */
+  if(( error = ak_kmac_create_kmac128( &kctx )) != ak_error_ok ) {
+    ak_error_message( error, __func__ , "incorrect initialization of kmac128 context" );
+    return ak_false;
+  }
+  if(( error = ak_kmac_set_key( &kctx, key, sizeof( key ))) != ak_error_ok ) {
+    ak_error_message( error, __func__ , "incorrect assigning a key value" );
+    result = ak_false;
+    goto lab_exit;
+  }
+  if(( result = ak_libakrypt_test_kmac_sample( &kctx, NULL, data, 4,
+                                                   kmac128_sample[0], 1 )) != ak_true ) goto lab_exit;
+  if(( result = ak_libakrypt_test_kmac_sample( &kctx, kmac_tagged_application, data, 4,
+                                                   kmac128_sample[1], 2 )) != ak_true ) goto lab_exit;
+  if(( result = ak_libakrypt_test_kmac_sample( &kctx, kmac_tagged_application, data, 200,
+                                                   kmac128_sample[2], 3 )) != ak_true ) goto lab_exit;
+  ak_kmac_destroy( &kctx );
+
+ /* примеры 4-6 для KMAC256 */
+  if(( error = ak_kmac_create_kmac256( &kctx )) != ak_error_ok ) {
+    ak_error_message( error, __func__ , "incorrect initialization of kmac256 context" );
+    return ak_false;
+  }
+  if(( error = ak_kmac_set_key( &kctx, key, sizeof( key ))) != ak_error_ok ) {
+    ak_error_message( error, __func__ , "incorrect assigning a key value" );
+    result = ak_false;
+    goto lab_exit;
+  }
+  if(( result = ak_libakrypt_test_kmac_sample( &kctx, kmac_tagged_application, data, 4,
+                                                   kmac256_sample[0], 4 )) != ak_true ) goto lab_exit;
+  if(( result = ak_libakrypt_test_kmac_sample( &kctx, NULL, data, 200,
+                                                   kmac256_sample[1], 5 )) != ak_true ) goto lab_exit;
+  if(( result = ak_libakrypt_test_kmac_sample( &kctx, kmac_tagged_application, data, 200,
+                                                   kmac256_sample[2], 6 )) != ak_true ) goto lab_exit;
+
+ /* тестирование алгоритма выработки имитовставки фрагментами произвольной длины */
+  ak_random_create_lcg( &rnd );
+  steps = 0;
+  ptr = data;
+  offset = sizeof( data );
+  ak_kmac_clean( &kctx );
+  do{
+      ak_random_ptr( &rnd, &len, sizeof( len )); len = ak_min( len%47, offset );
+      if( len > 0 ) {
+        ak_kmac_update( &kctx, ptr, len );
+        ptr += len;
+        offset -= len;
+        ++steps;
+      }
+  } while( offset );
+  memset( out2, 0, sizeof( out2 ));
+  ak_kmac_finalize( &kctx, NULL, 0, out2, sizeof( out2 ));
+  ak_random_destroy( &rnd );
+
+  memcpy( out, kmac256_sample[2], sizeof( out ));
+  if(( result = ak_ptr_is_equal_with_log( out, out2, sizeof( out ))) != ak_true ) {
+    ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                                            "the random walk test with %u steps is wrong", steps );
+    goto lab_exit;
+  }
+  if( audit >= ak_log_maximum )
+    ak_error_message_fmt( ak_error_ok, __func__ ,
+                                               "the random walk test with %u steps is Ok", steps );
+ lab_exit:
+  ak_kmac_destroy( &kctx );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                                                                                      ak_kmac.c  */
+/* ----------------------------------------------------------------------------------------------- */
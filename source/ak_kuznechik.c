@@ -255,6 +255,14 @@
        memcpy( par->dec[i][j], ib, 16 );
      }
   }
+
+ /* вычисляем итерационные константы развертки ключа (каноническое представление) */
+  for( i = 0; i < 32; i++ ) {
+     ak_uint8 c[16];
+     memset( c, 0, sizeof( c ));
+     c[0] = ( ak_uint8 )( i+1 );
+     ak_kuznechik_matrix_mul_vector( par->L, c, ( ak_uint8 *)par->cons[i] );
+  }
  return ak_error_ok;
 }
 
@@ -301,6 +309,41 @@
  return error;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет значение LS(x) с использованием развернутых таблиц зашифрования.
+    \details Функция может использоваться только в случае, когда таблицы выработаны для
+    канонического представления данных (опция `openssl_compability` равна нулю).                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_kuznechik_ls_table( ak_uint64 *w )
+{
+  int i = 0;
+  ak_uint64 t0 = 0, t1 = 0;
+  const ak_uint8 *b = ( const ak_uint8 *)w;
+
+  for( i = 0; i < 16; i++ ) {
+     t0 ^= kuznechik_parameters.enc[i][b[i]][0];
+     t1 ^= kuznechik_parameters.enc[i][b[i]][1];
+  }
+  w[0] = t0; w[1] = t1;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет значение \f$ L^{-1}(x) \f$ с использованием развернутых таблиц
+    расшифрования (для канонического представления данных).                                        */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_kuznechik_linv_table( const ak_uint64 *w, ak_uint64 *x )
+{
+  int i = 0;
+  ak_uint64 t0 = 0, t1 = 0;
+  const ak_uint8 *b = ( const ak_uint8 *)w;
+
+  for( i = 0; i < 16; i++ ) {
+     t0 ^= kuznechik_parameters.dec[i][kuznechik_parameters.pi[b[i]]][0];
+     t1 ^= kuznechik_parameters.dec[i][kuznechik_parameters.pi[b[i]]][1];
+  }
+  x[0] = t0; x[1] = t1;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Функция реализует развертку ключей для алгоритма Кузнечик.
     \param skey Указатель на контекст секретного ключа, в который помещаются развернутые
@@ -312,7 +355,7 @@
 {
   ak_uint8 reverse[64];
   int i = 0, j = 0, l = 0, kdx = 2;
-  ak_uint64 a0[2], a1[2], c[2], t[2], idx = 0;
+  ak_uint64 a0[2], a1[2], t[2];
   ak_int64 oc = ak_libakrypt_get_option_by_name( "openssl_compability" );
   ak_uint64 *ekey = NULL, *mkey = NULL, *dkey = NULL, *xkey = NULL, *rkey = NULL, *lkey = NULL;
 
@@ -324,13 +367,14 @@
  /* проверяем целостность ключа */
   if( skey->check_icode( skey ) != ak_true ) return ak_error_message( ak_error_wrong_key_icode,
                                                 __func__ , "using key with wrong integrity code" );
- /* удаляем былое */
-  if( skey->data != NULL ) ak_kuznechik_delete_keys( skey );
-
- /* далее, по-возможности, выделяем выравненную память */
-  if(( skey->data = ak_aligned_malloc( sizeof( ak_kuznechik_expanded_keys ))) == NULL )
-    return ak_error_message( ak_error_out_of_memory, __func__ ,
+ /* при повторной развертке (например, при смене ключа в режимах ACPKM) используется
+    ранее выделенная память: все раундовые ключи и маски будут перезаписаны */
+  if( skey->data == NULL ) {
+   /* по-возможности, выделяем выравненную память */
+    if(( skey->data = ak_aligned_malloc( sizeof( ak_kuznechik_expanded_keys ))) == NULL )
+      return ak_error_message( ak_error_out_of_memory, __func__ ,
                                                              "wrong allocation of internal data" );
+  }
  /* получаем указатели на области памяти */
   ekey = ( ak_uint64 *)skey->data;                  /* 10 прямых раундовых ключей */
   dkey = ( ak_uint64 *)skey->data + 20;           /* 10 обратных раундовых ключей */
@@ -359,23 +403,22 @@
   dkey[0] = a1[0]^xkey[0]; dkey[1] = a1[1]^xkey[1];
 
   ekey[2] = a0[0]^mkey[2]; ekey[3] = a0[1]^mkey[3];
-  ak_kuznechik_matrix_mul_vector( kuznechik_parameters.Linv,
+  if( oc ) ak_kuznechik_matrix_mul_vector( kuznechik_parameters.Linv,
                                             (ak_uint8 *)a0, (ak_uint8 *)( dkey+2 ));
+   else ak_kuznechik_linv_table( a0, dkey+2 );
   dkey[2] ^= xkey[2]; dkey[3] ^= xkey[3];
 
+ /* развернутые таблицы используются только для канонического представления данных,
+    константы алгоритма согласно ГОСТ Р 34.12-2015 вычислены заранее */
   for( j = 0; j < 4; j++ ) {
      for( i = 0; i < 8; i++ ) {
-      #ifdef AK_LITTLE_ENDIAN
-        c[0] = ++idx; /* вычисляем константу алгоритма согласно ГОСТ Р 34.12-2015 */
-      #else
-        c[0] = bswap_64( ++idx );
-      #endif
-        c[1] = 0;
-        ak_kuznechik_linear_steps(( ak_uint8 *)c );
-
-        t[0] = a1[0] ^ c[0]; t[1] = a1[1] ^ c[1];
-        for( l = 0; l < 16; l++ ) ((ak_uint8 *)t)[l] = kuznechik_parameters.pi[ ((ak_uint8 *)t)[l]];
-        ak_kuznechik_linear_steps(( ak_uint8 *)t );
+        t[0] = a1[0] ^ kuznechik_parameters.cons[8*j+i][0];
+        t[1] = a1[1] ^ kuznechik_parameters.cons[8*j+i][1];
+        if( oc ) {
+          for( l = 0; l < 16; l++ )
+             ((ak_uint8 *)t)[l] = kuznechik_parameters.pi[ ((ak_uint8 *)t)[l]];
+          ak_kuznechik_linear_steps(( ak_uint8 *)t );
+        } else ak_kuznechik_ls_table( t );
 
         t[0] ^= a0[0]; t[1] ^= a0[1];
         a0[0] = a1[0]; a0[1] = a1[1];
@@ -383,14 +426,16 @@
      }
      kdx += 2;
      ekey[kdx] = a1[0]^mkey[kdx]; ekey[kdx+1] = a1[1]^mkey[kdx+1];
-     ak_kuznechik_matrix_mul_vector( kuznechik_parameters.Linv,
+     if( oc ) ak_kuznechik_matrix_mul_vector( kuznechik_parameters.Linv,
                                          ( ak_uint8 *)a1, (ak_uint8 *)( dkey+kdx ));
+      else ak_kuznechik_linv_table( a1, dkey+kdx );
      dkey[kdx] ^= xkey[kdx]; dkey[kdx+1] ^= xkey[kdx+1];
 
      kdx += 2;
      ekey[kdx] = a0[0]^mkey[kdx]; ekey[kdx+1] = a0[1]^mkey[kdx+1];
-     ak_kuznechik_matrix_mul_vector( kuznechik_parameters.Linv,
+     if( oc ) ak_kuznechik_matrix_mul_vector( kuznechik_parameters.Linv,
                                          ( ak_uint8 *)a0, (ak_uint8 *)( dkey+kdx ));
+      else ak_kuznechik_linv_table( a0, dkey+kdx );
      dkey[kdx] ^= xkey[kdx]; dkey[kdx+1] ^= xkey[kdx+1];
   }
 
@@ -670,6 +715,135 @@
   (( ak_uint64 *) out)[1] = x[1] ^ xkey[1];
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет значение LS(x) с использованием развернутых таблиц зашифрования
+    для представления данных, совместимого с библиотекой openssl.                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_kuznechik_ls_table_oc( ak_uint64 *w )
+{
+  int i = 0;
+  ak_uint64 t0 = 0, t1 = 0;
+  const ak_uint8 *b = ( const ak_uint8 *)w;
+
+  for( i = 0; i < 16; i++ ) {
+     t0 ^= kuznechik_parameters.enc[i][b[15-i]][0];
+     t1 ^= kuznechik_parameters.enc[i][b[15-i]][1];
+  }
+  w[0] = t0; w[1] = t1;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество блоков, одновременно обрабатываемых в режиме гаммирования. */
+ #define ak_kuznechik_ctr_batch     (4)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция реализует режим гаммирования для последовательности блоков.
+
+    \details В режиме гаммирования соседние значения счетчика отличаются только младшим октетом,
+    поэтому для 256 последовательных значений счетчика вклад остальных 15 октетов в результат
+    первого раунда одинаков. Функция вычисляет этот вклад один раз и для каждого блока
+    добавляет к нему только одно табличное значение, соответствующее младшему октету.
+    Остальные раунды выполняются одновременно для \ref ak_kuznechik_ctr_batch независимых
+    блоков, что позволяет процессору совмещать обращения к таблицам.
+    Младший октет счетчика всегда поступает на вход нулевой таблицы: при каноническом
+    представлении данных он расположен в нулевом октете блока, при представлении,
+    совместимом с openssl, - в последнем.
+
+    Значение счетчика хранится и изменяется так же, как в функции ak_bckey_ctr():
+    перенос распространяется только в пределах 64-битной половины блока.
+
+    \param skey Контекст секретного ключа.
+    \param ivector Текущее значение счетчика; по завершении содержит значение,
+    следующее за последним использованным.
+    \param in Входные данные.
+    \param out Выходные данные (могут совпадать с входными).
+    \param blocks Количество обрабатываемых блоков.
+    \param p Номер октета, содержащего младший октет счетчика (0 или 15).                          */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_kuznechik_ctr_blocks( ak_skey skey, ak_pointer ivector,
+                               ak_pointer in, ak_pointer out, size_t blocks, const int p )
+{
+  int i = 0;
+  size_t j = 0, k = 0, m = 0, n = 0;
+  ak_uint8 lsb = 0, v = 0;
+  ak_uint64 *ekey = ( ak_uint64 *)skey->data;
+  ak_uint64 *mkey = ( ak_uint64 *)skey->data + 40;
+  ak_uint64 *inptr = ( ak_uint64 *)in, *outptr = ( ak_uint64 *)out;
+  ak_uint64 ctr[2], y[2], x[2*ak_kuznechik_ctr_batch], r[2];
+  ak_uint8 *c = ( ak_uint8 *)ctr, *b = ( ak_uint8 *)y;
+
+  ctr[0] = (( ak_uint64 *)ivector)[0]; ctr[1] = (( ak_uint64 *)ivector)[1];
+  while( blocks > 0 ) {
+     lsb = c[p];
+     n = ak_min( ( size_t )( 256 - lsb ), blocks );
+
+    /* вклад неизменяемых октетов счетчика в первый раунд */
+     y[0] = ctr[0] ^ ekey[0]; y[0] ^= mkey[0];
+     y[1] = ctr[1] ^ ekey[1]; y[1] ^= mkey[1];
+     r[0] = r[1] = 0;
+     for( i = 1; i < 16; i++ ) {
+        r[0] ^= kuznechik_parameters.enc[i][b[p ? 15-i : i]][0];
+        r[1] ^= kuznechik_parameters.enc[i][b[p ? 15-i : i]][1];
+     }
+
+    /* блоки обрабатываются группами, что позволяет совместить вычисления нескольких раундов */
+     for( j = 0; j < n; j += m ) {
+        m = ak_min( n - j, ak_kuznechik_ctr_batch );
+        for( k = 0; k < m; k++ ) {
+           v = ( ak_uint8 )( lsb + j + k ) ^ (( ak_uint8 *)ekey)[p];
+           v ^= (( ak_uint8 *)mkey)[p];
+           x[2*k] = r[0] ^ kuznechik_parameters.enc[0][v][0];
+           x[2*k+1] = r[1] ^ kuznechik_parameters.enc[0][v][1];
+        }
+        for( i = 2; i < 18; i += 2 ) {
+           for( k = 0; k < m; k++ ) {
+              x[2*k] ^= ekey[i]; x[2*k] ^= mkey[i];
+              x[2*k+1] ^= ekey[i+1]; x[2*k+1] ^= mkey[i+1];
+              if( p ) ak_kuznechik_ls_table_oc( x+2*k );
+               else ak_kuznechik_ls_table( x+2*k );
+           }
+        }
+        for( k = 0; k < 2*m; k += 2 ) {
+           outptr[k] = inptr[k] ^ x[k] ^ ekey[18] ^ mkey[18];
+           outptr[k+1] = inptr[k+1] ^ x[k+1] ^ ekey[19] ^ mkey[19];
+        }
+        inptr += 2*m; outptr += 2*m;
+     }
+     blocks -= n;
+
+    /* увеличиваем значение счетчика на n */
+     if(( c[p] = ( ak_uint8 )( lsb + n )) == 0 ) {
+       if( p ) { for( i = 14; i > 7; i-- ) if( ++c[i] != 0 ) break; }
+        else { for( i = 1; i < 8; i++ ) if( ++c[i] != 0 ) break; }
+     }
+  }
+  (( ak_uint64 *)ivector)[0] = ctr[0]; (( ak_uint64 *)ivector)[1] = ctr[1];
+
+  ak_ptr_wipe( y, sizeof( y ), &skey->generator );
+  ak_ptr_wipe( r, sizeof( r ), &skey->generator );
+  ak_ptr_wipe( x, sizeof( x ), &skey->generator );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция реализует режим гаммирования для последовательности блоков
+    (каноническое представление данных).                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_kuznechik_ctr_with_mask( ak_skey skey, ak_pointer ivector,
+                                                    ak_pointer in, ak_pointer out, size_t blocks )
+{
+  ak_kuznechik_ctr_blocks( skey, ivector, in, out, blocks, 0 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция реализует режим гаммирования для последовательности блоков
+    (представление данных, совместимое с библиотекой openssl).                                     */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_kuznechik_ctr_with_mask_oc( ak_skey skey, ak_pointer ivector,
+                                                    ak_pointer in, ak_pointer out, size_t blocks )
+{
+  ak_kuznechik_ctr_blocks( skey, ivector, in, out, blocks, 15 );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! После инициализации устанавливаются обработчики (функции класса). Однако само значение
     ключу не присваивается - поле `bkey->key` остается неопределенным.
@@ -706,10 +880,12 @@
   if( oc ) {
     bkey->encrypt = ak_kuznechik_encrypt_with_mask_oc;
     bkey->decrypt = ak_kuznechik_decrypt_with_mask_oc;
+    bkey->ctr = ak_kuznechik_ctr_with_mask_oc;
   }
    else {
     bkey->encrypt = ak_kuznechik_encrypt_with_mask;
     bkey->decrypt = ak_kuznechik_decrypt_with_mask;
+    bkey->ctr = ak_kuznechik_ctr_with_mask;
   }
  return error;
 }
@@ -79,6 +79,9 @@
   #ifdef AK_HAVE_BUILTIN_CLMULEPI64
    ak_error_message( ak_error_ok, __func__ , "library applies clmulepi64 instruction" );
   #endif
+  #ifdef AK_HAVE_BUILTIN_AESENC
+   ak_error_message( ak_error_ok, __func__ , "library applies aes-ni instructions" );
+  #endif
   #ifdef AK_HAVE_BUILTIN_MULQ_GCC
    ak_error_message( ak_error_ok, __func__ , "library applies assembler code for mulq command" );
   #endif
@@ -130,6 +133,24 @@
     return ak_false;
   }
 
+ /* тестируем функции семейства SHA-3 */
+  if( ak_libakrypt_test_sha3() != ak_true ) {
+    ak_error_message( ak_error_get_value(), __func__, "incorrect sha3 testing" );
+    return ak_false;
+  }
+
+ /* тестируем функции SHAKE128 и SHAKE256 с произвольной длиной выхода */
+  if( ak_libakrypt_test_shake() != ak_true ) {
+    ak_error_message( ak_error_get_value(), __func__, "incorrect shake testing" );
+    return ak_false;
+  }
+
+ /* тестируем одновременную обработку четырех сообщений */
+  if( ak_libakrypt_test_keccak_x4() != ak_true ) {
+    ak_error_message( ak_error_get_value(), __func__, "incorrect 4-way keccak testing" );
+    return ak_false;
+  }
+
   if( audit >= ak_log_maximum )
    ak_error_message( ak_error_ok, __func__ , "testing hash functions ended successfully" );
 
@@ -160,6 +181,12 @@
     return ak_false;
   }
 
+ /* тестируем корректность реализации блочного шифра AES */
+  if( ak_libakrypt_test_aes()  != ak_true ) {
+    ak_error_message( ak_error_get_value(), __func__ , "incorrect testing of aes block cipher" );
+    return ak_false;
+  }
+
  /* тестируем дополнительные режимы работы */
   if( ak_libakrypt_test_acpkm()  != ak_true ) {
     ak_error_message( ak_error_get_value(), __func__ ,
@@ -171,6 +198,16 @@
                                                "incorrect testing of mgm mode for block ciphers" );
     return ak_false;
   }
+  if( ak_libakrypt_test_ocb()  != ak_true ) {
+    ak_error_message( ak_error_get_value(), __func__ ,
+                                               "incorrect testing of ocb mode for block ciphers" );
+    return ak_false;
+  }
+  if( ak_libakrypt_test_gcm()  != ak_true ) {
+    ak_error_message( ak_error_get_value(), __func__ ,
+                                               "incorrect testing of gcm mode for block ciphers" );
+    return ak_false;
+  }
 
   if( audit >= ak_log_maximum )
     ak_error_message( ak_error_ok, __func__ , "testing block ciphers ended successfully" );
@@ -178,6 +215,29 @@
  return ak_true;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! @return Возвращает ak_true в случае успешного тестирования. В случае возникновения ошибки
+    функция возвращает ak_false. Код ошибки можеть быть получен с помощью
+    вызова ak_error_get_value()                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_libakrypt_test_random_generators( void )
+{
+  int audit = ak_log_get_level();
+  if( audit >= ak_log_maximum )
+    ak_error_message( ak_error_ok, __func__ , "testing random generators started" );
+
+ /* тестируем генератор псевдо-случайных чисел, основанный на блочном шифре Кузнечик */
+  if( ak_libakrypt_test_drbg() != ak_true ) {
+    ak_error_message( ak_error_get_value(), __func__, "incorrect drbg testing" );
+    return ak_false;
+  }
+
+  if( audit >= ak_log_maximum )
+    ak_error_message( ak_error_ok, __func__ , "testing random generators ended successfully" );
+
+ return ak_true;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Функция проверяет корректность реализации алгоритмов итерационного сжатия
     @return Возвращает ak_true в случае успешного тестирования. В случае возникновения ошибки
@@ -204,6 +264,11 @@
     ak_error_message( ak_error_get_value(), __func__, "incorrect testing different kinds of cmac" );
     return ak_false;
   }
+ /* тестирование алгоритмов kmac */
+  if( ak_libakrypt_test_kmac() != ak_true ) {
+    ak_error_message( ak_error_get_value(), __func__, "incorrect testing of kmac functions" );
+    return ak_false;
+  }
 
   if( audit >= ak_log_maximum )
    ak_error_message( ak_error_ok, __func__ , "testing mac algorithms ended successfully" );
@@ -269,6 +334,12 @@
     return ak_false;
   }
 
+ /* тестируем генераторы псевдо-случайных чисел (после блочных шифров, на которых они основаны) */
+  if( ak_libakrypt_test_random_generators() != ak_true ) {
+    ak_error_message( ak_error_get_value(), __func__ , "error while testing random generators" );
+    return ak_false;
+  }
+
  /* проверяем корректность реализации алгоритмов итерационного сжатия */
    if( ak_libakrypt_test_mac_functions( ) != ak_true ) {
      ak_error_message( ak_error_get_value(), __func__ , "incorrect testing of mac algorithms" );
@@ -408,6 +479,7 @@
   #endif
 #endif
 
+  ak_wcurve_tables_destroy();
   if( ak_log_get_level() != ak_log_none )
     ak_error_message( ak_error_ok, __func__ , "all crypto mechanisms successfully destroyed" );
 
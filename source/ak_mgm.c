@@ -902,6 +902,221 @@
  return error;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Параметры режима `mgm`, передаваемые функциям обработки фрагментов данных. */
+ typedef struct mgm_iov {
+  /*! \brief Контекст внутреннего состояния алгоритма. */
+   ak_mgm_ctx ctx;
+  /*! \brief Ключ шифрования. */
+   ak_bckey encryptionKey;
+  /*! \brief Ключ выработки имитовставки. */
+   ak_bckey authenticationKey;
+ } *ak_mgm_iov;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Обработка непрерывного фрагмента ассоциированных данных. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_mgm_iov_authentication_update( ak_pointer ptr, const ak_uint8 *in,
+                                                               ak_uint8 *out, const size_t size )
+{
+  ak_mgm_iov iov = ptr;
+  (void) out;
+ return ak_mgm_authentication_update( iov->ctx, iov->authenticationKey, (ak_pointer) in, size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Зашифрование непрерывного фрагмента данных. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_mgm_iov_encryption_update( ak_pointer ptr, const ak_uint8 *in,
+                                                               ak_uint8 *out, const size_t size )
+{
+  ak_mgm_iov iov = ptr;
+ return ak_mgm_encryption_update( iov->ctx, iov->encryptionKey, iov->authenticationKey,
+                                                                     (ak_pointer) in, out, size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Расшифрование непрерывного фрагмента данных. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_mgm_iov_decryption_update( ak_pointer ptr, const ak_uint8 *in,
+                                                               ak_uint8 *out, const size_t size )
+{
+  ak_mgm_iov iov = ptr;
+ return ak_mgm_decryption_update( iov->ctx, iov->encryptionKey, iov->authenticationKey,
+                                                                     (ak_pointer) in, out, size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция выполняет зашифрование или расшифрование данных, расположенных
+    в последовательностях фрагментов, и вычисляет значение имитовставки.                          */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_bckey_mgm_iov( ak_pointer encryptionKey, ak_pointer authenticationKey,
+                                     const struct iovec *adata, const size_t adata_count,
+                                           const struct iovec *in, const size_t in_count,
+                                         const struct iovec *out, const size_t out_count,
+                                                       const ak_pointer iv, const size_t iv_size,
+                                     ak_pointer icode, const size_t icode_size, bool_t encrypt )
+{
+  struct mgm_ctx mgm;
+  struct mgm_iov params;
+  struct iov_cursor icur, ocur;
+  int error = ak_error_ok;
+  size_t bs = 0, asize = 0, size = 0, osize = 0;
+
+ /* проверки ключей */
+  if(( encryptionKey == NULL ) && ( authenticationKey == NULL ))
+    return ak_error_message( ak_error_null_pointer, __func__ ,
+                               "using null pointers both to encryption and authentication keys" );
+  if(( encryptionKey != NULL ) && ( authenticationKey ) != NULL ) {
+    if( ((ak_bckey)encryptionKey)->bsize != ((ak_bckey)authenticationKey)->bsize )
+      return ak_error_message( ak_error_not_equal_data, __func__,
+                                                   "different block sizes for given secret keys");
+  }
+  if( encryptionKey != NULL ) bs = ((ak_bckey)encryptionKey)->bsize;
+    else bs = ((ak_bckey)authenticationKey)->bsize;
+
+ /* проверяем фрагменты и размер входных данных */
+  if(( error = ak_iov_length( adata, adata_count, &asize )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect fragments of associated data" );
+  if(( error = ak_iov_length( in, in_count, &size )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect fragments of input data" );
+  if(( error = ak_iov_length( out, out_count, &osize )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect fragments of output data" );
+  if( osize < size ) return ak_error_message( ak_error_wrong_length, __func__,
+                                                      "total length of output fragments is small" );
+  if(( error = ak_bckey_check_mgm_length( asize, size, bs )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect length of input data");
+
+ /* подготавливаем память */
+  memset( &mgm, 0, sizeof( struct mgm_ctx ));
+  params.ctx = &mgm;
+  params.encryptionKey = encryptionKey;
+  params.authenticationKey = authenticationKey;
+
+ /* в начале обрабатываем ассоциированные данные */
+  if( authenticationKey != NULL ) {
+    if(( error = ak_mgm_authentication_clean( &mgm, authenticationKey, iv, iv_size ))
+                                                                              != ak_error_ok ) {
+      ak_error_message( error, __func__, "incorrect initialization of internal mgm context" );
+      goto exit;
+    }
+    ak_iov_cursor_set( &icur, adata, adata_count );
+    if(( error = ak_iov_cursor_process( &icur, NULL, asize, bs,
+                             ak_mgm_iov_authentication_update, &params )) != ak_error_ok ) {
+      ak_error_message( error, __func__, "incorrect hashing of associated data" );
+      goto exit;
+    }
+  }
+
+ /* потом зашифровываем (расшифровываем) данные */
+  if( encryptionKey != NULL ) {
+    if(( error = ak_mgm_encryption_clean( &mgm, encryptionKey, iv, iv_size )) != ak_error_ok ) {
+      ak_error_message( error, __func__, "incorrect initialization of internal mgm context" );
+      goto exit;
+    }
+    ak_iov_cursor_set( &icur, in, in_count );
+    ak_iov_cursor_set( &ocur, out, out_count );
+    if(( error = ak_iov_cursor_process( &icur, &ocur, size, bs, encrypt ?
+                                    ak_mgm_iov_encryption_update : ak_mgm_iov_decryption_update,
+                                                                   &params )) != ak_error_ok ) {
+      ak_error_message( error, __func__, "incorrect encryption of plain data" );
+      goto exit;
+    }
+  }
+
+ /* в конце - вырабатываем имитовставку */
+  if( authenticationKey != NULL ) {
+    if(( error = ak_mgm_authentication_finalize( &mgm,
+                                         authenticationKey, icode, icode_size )) != ak_error_ok )
+      ak_error_message( error, __func__, "incorrect finanlize of integrity code" );
+  }
+
+  exit:
+   if( authenticationKey != NULL )
+     ak_ptr_wipe( &mgm, sizeof( struct mgm_ctx ), &((ak_bckey)authenticationKey)->key.generator );
+    else
+     ak_ptr_wipe( &mgm, sizeof( struct mgm_ctx ), &((ak_bckey)encryptionKey)->key.generator );
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция реализует режим `mgm` для данных, расположенных в последовательностях фрагментов
+    (например, в цепочке буфферов сетевого пакета). Разбиение ассоциированных, входных и выходных
+    данных на фрагменты может быть произвольным; результат работы функции совпадает с результатом
+    функции ak_bckey_encrypt_mgm(), примененной к тем же данным, расположенным в памяти
+    последовательно. Требования к ключам, синхропосылке и имитовставке аналогичны требованиям,
+    предъявляемым к параметрам функции ak_bckey_encrypt_mgm().
+
+    @param encryptionKey ключ шифрования; может принимать значение `NULL`;
+    @param authenticationKey ключ выработки имитовставки; может принимать значение `NULL`;
+    @param adata указатель на массив фрагментов ассоциированных данных;
+    @param adata_count количество фрагментов ассоциированных данных;
+    @param in указатель на массив фрагментов зашифровываемых данных;
+    @param in_count количество фрагментов зашифровываемых данных;
+    @param out указатель на массив фрагментов зашифрованных данных (может совпадать с `in`);
+    @param out_count количество фрагментов зашифрованных данных;
+    @param iv указатель на синхропосылку;
+    @param iv_size длина синхропосылки в байтах;
+    @param icode указатель на область памяти, куда будет помещено значение имитовставки;
+    @param icode_size ожидаемый размер имитовставки в байтах.
+
+   @return Функция возвращает \ref ak_error_ok в случае успешного завершения.
+   В противном случае, возвращается код ошибки.                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_encrypt_mgm_iov( ak_pointer encryptionKey, ak_pointer authenticationKey,
+                                     const struct iovec *adata, const size_t adata_count,
+                                           const struct iovec *in, const size_t in_count,
+                                         const struct iovec *out, const size_t out_count,
+                                                       const ak_pointer iv, const size_t iv_size,
+                                                       ak_pointer icode, const size_t icode_size )
+{
+ return ak_bckey_mgm_iov( encryptionKey, authenticationKey, adata, adata_count, in, in_count,
+                                out, out_count, iv, iv_size, icode, icode_size, ak_true );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция реализует процедуру расшифрования с одновременной проверкой целостности данных,
+    расположенных в последовательностях фрагментов. Требования к передаваемым параметрам
+    аналогичны требованиям, предъявляемым к параметрам функции ak_bckey_encrypt_mgm_iov().
+
+    @param encryptionKey ключ шифрования; может принимать значение `NULL`;
+    @param authenticationKey ключ выработки имитовставки; может принимать значение `NULL`;
+    @param adata указатель на массив фрагментов ассоциированных данных;
+    @param adata_count количество фрагментов ассоциированных данных;
+    @param in указатель на массив фрагментов расшифровываемых данных;
+    @param in_count количество фрагментов расшифровываемых данных;
+    @param out указатель на массив фрагментов расшифрованных данных (может совпадать с `in`);
+    @param out_count количество фрагментов расшифрованных данных;
+    @param iv указатель на синхропосылку;
+    @param iv_size длина синхропосылки в байтах;
+    @param icode указатель на область памяти, в которой хранится значение имитовставки;
+    @param icode_size размер имитовставки в байтах.
+
+    @return Функция возвращает \ref ak_error_ok, если значение имитовтсавки совпало с
+            вычисленным в ходе выполнения функции значением; если значения не совпадают,
+            или в ходе выполнения функции возникла ошибка, то возвращается код ошибки.             */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_decrypt_mgm_iov( ak_pointer encryptionKey, ak_pointer authenticationKey,
+                                     const struct iovec *adata, const size_t adata_count,
+                                           const struct iovec *in, const size_t in_count,
+                                         const struct iovec *out, const size_t out_count,
+                                                       const ak_pointer iv, const size_t iv_size,
+                                                       ak_pointer icode, const size_t icode_size )
+{
+  ak_uint8 icode2[16];
+  int error = ak_error_ok;
+
+  memset( icode2, 0, sizeof( icode2 ));
+  if(( error = ak_bckey_mgm_iov( encryptionKey, authenticationKey, adata, adata_count, in,
+                 in_count, out, out_count, iv, iv_size, icode2, icode_size, ak_false )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect decryption of cipher data" );
+
+ /* если ключ имитозащиты не задан, то проверять нечего */
+  if( authenticationKey == NULL ) return ak_error_ok;
+  if( ak_ptr_is_equal( icode, icode2, icode_size )) return ak_error_ok;
+ return ak_error_not_equal_data;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
  bool_t ak_libakrypt_test_mgm( void )
 {
@@ -660,8 +660,8 @@
                                                                 ak_uint64 *p, const size_t size )
 {
   size_t i = 0;
-  ak_uint64 av = 0, bv = 0, cy = 0;
-  ak_mpznmax t = ak_mpznmax_zero;
+  ak_uint64 av = 0, bv = 0, cy = 0, mask;
+  ak_mpznmax t;
 
  // сначала складываем: (x + y) -> t
   for( i = 0; i < size; i++, x++, y++ ) {
@@ -682,7 +682,9 @@
      cy += av > bv;
      z[i] = av;
   }
-  if( t[size] != cy ) memcpy( z, t, size*sizeof( ak_uint64 ));
+ // если при вычитании возник заем, то результатом является t; выбор выполняется с помощью маски
+  mask = ( ak_uint64 )0 - ( t[size]^cy );
+  for( i = 0; i < size; i++ ) z[i] = ( z[i]&~mask )^( t[i]&mask );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -702,7 +704,7 @@
  void ak_mpzn_lshift_montgomery( ak_uint64 *z, ak_uint64 *x, ak_uint64 *p, const size_t size )
 {
   size_t i;
-  ak_uint64 av = 0, bv = 0, cy = 0;
+  ak_uint64 av = 0, bv = 0, cy = 0, mask;
   ak_mpznmax t = ak_mpznmax_zero;
 
   t[size] = 0;
@@ -716,27 +718,14 @@
     cy += av > bv;
     z[i] = av;
    }
-   if( t[size] != cy ) memcpy( z, t, size*sizeof( ak_uint64 ));
+   mask = ( ak_uint64 )0 - ( t[size]^cy );
+   for( i = 0; i < size; i++ ) z[i] = ( z[i]&~mask )^( t[i]&mask );
 }
 
 /* ----------------------------------------------------------------------------------------------- */
-/*! Функция умножает два вычета x и y в представлении Монтгомери, после чего приводит полученное
-    произведение по модулю p, то есть для \f$ x \equiv x_0r \pmod{p} \f$ и
-    \f$ y \equiv y_0r \pmod{p} \f$ функция вычисляет значение,
-    удовлетворяющее сравнению \f$ z \equiv x_0y_0r \pmod{p}\f$.
-    Результат помещается в переменную z. Указатель на z может совпадать с одним из указателей на
-    перемножаемые вычеты.
-
-    @param z Указатель на вычет, в который помещается результат
-    @param x Левый аргумент опреации сложения
-    @param y Правый аргумент операции сложения
-    @param p Модуль, по которому производятся вычисления
-    @param n0 Константа, используемая в вычислениях. Представляет собой младшее слово
-    числа n, удовлетворяющего равенству \f$ rs - np = 1\f$.
-    @param size Размер модуля в словах (значение константы \ref ak_mpzn256_size или
-                                                                          \ref ak_mpzn512_size).   */
+/*! \brief Умножение Монтгомери для модулей произвольной длины. */
 /* ----------------------------------------------------------------------------------------------- */
- inline void ak_mpzn_mul_montgomery( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+ static void ak_mpzn_mul_montgomery_generic( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
                                                ak_uint64 *p, ak_uint64 n0, const size_t size )
 {
   size_t i = 0, j = 0, ij = 0;
@@ -795,6 +784,656 @@
   if( cy != t[2*size] ) memcpy( z, t+size, size*sizeof( ak_uint64 ));
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*         специализированные реализации умножения Монтгомери для 256-ти и 512-ти битных модулей   */
+/* ----------------------------------------------------------------------------------------------- */
+#ifdef __SIZEOF_INT128__
+ #define LIBAKRYPT_HAVE_UINT128
+/*! \brief Беззнаковое 128-ми битное целое, используемое для хранения произведения двух слов. */
+ __extension__ typedef unsigned __int128 ak_mpzn_dword;
+
+ #if defined( __clang__ ) || ( defined( __GNUC__ ) && ( __GNUC__ >= 8 ))
+  #define ak_unroll _Pragma( "GCC unroll 8" )
+ #else
+  #define ak_unroll
+ #endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычитание модуля из результата умножения Монтгомери.
+
+    Значение \f$ t < 2p \f$ задается \f$ N \f$ словами массива `t` и старшим битом `top`.
+    Вычитание выполняется всегда, а результат выбирается с помощью маски.                          */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline __attribute__(( always_inline )) void ak_mpzn_montgomery_final( ak_uint64 *z,
+                      const ak_uint64 *t, ak_uint64 top, const ak_uint64 *p, const size_t N )
+{
+  size_t j;
+  ak_mpzn_dword w;
+  ak_uint64 mask, b = 0, u[ak_mpzn512_size];
+
+  ak_unroll
+  for( j = 0; j < N; j++ ) {
+     w = ( ak_mpzn_dword )t[j] - p[j] - b;
+     u[j] = ( ak_uint64 )w;
+     b = ( ak_uint64 )( w >> 64 )&1;
+  }
+ /* маска из единиц означает, что t < p и вычитание выполнять не надо */
+  mask = ( ak_uint64 )0 - ( b&( top^1 ));
+  ak_unroll
+  for( j = 0; j < N; j++ ) z[j] = ( t[j]&mask )^( u[j]&~mask );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Умножение Монтгомери для модуля фиксированной длины \f$ N \f$ слов (метод CIOS).
+
+    Умножение на очередное слово множителя и редукция выполняются в одном цикле, поэтому
+    промежуточное значение занимает \f$ N+2 \f$ слова. При вызове с константным значением
+    \f$ N \f$ все циклы разворачиваются компилятором.                                             */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline __attribute__(( always_inline )) void ak_mpzn_mul_montgomery_cios( ak_uint64 *z,
+     const ak_uint64 *x, const ak_uint64 *y, const ak_uint64 *p, ak_uint64 n0, const size_t N )
+{
+  size_t i, j;
+  ak_mpzn_dword w;
+  ak_uint64 c, m, t[ak_mpzn512_size+2];
+
+  ak_unroll
+  for( j = 0; j < N+2; j++ ) t[j] = 0;
+  ak_unroll
+  for( i = 0; i < N; i++ ) {
+    /* t <- t + x[i]y */
+     c = 0;
+     ak_unroll
+     for( j = 0; j < N; j++ ) {
+        w = ( ak_mpzn_dword )x[i]*y[j] + t[j] + c;
+        t[j] = ( ak_uint64 )w;
+        c = ( ak_uint64 )( w >> 64 );
+     }
+     w = ( ak_mpzn_dword )t[N] + c;
+     t[N] = ( ak_uint64 )w;
+     t[N+1] = ( ak_uint64 )( w >> 64 );
+
+    /* t <- ( t + mp )/2^64 */
+     m = t[0]*n0;
+     w = ( ak_mpzn_dword )m*p[0] + t[0];
+     c = ( ak_uint64 )( w >> 64 );
+     ak_unroll
+     for( j = 1; j < N; j++ ) {
+        w = ( ak_mpzn_dword )m*p[j] + t[j] + c;
+        t[j-1] = ( ak_uint64 )w;
+        c = ( ak_uint64 )( w >> 64 );
+     }
+     w = ( ak_mpzn_dword )t[N] + c;
+     t[N-1] = ( ak_uint64 )w;
+     t[N] = t[N+1] + ( ak_uint64 )( w >> 64 );
+  }
+  ak_mpzn_montgomery_final( z, t, t[N], p, N );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Возведение в квадрат вычета длины \f$ N \f$ слов.
+
+    Каждое из попарных произведений слов вычисляется один раз, после чего сумма удваивается и
+    к ней прибавляются квадраты слов. По сравнению с умножением экономится \f$ N(N-1)/2 \f$
+    умножений слов. Результат занимает \f$ 2N \f$ слов.                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline __attribute__(( always_inline )) void ak_mpzn_sqr_full( ak_uint64 *t,
+                                                             const ak_uint64 *x, const size_t N )
+{
+  size_t i, j;
+  ak_mpzn_dword w;
+  ak_uint64 c;
+
+ /* попарные произведения x[i]x[j], i < j */
+  ak_unroll
+  for( j = 0; j < 2*N; j++ ) t[j] = 0;
+  ak_unroll
+  for( i = 0; i < N-1; i++ ) {
+     c = 0;
+     ak_unroll
+     for( j = i+1; j < N; j++ ) {
+        w = ( ak_mpzn_dword )x[i]*x[j] + t[i+j] + c;
+        t[i+j] = ( ak_uint64 )w;
+        c = ( ak_uint64 )( w >> 64 );
+     }
+     t[i+N] = c;
+  }
+ /* удваиваем и прибавляем квадраты слов */
+  t[2*N-1] = t[2*N-2] >> 63;
+  ak_unroll
+  for( j = 2*N-2; j > 1; j-- ) t[j] = ( t[j] << 1 )^( t[j-1] >> 63 );
+  t[1] <<= 1;
+  c = 0;
+  ak_unroll
+  for( i = 0; i < N; i++ ) {
+     w = ( ak_mpzn_dword )x[i]*x[i] + t[2*i] + c;
+     t[2*i] = ( ak_uint64 )w;
+     w = ( ak_mpzn_dword )t[2*i+1] + ( ak_uint64 )( w >> 64 );
+     t[2*i+1] = ( ak_uint64 )w;
+     c = ( ak_uint64 )( w >> 64 );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Редукция Монтгомери числа длины \f$ 2N \f$ слов (метод SOS).
+
+    Для \f$ t < p^2 \f$ вычисляется значение \f$ z \equiv tr^{-1} \pmod{p} \f$, \f$ z < p \f$.
+    Массив `t` используется для хранения промежуточных значений.                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline __attribute__(( always_inline )) void ak_mpzn_redc( ak_uint64 *z,
+                                  ak_uint64 *t, const ak_uint64 *p, ak_uint64 n0, const size_t N )
+{
+  size_t i, j;
+  ak_mpzn_dword w;
+  ak_uint64 c, m, hi = 0;
+
+  ak_unroll
+  for( i = 0; i < N; i++ ) {
+     m = t[i]*n0;
+     c = 0;
+     ak_unroll
+     for( j = 0; j < N; j++ ) {
+        w = ( ak_mpzn_dword )m*p[j] + t[i+j] + c;
+        t[i+j] = ( ak_uint64 )w;
+        c = ( ak_uint64 )( w >> 64 );
+     }
+     w = ( ak_mpzn_dword )t[i+N] + c + hi;
+     t[i+N] = ( ak_uint64 )w;
+     hi = ( ak_uint64 )( w >> 64 );
+  }
+  ak_mpzn_montgomery_final( z, t+N, hi, p, N );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Возведение в квадрат в представлении Монтгомери для модуля фиксированной длины. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline __attribute__(( always_inline )) void ak_mpzn_sqr_montgomery_sos( ak_uint64 *z,
+                            const ak_uint64 *x, const ak_uint64 *p, ak_uint64 n0, const size_t N )
+{
+  ak_uint64 t[2*ak_mpzn512_size];
+
+  ak_mpzn_sqr_full( t, x, N );
+  ak_mpzn_redc( z, t, p, n0, N );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Умножение Монтгомери для 256-ти битного модуля. */
+ static void ak_mpzn_mul_montgomery_n4( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                                      ak_uint64 *p, ak_uint64 n0 )
+{
+  ak_mpzn_mul_montgomery_cios( z, x, y, p, n0, ak_mpzn256_size );
+}
+
+/*! \brief Умножение Монтгомери для 512-ти битного модуля. */
+ static void ak_mpzn_mul_montgomery_n8( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                                      ak_uint64 *p, ak_uint64 n0 )
+{
+  ak_mpzn_mul_montgomery_cios( z, x, y, p, n0, ak_mpzn512_size );
+}
+
+/*! \brief Возведение в квадрат в представлении Монтгомери для 256-ти битного модуля. */
+ static void ak_mpzn_sqr_montgomery_n4( ak_uint64 *z, ak_uint64 *x, ak_uint64 *p, ak_uint64 n0 )
+{
+  ak_mpzn_sqr_montgomery_sos( z, x, p, n0, ak_mpzn256_size );
+}
+
+/*! \brief Возведение в квадрат в представлении Монтгомери для 512-ти битного модуля. */
+ static void ak_mpzn_sqr_montgomery_n8( ak_uint64 *z, ak_uint64 *x, ak_uint64 *p, ak_uint64 n0 )
+{
+  ak_mpzn_sqr_montgomery_sos( z, x, p, n0, ak_mpzn512_size );
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+#if defined( LIBAKRYPT_HAVE_UINT128 ) && defined( AK_HAVE_BUILTIN_MULX_ADX )
+/*! \brief Один шаг прибавления произведения \f$ a\cdot y_k \f$ к слову `t[k]` с использованием
+    двух независимых цепочек переносов (флаги CF и OF); старшая половина произведения
+    сохраняется в регистре `hout` и прибавляется на следующем шаге.                                */
+ #define ak_adx_step( off, hin, hout ) \
+     "mulx " off "(%[y]), %[lo], %[" hout "]\n\t" \
+     "adox %[" hin "], %[lo]\n\t"                 \
+     "adcx " off "(%[t]), %[lo]\n\t"              \
+     "mov %[lo], " off "(%[t])\n\t"
+
+/*! \brief Первый шаг прибавления произведения; флаги CF и OF обнуляются командой xor. */
+ #define ak_adx_first \
+     "xor %[hi], %[hi]\n\t"                       \
+     "mulx (%[y]), %[lo], %[hi]\n\t"              \
+     "adcx (%[t]), %[lo]\n\t"                     \
+     "mov %[lo], (%[t])\n\t"
+
+/*! \brief Завершение прибавления: к старшему слову последнего произведения прибавляются
+    оба оставшихся переноса. */
+ #define ak_adx_last( hout, hzero ) \
+     "mov $0, %[" hzero "]\n\t"                   \
+     "adox %[" hzero "], %[" hout "]\n\t"         \
+     "adcx %[" hzero "], %[" hout "]\n\t"
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление \f$ t \leftarrow t + ay \f$ для 256-ти битного \f$ y \f$ с помощью команд
+    mulx, adcx и adox. \return Старшее слово суммы.                                                */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline ak_uint64 ak_mpzn_addmul_adx_n4( ak_uint64 *t, ak_uint64 a, const ak_uint64 *y )
+{
+  ak_uint64 lo, hi, c;
+
+  __asm__ (
+     ak_adx_first
+     ak_adx_step( "8", "hi", "c" )
+     ak_adx_step( "16", "c", "hi" )
+     ak_adx_step( "24", "hi", "c" )
+     ak_adx_last( "c", "hi" )
+     : [lo] "=&r" ( lo ), [hi] "=&r" ( hi ), [c] "=&r" ( c )
+     : [t] "r" ( t ), [y] "r" ( y ), "d" ( a )
+     : "cc", "memory" );
+ return c;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление \f$ t \leftarrow t + ay \f$ для 512-ти битного \f$ y \f$ с помощью команд
+    mulx, adcx и adox. \return Старшее слово суммы.                                                */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline ak_uint64 ak_mpzn_addmul_adx_n8( ak_uint64 *t, ak_uint64 a, const ak_uint64 *y )
+{
+  ak_uint64 lo, hi, c;
+
+  __asm__ (
+     ak_adx_first
+     ak_adx_step( "8", "hi", "c" )
+     ak_adx_step( "16", "c", "hi" )
+     ak_adx_step( "24", "hi", "c" )
+     ak_adx_step( "32", "c", "hi" )
+     ak_adx_step( "40", "hi", "c" )
+     ak_adx_step( "48", "c", "hi" )
+     ak_adx_step( "56", "hi", "c" )
+     ak_adx_last( "c", "hi" )
+     : [lo] "=&r" ( lo ), [hi] "=&r" ( hi ), [c] "=&r" ( c )
+     : [t] "r" ( t ), [y] "r" ( y ), "d" ( a )
+     : "cc", "memory" );
+ return c;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Умножение Монтгомери с использованием команд mulx, adcx и adox.
+
+    Используется тот же метод CIOS, что и в функции ak_mpzn_mul_montgomery_cios(); вместо сдвига
+    промежуточного значения на каждом шаге сдвигается указатель на него.                          */
+/* ----------------------------------------------------------------------------------------------- */
+ #define ak_mpzn_mul_montgomery_adx_body( addmul, N )                   \
+  size_t i, j;                                                          \
+  ak_mpzn_dword w;                                                      \
+  ak_uint64 c, t[2*N+2];                                                \
+                                                                        \
+  for( j = 0; j < 2*N+2; j++ ) t[j] = 0;                                \
+  for( i = 0; i < N; i++ ) {                                            \
+     w = ( ak_mpzn_dword )t[i+N] + addmul( t+i, x[i], y );              \
+     t[i+N] = ( ak_uint64 )w;                                           \
+     t[i+N+1] = ( ak_uint64 )( w >> 64 );                               \
+     c = addmul( t+i, t[i]*n0, p );                                     \
+     w = ( ak_mpzn_dword )t[i+N] + c;                                   \
+     t[i+N] = ( ak_uint64 )w;                                           \
+     t[i+N+1] += ( ak_uint64 )( w >> 64 );                              \
+  }                                                                     \
+  ak_mpzn_montgomery_final( z, t+N, t[2*N], p, N );
+
+/*! \brief Умножение двух вычетов с использованием команд mulx, adcx и adox;
+    результат занимает \f$ 2N \f$ слов. */
+ #define ak_mpzn_mul_full_adx( t, x, y, addmul, N )                     \
+  do {                                                                  \
+     size_t k;                                                          \
+     for( k = 0; k < N; k++ ) t[k] = 0;                                 \
+     for( k = 0; k < N; k++ ) t[k+N] = addmul( t+k, x[k], y );          \
+  } while( 0 )
+
+/*! \brief Умножение Монтгомери для 256-ти битного модуля с использованием команд mulx, adcx и adox. */
+ static void ak_mpzn_mul_montgomery_adx_n4( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                                      ak_uint64 *p, ak_uint64 n0 )
+{
+  ak_mpzn_mul_montgomery_adx_body( ak_mpzn_addmul_adx_n4, ak_mpzn256_size )
+}
+
+/*! \brief Умножение Монтгомери для 512-ти битного модуля с использованием команд mulx, adcx и adox. */
+ static void ak_mpzn_mul_montgomery_adx_n8( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                                      ak_uint64 *p, ak_uint64 n0 )
+{
+  ak_mpzn_mul_montgomery_adx_body( ak_mpzn_addmul_adx_n8, ak_mpzn512_size )
+}
+#endif
+
+#if defined( LIBAKRYPT_HAVE_UINT128 ) && defined( AK_HAVE_BUILTIN_MULX_ADX )
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка возможности использования команд mulx, adcx и adox. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline bool_t ak_mpzn_has_adx( void )
+{
+  static int adx = -1;
+  if( adx < 0 ) {
+    __builtin_cpu_init();
+    adx = ( __builtin_cpu_supports( "bmi2" ) && __builtin_cpu_supports( "adx" )) ? 1 : 0;
+  }
+ return adx ? ak_true : ak_false;
+}
+#endif
+
+#ifdef LIBAKRYPT_HAVE_UINT128
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка того, что модуль имеет специальный вид \f$ p = 2^{64N} - c \f$,
+    где \f$ 0 < c < 2^{64} \f$, то есть все слова модуля, кроме младшего, состоят из единиц.       */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline bool_t ak_mpzn_is_special( const ak_uint64 *p, const size_t N )
+{
+  size_t j;
+  for( j = N-1; j > 0; j-- ) if( p[j] != ( ak_uint64 )-1 ) return ak_false;
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка того, что модуль имеет специальный вид \f$ p = 2^{64N-1} + c \f$,
+    где \f$ 0 < c < 2^{63} \f$, то есть старшее слово модуля равно \f$ 2^{63} \f$,
+    а все остальные слова, кроме младшего, равны нулю.                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline bool_t ak_mpzn_is_special_plus( const ak_uint64 *p, const size_t N )
+{
+  size_t j;
+  if( p[N-1] != 0x8000000000000000LL ) return ak_false;
+  for( j = N-2; j > 0; j-- ) if( p[j] != 0 ) return ak_false;
+ return ( p[0] >> 63 ) == 0;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Умножение двух вычетов длины \f$ N \f$ слов. Результат занимает \f$ 2N \f$ слов. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline __attribute__(( always_inline )) void ak_mpzn_mul_full( ak_uint64 *t,
+                                          const ak_uint64 *x, const ak_uint64 *y, const size_t N )
+{
+  size_t i, j;
+  ak_mpzn_dword w;
+  ak_uint64 c;
+
+  ak_unroll
+  for( j = 0; j < N; j++ ) t[j] = 0;
+  ak_unroll
+  for( i = 0; i < N; i++ ) {
+     c = 0;
+     ak_unroll
+     for( j = 0; j < N; j++ ) {
+        w = ( ak_mpzn_dword )x[i]*y[j] + t[i+j] + c;
+        t[i+j] = ( ak_uint64 )w;
+        c = ( ak_uint64 )( w >> 64 );
+     }
+     t[i+N] = c;
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Редукция Монтгомери по модулю специального вида \f$ p = 2^{64N} - c \f$.
+
+    Поскольку \f$ n_0 \equiv c^{-1} \pmod{2^{64}} \f$, а \f$ mp = m2^{64N} - mc \f$, на каждом шаге
+    редукции вместо умножения множителя \f$ m \f$ на все слова модуля вычисляется только одно
+    произведение \f$ mc \f$. Младшее слово этого произведения совпадает с текущим словом
+    числа \f$ t \f$, а старшее слово вычитается из следующего слова. Множители \f$ m_i \f$
+    образуют число \f$ M \f$, которое прибавляется к старшей половине \f$ t \f$.
+    Таким образом, редукция требует \f$ 2N \f$ умножений слов вместо \f$ N^2 + N \f$.
+
+    Для \f$ t < p^2 \f$ вычисляется значение \f$ z \equiv tr^{-1} \pmod{p} \f$, \f$ z < p \f$.    */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline __attribute__(( always_inline )) void ak_mpzn_redc_special( ak_uint64 *z,
+                            const ak_uint64 *t, const ak_uint64 *p, ak_uint64 n0, const size_t N )
+{
+  size_t i;
+  ak_mpzn_dword w;
+  ak_uint64 v, s = 0, c = ( ak_uint64 )0 - p[0], m[ak_mpzn512_size], u[ak_mpzn512_size];
+
+ /* вычисляем множители m_i, s - величина, вычитаемая из очередного слова */
+  ak_unroll
+  for( i = 0; i < N; i++ ) {
+     w = ( ak_mpzn_dword )t[i] - s;
+     v = ( ak_uint64 )w;
+     m[i] = v*n0;
+     s = ( ak_uint64 )((( ak_mpzn_dword )m[i]*c ) >> 64 ) + (( ak_uint64 )( w >> 64 )&1 );
+  }
+ /* (t + Mp)/r = t_hi + M - s */
+  v = 0;
+  ak_unroll
+  for( i = 0; i < N; i++ ) {
+     w = ( ak_mpzn_dword )t[i+N] + m[i] + v;
+     u[i] = ( ak_uint64 )w;
+     v = ( ak_uint64 )( w >> 64 );
+  }
+  ak_unroll
+  for( i = 0; i < N; i++ ) {
+     w = ( ak_mpzn_dword )u[i] - s;
+     u[i] = ( ak_uint64 )w;
+     s = ( ak_uint64 )( w >> 64 )&1;
+  }
+  ak_mpzn_montgomery_final( z, u, v - s, p, N );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Редукция Монтгомери по модулю специального вида \f$ p = 2^{64N-1} + c \f$.
+
+    Поскольку \f$ mp = mc + m2^{64N-1} \f$, на каждом шаге редукции вычисляется только
+    произведение \f$ m_ic \f$, старшее слово которого переносится в следующее слово.
+    Слагаемые \f$ m_i2^{64(N+i)-1} \f$ затрагивают младшую половину числа \f$ t \f$ только для
+    \f$ i = 0 \f$ (старший бит слова \f$ N-1 \f$); их вклад в старшую половину равен
+    \f$ \lfloor M/2 \rfloor \f$, где \f$ M \f$ число, образованное множителями \f$ m_i \f$.
+    Ограничение \f$ c < 2^{63} \f$ исключает переполнение 128-ми битных сумм.
+
+    Для \f$ t < p^2 \f$ вычисляется значение \f$ z \equiv tr^{-1} \pmod{p} \f$, \f$ z < p \f$.    */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline __attribute__(( always_inline )) void ak_mpzn_redc_special_plus( ak_uint64 *z,
+                            const ak_uint64 *t, const ak_uint64 *p, ak_uint64 n0, const size_t N )
+{
+  size_t i;
+  ak_mpzn_dword w;
+  ak_uint64 v, c = p[0], m[ak_mpzn512_size], u[ak_mpzn512_size];
+
+ /* вычисляем множители m_i, w - перенос в очередное слово */
+  w = 0;
+  ak_unroll
+  for( i = 0; i < N; i++ ) {
+     w += t[i];
+     if( i == N-1 ) w += ( ak_mpzn_dword )( m[0]&1 ) << 63;
+     m[i] = ( ak_uint64 )w*n0;
+     w = ( w + ( ak_mpzn_dword )m[i]*c ) >> 64;
+  }
+ /* (t + Mp)/r = t_hi + w + floor(M/2) */
+  ak_unroll
+  for( i = 0; i < N; i++ ) {
+     v = ( m[i] >> 1 ) | ( i < N-1 ? m[i+1] << 63 : 0 );
+     w += ( ak_mpzn_dword )t[i+N] + v;
+     u[i] = ( ak_uint64 )w;
+     w >>= 64;
+  }
+  ak_mpzn_montgomery_final( z, u, ( ak_uint64 )w, p, N );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Умножение Монтгомери для 256-ти битного модуля вида \f$ p = 2^{256} - c \f$
+    (при `plus` равном \ref ak_false), либо вида \f$ p = 2^{255} + c \f$.                          */
+ static void ak_mpzn_mul_montgomery_special_n4( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                 ak_uint64 *p, ak_uint64 n0, const bool_t plus )
+{
+  ak_uint64 t[2*ak_mpzn256_size];
+
+#ifdef AK_HAVE_BUILTIN_MULX_ADX
+  if( ak_mpzn_has_adx( )) ak_mpzn_mul_full_adx( t, x, y, ak_mpzn_addmul_adx_n4, ak_mpzn256_size );
+   else
+#endif
+  ak_mpzn_mul_full( t, x, y, ak_mpzn256_size );
+  if( plus ) ak_mpzn_redc_special_plus( z, t, p, n0, ak_mpzn256_size );
+   else ak_mpzn_redc_special( z, t, p, n0, ak_mpzn256_size );
+}
+
+/*! \brief Умножение Монтгомери для 512-ти битного модуля вида \f$ p = 2^{512} - c \f$
+    (при `plus` равном \ref ak_false), либо вида \f$ p = 2^{511} + c \f$.                          */
+ static void ak_mpzn_mul_montgomery_special_n8( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                                 ak_uint64 *p, ak_uint64 n0, const bool_t plus )
+{
+  ak_uint64 t[2*ak_mpzn512_size];
+
+#ifdef AK_HAVE_BUILTIN_MULX_ADX
+  if( ak_mpzn_has_adx( )) ak_mpzn_mul_full_adx( t, x, y, ak_mpzn_addmul_adx_n8, ak_mpzn512_size );
+   else
+#endif
+  ak_mpzn_mul_full( t, x, y, ak_mpzn512_size );
+  if( plus ) ak_mpzn_redc_special_plus( z, t, p, n0, ak_mpzn512_size );
+   else ak_mpzn_redc_special( z, t, p, n0, ak_mpzn512_size );
+}
+
+/*! \brief Возведение в квадрат в представлении Монтгомери для 256-ти битного модуля
+    вида \f$ p = 2^{256} - c \f$ (при `plus` равном \ref ak_false), либо вида \f$ p = 2^{255} + c \f$. */
+ static void ak_mpzn_sqr_montgomery_special_n4( ak_uint64 *z, ak_uint64 *x,
+                                                 ak_uint64 *p, ak_uint64 n0, const bool_t plus )
+{
+  ak_uint64 t[2*ak_mpzn256_size];
+
+  ak_mpzn_sqr_full( t, x, ak_mpzn256_size );
+  if( plus ) ak_mpzn_redc_special_plus( z, t, p, n0, ak_mpzn256_size );
+   else ak_mpzn_redc_special( z, t, p, n0, ak_mpzn256_size );
+}
+
+/*! \brief Возведение в квадрат в представлении Монтгомери для 512-ти битного модуля
+    вида \f$ p = 2^{512} - c \f$ (при `plus` равном \ref ak_false), либо вида \f$ p = 2^{511} + c \f$. */
+ static void ak_mpzn_sqr_montgomery_special_n8( ak_uint64 *z, ak_uint64 *x,
+                                                 ak_uint64 *p, ak_uint64 n0, const bool_t plus )
+{
+  ak_uint64 t[2*ak_mpzn512_size];
+
+  ak_mpzn_sqr_full( t, x, ak_mpzn512_size );
+  if( plus ) ak_mpzn_redc_special_plus( z, t, p, n0, ak_mpzn512_size );
+   else ak_mpzn_redc_special( z, t, p, n0, ak_mpzn512_size );
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция умножает два вычета x и y в представлении Монтгомери, после чего приводит полученное
+    произведение по модулю p, то есть для \f$ x \equiv x_0r \pmod{p} \f$ и
+    \f$ y \equiv y_0r \pmod{p} \f$ функция вычисляет значение,
+    удовлетворяющее сравнению \f$ z \equiv x_0y_0r \pmod{p}\f$.
+    Результат помещается в переменную z. Указатель на z может совпадать с одним из указателей на
+    перемножаемые вычеты.
+
+    Для модулей длины \ref ak_mpzn256_size и \ref ak_mpzn512_size используются развернутые
+    реализации умножения; на процессорах x86-64, поддерживающих расширения BMI2 и ADX,
+    используются команды mulx, adcx и adox (выбор реализации выполняется при первом вызове).
+    Если модуль имеет вид \f$ p = 2^{64N} - c \f$ (таковы, например, модули кривых
+    id-tc26-gost-3410-2012-256-paramSetA и id-tc26-gost-3410-2012-512-paramSetA),
+    то используется упрощенная редукция, см. функцию ak_mpzn_redc_special(). Для модулей вида
+    \f$ p = 2^{64N-1} + c \f$ (кривые id-tc26-gost-3410-2012-256-paramSetTest,
+    id-tc26-gost-3410-2012-256-paramSetC и id-tc26-gost-3410-2012-512-paramSetB)
+    используется функция ak_mpzn_redc_special_plus(). Проверка вида модуля
+    выполняется при каждом вызове, поэтому упрощенная редукция используется и для кривых,
+    параметры которых загружаются во время работы программы.
+
+    @param z Указатель на вычет, в который помещается результат
+    @param x Левый аргумент опреации сложения
+    @param y Правый аргумент операции сложения
+    @param p Модуль, по которому производятся вычисления
+    @param n0 Константа, используемая в вычислениях. Представляет собой младшее слово
+    числа n, удовлетворяющего равенству \f$ rs - np = 1\f$.
+    @param size Размер модуля в словах (значение константы \ref ak_mpzn256_size или
+                                                                          \ref ak_mpzn512_size).   */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_mpzn_mul_montgomery( ak_uint64 *z, ak_uint64 *x, ak_uint64 *y,
+                                               ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+#ifdef LIBAKRYPT_HAVE_UINT128
+  switch( size ) {
+    case ak_mpzn256_size:
+      if( ak_mpzn_is_special( p, ak_mpzn256_size )) {
+        ak_mpzn_mul_montgomery_special_n4( z, x, y, p, n0, ak_false );
+        return;
+      }
+      if( ak_mpzn_is_special_plus( p, ak_mpzn256_size )) {
+        ak_mpzn_mul_montgomery_special_n4( z, x, y, p, n0, ak_true );
+        return;
+      }
+#ifdef AK_HAVE_BUILTIN_MULX_ADX
+      if( ak_mpzn_has_adx( )) ak_mpzn_mul_montgomery_adx_n4( z, x, y, p, n0 );
+       else
+#endif
+      ak_mpzn_mul_montgomery_n4( z, x, y, p, n0 );
+      return;
+    case ak_mpzn512_size:
+      if( ak_mpzn_is_special( p, ak_mpzn512_size )) {
+        ak_mpzn_mul_montgomery_special_n8( z, x, y, p, n0, ak_false );
+        return;
+      }
+      if( ak_mpzn_is_special_plus( p, ak_mpzn512_size )) {
+        ak_mpzn_mul_montgomery_special_n8( z, x, y, p, n0, ak_true );
+        return;
+      }
+#ifdef AK_HAVE_BUILTIN_MULX_ADX
+      if( ak_mpzn_has_adx( )) ak_mpzn_mul_montgomery_adx_n8( z, x, y, p, n0 );
+       else
+#endif
+      ak_mpzn_mul_montgomery_n8( z, x, y, p, n0 );
+      return;
+    default: break;
+  }
+#endif
+  ak_mpzn_mul_montgomery_generic( z, x, y, p, n0, size );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция возводит в квадрат вычет x, заданный в представлении Монтгомери, то есть
+    для \f$ x \equiv x_0r \pmod{p} \f$ вычисляет значение, удовлетворяющее сравнению
+    \f$ z \equiv x_0^2r \pmod{p}\f$. Результат совпадает с результатом вызова
+    функции ak_mpzn_mul_montgomery() с равными сомножителями, однако для модулей длины
+    \ref ak_mpzn256_size и \ref ak_mpzn512_size вычисляется быстрее.
+    При наличии команд mulx, adcx и adox используется умножение с их помощью, поскольку
+    на таких процессорах оно выполняется быстрее отдельной реализации возведения в квадрат.
+    Указатель на z может совпадать с указателем на x.
+
+    @param z Указатель на вычет, в который помещается результат
+    @param x Вычет, который возводится в квадрат
+    @param p Модуль, по которому производятся вычисления
+    @param n0 Константа, используемая в вычислениях (см. описание функции ak_mpzn_mul_montgomery())
+    @param size Размер модуля в словах (значение константы \ref ak_mpzn256_size или
+                                                                          \ref ak_mpzn512_size).   */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_mpzn_sqr_montgomery( ak_uint64 *z, ak_uint64 *x,
+                                               ak_uint64 *p, ak_uint64 n0, const size_t size )
+{
+#ifdef LIBAKRYPT_HAVE_UINT128
+  switch( size ) {
+    case ak_mpzn256_size:
+      if( ak_mpzn_is_special( p, ak_mpzn256_size )) {
+        ak_mpzn_sqr_montgomery_special_n4( z, x, p, n0, ak_false );
+        return;
+      }
+      if( ak_mpzn_is_special_plus( p, ak_mpzn256_size )) {
+        ak_mpzn_sqr_montgomery_special_n4( z, x, p, n0, ak_true );
+        return;
+      }
+#ifdef AK_HAVE_BUILTIN_MULX_ADX
+      if( ak_mpzn_has_adx( )) ak_mpzn_mul_montgomery_adx_n4( z, x, x, p, n0 );
+       else
+#endif
+      ak_mpzn_sqr_montgomery_n4( z, x, p, n0 );
+      return;
+    case ak_mpzn512_size:
+      if( ak_mpzn_is_special( p, ak_mpzn512_size )) {
+        ak_mpzn_sqr_montgomery_special_n8( z, x, p, n0, ak_false );
+        return;
+      }
+      if( ak_mpzn_is_special_plus( p, ak_mpzn512_size )) {
+        ak_mpzn_sqr_montgomery_special_n8( z, x, p, n0, ak_true );
+        return;
+      }
+#ifdef AK_HAVE_BUILTIN_MULX_ADX
+      if( ak_mpzn_has_adx( )) ak_mpzn_mul_montgomery_adx_n8( z, x, x, p, n0 );
+       else
+#endif
+      ak_mpzn_sqr_montgomery_n8( z, x, p, n0 );
+      return;
+    default: break;
+  }
+#endif
+  ak_mpzn_mul_montgomery_generic( z, x, x, p, n0, size );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Для вычета \f$ x \f$, заданного в представлении Монтгомери в виде \f$ xr \f$, где \f$ r \f$
     заданная степень двойки, вычисляется вычет \f$ z \f$,
@@ -833,7 +1472,7 @@
   for( i = s; i >= 0; i-- ) {
      uk = k[i];
      for( j = 0; j < 64; j++ ) {
-        ak_mpzn_mul_montgomery( res, res, res, p, n0, size );
+        ak_mpzn_sqr_montgomery( res, res, p, n0, size );
         if( uk&0x8000000000000000LL ) ak_mpzn_mul_montgomery( res, res, x, p, n0, size );
         uk <<= 1;
      }
@@ -841,6 +1480,338 @@
   memcpy( z, res, size*sizeof( ak_uint64 ));
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*                  обращение вычетов с помощью алгоритма Бернштейна-Янга (safegcd)                */
+/* ----------------------------------------------------------------------------------------------- */
+#ifdef LIBAKRYPT_HAVE_UINT128
+ __extension__ typedef __int128 ak_mpzn_sdword;
+
+/*! \brief Максимальное количество 62-х битных слов, используемых для представления вычетов. */
+ #define ak_mpzn_s62_size ( ak_mpzn512_size + 1 )
+/*! \brief Маска младших 62-х бит. */
+ #define ak_mpzn_m62 ( (( ak_uint64 )-1 ) >> 2 )
+
+/*! \brief Матрица перехода, соответствующая 62-м последовательным шагам алгоритма
+    (элементы матрицы умножены на \f$ 2^{62} \f$). */
+ typedef struct {
+  ak_int64 u, v, q, r;
+ } ak_mpzn_trans;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество 62-х битных слов, необходимое для вычетов длины size 64-х битных слов. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline size_t ak_mpzn_s62_length( const size_t size )
+{
+ return ( 64*size )/62 + 1;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Преобразование вычета в последовательность 62-х битных слов. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_to_s62( ak_int64 *r, const ak_uint64 *x, const size_t size, const size_t len )
+{
+  size_t j, w, s;
+  ak_uint64 v;
+
+  for( j = 0; j < len; j++ ) {
+     w = ( 62*j ) >> 6;
+     s = ( 62*j )&0x3f;
+     v = 0;
+     if( w < size ) v = x[w] >> s;
+     if(( s > 2 ) && ( w+1 < size )) v |= x[w+1] << ( 64 - s );
+     r[j] = ( ak_int64 )( v&ak_mpzn_m62 );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Преобразование последовательности неотрицательных 62-х битных слов в вычет. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_from_s62( ak_uint64 *x, const ak_int64 *r, const size_t size, const size_t len )
+{
+  size_t i, j, s;
+
+  for( i = 0; i < size; i++ ) {
+     j = ( 64*i )/62;
+     s = ( 64*i )%62;
+     x[i] = ( ak_uint64 )r[j] >> s;
+     if( j+1 < len ) x[i] |= ( ak_uint64 )r[j+1] << ( 62 - s );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Выполнение 62-х шагов (divsteps) алгоритма за постоянное время.
+
+    Величина \f$ \eta = -\delta \f$; функция вычисляет матрицу перехода `t` по младшим словам
+    \f$ f_0, g_0 \f$ и возвращает новое значение \f$ \eta \f$. Ветвления, зависящие от
+    обрабатываемых данных, заменены вычислениями с масками.                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_int64 ak_mpzn_divsteps_62( ak_int64 eta, ak_uint64 f, ak_uint64 g, ak_mpzn_trans *t )
+{
+  int i;
+  ak_uint64 u = 1, v = 0, q = 0, r = 1, c1, c2, x, y, z;
+
+  for( i = 0; i < 62; i++ ) {
+    /* c1 - маска условия delta > 0, c2 - маска нечетности g */
+     c1 = ( ak_uint64 )( eta >> 63 );
+     c2 = ( ak_uint64 )0 - ( g&1 );
+     x = ( f^c1 ) - c1;
+     y = ( u^c1 ) - c1;
+     z = ( v^c1 ) - c1;
+     g += x&c2; q += y&c2; r += z&c2;
+    /* при выполнении обоих условий меняем f и g местами */
+     c1 &= c2;
+     eta = ( eta^( ak_int64 )c1 ) - 1 - ( ak_int64 )c1;
+     f += g&c1; u += q&c1; v += r&c1;
+     g >>= 1; u <<= 1; v <<= 1;
+  }
+  t->u = ( ak_int64 )u; t->v = ( ak_int64 )v;
+  t->q = ( ak_int64 )q; t->r = ( ak_int64 )r;
+ return eta;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Выполнение 62-х шагов (divsteps) алгоритма за время, зависящее от входных данных.
+
+    Нулевые младшие биты \f$ g \f$ отбрасываются за один шаг, а несколько последовательных
+    шагов без обмена \f$ f \f$ и \f$ g \f$ объединяются за счет вычисления \f$ -g/f \f$
+    по модулю \f$ 2^{4} \f$ или \f$ 2^{6} \f$.                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_int64 ak_mpzn_divsteps_62_var( ak_int64 eta,
+                                                     ak_uint64 f, ak_uint64 g, ak_mpzn_trans *t )
+{
+  int i = 62, limit, zeros;
+  ak_uint64 u = 1, v = 0, q = 0, r = 1, m, w, tmp;
+
+  for( ;; ) {
+     zeros = __builtin_ctzll( g|(( ak_uint64 )-1 << i ));
+     g >>= zeros; u <<= zeros; v <<= zeros;
+     eta -= zeros; i -= zeros;
+     if( i == 0 ) break;
+    /* теперь g нечетно */
+     if( eta < 0 ) {
+       eta = -eta;
+       tmp = f; f = g; g = -tmp;
+       tmp = u; u = q; q = -tmp;
+       tmp = v; v = r; r = -tmp;
+       limit = (( int )eta + 1 ) > i ? i : (( int )eta + 1 );
+       m = (( ak_uint64 )-1 >> ( 64 - limit ))&63U;
+       w = ( f*g*( f*f - 2 ))&m;
+     } else {
+       limit = (( int )eta + 1 ) > i ? i : (( int )eta + 1 );
+       m = (( ak_uint64 )-1 >> ( 64 - limit ))&15U;
+       w = f + ((( f + 1 )&4 ) << 1 );
+       w = ( -w*g )&m;
+     }
+     g += f*w; q += u*w; r += v*w;
+  }
+  t->u = ( ak_int64 )u; t->v = ( ak_int64 )v;
+  t->q = ( ak_int64 )q; t->r = ( ak_int64 )r;
+ return eta;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление \f$ (d, e) \leftarrow t(d, e)/2^{62} \pmod{p} \f$.
+
+    Значения \f$ d, e \f$ лежат в интервале \f$ (-2p, p) \f$ до и после вычислений. Для деления
+    на \f$ 2^{62} \f$ к результату прибавляются такие кратные модуля, что младшие 62 бита
+    обнуляются; `pinv` - обратный к модулю элемент по модулю \f$ 2^{62} \f$.                      */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_update_de_62( ak_int64 *d, ak_int64 *e, const ak_mpzn_trans *t,
+                                         const ak_int64 *p, ak_uint64 pinv, const size_t len )
+{
+  size_t i;
+  ak_mpzn_sdword cd, ce;
+  const ak_int64 u = t->u, v = t->v, q = t->q, r = t->r;
+  ak_int64 sd = d[len-1] >> 63, se = e[len-1] >> 63, md, me;
+
+  md = ( u&sd ) + ( v&se );
+  me = ( q&sd ) + ( r&se );
+  cd = ( ak_mpzn_sdword )u*d[0] + ( ak_mpzn_sdword )v*e[0];
+  ce = ( ak_mpzn_sdword )q*d[0] + ( ak_mpzn_sdword )r*e[0];
+  md -= ( ak_int64 )(( pinv*( ak_uint64 )cd + ( ak_uint64 )md )&ak_mpzn_m62 );
+  me -= ( ak_int64 )(( pinv*( ak_uint64 )ce + ( ak_uint64 )me )&ak_mpzn_m62 );
+  cd += ( ak_mpzn_sdword )p[0]*md;
+  ce += ( ak_mpzn_sdword )p[0]*me;
+  cd >>= 62;
+  ce >>= 62;
+  for( i = 1; i < len; i++ ) {
+     cd += ( ak_mpzn_sdword )u*d[i] + ( ak_mpzn_sdword )v*e[i] + ( ak_mpzn_sdword )p[i]*md;
+     ce += ( ak_mpzn_sdword )q*d[i] + ( ak_mpzn_sdword )r*e[i] + ( ak_mpzn_sdword )p[i]*me;
+     d[i-1] = ( ak_int64 )(( ak_uint64 )cd&ak_mpzn_m62 ); cd >>= 62;
+     e[i-1] = ( ak_int64 )(( ak_uint64 )ce&ak_mpzn_m62 ); ce >>= 62;
+  }
+  d[len-1] = ( ak_int64 )cd;
+  e[len-1] = ( ak_int64 )ce;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление \f$ (f, g) \leftarrow t(f, g)/2^{62} \f$ для первых len слов. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_update_fg_62( ak_int64 *f, ak_int64 *g, const ak_mpzn_trans *t,
+                                                                               const size_t len )
+{
+  size_t i;
+  ak_mpzn_sdword cf, cg;
+  const ak_int64 u = t->u, v = t->v, q = t->q, r = t->r;
+
+  cf = ( ak_mpzn_sdword )u*f[0] + ( ak_mpzn_sdword )v*g[0];
+  cg = ( ak_mpzn_sdword )q*f[0] + ( ak_mpzn_sdword )r*g[0];
+  cf >>= 62;
+  cg >>= 62;
+  for( i = 1; i < len; i++ ) {
+     cf += ( ak_mpzn_sdword )u*f[i] + ( ak_mpzn_sdword )v*g[i];
+     cg += ( ak_mpzn_sdword )q*f[i] + ( ak_mpzn_sdword )r*g[i];
+     f[i-1] = ( ak_int64 )(( ak_uint64 )cf&ak_mpzn_m62 ); cf >>= 62;
+     g[i-1] = ( ak_int64 )(( ak_uint64 )cg&ak_mpzn_m62 ); cg >>= 62;
+  }
+  f[len-1] = ( ak_int64 )cf;
+  g[len-1] = ( ak_int64 )cg;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Приведение значения \f$ d \in (-2p, p) \f$, умноженного на знак `sign`,
+    к интервалу \f$ [0, p) \f$ за постоянное время. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_normalize_62( ak_int64 *d, ak_int64 sign, const ak_int64 *p, const size_t len )
+{
+  size_t i;
+  ak_int64 cond = d[len-1] >> 63;
+
+  for( i = 0; i < len; i++ ) d[i] += p[i]&cond;
+  cond = sign >> 63;
+  for( i = 0; i < len; i++ ) d[i] = ( d[i]^cond ) - cond;
+  for( i = 1; i < len; i++ ) { d[i] += d[i-1] >> 62; d[i-1] &= ( ak_int64 )ak_mpzn_m62; }
+  cond = d[len-1] >> 63;
+  for( i = 0; i < len; i++ ) d[i] += p[i]&cond;
+  for( i = 1; i < len; i++ ) { d[i] += d[i-1] >> 62; d[i-1] &= ( ak_int64 )ak_mpzn_m62; }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление \f$ z \equiv cx^{-1} \pmod{p} \f$ для нечетного модуля \f$ p \f$.
+
+    Если `var` равно ak_false, то выполняется фиксированное количество шагов, достаточное для
+    любых входных данных (оценка Бернштейна-Янга \f$ \lceil (49d+57)/17 \rceil \f$, где
+    \f$ d \f$ - длина модуля в битах), и время вычислений не зависит от значения \f$ x \f$.
+    В противном случае вычисления прекращаются сразу после обнуления \f$ g \f$.                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_mpzn_safegcd( ak_uint64 *z, ak_uint64 *x, ak_uint64 *c, ak_uint64 *p,
+                                                             const size_t size, const bool_t var )
+{
+  ak_mpzn_trans t;
+  ak_int64 eta = -1, cond; /* eta = -delta, начальное значение delta = 1 */
+  size_t i, j, flen, len = ak_mpzn_s62_length( size ),
+         count = (((( 49*64*size + 57 ) + 16 )/17 ) + 61 )/62;
+  ak_uint64 pinv = p[0];
+  ak_int64 d[ak_mpzn_s62_size], e[ak_mpzn_s62_size],
+           f[ak_mpzn_s62_size], g[ak_mpzn_s62_size], m[ak_mpzn_s62_size];
+
+ /* обратный к модулю элемент по модулю 2^62 (метод Ньютона) */
+  for( i = 0; i < 5; i++ ) pinv *= 2 - p[0]*pinv;
+  pinv &= ak_mpzn_m62;
+
+  memset( d, 0, sizeof( d ));
+  ak_mpzn_to_s62( e, c, size, len );
+  ak_mpzn_to_s62( m, p, size, len );
+  ak_mpzn_to_s62( f, p, size, len );
+  ak_mpzn_to_s62( g, x, size, len );
+
+  if( var ) {
+    flen = len;
+    for( ;; ) {
+       eta = ak_mpzn_divsteps_62_var( eta, ( ak_uint64 )f[0], ( ak_uint64 )g[0], &t );
+       ak_mpzn_update_de_62( d, e, &t, m, pinv, len );
+       ak_mpzn_update_fg_62( f, g, &t, flen );
+      /* проверяем, что g = 0 */
+       cond = 0;
+       for( j = 0; j < flen; j++ ) cond |= g[j];
+       if( cond == 0 ) break;
+      /* если старшие слова f и g малы, то уменьшаем длину */
+       cond = ( ak_int64 )( flen - 2 ) >> 63;
+       cond |= f[flen-1]^( f[flen-1] >> 63 );
+       cond |= g[flen-1]^( g[flen-1] >> 63 );
+       if( cond == 0 ) {
+         f[flen-2] = ( ak_int64 )(( ak_uint64 )f[flen-2] | (( ak_uint64 )f[flen-1] << 62 ));
+         g[flen-2] = ( ak_int64 )(( ak_uint64 )g[flen-2] | (( ak_uint64 )g[flen-1] << 62 ));
+         --flen;
+       }
+    }
+    ak_mpzn_normalize_62( d, f[flen-1], m, len );
+  } else {
+    for( i = 0; i < count; i++ ) {
+       eta = ak_mpzn_divsteps_62( eta, ( ak_uint64 )f[0], ( ak_uint64 )g[0], &t );
+       ak_mpzn_update_de_62( d, e, &t, m, pinv, len );
+       ak_mpzn_update_fg_62( f, g, &t, len );
+    }
+    ak_mpzn_normalize_62( d, f[len-1], m, len );
+  }
+  ak_mpzn_from_s62( z, d, size, len );
+
+ /* очищаем промежуточные значения */
+  memset( d, 0, sizeof( d ));
+  memset( e, 0, sizeof( e ));
+  memset( f, 0, sizeof( f ));
+  memset( g, 0, sizeof( g ));
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Для вычета \f$ x \f$, заданного в представлении Монтгомери, функция вычисляет вычет
+    \f$ z \f$, удовлетворяющий сравнению \f$ xz \equiv r^2 \pmod{p} \f$, то есть обратный к
+    \f$ x \f$ вычет в представлении Монтгомери. Результат совпадает с результатом вызова функции
+    ak_mpzn_modpow_montgomery() с показателем \f$ p-2 \f$, однако вычисляется с помощью
+    алгоритма Бернштейна-Янга (safegcd) в несколько раз быстрее. Для нулевого \f$ x \f$
+    результат равен нулю.
+
+    Время вычислений не зависит от значения \f$ x \f$, поэтому функция может использоваться
+    для обращения секретных значений.
+
+    @param z Указатель на вычет, в который помещается результат
+    @param x Обращаемый вычет, \f$ x < p \f$
+    @param p Нечетный модуль, по которому производятся вычисления
+    @param n0 Константа, используемая в арифметике Монтгомери
+    (см. описание функции ak_mpzn_mul_montgomery())
+    @param r2 Величина \f$ r^2 \pmod{p}\f$
+    @param size Размер модуля в словах (значение константы \ref ak_mpzn256_size или
+                                                                          \ref ak_mpzn512_size).   */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_mpzn_inverse_montgomery( ak_uint64 *z, ak_uint64 *x, ak_uint64 *p,
+                                     ak_uint64 n0, ak_uint64 *r2, const size_t size )
+{
+#ifdef LIBAKRYPT_HAVE_UINT128
+  (void)n0;
+  ak_mpzn_safegcd( z, x, r2, p, size, ak_false );
+#else
+  ak_mpznmax u;
+  (void)r2;
+  ak_mpzn_set_ui( u, size, 2 );
+  ak_mpzn_sub( u, p, u, size );
+  ak_mpzn_modpow_montgomery( z, x, u, p, n0, size );
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет тот же результат, что и функция ak_mpzn_inverse_montgomery(), однако время
+    вычислений зависит от значения \f$ x \f$. Функция должна использоваться только для
+    обращения открытых значений, например, при проверке электронной подписи.
+
+    @param z Указатель на вычет, в который помещается результат
+    @param x Обращаемый вычет, \f$ x < p \f$
+    @param p Нечетный модуль, по которому производятся вычисления
+    @param n0 Константа, используемая в арифметике Монтгомери
+    @param r2 Величина \f$ r^2 \pmod{p}\f$
+    @param size Размер модуля в словах                                                             */
+/* ----------------------------------------------------------------------------------------------- */
+ void ak_mpzn_inverse_montgomery_var( ak_uint64 *z, ak_uint64 *x, ak_uint64 *p,
+                                         ak_uint64 n0, ak_uint64 *r2, const size_t size )
+{
+#ifdef LIBAKRYPT_HAVE_UINT128
+  (void)n0;
+  ak_mpzn_safegcd( z, x, r2, p, size, ak_true );
+#else
+  ak_mpzn_inverse_montgomery( z, x, p, n0, r2, size );
+#endif
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 #ifdef AK_HAVE_GMP_H
 /* преобразование "туда и обратно" */
@@ -0,0 +1,527 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Copyright (c) 2020 by Axel Kenzo, axelkenzo@mail.ru                                            */
+/*                                                                                                 */
+/*  Файл ak_ocb.c                                                                                  */
+/*  - содержит реализацию режима аутентифицированного шифрования OCB (RFC 7253)                    */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <libakrypt-internal.h>
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Максимальное количество значений L_i, вычисляемых для одного сообщения. */
+ #define ak_ocb_max_l_count             (64)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Контекст режима `ocb`, содержащий промежуточные значения вычислений.
+    \details Все значения хранятся в виде последовательностей октетов; порядок следования
+    битов соответствует RFC 7253 (старший бит первого октета является первым битом строки).      */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct ocb_ctx {
+  /*! \brief Значение L_* = E( 0^n ). */
+   ak_uint64 lstar[2];
+  /*! \brief Значение L_$ = double( L_* ). */
+   ak_uint64 ldollar[2];
+  /*! \brief Значения L_i = double( L_{i-1} ), L_0 = double( L_$ ). */
+   ak_uint64 l[ak_ocb_max_l_count][2];
+  /*! \brief Количество вычисленных значений L_i. */
+   size_t lcount;
+  /*! \brief Текущее значение смещения при обработке шифруемых данных. */
+   ak_uint64 offset[2];
+  /*! \brief Контрольная сумма открытого текста. */
+   ak_uint64 checksum[2];
+  /*! \brief Результат сжатия ассоциированных данных (значение HASH( K, A )). */
+   ak_uint64 sum[2];
+  /*! \brief Длина блока в октетах. */
+   size_t bsize;
+ } *ak_ocb_ctx;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет значение double( S ) в поле \f$ \mathbb F_{2^n} \f$ для n = 64 или 128.
+    \details Для n = 128 используется неприводимый многочлен \f$ x^{128} + x^7 + x^2 + x + 1\f$,
+    для n = 64 - многочлен \f$ x^{64} + x^4 + x^3 + x + 1\f$.                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_ocb_double( ak_uint8 *out, const ak_uint8 *in, const size_t bsize )
+{
+  size_t i = 0;
+  ak_uint8 carry = in[0] >> 7;
+
+  for( i = 0; i < bsize - 1; i++ ) out[i] = ( ak_uint8 )(( in[i] << 1 )|( in[i+1] >> 7 ));
+  out[bsize-1] = ( ak_uint8 )(( in[bsize-1] << 1 )^( carry*( bsize == 16 ? 0x87 : 0x1B )));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция возвращает количество младших нулевых битов натурального числа. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline size_t ak_ocb_ntz( size_t i )
+{
+  size_t n = 0;
+  while(( i&1 ) == 0 ) { i >>= 1; n++; }
+ return n;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет значения L_*, L_$ и L_i, необходимые для обработки
+    заданного количества блоков.                                                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_ocb_context_set_l( ak_ocb_ctx ctx, ak_bckey bkey, const size_t blocks )
+{
+  size_t i = 0, count = 1;
+
+  ctx->bsize = bkey->bsize;
+  memset( ctx->lstar, 0, sizeof( ctx->lstar ));
+  bkey->encrypt( &bkey->key, ctx->lstar, ctx->lstar );
+  ak_ocb_double( (ak_uint8 *)ctx->ldollar, (ak_uint8 *)ctx->lstar, ctx->bsize );
+  ak_ocb_double( (ak_uint8 *)ctx->l[0], (ak_uint8 *)ctx->ldollar, ctx->bsize );
+
+ /* при обработке i-го блока используется значение L_{ntz(i)} */
+  while(( count < ak_ocb_max_l_count ) && (( (size_t)1 << count ) <= blocks )) count++;
+  for( i = 1; i < count; i++ )
+     ak_ocb_double( (ak_uint8 *)ctx->l[i], (ak_uint8 *)ctx->l[i-1], ctx->bsize );
+  ctx->lcount = count;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет начальное значение смещения по заданной синхропосылке (nonce).
+    \details Для блочных шифров с длиной блока 128 бит используются константы из RFC 7253,
+    для блочных шифров с длиной блока 64 бита - константы обобщения режима OCB
+    на блоки произвольной длины (сдвиг 25 бит и 5 бит индекса).                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_ocb_context_set_nonce( ak_ocb_ctx ctx, ak_bckey bkey,
+                           const ak_uint8 *iv, const size_t iv_size, const size_t icode_size )
+{
+  size_t i = 0, bottom = 0, bs = ctx->bsize;
+  size_t shift = ( bs == 16 ) ? 8 : 25, mask = ( bs == 16 ) ? 0x3f : 0x1f;
+  ak_uint8 nonce[16], stretch[32], *ktop = stretch;
+
+ /* Nonce = num2str( TAGLEN mod n, 7 ) || 0^* || 1 || N */
+  memset( nonce, 0, sizeof( nonce ));
+  nonce[0] = ( ak_uint8 )((( icode_size << 3 )%( bs << 3 )) << 1 );
+  nonce[bs - iv_size - 1] |= 0x01;
+  memcpy( nonce + bs - iv_size, iv, iv_size );
+
+ /* bottom = str2num( Nonce[n-5 or n-6 .. n] ), Ktop = E( Nonce с обнуленными младшими битами ) */
+  bottom = nonce[bs-1]&mask;
+  nonce[bs-1] &= ( ak_uint8 )( ~mask );
+  bkey->encrypt( &bkey->key, nonce, ktop );
+
+ /* Stretch = Ktop || ( Ktop xor ( Ktop << shift )) */
+  for( i = 0; i < bs; i++ ) {
+     size_t j = i + ( shift >> 3 );
+     ak_uint8 value = ( j < bs ) ? ( ak_uint8 )( ktop[j] << ( shift&7 )) : 0;
+     if((( shift&7 ) != 0 ) && ( j+1 < bs )) value |= ( ak_uint8 )( ktop[j+1] >> ( 8 - ( shift&7 )));
+     stretch[bs+i] = ktop[i] ^ value;
+  }
+
+ /* Offset_0 = Stretch[1+bottom..n+bottom] */
+  for( i = 0; i < bs; i++ ) {
+     size_t j = i + ( bottom >> 3 );
+     ak_uint8 value = ( ak_uint8 )( stretch[j] << ( bottom&7 ));
+     if(( bottom&7 ) != 0 ) value |= ( ak_uint8 )( stretch[j+1] >> ( 8 - ( bottom&7 )));
+     ((ak_uint8 *)ctx->offset)[i] = value;
+  }
+  memset( ctx->checksum, 0, sizeof( ctx->checksum ));
+
+  ak_ptr_wipe( stretch, sizeof( stretch ), &bkey->key.generator );
+  ak_ptr_wipe( nonce, sizeof( nonce ), &bkey->key.generator );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет значение HASH( K, A ) от ассоциированных данных. */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_ocb_context_hash( ak_ocb_ctx ctx, ak_bckey bkey,
+                                                     const ak_uint8 *adata, const size_t adata_size )
+{
+  size_t i = 0, blocks = adata_size/ctx->bsize, tail = adata_size%ctx->bsize;
+  ak_uint64 offset[2] = { 0, 0 }, x[2] = { 0, 0 };
+
+  memset( ctx->sum, 0, sizeof( ctx->sum ));
+  for( i = 1; i <= blocks; i++ ) {
+     size_t idx = ak_ocb_ntz( i );
+     offset[0] ^= ctx->l[idx][0]; offset[1] ^= ctx->l[idx][1];
+     memcpy( x, adata, ctx->bsize );
+     x[0] ^= offset[0]; x[1] ^= offset[1];
+     bkey->encrypt( &bkey->key, x, x );
+     ctx->sum[0] ^= x[0]; ctx->sum[1] ^= x[1];
+     adata += ctx->bsize;
+  }
+  if( tail ) {
+    offset[0] ^= ctx->lstar[0]; offset[1] ^= ctx->lstar[1];
+    memset( x, 0, sizeof( x ));
+    memcpy( x, adata, tail );
+    ((ak_uint8 *)x)[tail] = 0x80;
+    x[0] ^= offset[0]; x[1] ^= offset[1];
+    bkey->encrypt( &bkey->key, x, x );
+    ctx->sum[0] ^= x[0]; ctx->sum[1] ^= x[1];
+  }
+  ak_ptr_wipe( x, sizeof( x ), &bkey->key.generator );
+  ak_ptr_wipe( offset, sizeof( offset ), &bkey->key.generator );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция зашифровывает или расшифровывает данные и вычисляет контрольную сумму
+    открытого текста.
+
+    \details Преобразование каждого блока требует одного обращения к блочному шифру,
+    причем обращения для различных блоков не зависят друг от друга.                                */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_ocb_context_update( ak_ocb_ctx ctx, ak_bckey bkey,
+                          const ak_uint8 *in, ak_uint8 *out, const size_t size, bool_t encrypt )
+{
+  size_t i = 0, blocks = size/ctx->bsize, tail = size%ctx->bsize;
+  ak_uint64 x[2] = { 0, 0 }, p[2] = { 0, 0 };
+
+  for( i = 1; i <= blocks; i++ ) {
+     size_t idx = ak_ocb_ntz( i );
+     ctx->offset[0] ^= ctx->l[idx][0]; ctx->offset[1] ^= ctx->l[idx][1];
+     memcpy( x, in, ctx->bsize );
+     if( encrypt ) { ctx->checksum[0] ^= x[0]; ctx->checksum[1] ^= x[1]; }
+     x[0] ^= ctx->offset[0]; x[1] ^= ctx->offset[1];
+     if( encrypt ) bkey->encrypt( &bkey->key, x, x );
+      else bkey->decrypt( &bkey->key, x, x );
+     x[0] ^= ctx->offset[0]; x[1] ^= ctx->offset[1];
+     if( !encrypt ) { ctx->checksum[0] ^= x[0]; ctx->checksum[1] ^= x[1]; }
+     memcpy( out, x, ctx->bsize );
+     in += ctx->bsize; out += ctx->bsize;
+  }
+
+ /* последний неполный блок зашифровывается путем гаммирования */
+  if( tail ) {
+    ctx->offset[0] ^= ctx->lstar[0]; ctx->offset[1] ^= ctx->lstar[1];
+    bkey->encrypt( &bkey->key, ctx->offset, x );
+    memcpy( p, in, tail );
+    for( i = 0; i < tail; i++ ) out[i] = in[i] ^ ((ak_uint8 *)x)[i];
+    if( !encrypt ) memcpy( p, out, tail );
+    ((ak_uint8 *)p)[tail] = 0x80;
+    ctx->checksum[0] ^= p[0]; ctx->checksum[1] ^= p[1];
+  }
+  ak_ptr_wipe( x, sizeof( x ), &bkey->key.generator );
+  ak_ptr_wipe( p, sizeof( p ), &bkey->key.generator );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет значение имитовставки
+    Tag = E( Checksum xor Offset xor L_$ ) xor HASH( K, A ).                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_ocb_context_finalize( ak_ocb_ctx ctx, ak_bckey bkey,
+                                                      ak_pointer icode, const size_t icode_size )
+{
+  ak_uint64 x[2];
+
+  x[0] = ctx->checksum[0] ^ ctx->offset[0] ^ ctx->ldollar[0];
+  x[1] = ctx->checksum[1] ^ ctx->offset[1] ^ ctx->ldollar[1];
+  bkey->encrypt( &bkey->key, x, x );
+  x[0] ^= ctx->sum[0]; x[1] ^= ctx->sum[1];
+  memcpy( icode, x, icode_size );
+  ak_ptr_wipe( x, sizeof( x ), &bkey->key.generator );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция выполняет зашифрование или расшифрование данных в режиме `ocb`. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_bckey_ocb( ak_pointer encryptionKey, ak_pointer authenticationKey,
+           const ak_pointer adata, const size_t adata_size, const ak_pointer in, ak_pointer out,
+                                   const size_t size, const ak_pointer iv, const size_t iv_size,
+                                     ak_pointer icode, const size_t icode_size, bool_t encrypt )
+{
+  ak_int64 calls = 0;
+  struct ocb_ctx ctx;
+  ak_bckey bkey = NULL;
+  size_t bs = 0, nsize = 0, tsize = 0;
+
+ /* проверки ключей: режим использует один ключ, ключ имитозащиты используется
+                                               только в случае отсутствия ключа шифрования */
+  if(( encryptionKey == NULL ) && ( authenticationKey == NULL ))
+    return ak_error_message( ak_error_null_pointer, __func__ ,
+                               "using null pointers both to encryption and authentication keys" );
+  if(( encryptionKey != NULL ) && ( authenticationKey ) != NULL ) {
+    if( ((ak_bckey)encryptionKey)->bsize != ((ak_bckey)authenticationKey)->bsize )
+      return ak_error_message( ak_error_not_equal_data, __func__,
+                                                   "different block sizes for given secret keys");
+  }
+  if( encryptionKey != NULL ) bkey = encryptionKey;
+   else {
+     if(( in != NULL ) || ( out != NULL ) || ( size != 0 ))
+       return ak_error_message( ak_error_null_pointer, __func__ ,
+                                              "using null pointer to encryption key with data" );
+     bkey = authenticationKey;
+   }
+  if((( bs = bkey->bsize ) != 8 ) && ( bs != 16 ))
+    return ak_error_message( ak_error_wrong_block_cipher, __func__ ,
+                                                        "incorrect block size of block cipher key" );
+ /* проверяем параметры */
+  if(( size > 0 ) && (( in == NULL ) || ( out == NULL )))
+    return ak_error_message( ak_error_null_pointer, __func__ , "using null pointer to data" );
+  if(( adata_size > 0 ) && ( adata == NULL ))
+    return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                          "using null pointer to associated data" );
+  if( iv == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                   "using null pointer to initialization vector" );
+  if( iv_size == 0 ) return ak_error_message( ak_error_zero_length, __func__ ,
+                                           "unexpected zero length of initialization vector" );
+  if( icode == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                             "using null pointer to integrity code" );
+  if( icode_size == 0 ) return ak_error_message( ak_error_zero_length, __func__ ,
+                                                    "unexpected zero length of integrity code" );
+ /* используется не более n-1 октетов синхропосылки и не более n октетов имитовставки */
+  nsize = ak_min( iv_size, bs - 1 );
+  tsize = ak_min( icode_size, bs );
+  if(( size/bs >= ( (size_t)1 << ( ak_ocb_max_l_count - 1 ))) ||
+                                    ( adata_size/bs >= ( (size_t)1 << ( ak_ocb_max_l_count - 1 ))))
+    return ak_error_message( ak_error_wrong_length, __func__, "very large length of input data" );
+
+ /* проверяем целостность ключа */
+  if( bkey->key.check_icode( &bkey->key ) != ak_true )
+    return ak_error_message( ak_error_wrong_key_icode, __func__,
+                                                  "incorrect integrity code of secret key value" );
+ /* уменьшаем значение ресурса ключа: L_*, Ktop, имитовставка и все блоки данных */
+  calls = ( ak_int64 )( 3 + ( adata_size + bs - 1 )/bs + ( size + bs - 1 )/bs );
+  if( bkey->key.resource.value.counter < calls )
+    return ak_error_message( ak_error_low_key_resource,
+                                                   __func__ , "low resource of block cipher key" );
+   else bkey->key.resource.value.counter -= calls;
+
+ /* выполняем преобразования */
+  memset( &ctx, 0, sizeof( struct ocb_ctx ));
+  ak_ocb_context_set_l( &ctx, bkey, ak_max( size, adata_size )/bs );
+  ak_ocb_context_hash( &ctx, bkey, adata, adata_size );
+  ak_ocb_context_set_nonce( &ctx, bkey, iv, nsize, tsize );
+  ak_ocb_context_update( &ctx, bkey, in, out, size, encrypt );
+  ak_ocb_context_finalize( &ctx, bkey, icode, tsize );
+  ak_ptr_wipe( &ctx, sizeof( struct ocb_ctx ), &bkey->key.generator );
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция реализует режим `ocb` (вариант OCB3, RFC 7253) - режим шифрования для блочного
+    шифра с одновременным вычислением имитовставки. На вход функции подаются как данные,
+    подлежащие зашифрованию, так и ассоциированные данные, которые не зашифровываются.
+    При этом имитовставка вычисляется для всех переданных на вход функции данных.
+
+    Режим требует одного обращения к блочному шифру для каждого блока данных, причем
+    обращения для различных блоков могут выполняться независимо друг от друга.
+    Для алгоритмов с длиной блока 128 бит реализация в точности соответствует RFC 7253,
+    для алгоритмов с длиной блока 64 бита используется обобщение режима на блоки
+    произвольной длины (многочлен \f$ x^{64} + x^4 + x^3 + x + 1\f$, сдвиг 25 бит).
+
+    Режим `ocb` использует для шифрования и выработки имитовставки один ключ. Если заданы оба
+    ключа, то используется ключ шифрования. Если указатель на ключ шифрования равен `NULL`,
+    то вычисляется только имитовставка от ассоциированных данных (с помощью ключа имитозащиты);
+    в этом случае указатели на зашифровываемые и зашифрованные данные \b должны быть равны `NULL`,
+    а длина данных \b должна быть равна нулю.
+
+    @param encryptionKey ключ шифрования, должен быть инициализирован перед вызовом функции;
+           может принимать значение NULL;
+    @param authenticationKey ключ имитозащиты, используется только в случае, если ключ
+           шифрования не задан; может принимать значение `NULL`;
+
+    @param adata указатель на ассоциированные (незашифровываемые) данные;
+    @param adata_size длина ассоциированных данных в байтах;
+    @param in указатель на зашифровываеме данные;
+    @param out указатель на зашифрованные данные; данный указатель может совпадать с указателем in;
+    @param size размер зашифровываемых данных в байтах;
+    @param iv указатель на синхропосылку (nonce);
+    @param iv_size длина синхропосылки в байтах; если длина больше или равна длине блока,
+           то используются первые 15 октетов для Кузнечика или 7 октетов для Магмы;
+    @param icode указатель на область памяти, куда будет помещено значение имитовставки;
+           память должна быть выделена заранее;
+    @param icode_size ожидаемый размер имитовставки в байтах; если значение больше длины блока,
+           то вырабатывается имитовставка, длина которой равна длине блока; длина имитовставки
+           влияет на вычисляемое значение.
+
+   @return Функция возвращает \ref ak_error_ok в случае успешного завершения.
+   В противном случае, возвращается код ошибки.                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_encrypt_ocb( ak_pointer encryptionKey, ak_pointer authenticationKey,
+           const ak_pointer adata, const size_t adata_size, const ak_pointer in, ak_pointer out,
+                                   const size_t size, const ak_pointer iv, const size_t iv_size,
+                                                       ak_pointer icode, const size_t icode_size )
+{
+  int error = ak_error_ok;
+
+  if(( error = ak_bckey_ocb( encryptionKey, authenticationKey, adata, adata_size, in, out,
+                            size, iv, iv_size, icode, icode_size, ak_true )) != ak_error_ok )
+    ak_error_message( error, __func__, "incorrect encryption of plain data" );
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция реализует процедуру расшифрования с одновременной проверкой целостности зашифрованных
+    данных в режиме `ocb`. Требования к передаваемым параметрам аналогичны требованиям,
+    предъявляемым к параметрам функции ak_bckey_encrypt_ocb().
+
+    @param encryptionKey ключ шифрования, должен быть инициализирован перед вызовом функции;
+           может принимать значение `NULL`;
+    @param authenticationKey ключ имитозащиты, используется только в случае, если ключ
+           шифрования не задан; может принимать значение `NULL`;
+
+    @param adata указатель на ассоциированные (незашифровываемые) данные;
+    @param adata_size длина ассоциированных данных в байтах;
+    @param in указатель на расшифровываемые данные;
+    @param out указатель на область памяти, куда будут помещены расшифрованные данные;
+           данный указатель может совпадать с указателем in;
+    @param size размер зашифровываемых данных в байтах;
+    @param iv указатель на синхропосылку (nonce);
+    @param iv_size длина синхропосылки в байтах;
+    @param icode указатель на область памяти, в которой хранится значение имитовставки;
+    @param icode_size размер имитовставки в байтах; если значение больше длины блока,
+           то проверяется имитовставка, длина которой равна длине блока.
+
+    @return Функция возвращает \ref ak_error_ok, если значение имитовтсавки совпало с
+            вычисленным в ходе выполнения функции значением; если значения не совпадают,
+            или в ходе выполнения функции возникла ошибка, то возвращается код ошибки.             */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_decrypt_ocb( ak_pointer encryptionKey, ak_pointer authenticationKey,
+           const ak_pointer adata, const size_t adata_size, const ak_pointer in, ak_pointer out,
+                                   const size_t size, const ak_pointer iv, const size_t iv_size,
+                                                       ak_pointer icode, const size_t icode_size )
+{
+  size_t bs = 0;
+  ak_uint8 icode2[16];
+  int error = ak_error_ok;
+
+  memset( icode2, 0, sizeof( icode2 ));
+  if(( error = ak_bckey_ocb( encryptionKey, authenticationKey, adata, adata_size, in, out,
+                          size, iv, iv_size, icode2, icode_size, ak_false )) != ak_error_ok )
+    return ak_error_message( error, __func__, "incorrect decryption of cipher data" );
+
+ /* сравниваем только вычисленную часть имитовставки */
+  bs = ( encryptionKey != NULL ) ? ((ak_bckey)encryptionKey)->bsize :
+                                                             ((ak_bckey)authenticationKey)->bsize;
+  if( ak_ptr_is_equal_with_log( icode2, icode, ak_min( icode_size, bs ))) return ak_error_ok;
+ return ak_error_not_equal_data;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция проверяет зашифрование и расшифрование одного тестового примера. */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_libakrypt_test_ocb_example( ak_function_bckey_create *create, const char *name,
+              ak_uint8 *key, ak_uint8 *adata, const size_t adata_size, ak_uint8 *plain,
+            ak_uint8 *cipher, const size_t size, ak_uint8 *iv, const size_t iv_size,
+                                                         ak_uint8 *icode, const size_t icode_size )
+{
+  struct bckey bkey;
+  ak_uint8 out[128], icode2[16];
+  bool_t result = ak_false;
+  int error = ak_error_ok, audit = ak_log_get_level();
+
+  if(( error = create( &bkey )) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__, "incorrect initialization of %s secret key", name );
+    return ak_false;
+  }
+  if(( error = ak_bckey_set_key( &bkey, key, 32 )) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__, "incorrect assigning a constant value to %s key", name );
+    goto exit;
+  }
+
+ /* зашифрование */
+  memset( out, 0, sizeof( out ));
+  memset( icode2, 0, sizeof( icode2 ));
+  if(( error = ak_bckey_encrypt_ocb( &bkey, &bkey, adata, adata_size,
+                  plain, out, size, iv, iv_size, icode2, icode_size )) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__, "incorrect encryption with %s key", name );
+    goto exit;
+  }
+  if( !ak_ptr_is_equal_with_log( out, cipher, size )) {
+    ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                                                    "the encryption test for %s is wrong", name );
+    goto exit;
+  }
+  if( !ak_ptr_is_equal_with_log( icode2, icode, icode_size )) {
+    ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                                         "the value of integrity code for %s is wrong", name );
+    goto exit;
+  }
+
+ /* расшифрование на месте */
+  if(( error = ak_bckey_decrypt_ocb( &bkey, &bkey, adata, adata_size,
+                      out, out, size, iv, iv_size, icode, icode_size )) != ak_error_ok ) {
+    ak_error_message_fmt( error, __func__, "checking the integrity code for %s is wrong", name );
+    goto exit;
+  }
+  if( !ak_ptr_is_equal_with_log( out, plain, size )) {
+    ak_error_message_fmt( ak_error_not_equal_data, __func__ ,
+                                                    "the decryption test for %s is wrong", name );
+    goto exit;
+  }
+
+  if( audit >= ak_log_maximum ) ak_error_message_fmt( ak_error_ok, __func__ ,
+                              "the full encryption, decryption & integrity test with %s is Ok", name );
+  result = ak_true;
+
+  exit:
+   ak_bckey_destroy( &bkey );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \details Поскольку для блочных шифров ГОСТ Р 34.12-2015 отсутствуют стандартизованные
+    контрольные примеры режима `ocb`, используемые значения вычислены независимой реализацией
+    режима, проверенной на контрольных примерах RFC 7253.
+
+    @return Функция возвращает ak_true в случае успешного тестирования. В противном случае
+    возвращается ak_false.                                                                         */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_libakrypt_test_ocb( void )
+{
+ /* константное значение ключа из ГОСТ Р 34.13-2015 */
+  ak_uint8 keyAnnexA[32] = {
+     0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01, 0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+     0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00, 0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88 };
+
+ /* открытый текст (модификация ГОСТ Р 34.13-2015, приложение А.1) */
+  ak_uint8 plain[67] = {
+     0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0x00, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11,
+     0x0A, 0xFF, 0xEE, 0xCC, 0xBB, 0xAA, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00,
+     0x00, 0x0A, 0xFF, 0xEE, 0xCC, 0xBB, 0xAA, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11,
+     0x11, 0x00, 0x0A, 0xFF, 0xEE, 0xCC, 0xBB, 0xAA, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22,
+     0xCC, 0xBB, 0xAA };
+
+ /* асссоциированные данные */
+  ak_uint8 associated[41] = {
+     0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+     0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0xEA };
+
+ /* синхропосылки */
+  ak_uint8 iv128[12] = {
+     0xBB, 0xAA, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00 };
+  ak_uint8 iv64[7] = { 0x59, 0x0a, 0x13, 0x3c, 0x6b, 0xf0, 0xde };
+
+ /* шифртексты и имитовставки */
+  ak_uint8 cipherKuznechik[67] = {
+     0x2E, 0x3C, 0x1F, 0x2B, 0x27, 0x73, 0x57, 0x90, 0x88, 0x24, 0x1D, 0xBA, 0x99, 0x66, 0xE2, 0x21,
+     0x9D, 0xC3, 0xFB, 0x61, 0x02, 0x4E, 0xE9, 0x8D, 0x2F, 0xF2, 0xD3, 0x1C, 0x49, 0xCC, 0x46, 0xF0,
+     0x7F, 0x93, 0x11, 0xCC, 0x68, 0x47, 0xC1, 0x9B, 0xFD, 0x83, 0x19, 0xB7, 0x06, 0x08, 0xF0, 0x31,
+     0xBB, 0x2B, 0xD3, 0x51, 0xB4, 0xBB, 0x70, 0x9A, 0xAD, 0xCA, 0x88, 0xC4, 0x3E, 0xBE, 0x0E, 0x8A,
+     0xF0, 0x5C, 0xBA };
+  ak_uint8 icodeKuznechik[16] = {
+     0x4C, 0x7B, 0xDD, 0xF8, 0xF9, 0x2F, 0xC8, 0x19, 0x6F, 0x84, 0xC8, 0xD6, 0xE2, 0x59, 0x0C, 0x62 };
+
+  ak_uint8 cipherMagma[67] = {
+     0x46, 0x11, 0x52, 0x4C, 0x30, 0x03, 0x07, 0xCE, 0x73, 0x0F, 0x96, 0xCC, 0xC3, 0x29, 0xE4, 0xC4,
+     0xDB, 0x14, 0xEC, 0xBA, 0x4C, 0xD3, 0x51, 0xC2, 0x05, 0xA4, 0x08, 0x01, 0x40, 0xDF, 0xD8, 0xDC,
+     0x03, 0x9A, 0x6D, 0x18, 0x28, 0xAD, 0x9F, 0x10, 0xF9, 0xB3, 0xC7, 0x95, 0x3C, 0x17, 0x35, 0x89,
+     0x91, 0x34, 0xAE, 0xE7, 0xD9, 0x68, 0xC0, 0x9E, 0x99, 0xFB, 0x98, 0xF7, 0xE9, 0xBE, 0x32, 0xCD,
+     0x58, 0x40, 0xD1 };
+  ak_uint8 icodeMagma[8] = { 0x5F, 0xD2, 0xD7, 0x36, 0x61, 0xA5, 0xD1, 0xA4 };
+
+  int audit = ak_log_get_level();
+
+  if( ak_libakrypt_test_ocb_example( ak_bckey_create_kuznechik, "kuznechik", keyAnnexA,
+        associated, sizeof( associated ), plain, cipherKuznechik, sizeof( plain ),
+                  iv128, sizeof( iv128 ), icodeKuznechik, sizeof( icodeKuznechik )) != ak_true )
+    return ak_false;
+  if( ak_libakrypt_test_ocb_example( ak_bckey_create_magma, "magma", keyAnnexA,
+        associated, sizeof( associated ), plain, cipherMagma, sizeof( plain ),
+                              iv64, sizeof( iv64 ), icodeMagma, sizeof( icodeMagma )) != ak_true )
+    return ak_false;
+
+  if( audit >= ak_log_maximum )
+    ak_error_message( ak_error_ok, __func__ , "testing ocb mode ended successfully" );
+ return ak_true;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                                                                                       ak_ocb.c  */
+/* ----------------------------------------------------------------------------------------------- */
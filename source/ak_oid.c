@@ -112,12 +112,20 @@
 /*! Константные значения имен идентификаторов */
  static const char *asn1_lcg_n[] =         { "lcg", NULL };
  static const char *asn1_lcg_i[] =         { "1.2.643.2.52.1.1.1", NULL };
+ static const char *asn1_xoshiro256_n[] =  { "xoshiro256", NULL };
+ static const char *asn1_xoshiro256_i[] =  { "1.2.643.2.52.1.1.7", NULL };
 #if defined(__unix__) || defined(__APPLE__)
  static const char *asn1_dev_random_n[] =  { "dev-random", "/dev/random", NULL };
  static const char *asn1_dev_random_i[] =  { "1.2.643.2.52.1.1.2", NULL };
  static const char *asn1_dev_urandom_n[] = { "dev-urandom", "/dev/urandom", NULL };
  static const char *asn1_dev_urandom_i[] = { "1.2.643.2.52.1.1.3", NULL };
 #endif
+#ifdef AK_HAVE_SYSRANDOM_H
+ static const char *asn1_getrandom_n[] =   { "getrandom", NULL };
+ static const char *asn1_getrandom_i[] =   { "1.2.643.2.52.1.1.5", NULL };
+#endif
+ static const char *asn1_drbg_n[] =        { "drbg", "ctr-drbg-kuznechik", NULL };
+ static const char *asn1_drbg_i[] =        { "1.2.643.2.52.1.1.6", NULL };
 #ifdef _WIN32
  static const char *asn1_winrtl_n[] =       { "winrtl", NULL };
  static const char *asn1_winrtl_i[] =       { "1.2.643.2.52.1.1.4", NULL };
@@ -131,10 +139,30 @@
  static const char *asn1_hmac_streebog256_i[] = { "1.2.643.7.1.1.4.1", NULL };
  static const char *asn1_hmac_streebog512_n[] = { "hmac-streebog512", "HMAC-md_gost12_512", NULL };
  static const char *asn1_hmac_streebog512_i[] = { "1.2.643.7.1.1.4.2", NULL };
+ static const char *asn1_sha3_224_n[] =    { "sha3-224", NULL };
+ static const char *asn1_sha3_224_i[] =    { "2.16.840.1.101.3.4.2.7", NULL };
+ static const char *asn1_sha3_256_n[] =    { "sha3-256", NULL };
+ static const char *asn1_sha3_256_i[] =    { "2.16.840.1.101.3.4.2.8", NULL };
+ static const char *asn1_sha3_384_n[] =    { "sha3-384", NULL };
+ static const char *asn1_sha3_384_i[] =    { "2.16.840.1.101.3.4.2.9", NULL };
+ static const char *asn1_sha3_512_n[] =    { "sha3-512", NULL };
+ static const char *asn1_sha3_512_i[] =    { "2.16.840.1.101.3.4.2.10", NULL };
+ static const char *asn1_shake128_n[] =    { "shake128", NULL };
+ static const char *asn1_shake128_i[] =    { "2.16.840.1.101.3.4.2.11", NULL };
+ static const char *asn1_shake256_n[] =    { "shake256", NULL };
+ static const char *asn1_shake256_i[] =    { "2.16.840.1.101.3.4.2.12", NULL };
+ static const char *asn1_kmac128_n[] =     { "kmac128", NULL };
+ static const char *asn1_kmac128_i[] =     { "2.16.840.1.101.3.4.2.19", NULL };
+ static const char *asn1_kmac256_n[] =     { "kmac256", NULL };
+ static const char *asn1_kmac256_i[] =     { "2.16.840.1.101.3.4.2.20", NULL };
  static const char *asn1_magma_n[] =       { "magma", NULL };
  static const char *asn1_magma_i[] =       { "1.2.643.7.1.1.5.1", NULL };
  static const char *asn1_kuznechik_n[] =   { "kuznechik", "kuznyechik", "grasshopper", NULL };
  static const char *asn1_kuznechik_i[] =   { "1.2.643.7.1.1.5.2", NULL };
+ static const char *asn1_aes128_n[] =      { "aes128", "id-aes128-ECB", NULL };
+ static const char *asn1_aes128_i[] =      { "2.16.840.1.101.3.4.1.1", NULL };
+ static const char *asn1_aes256_n[] =      { "aes256", "id-aes256-ECB", NULL };
+ static const char *asn1_aes256_i[] =      { "2.16.840.1.101.3.4.1.41", NULL };
 
  static const char *asn1_ctr_magma_n[] =   { "ctr-magma", NULL };
  static const char *asn1_ctr_magma_i[] =   { "1.2.643.2.52.1.5.1.1", NULL };
@@ -142,24 +170,56 @@
                                            { "ctr-kuznechik", "ctr-kuznyechik", NULL };
  static const char *asn1_ctr_kuznechik_i[] =
                                            { "1.2.643.2.52.1.5.1.2", NULL };
+ static const char *asn1_ctr_aes128_n[] =
+                                           { "ctr-aes128", NULL };
+ static const char *asn1_ctr_aes128_i[] =
+                                           { "1.2.643.2.52.1.5.1.3", NULL };
+ static const char *asn1_ctr_aes256_n[] =
+                                           { "ctr-aes256", NULL };
+ static const char *asn1_ctr_aes256_i[] =
+                                           { "1.2.643.2.52.1.5.1.4", NULL };
  static const char *asn1_ofb_magma_n[] =   { "ofb-magma", NULL };
  static const char *asn1_ofb_magma_i[] =   { "1.2.643.2.52.1.5.2.1", NULL };
  static const char *asn1_ofb_kuznechik_n[] =
                                            { "ofb-kuznechik", "ofb-kuznyechik", NULL };
  static const char *asn1_ofb_kuznechik_i[] =
                                            { "1.2.643.2.52.1.5.2.2", NULL };
+ static const char *asn1_ofb_aes128_n[] =
+                                           { "ofb-aes128", NULL };
+ static const char *asn1_ofb_aes128_i[] =
+                                           { "1.2.643.2.52.1.5.2.3", NULL };
+ static const char *asn1_ofb_aes256_n[] =
+                                           { "ofb-aes256", NULL };
+ static const char *asn1_ofb_aes256_i[] =
+                                           { "1.2.643.2.52.1.5.2.4", NULL };
  static const char *asn1_cfb_magma_n[] =   { "cfb-magma", NULL };
  static const char *asn1_cfb_magma_i[] =   { "1.2.643.2.52.1.5.3.1", NULL };
  static const char *asn1_cfb_kuznechik_n[] =
                                            { "cfb-kuznechik", "cfb-kuznyechik", NULL };
  static const char *asn1_cfb_kuznechik_i[] =
                                            { "1.2.643.2.52.1.5.3.2", NULL };
+ static const char *asn1_cfb_aes128_n[] =
+                                           { "cfb-aes128", NULL };
+ static const char *asn1_cfb_aes128_i[] =
+                                           { "1.2.643.2.52.1.5.3.3", NULL };
+ static const char *asn1_cfb_aes256_n[] =
+                                           { "cfb-aes256", NULL };
+ static const char *asn1_cfb_aes256_i[] =
+                                           { "1.2.643.2.52.1.5.3.4", NULL };
  static const char *asn1_cbc_magma_n[] =   { "cbc-magma", NULL };
  static const char *asn1_cbc_magma_i[] =   { "1.2.643.2.52.1.5.4.1", NULL };
  static const char *asn1_cbc_kuznechik_n[] =
                                            { "cbc-kuznechik", "cbc-kuznyechik", NULL };
  static const char *asn1_cbc_kuznechik_i[] =
                                            { "1.2.643.2.52.1.5.4.2", NULL };
+ static const char *asn1_cbc_aes128_n[] =
+                                           { "cbc-aes128", "id-aes128-CBC", NULL };
+ static const char *asn1_cbc_aes128_i[] =
+                                           { "2.16.840.1.101.3.4.1.2", NULL };
+ static const char *asn1_cbc_aes256_n[] =
+                                           { "cbc-aes256", "id-aes256-CBC", NULL };
+ static const char *asn1_cbc_aes256_i[] =
+                                           { "2.16.840.1.101.3.4.1.42", NULL };
 
  static const char *asn1_xts_magma_n[] =   { "xts-magma", NULL };
  static const char *asn1_xts_magma_i[] =   { "1.2.643.2.52.1.5.5.1", NULL };
@@ -167,6 +227,14 @@
                                            { "xts-kuznechik", NULL };
  static const char *asn1_xts_kuznechik_i[] =
                                            { "1.2.643.2.52.1.5.5.2", NULL };
+ static const char *asn1_xts_aes128_n[] =
+                                           { "xts-aes128", NULL };
+ static const char *asn1_xts_aes128_i[] =
+                                           { "1.2.643.2.52.1.5.5.3", NULL };
+ static const char *asn1_xts_aes256_n[] =
+                                           { "xts-aes256", NULL };
+ static const char *asn1_xts_aes256_i[] =
+                                           { "1.2.643.2.52.1.5.5.4", NULL };
 
  /*   id-gostr3412-2015-magma-ctracpkm OBJECT IDENTIFIER ::= { 1.2.643.7.1.1.5.1.1 }
       id-gostr3412-2015-kuznechik-ctracpkm OBJECT IDENTIFIER ::= { 1.2.643.7.1.1.5.2.1 } */
@@ -186,6 +254,14 @@
                                            { "cmac-kuznechik", "cmac-kuznyechik", NULL };
  static const char *asn1_cmac_kuznechik_i[] =
                                            { "1.2.643.2.52.1.7.1.2", NULL };
+ static const char *asn1_cmac_aes128_n[] =
+                                           { "cmac-aes128", NULL };
+ static const char *asn1_cmac_aes128_i[] =
+                                           { "1.2.643.2.52.1.7.1.3", NULL };
+ static const char *asn1_cmac_aes256_n[] =
+                                           { "cmac-aes256", NULL };
+ static const char *asn1_cmac_aes256_i[] =
+                                           { "1.2.643.2.52.1.7.1.4", NULL };
 
  static const char *asn1_mgm_magma_n[] =   { "mgm-magma",
                                              "id-tc26-cipher-gostr3412-2015-magma-mgm", NULL };
@@ -227,6 +303,34 @@
                                            { "xtsmac-kuznechik", "xtsmac-kuznyechik", NULL };
  static const char *asn1_xtsmac_kuznechik_i[] =
                                            { "1.2.643.2.52.1.6.3.2", NULL };
+ static const char *asn1_ocb_magma_n[] =
+                                           { "ocb-magma", NULL };
+ static const char *asn1_ocb_magma_i[] =
+                                           { "1.2.643.2.52.1.6.4.1", NULL };
+ static const char *asn1_ocb_kuznechik_n[] =
+                                           { "ocb-kuznechik", "ocb-kuznyechik", NULL };
+ static const char *asn1_ocb_kuznechik_i[] =
+                                           { "1.2.643.2.52.1.6.4.2", NULL };
+ static const char *asn1_ocb_aes128_n[] =
+                                           { "ocb-aes128", NULL };
+ static const char *asn1_ocb_aes128_i[] =
+                                           { "1.2.643.2.52.1.6.4.3", NULL };
+ static const char *asn1_ocb_aes256_n[] =
+                                           { "ocb-aes256", NULL };
+ static const char *asn1_ocb_aes256_i[] =
+                                           { "1.2.643.2.52.1.6.4.4", NULL };
+ static const char *asn1_gcm_kuznechik_n[] =
+                                           { "gcm-kuznechik", "gcm-kuznyechik", NULL };
+ static const char *asn1_gcm_kuznechik_i[] =
+                                           { "1.2.643.2.52.1.6.5.2", NULL };
+ static const char *asn1_gcm_aes128_n[] =
+                                           { "gcm-aes128", "id-aes128-GCM", NULL };
+ static const char *asn1_gcm_aes128_i[] =
+                                           { "2.16.840.1.101.3.4.1.6", NULL };
+ static const char *asn1_gcm_aes256_n[] =
+                                           { "gcm-aes256", "id-aes256-GCM", NULL };
+ static const char *asn1_gcm_aes256_i[] =
+                                           { "2.16.840.1.101.3.4.1.46", NULL };
 
  static const char *asn1_sign256_n[] =     { "id-tc26-signwithdigest-gost3410-12-256",
                                              "sign256", NULL };
@@ -412,6 +516,20 @@
                            ( ak_function_set_key_random_object *)ak_bckey_set_key_random, \
                       ( ak_function_set_key_from_password_object *)ak_bckey_set_key_from_password }
 
+ #define ak_object_bckey_aes128 { sizeof( struct bckey ), \
+                           ( ak_function_create_object *) ak_bckey_create_aes128, \
+                           ( ak_function_destroy_object *) ak_bckey_destroy, \
+                           ( ak_function_set_key_object *)ak_bckey_set_key, \
+                           ( ak_function_set_key_random_object *)ak_bckey_set_key_random, \
+                      ( ak_function_set_key_from_password_object *)ak_bckey_set_key_from_password }
+
+ #define ak_object_bckey_aes256 { sizeof( struct bckey ), \
+                           ( ak_function_create_object *) ak_bckey_create_aes256, \
+                           ( ak_function_destroy_object *) ak_bckey_destroy, \
+                           ( ak_function_set_key_object *)ak_bckey_set_key, \
+                           ( ak_function_set_key_random_object *)ak_bckey_set_key_random, \
+                      ( ak_function_set_key_from_password_object *)ak_bckey_set_key_from_password }
+
  #define ak_object_hmac_streebog256 { sizeof( struct hmac ), \
                            ( ak_function_create_object *) ak_hmac_create_streebog256, \
                            ( ak_function_destroy_object *) ak_hmac_destroy, \
@@ -426,6 +544,18 @@
                            ( ak_function_set_key_random_object *)ak_hmac_set_key_random, \
                        ( ak_function_set_key_from_password_object *)ak_hmac_set_key_from_password }
 
+ #define ak_object_kmac128 { sizeof( struct kmac ), \
+                           ( ak_function_create_object *) ak_kmac_create_kmac128, \
+                           ( ak_function_destroy_object *) ak_kmac_destroy, \
+                           ( ak_function_set_key_object *)ak_kmac_set_key, \
+                           ( ak_function_set_key_random_object *)ak_kmac_set_key_random, NULL }
+
+ #define ak_object_kmac256 { sizeof( struct kmac ), \
+                           ( ak_function_create_object *) ak_kmac_create_kmac256, \
+                           ( ak_function_destroy_object *) ak_kmac_destroy, \
+                           ( ak_function_set_key_object *)ak_kmac_set_key, \
+                           ( ak_function_set_key_random_object *)ak_kmac_set_key_random, NULL }
+
  #define ak_object_signkey256 { sizeof( struct signkey ), \
                           ( ak_function_create_object *) ak_signkey_create_streebog256, \
                           ( ak_function_destroy_object *) ak_signkey_destroy, \
@@ -457,6 +587,10 @@ static struct oid libakrypt_oids[] =
   {{ sizeof( struct random ), (ak_function_create_object *)ak_random_create_lcg,
                               (ak_function_destroy_object *)ak_random_destroy, NULL, NULL, NULL },
                                                                 ak_object_undefined, NULL, NULL }},
+ { random_generator, algorithm, asn1_xoshiro256_i, asn1_xoshiro256_n, NULL,
+  {{ sizeof( struct random ), (ak_function_create_object *)ak_random_create_xoshiro256,
+                              (ak_function_destroy_object *)ak_random_destroy, NULL, NULL, NULL },
+                                                                ak_object_undefined, NULL, NULL }},
 #if defined(__unix__) || defined(__APPLE__)
  { random_generator, algorithm, asn1_dev_random_i, asn1_dev_random_n, NULL,
   {{ sizeof( struct random ), (ak_function_create_object *)ak_random_create_random,
@@ -467,6 +601,16 @@ static struct oid libakrypt_oids[] =
                               (ak_function_destroy_object *)ak_random_destroy, NULL, NULL, NULL },
                                                                 ak_object_undefined, NULL, NULL }},
 #endif
+#ifdef AK_HAVE_SYSRANDOM_H
+ { random_generator, algorithm, asn1_getrandom_i, asn1_getrandom_n, NULL,
+  {{ sizeof( struct random ), (ak_function_create_object *)ak_random_create_getrandom,
+                              (ak_function_destroy_object *)ak_random_destroy, NULL, NULL, NULL },
+                                                                ak_object_undefined, NULL, NULL }},
+#endif
+ { random_generator, algorithm, asn1_drbg_i, asn1_drbg_n, NULL,
+  {{ sizeof( struct random ), (ak_function_create_object *)ak_random_create_drbg,
+                              (ak_function_destroy_object *)ak_random_destroy, NULL, NULL, NULL },
+                                                                ak_object_undefined, NULL, NULL }},
 #ifdef _WIN32
  { random_generator, algorithm,asn1_winrtl_i, asn1_winrtl_n, NULL,
   {{ sizeof( struct random ), (ak_function_create_object *)ak_random_create_winrtl,
@@ -493,12 +637,56 @@ static struct oid libakrypt_oids[] =
                             { ak_object_hmac_streebog512,
                               ak_object_undefined, (ak_function_run_object *) ak_hmac_ptr, NULL }},
 
+ { hash_function, algorithm, asn1_sha3_224_i, asn1_sha3_224_n, NULL,
+  {{ sizeof( struct hash ), ( ak_function_create_object *) ak_hash_create_sha3_224,
+                              ( ak_function_destroy_object *) ak_hash_destroy, NULL, NULL, NULL },
+                              ak_object_undefined, (ak_function_run_object *) ak_hash_ptr, NULL }},
+
+ { hash_function, algorithm, asn1_sha3_256_i, asn1_sha3_256_n, NULL,
+  {{ sizeof( struct hash ), ( ak_function_create_object *) ak_hash_create_sha3_256,
+                              ( ak_function_destroy_object *) ak_hash_destroy, NULL, NULL, NULL },
+                              ak_object_undefined, (ak_function_run_object *) ak_hash_ptr, NULL }},
+
+ { hash_function, algorithm, asn1_sha3_384_i, asn1_sha3_384_n, NULL,
+  {{ sizeof( struct hash ), ( ak_function_create_object *) ak_hash_create_sha3_384,
+                              ( ak_function_destroy_object *) ak_hash_destroy, NULL, NULL, NULL },
+                              ak_object_undefined, (ak_function_run_object *) ak_hash_ptr, NULL }},
+
+ { hash_function, algorithm, asn1_sha3_512_i, asn1_sha3_512_n, NULL,
+  {{ sizeof( struct hash ), ( ak_function_create_object *) ak_hash_create_sha3_512,
+                              ( ak_function_destroy_object *) ak_hash_destroy, NULL, NULL, NULL },
+                              ak_object_undefined, (ak_function_run_object *) ak_hash_ptr, NULL }},
+
+ { hash_function, algorithm, asn1_shake128_i, asn1_shake128_n, NULL,
+  {{ sizeof( struct hash ), ( ak_function_create_object *) ak_hash_create_shake128,
+                              ( ak_function_destroy_object *) ak_hash_destroy, NULL, NULL, NULL },
+                              ak_object_undefined, (ak_function_run_object *) ak_hash_ptr, NULL }},
+
+ { hash_function, algorithm, asn1_shake256_i, asn1_shake256_n, NULL,
+  {{ sizeof( struct hash ), ( ak_function_create_object *) ak_hash_create_shake256,
+                              ( ak_function_destroy_object *) ak_hash_destroy, NULL, NULL, NULL },
+                              ak_object_undefined, (ak_function_run_object *) ak_hash_ptr, NULL }},
+
+ { mac_function, algorithm, asn1_kmac128_i, asn1_kmac128_n, NULL,
+                            { ak_object_kmac128,
+                              ak_object_undefined, (ak_function_run_object *) ak_kmac_ptr, NULL }},
+
+ { mac_function, algorithm, asn1_kmac256_i, asn1_kmac256_n, NULL,
+                            { ak_object_kmac256,
+                              ak_object_undefined, (ak_function_run_object *) ak_kmac_ptr, NULL }},
+
  { block_cipher, algorithm, asn1_magma_i, asn1_magma_n, NULL,
                                        { ak_object_bckey_magma, ak_object_undefined, NULL, NULL }},
 
  { block_cipher, algorithm, asn1_kuznechik_i, asn1_kuznechik_n, NULL,
                                    { ak_object_bckey_kuznechik, ak_object_undefined, NULL, NULL }},
 
+ { block_cipher, algorithm, asn1_aes128_i, asn1_aes128_n, NULL,
+                                      { ak_object_bckey_aes128, ak_object_undefined, NULL, NULL }},
+
+ { block_cipher, algorithm, asn1_aes256_i, asn1_aes256_n, NULL,
+                                      { ak_object_bckey_aes256, ak_object_undefined, NULL, NULL }},
+
 /* базовые режимы блочного шифрования */
  { block_cipher, encrypt_mode, asn1_ctr_magma_i, asn1_ctr_magma_n, NULL,
   { ak_object_bckey_magma, ak_object_undefined, ( ak_function_run_object *) ak_bckey_ctr,
@@ -508,6 +696,14 @@ static struct oid libakrypt_oids[] =
   { ak_object_bckey_kuznechik, ak_object_undefined, ( ak_function_run_object *) ak_bckey_ctr,
                                                        ( ak_function_run_object *) ak_bckey_ctr }},
 
+ { block_cipher, encrypt_mode, asn1_ctr_aes128_i, asn1_ctr_aes128_n, NULL,
+  { ak_object_bckey_aes128, ak_object_undefined, ( ak_function_run_object *) ak_bckey_ctr,
+                                                       ( ak_function_run_object *) ak_bckey_ctr }},
+
+ { block_cipher, encrypt_mode, asn1_ctr_aes256_i, asn1_ctr_aes256_n, NULL,
+  { ak_object_bckey_aes256, ak_object_undefined, ( ak_function_run_object *) ak_bckey_ctr,
+                                                       ( ak_function_run_object *) ak_bckey_ctr }},
+
  { block_cipher, encrypt_mode, asn1_ofb_magma_i, asn1_ofb_magma_n, NULL,
   { ak_object_bckey_magma, ak_object_undefined, ( ak_function_run_object *) ak_bckey_ofb,
                                                        ( ak_function_run_object *) ak_bckey_ofb }},
@@ -516,6 +712,14 @@ static struct oid libakrypt_oids[] =
   { ak_object_bckey_kuznechik, ak_object_undefined, ( ak_function_run_object *) ak_bckey_ofb,
                                                        ( ak_function_run_object *) ak_bckey_ofb }},
 
+ { block_cipher, encrypt_mode, asn1_ofb_aes128_i, asn1_ofb_aes128_n, NULL,
+  { ak_object_bckey_aes128, ak_object_undefined, ( ak_function_run_object *) ak_bckey_ofb,
+                                                       ( ak_function_run_object *) ak_bckey_ofb }},
+
+ { block_cipher, encrypt_mode, asn1_ofb_aes256_i, asn1_ofb_aes256_n, NULL,
+  { ak_object_bckey_aes256, ak_object_undefined, ( ak_function_run_object *) ak_bckey_ofb,
+                                                       ( ak_function_run_object *) ak_bckey_ofb }},
+
  { block_cipher, encrypt_mode, asn1_cfb_magma_i, asn1_cfb_magma_n, NULL,
   { ak_object_bckey_magma, ak_object_undefined, ( ak_function_run_object *) ak_bckey_encrypt_cfb,
                                                ( ak_function_run_object *) ak_bckey_decrypt_cfb }},
@@ -525,6 +729,16 @@ static struct oid libakrypt_oids[] =
                                                 ( ak_function_run_object *) ak_bckey_encrypt_cfb,
                                                ( ak_function_run_object *) ak_bckey_decrypt_cfb }},
 
+ { block_cipher, encrypt_mode, asn1_cfb_aes128_i, asn1_cfb_aes128_n, NULL,
+  { ak_object_bckey_aes128, ak_object_undefined,
+                                                ( ak_function_run_object *) ak_bckey_encrypt_cfb,
+                                               ( ak_function_run_object *) ak_bckey_decrypt_cfb }},
+
+ { block_cipher, encrypt_mode, asn1_cfb_aes256_i, asn1_cfb_aes256_n, NULL,
+  { ak_object_bckey_aes256, ak_object_undefined,
+                                                ( ak_function_run_object *) ak_bckey_encrypt_cfb,
+                                               ( ak_function_run_object *) ak_bckey_decrypt_cfb }},
+
  { block_cipher, encrypt_mode, asn1_cbc_magma_i, asn1_cbc_magma_n, NULL,
   { ak_object_bckey_magma, ak_object_undefined, ( ak_function_run_object *) ak_bckey_encrypt_cbc,
                                                ( ak_function_run_object *) ak_bckey_decrypt_cbc }},
@@ -534,6 +748,16 @@ static struct oid libakrypt_oids[] =
                                                 ( ak_function_run_object *) ak_bckey_encrypt_cbc,
                                                ( ak_function_run_object *) ak_bckey_decrypt_cbc }},
 
+ { block_cipher, encrypt_mode, asn1_cbc_aes128_i, asn1_cbc_aes128_n, NULL,
+  { ak_object_bckey_aes128, ak_object_undefined,
+                                                ( ak_function_run_object *) ak_bckey_encrypt_cbc,
+                                               ( ak_function_run_object *) ak_bckey_decrypt_cbc }},
+
+ { block_cipher, encrypt_mode, asn1_cbc_aes256_i, asn1_cbc_aes256_n, NULL,
+  { ak_object_bckey_aes256, ak_object_undefined,
+                                                ( ak_function_run_object *) ak_bckey_encrypt_cbc,
+                                               ( ak_function_run_object *) ak_bckey_decrypt_cbc }},
+
  { block_cipher, encrypt2k_mode, asn1_xts_magma_i, asn1_xts_magma_n, NULL,
   { ak_object_bckey_magma, ak_object_bckey_magma,
                                                 ( ak_function_run_object *) ak_bckey_encrypt_xts,
@@ -544,6 +768,16 @@ static struct oid libakrypt_oids[] =
                                                  ( ak_function_run_object *) ak_bckey_encrypt_xts,
                                                ( ak_function_run_object *) ak_bckey_decrypt_xts }},
 
+ { block_cipher, encrypt2k_mode, asn1_xts_aes128_i, asn1_xts_aes128_n, NULL,
+  { ak_object_bckey_aes128, ak_object_bckey_aes128,
+                                                 ( ak_function_run_object *) ak_bckey_encrypt_xts,
+                                               ( ak_function_run_object *) ak_bckey_decrypt_xts }},
+
+ { block_cipher, encrypt2k_mode, asn1_xts_aes256_i, asn1_xts_aes256_n, NULL,
+  { ak_object_bckey_aes256, ak_object_bckey_aes256,
+                                                 ( ak_function_run_object *) ak_bckey_encrypt_xts,
+                                               ( ak_function_run_object *) ak_bckey_decrypt_xts }},
+
  { block_cipher, acpkm, asn1_acpkm_magma_i, asn1_acpkm_magma_n, NULL,
   { ak_object_bckey_magma, ak_object_undefined, ( ak_function_run_object *) ak_bckey_ctr_acpkm,
                                                  ( ak_function_run_object *) ak_bckey_ctr_acpkm }},
@@ -560,6 +794,14 @@ static struct oid libakrypt_oids[] =
   { ak_object_bckey_kuznechik, ak_object_undefined,
                                                 ( ak_function_run_object *) ak_bckey_cmac, NULL }},
 
+ { block_cipher, mac, asn1_cmac_aes128_i, asn1_cmac_aes128_n, NULL,
+  { ak_object_bckey_aes128, ak_object_undefined,
+                                                ( ak_function_run_object *) ak_bckey_cmac, NULL }},
+
+ { block_cipher, mac, asn1_cmac_aes256_i, asn1_cmac_aes256_n, NULL,
+  { ak_object_bckey_aes256, ak_object_undefined,
+                                                ( ak_function_run_object *) ak_bckey_cmac, NULL }},
+
 /* расширенные режимы блочного шифрования */
  { block_cipher, aead, asn1_mgm_magma_i, asn1_mgm_magma_n, NULL,
   { ak_object_bckey_magma, ak_object_bckey_magma,
@@ -613,6 +855,41 @@ static struct oid libakrypt_oids[] =
                                             ( ak_function_run_object *) ak_bckey_encrypt_xtsmac,
                                             ( ak_function_run_object *) ak_bckey_decrypt_xtsmac }},
 
+ { block_cipher, aead, asn1_ocb_magma_i, asn1_ocb_magma_n, NULL,
+  { ak_object_bckey_magma, ak_object_bckey_magma,
+                                               ( ak_function_run_object *) ak_bckey_encrypt_ocb,
+                                               ( ak_function_run_object *) ak_bckey_decrypt_ocb }},
+
+ { block_cipher, aead, asn1_ocb_kuznechik_i, asn1_ocb_kuznechik_n, NULL,
+  { ak_object_bckey_kuznechik, ak_object_bckey_kuznechik,
+                                               ( ak_function_run_object *) ak_bckey_encrypt_ocb,
+                                               ( ak_function_run_object *) ak_bckey_decrypt_ocb }},
+
+ { block_cipher, aead, asn1_ocb_aes128_i, asn1_ocb_aes128_n, NULL,
+  { ak_object_bckey_aes128, ak_object_bckey_aes128,
+                                               ( ak_function_run_object *) ak_bckey_encrypt_ocb,
+                                               ( ak_function_run_object *) ak_bckey_decrypt_ocb }},
+
+ { block_cipher, aead, asn1_ocb_aes256_i, asn1_ocb_aes256_n, NULL,
+  { ak_object_bckey_aes256, ak_object_bckey_aes256,
+                                               ( ak_function_run_object *) ak_bckey_encrypt_ocb,
+                                               ( ak_function_run_object *) ak_bckey_decrypt_ocb }},
+
+ { block_cipher, aead, asn1_gcm_kuznechik_i, asn1_gcm_kuznechik_n, NULL,
+  { ak_object_bckey_kuznechik, ak_object_bckey_kuznechik,
+                                               ( ak_function_run_object *) ak_bckey_encrypt_gcm,
+                                               ( ak_function_run_object *) ak_bckey_decrypt_gcm }},
+
+ { block_cipher, aead, asn1_gcm_aes128_i, asn1_gcm_aes128_n, NULL,
+  { ak_object_bckey_aes128, ak_object_bckey_aes128,
+                                               ( ak_function_run_object *) ak_bckey_encrypt_gcm,
+                                               ( ak_function_run_object *) ak_bckey_decrypt_gcm }},
+
+ { block_cipher, aead, asn1_gcm_aes256_i, asn1_gcm_aes256_n, NULL,
+  { ak_object_bckey_aes256, ak_object_bckey_aes256,
+                                               ( ak_function_run_object *) ak_bckey_encrypt_gcm,
+                                               ( ak_function_run_object *) ak_bckey_decrypt_gcm }},
+
  { sign_function, algorithm, asn1_sign256_i, asn1_sign256_n, NULL,
   { ak_object_signkey256, ak_object_undefined,
                                           ( ak_function_run_object *) ak_signkey_sign_ptr, NULL }},
@@ -35,6 +35,7 @@
      { "context_manager_max_size", 4096, 4096, 2147483648 },
      { "pbkdf2_iteration_count", 2000, 1000, 65536 },
      { "hmac_key_count_resource", 65536, 1024, 2147483648 },
+     { "kmac_key_count_resource", 65536, 1024, 2147483648 },
      { "digital_signature_count_resource", 65536, 1024, 2147483648 },
 
   /* значение константы задает максимальный объем зашифрованной информации на одном ключе в 4 Mб:
@@ -47,11 +48,23 @@
      { "acpkm_message_count", 4096, 128, 65536 },
      { "acpkm_section_magma_block_count", 128, 128, 16777216 },
      { "acpkm_section_kuznechik_block_count", 512, 512, 16777216 },
+  /* количество потоков, используемых для шифрования секторов в режиме xts
+                                                   (используется при наличии поддержки потоков)   */
+     { "xts_sector_threads", 1, 1, 64 },
+  /* количество потоков, используемых для шифрования в режиме ctr-acpkm
+                                                   (используется при наличии поддержки потоков)   */
+     { "acpkm_threads", 1, 1, 64 },
+  /* количество потоков, используемых для расшифрования в режимах cbc и cfb
+                                                   (используется при наличии поддержки потоков)   */
+     { "chain_decrypt_threads", 1, 1, 64 },
 
   /* при значении равным единицы, формат шифрования данных соответствует варианту OpenSSL */
      { "openssl_compability", 0, 0, 1 },
   /* флаг использования цвета при выводе сообщений библиотеки */
      { "use_color_output", 1, 0, 1 },
+  /* генератор масок секретных ключей: 0 - линейный конгруэнтный генератор (lcg),
+                                       1 - генератор xoshiro256**, вырабатывающий 8 байт за шаг   */
+     { "skey_mask_generator", 1, 0, 1 },
      { NULL, 0, 0, 0 } /* завершающая константа, должна всегда принимать нулевые значения */
  };
 
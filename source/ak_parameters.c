@@ -4,7 +4,7 @@
 /*  Файл ak_parameters.с                                                                           */
 /*  - содержит значения фиксированных параметров криптографических алгоритмов                      */
 /* ----------------------------------------------------------------------------------------------- */
- #include <libakrypt.h>
+ #include <libakrypt-internal.h>
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Параметры 256-ти битной эллиптической кривой из тестового примера ГОСТ Р 34.10-2012 (Приложение А.1). */
@@ -315,6 +315,41 @@
   "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffdc7"
  };
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Параметры искривленных кривых Эдвардса, эквивалентных кривым в форме Вейерштрасса.
+
+    Для кривых из рекомендаций Р 50.1.114-2016, заданных в форме Вейерштрасса, приводятся
+    параметры эквивалентной искривленной кривой Эдвардса \f$ eu^2 + v^2 = 1 + du^2v^2 \f$
+    с \f$ e = 1\f$, а также константы \f$ s = (e-d)/4 \f$ и \f$ t = (e+d)/6 \f$,
+    используемые для перехода между формами кривой.
+    \code
+      paramSetA (256 бит):
+       d = "0605F6B7C183FA81578BC39CFAD518132B9DF62897009AF7E522C32D6DC7BFFB",
+       s = "7E7E82520F9F015FAA1D0F18C14AB9FB35188275DA3FD94206B74F34A48E0ECD",
+       t = "0100FE73F595FF158E974B44D478D9588744FE5C192AC47EA63075DCE7A14AAA",
+      paramSetC (512 бит):
+       d = "9E4F5D8C017D8D9F13A5CF3CDF5BFE4DAB402D54198E31EBDE28A0621050439CA6B39E0A515C06B304E2CE43E79E369E91A0CFC2BC2A22B4CA302DBB33EE7550",
+       s = "186C289CFFA09C983B168C30C829006C952FF4AAF99C73850875D7E77BEBEF18D653187D6BA8FE533EC74C6F061872585B97CC0F50F57752CD73F4913304621E",
+       t = "9A628F975594ECEFD89BA28A2539FFB79C8AB238AEED0851FA5C1ABB02B80B44C6734501B83A011DD625CD0B5145091A6D9ACD4B1F5C5B1E21B2B249DDFD1271"
+    \endcode                                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ const struct wcurve_edwards ak_wcurve_edwards_params[] = {
+ { &id_tc26_gost_3410_2012_256_paramSetA,
+  { 0xe522c32d6dc7bffbLL, 0x2b9df62897009af7LL, 0x578bc39cfad51813LL, 0x0605f6b7c183fa81LL }, /* d */
+  { 0x06b74f34a48e0ecdLL, 0x35188275da3fd942LL, 0xaa1d0f18c14ab9fbLL, 0x7e7e82520f9f015fLL }, /* s */
+  { 0xa63075dce7a14aaaLL, 0x8744fe5c192ac47eLL, 0x8e974b44d478d958LL, 0x0100fe73f595ff15LL }  /* t */
+ },
+ { &id_tc26_gost_3410_2012_512_paramSetC,
+  { 0xca302dbb33ee7550LL, 0x91a0cfc2bc2a22b4LL, 0x04e2ce43e79e369eLL, 0xa6b39e0a515c06b3LL,
+    0xde28a0621050439cLL, 0xab402d54198e31ebLL, 0x13a5cf3cdf5bfe4dLL, 0x9e4f5d8c017d8d9fLL }, /* d */
+  { 0xcd73f4913304621eLL, 0x5b97cc0f50f57752LL, 0x3ec74c6f06187258LL, 0xd653187d6ba8fe53LL,
+    0x0875d7e77bebef18LL, 0x952ff4aaf99c7385LL, 0x3b168c30c829006cLL, 0x186c289cffa09c98LL }, /* s */
+  { 0x21b2b249ddfd1271LL, 0x6d9acd4b1f5c5b1eLL, 0xd625cd0b5145091aLL, 0xc6734501b83a011dLL,
+    0xfa5c1abb02b80b44LL, 0x9c8ab238aeed0851LL, 0xd89ba28a2539ffb7LL, 0x9a628f975594ecefLL }  /* t */
+ },
+ { NULL, { 0 }, { 0 }, { 0 } }
+};
+
 /* ----------------------------------------------------------------------------------------------- */
 /*                                                                                ak_parameters.c  */
 /* ----------------------------------------------------------------------------------------------- */
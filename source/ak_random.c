@@ -4,7 +4,7 @@
 /*  Файл ak_random.с                                                                               */
 /*  - содержит реализацию генераторов псевдо-случайных чисел                                       */
 /* ----------------------------------------------------------------------------------------------- */
- #include <libakrypt.h>
+ #include <libakrypt-internal.h>
 
 /* ----------------------------------------------------------------------------------------------- */
 #ifdef AK_HAVE_TIME_H
@@ -16,6 +16,12 @@
 #ifdef AK_HAVE_FCNTL_H
  #include <fcntl.h>
 #endif
+#ifdef AK_HAVE_ERRNO_H
+ #include <errno.h>
+#endif
+#ifdef AK_HAVE_SYSRANDOM_H
+ #include <sys/random.h>
+#endif
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Инициализация генератора псевдо-случайных чисел.
@@ -283,6 +289,147 @@
  return error;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*                                 реализация класса rng_xoshiro256                                */
+/* ----------------------------------------------------------------------------------------------- */
+ #define ak_random_rotl64( x, k ) ((( x ) << ( k )) | (( x ) >> ( 64 - ( k ))))
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вырабатывает следующее значение генератора xoshiro256** и
+    изменяет его внутреннее состояние. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline ak_uint64 ak_random_xoshiro256_step( ak_uint64 *s )
+{
+  const ak_uint64 result = ak_random_rotl64( s[1]*5, 7 )*9, t = s[1] << 17;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = ak_random_rotl64( s[3], 45 );
+
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_xoshiro256_next( ak_random rnd )
+{
+  if( rnd == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                      "use a null pointer to a random generator" );
+  ak_random_xoshiro256_step( rnd->data.xs );
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вырабатывает внутреннее состояние генератора xoshiro256** из
+    произвольного массива данных с помощью генератора splitmix64.                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_xoshiro256_randomize_ptr( ak_random rnd,
+                                                       const ak_pointer ptr, const ssize_t size )
+{
+  int i = 0;
+  ssize_t idx = 0;
+  ak_uint64 z, seed = 0x9e3779b97f4a7c15ULL;
+  const ak_uint8 *value = ptr;
+
+  if( rnd == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                      "use a null pointer to a random generator" );
+  if( ptr == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                          "use a null pointer to initial vector" );
+  if( size <= 0 ) return ak_error_message( ak_error_wrong_length, __func__ ,
+                                                          "use initial vector with wrong length" );
+ /* сжимаем начальное значение в одно 64-х битное слово */
+  for( idx = 0; idx < size; idx++ ) {
+     seed = ( seed ^ value[idx] )*0x100000001b3ULL;
+     seed ^= seed >> 29;
+  }
+ /* вырабатываем четыре слова состояния (состояние не может быть нулевым) */
+  for( i = 0; i < 4; i++ ) {
+     z = ( seed += 0x9e3779b97f4a7c15ULL );
+     z = ( z ^ ( z >> 30 ))*0xbf58476d1ce4e5b9ULL;
+     z = ( z ^ ( z >> 27 ))*0x94d049bb133111ebULL;
+     rnd->data.xs[i] = z ^ ( z >> 31 );
+  }
+  if(( rnd->data.xs[0] | rnd->data.xs[1] | rnd->data.xs[2] | rnd->data.xs[3] ) == 0 )
+    rnd->data.xs[0] = 1;
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_xoshiro256_random( ak_random rnd, const ak_pointer ptr, const ssize_t size )
+{
+  ak_uint64 word, s[4];
+  ak_uint8 *value = ptr;
+  size_t count = ( size_t ) size;
+
+  if( rnd == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                      "use a null pointer to a random generator" );
+  if( ptr == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                                    "use a null pointer to data" );
+  if( size <= 0 ) return ak_error_message( ak_error_wrong_length, __func__ ,
+                                                           "use a data vector with wrong length" );
+ /* состояние копируется в локальные переменные, что позволяет компилятору
+    держать его в регистрах на протяжении всего цикла */
+  memcpy( s, rnd->data.xs, sizeof( s ));
+  while( count >= 32 ) {
+     ak_uint64 w[4];
+     w[0] = ak_random_xoshiro256_step( s );
+     w[1] = ak_random_xoshiro256_step( s );
+     w[2] = ak_random_xoshiro256_step( s );
+     w[3] = ak_random_xoshiro256_step( s );
+     memcpy( value, w, sizeof( w ));
+     value += 32; count -= 32;
+  }
+  while( count >= 8 ) {
+     word = ak_random_xoshiro256_step( s );
+     memcpy( value, &word, 8 );
+     value += 8; count -= 8;
+  }
+  if( count ) {
+    word = ak_random_xoshiro256_step( s );
+    memcpy( value, &word, count );
+  }
+  memcpy( rnd->data.xs, s, sizeof( s ));
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Генератор xoshiro256** (D. Blackman, S. Vigna) имеет 256-ти битное внутреннее состояние
+    и за один шаг вырабатывает 64-х битное слово выходной последовательности, используя только
+    операции сдвига, сложения по модулю 2 и два умножения. По сравнению с линейным конгруэнтным
+    генератором, вырабатывающим один байт за шаг, генератор позволяет в восемь раз сократить
+    количество последовательно выполняемых умножений.
+
+    Генератор не является криптографически стойким и предназначен для выработки масок
+    секретных ключей (см. опцию библиотеки `skey_mask_generator`), а также для задач
+    тестирования. Начальное состояние генератора вырабатывается из значения, возвращаемого
+    функцией ak_random_value(), с помощью генератора splitmix64.
+
+    @param generator Контекст создаваемого генератора.
+    \return В случае успеха, функция возвращает \ref ak_error_ok. В противном случае
+            возвращается код ошибки.                                                               */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_random_create_xoshiro256( ak_random generator )
+{
+  int error = ak_error_ok;
+  ak_uint64 qword = ak_random_value(); /* вырабатываем случайное число */
+
+  if(( error = ak_random_create( generator )) != ak_error_ok )
+    return ak_error_message( error, __func__ , "wrong initialization of random generator" );
+
+  generator->oid = ak_oid_find_by_name("xoshiro256");
+  generator->next = ak_random_xoshiro256_next;
+  generator->randomize_ptr = ak_random_xoshiro256_randomize_ptr;
+  generator->random = ak_random_xoshiro256_random;
+
+ /* для корректной работы присваиваем какое-то случайное начальное значение */
+  ak_random_xoshiro256_randomize_ptr( generator, &qword, sizeof( ak_uint64 ));
+ return error;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*                                 реализация класса rng_file                                      */
 /* ----------------------------------------------------------------------------------------------- */
@@ -396,6 +543,759 @@
 }
 #endif
 
+#ifdef AK_HAVE_SYSRANDOM_H
+/* ----------------------------------------------------------------------------------------------- */
+/*                                 реализация класса rng_getrandom                                 */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Размер буфера генератора, основанного на системном вызове getrandom() (в октетах). */
+ #define ak_random_getrandom_buffer_size    (4096)
+
+/*! \brief Внутреннее состояние генератора, основанного на системном вызове getrandom(). */
+ struct random_getrandom {
+  /*! \brief Буфер, содержащий полученные от ОС случайные данные */
+   ak_uint8 buffer[ak_random_getrandom_buffer_size];
+  /*! \brief Количество еще не использованных октетов, расположенных в конце буфера */
+   size_t count;
+  /*! \brief Идентификатор процесса, заполнившего буфер; нулевое значение означает,
+      что буфер должен быть заполнен заново (в том числе после очистки памяти при вызове fork()) */
+   pid_t pid;
+  /*! \brief Флаг того, что ОС обнуляет память контекста в дочернем процессе (MADV_WIPEONFORK) */
+   bool_t wipeonfork;
+ };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Получение от ОС заданного количества случайных октетов. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_getrandom_read( ak_uint8 *ptr, size_t size )
+{
+  ssize_t result = 0;
+
+  while( size > 0 ) {
+    if(( result = getrandom( ptr, size, 0 )) < 0 ) {
+      if( errno == EINTR ) continue;
+      return ak_error_message_fmt( ak_error_read_data, __func__ ,
+                                 "wrong reading data from getrandom() call (%s)", strerror( errno ));
+    }
+    ptr += result;
+    size -= ( size_t )result;
+  }
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Заполнение буфера генератора новыми случайными данными. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_getrandom_refill( struct random_getrandom *ctx )
+{
+  int error = ak_error_ok;
+
+ /* при первом заполнении, а также после обнуления памяти в дочернем процессе,
+    заново определяем, поддерживает ли ОС обнуление памяти при вызове fork() */
+  if( ctx->pid == 0 ) {
+   #if defined( AK_HAVE_SYSMMAN_H ) && defined( MADV_WIPEONFORK )
+    ctx->wipeonfork = ( madvise( ctx, sizeof( struct random_getrandom ),
+                                                      MADV_WIPEONFORK ) == 0 ) ? ak_true : ak_false;
+   #else
+    ctx->wipeonfork = ak_false;
+   #endif
+  }
+  if(( error = ak_random_getrandom_read( ctx->buffer, sizeof( ctx->buffer ))) != ak_error_ok ) {
+    ctx->count = 0;
+    return ak_error_message( error, __func__ , "incorrect refilling of random buffer" );
+  }
+  ctx->count = sizeof( ctx->buffer );
+  ctx->pid = getpid();
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_getrandom_random( ak_random rnd, const ak_pointer ptr, const ssize_t size )
+{
+  size_t len = 0, offset = 0;
+  int error = ak_error_ok;
+  ak_uint8 *out = ptr;
+  struct random_getrandom *ctx = NULL;
+
+  if( rnd == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                      "use a null pointer to a random generator" );
+  if( ptr == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                                    "use a null pointer to data" );
+  if( size <= 0 ) return ak_error_message( ak_error_wrong_length, __func__ ,
+                                                           "use a data vector with wrong length" );
+  if(( ctx = ( struct random_getrandom * ) rnd->data.ctx ) == NULL )
+    return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                  "using uninitialized random generator context" );
+
+ /* после вызова fork() дочерний процесс не должен использовать содержимое буфера родителя;
+    если ОС не обнуляет память, то проверяем идентификатор процесса */
+  if(( ctx->pid == 0 ) || ( !ctx->wipeonfork && ( ctx->pid != getpid( )))) {
+    ctx->pid = 0;
+    if(( error = ak_random_getrandom_refill( ctx )) != ak_error_ok ) return error;
+  }
+
+  while( offset < ( size_t )size ) {
+   /* большие объемы данных запрашиваем у ОС непосредственно */
+    if(( ctx->count == 0 ) && (( size_t )size - offset >= sizeof( ctx->buffer )))
+      return ak_random_getrandom_read( out + offset, ( size_t )size - offset );
+
+    if( ctx->count == 0 )
+      if(( error = ak_random_getrandom_refill( ctx )) != ak_error_ok ) return error;
+
+   /* выданные данные сразу удаляются из буфера */
+    len = ak_min( ctx->count, ( size_t )size - offset );
+    memcpy( out + offset, ctx->buffer + sizeof( ctx->buffer ) - ctx->count, len );
+    memset( ctx->buffer + sizeof( ctx->buffer ) - ctx->count, 0, len );
+    ctx->count -= len;
+    offset += len;
+  }
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_getrandom_free( ak_random rnd )
+{
+  if( rnd == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                     "use a null pointer to a random generator" );
+  if( rnd->data.ctx == NULL ) return ak_error_ok;
+  memset( rnd->data.ctx, 0, sizeof( struct random_getrandom ));
+ #ifdef AK_HAVE_SYSMMAN_H
+  munmap( rnd->data.ctx, sizeof( struct random_getrandom ));
+ #else
+  free( rnd->data.ctx );
+ #endif
+  rnd->data.ctx = NULL;
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Генератор получает случайные данные от ядра ОС с помощью системного вызова getrandom()
+    и хранит их в собственном буфере размером 4 Кб, так что небольшие запросы
+    (например, при маскировании ключей или очистке памяти) не приводят к системным вызовам.
+    Выданные генератором данные сразу удаляются из буфера.
+
+    Для того, чтобы родительский и дочерний процессы не выдавали одинаковых значений,
+    буфер размещается в отдельной области памяти, для которой ОС обнуляет содержимое
+    при вызове fork() (флаг MADV_WIPEONFORK). Если данная возможность не поддерживается,
+    то при каждом обращении к генератору проверяется идентификатор текущего процесса.
+
+    @param generator Контекст создаваемого генератора.
+    \return В случае успеха, функция возвращает \ref ak_error_ok. В противном случае
+            возвращается код ошибки.                                                               */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_random_create_getrandom( ak_random generator )
+{
+  int error = ak_error_ok;
+  struct random_getrandom *ctx = NULL;
+
+  if(( error = ak_random_create( generator )) != ak_error_ok )
+    return ak_error_message( error, __func__ , "wrong initialization of random generator" );
+
+ #ifdef AK_HAVE_SYSMMAN_H
+  if(( ctx = mmap( NULL, sizeof( struct random_getrandom ), PROT_READ | PROT_WRITE,
+                                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 )) == MAP_FAILED )
+    ctx = NULL;
+ #else
+  ctx = malloc( sizeof( struct random_getrandom ));
+ #endif
+  if( ctx == NULL ) return ak_error_message( ak_error_out_of_memory, __func__ ,
+                                                       "incorrect memory allocation for buffer" );
+  memset( ctx, 0, sizeof( struct random_getrandom ));
+  generator->data.ctx = ctx;
+  generator->oid = ak_oid_find_by_name( "getrandom" );
+  generator->next = NULL;
+  generator->randomize_ptr = NULL;
+  generator->random = ak_random_getrandom_random;
+  generator->free = ak_random_getrandom_free;
+
+  if(( error = ak_random_getrandom_refill( ctx )) != ak_error_ok ) {
+    ak_random_destroy( generator );
+    return ak_error_message( error, __func__ , "incorrect initial filling of random buffer" );
+  }
+
+ return error;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                                 реализация класса rng_drbg                                      */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Длина начального заполнения генератора drbg (длина ключа и блока Кузнечика, в октетах). */
+ #define ak_drbg_seed_size              (48)
+/*! \brief Максимальное количество обновлений буфера генератора drbg до автоматического
+    обновления его внутреннего состояния с использованием источника энтропии ОС. */
+ #define ak_drbg_reseed_interval        (65536)
+/*! \brief Размер буфера выходных данных генератора drbg (в октетах).
+    \details Выработанные, но еще не выданные данные хранятся в открытом виде и являются
+    будущими выходами генератора (например, одноразовыми ключами электронной подписи),
+    поэтому размер буфера ограничен четырьмя блоками; запросы такого или большего объема
+    выполняются непосредственно в память пользователя. */
+ #define ak_drbg_buffer_size            (64)
+
+/*! \brief Внутреннее состояние генератора drbg. */
+ struct random_drbg {
+  /*! \brief Ключ алгоритма блочного шифрования Кузнечик (часть внутреннего состояния) */
+   struct bckey key;
+  /*! \brief Счетчик (часть внутреннего состояния) */
+   ak_uint8 v[16];
+  /*! \brief Количество запросов к генератору с момента последнего обновления состояния */
+   ak_uint64 reseed_counter;
+  /*! \brief Буфер, содержащий выработанные, но еще не выданные данные */
+   ak_uint8 buffer[ak_drbg_buffer_size];
+  /*! \brief Количество еще не использованных октетов, расположенных в конце буфера */
+   size_t count;
+ #ifdef AK_HAVE_UNISTD_H
+  /*! \brief Идентификатор процесса, использующего генератор */
+   pid_t pid;
+ #endif
+ #ifndef AK_HAVE_SYSRANDOM_H
+  /*! \brief Источник энтропии ОС, создаваемый один раз вместе с генератором */
+   struct random entropy;
+ #endif
+ };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Получение начального заполнения от источника энтропии ОС.
+    \details При наличии системного вызова getrandom() данные запрашиваются у ОС непосредственно,
+    без промежуточной буфферизации; в противном случае используется источник энтропии,
+    созданный вместе с генератором функцией ak_random_create_drbg().                              */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_drbg_get_entropy( struct random_drbg *dctx, ak_uint8 *ptr,
+                                                                               const size_t size )
+{
+ #if defined( AK_HAVE_SYSRANDOM_H )
+  (void) dctx;
+ return ak_random_getrandom_read( ptr, size );
+ #else
+ return ak_random_ptr( &dctx->entropy, ptr, ( ssize_t )size );
+ #endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Увеличение на единицу 128-ми битного счетчика, записанного в порядке big endian. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_random_drbg_increment( ak_uint8 *v )
+{
+  int i = 15;
+  while(( i >= 0 ) && ( ++v[i] == 0 )) i--;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция выработки производной последовательности (Block_Cipher_df).
+    \details Функция преобразует конкатенацию трех массивов произвольной длины в
+    последовательность из \ref ak_drbg_seed_size октетов. В качестве функции сжатия (BCC)
+    используется блочный шифр Кузнечик в режиме выработки имитовставки CBC-MAC.                    */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_drbg_df( ak_uint8 *out, const ak_uint8 *in1, const size_t size1,
+               const ak_uint8 *in2, const size_t size2, const ak_uint8 *in3, const size_t size3 )
+{
+  struct bckey key;
+  int error = ak_error_ok;
+  ak_uint32 i = 0, len = ( ak_uint32 )( size1 + size2 + size3 );
+  size_t j = 0, k = 0, pos = 0;
+  ak_uint8 temp[ak_drbg_seed_size], chain[16], header[8], x[16];
+  const ak_uint8 *parts[3] = { in1, in2, in3 };
+  const size_t sizes[3] = { size1, size2, size3 };
+
+  if(( error = ak_bckey_create_kuznechik( &key )) != ak_error_ok )
+    return ak_error_message( error, __func__ , "incorrect creation of block cipher key" );
+  for( j = 0; j < 32; j++ ) temp[j] = ( ak_uint8 )j;
+  if(( error = ak_bckey_set_key( &key, temp, 32 )) != ak_error_ok ) {
+    ak_error_message( error, __func__ , "incorrect assigning of block cipher key" );
+    goto lab_exit;
+  }
+
+ /* S = L || N || input || 0x80 || 0x00 ... 0x00 */
+  header[0] = ( ak_uint8 )( len >> 24 ); header[1] = ( ak_uint8 )( len >> 16 );
+  header[2] = ( ak_uint8 )( len >> 8 );  header[3] = ( ak_uint8 )len;
+  header[4] = 0; header[5] = 0; header[6] = 0; header[7] = ak_drbg_seed_size;
+
+  for( i = 0; i < 3; i++ ) {
+    /* BCC( K, IV || S ), где IV = i || 0 ... 0 */
+     memset( chain, 0, sizeof( chain ));
+     chain[3] = ( ak_uint8 )i;
+     key.encrypt( &key.key, chain, chain );
+     pos = 0;
+     for( j = 0; j < sizeof( header ); j++ ) chain[pos++] ^= header[j];
+     for( k = 0; k < 3; k++ )
+        for( j = 0; j < sizes[k]; j++ ) {
+           chain[pos++] ^= parts[k][j];
+           if( pos == 16 ) { key.encrypt( &key.key, chain, chain ); pos = 0; }
+        }
+     chain[pos++] ^= 0x80;
+     key.encrypt( &key.key, chain, chain );
+     memcpy( temp + 16*i, chain, 16 );
+  }
+
+ /* вырабатываем результат на новом ключе */
+  if(( error = ak_bckey_set_key( &key, temp, 32 )) != ak_error_ok ) {
+    ak_error_message( error, __func__ , "incorrect assigning of block cipher key" );
+    goto lab_exit;
+  }
+  memcpy( x, temp + 32, 16 );
+  for( i = 0; i < 3; i++ ) {
+     key.encrypt( &key.key, x, x );
+     memcpy( out + 16*i, x, 16 );
+  }
+
+ lab_exit:
+  memset( temp, 0, sizeof( temp ));
+  memset( chain, 0, sizeof( chain ));
+  memset( x, 0, sizeof( x ));
+  ak_bckey_destroy( &key );
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Изменение внутреннего состояния генератора с использованием
+    \ref ak_drbg_seed_size октетов дополнительных данных (update). */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_drbg_update( struct random_drbg *dctx, const ak_uint8 *provided )
+{
+  size_t i = 0;
+  int error = ak_error_ok;
+  ak_uint8 temp[ak_drbg_seed_size];
+
+  for( i = 0; i < ak_drbg_seed_size; i += 16 ) {
+     ak_random_drbg_increment( dctx->v );
+     dctx->key.encrypt( &dctx->key.key, dctx->v, temp + i );
+  }
+  if( provided != NULL ) for( i = 0; i < ak_drbg_seed_size; i++ ) temp[i] ^= provided[i];
+ /* ключ заменяется без перераспределения памяти и обращения к опциям библиотеки */
+  if(( error = ak_bckey_replace_key( &dctx->key, temp )) != ak_error_ok )
+    ak_error_message( error, __func__ , "incorrect assigning of block cipher key" );
+  memcpy( dctx->v, temp + 32, 16 );
+  memset( temp, 0, sizeof( temp ));
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Создание внутреннего состояния генератора (instantiate). */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_drbg_instantiate( struct random_drbg *dctx, const ak_uint8 *entropy,
+      const size_t esize, const ak_uint8 *nonce, const size_t nsize, const ak_uint8 *personal,
+                                                                              const size_t psize )
+{
+  int error = ak_error_ok;
+  ak_uint8 seed[ak_drbg_seed_size], zero[32];
+
+  memset( zero, 0, sizeof( zero ));
+  if(( error = ak_random_drbg_df( seed, entropy, esize,
+                                              nonce, nsize, personal, psize )) == ak_error_ok ) {
+    memset( dctx->v, 0, sizeof( dctx->v ));
+    memset( dctx->buffer, 0, sizeof( dctx->buffer ));
+    dctx->count = 0;
+    if(( error = ak_bckey_set_key( &dctx->key, zero, sizeof( zero ))) == ak_error_ok )
+      error = ak_random_drbg_update( dctx, seed );
+  }
+  dctx->reseed_counter = 1;
+ #ifdef AK_HAVE_UNISTD_H
+  dctx->pid = getpid();
+ #endif
+  memset( seed, 0, sizeof( seed ));
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Обновление внутреннего состояния генератора (reseed). */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_drbg_reseed_internal( struct random_drbg *dctx, const ak_uint8 *entropy,
+                             const size_t esize, const ak_uint8 *additional, const size_t asize )
+{
+  int error = ak_error_ok;
+  ak_uint8 seed[ak_drbg_seed_size];
+
+ /* невыданные ранее данные не должны зависеть от нового состояния */
+  memset( dctx->buffer, 0, sizeof( dctx->buffer ));
+  dctx->count = 0;
+  if(( error = ak_random_drbg_df( seed, entropy, esize,
+                                                  additional, asize, NULL, 0 )) == ak_error_ok )
+    error = ak_random_drbg_update( dctx, seed );
+  dctx->reseed_counter = 1;
+  memset( seed, 0, sizeof( seed ));
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Выработка последовательности заданной длины (generate). */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_drbg_generate( struct random_drbg *dctx, ak_uint8 *out, size_t size,
+                                                  const ak_uint8 *additional, const size_t asize )
+{
+  int error = ak_error_ok;
+  ak_uint8 add[ak_drbg_seed_size], block[16], entropy[64];
+
+ /* по исчерпании ресурса автоматически обновляем состояние с помощью источника энтропии ОС */
+  if( dctx->reseed_counter > ak_drbg_reseed_interval ) {
+    if(( error = ak_random_drbg_get_entropy( dctx, entropy, sizeof( entropy ))) != ak_error_ok )
+      return ak_error_message( error, __func__, "incorrect reading of system entropy" );
+    error = ak_random_drbg_reseed_internal( dctx, entropy, sizeof( entropy ), NULL, 0 );
+    memset( entropy, 0, sizeof( entropy ));
+    if( error != ak_error_ok ) return error;
+  }
+
+ /* учитываем дополнительные данные */
+  memset( add, 0, sizeof( add ));
+  if( asize ) {
+    if(( error = ak_random_drbg_df( add, additional, asize, NULL, 0, NULL, 0 )) != ak_error_ok )
+      return error;
+    if(( error = ak_random_drbg_update( dctx, add )) != ak_error_ok ) return error;
+  }
+
+ /* вырабатываем выходную последовательность в режиме гаммирования */
+  while( size >= 16 ) {
+    ak_random_drbg_increment( dctx->v );
+    dctx->key.encrypt( &dctx->key.key, dctx->v, out );
+    out += 16; size -= 16;
+  }
+  if( size ) {
+    ak_random_drbg_increment( dctx->v );
+    dctx->key.encrypt( &dctx->key.key, dctx->v, block );
+    memcpy( out, block, size );
+    memset( block, 0, sizeof( block ));
+  }
+
+ /* изменяем внутреннее состояние */
+  error = ak_random_drbg_update( dctx, add );
+  dctx->reseed_counter++;
+  memset( add, 0, sizeof( add ));
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_drbg_randomize_ptr( ak_random rnd, const ak_pointer ptr, const ssize_t size )
+{
+  struct random_drbg *dctx = NULL;
+
+  if( rnd == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                     "use a null pointer to a random generator" );
+  if( ptr == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                               "use a null pointer to initializer" );
+  if( size <= 0 ) return ak_error_message( ak_error_wrong_length, __func__ ,
+                                                          "use initializer with wrong length" );
+  if(( dctx = ( struct random_drbg * ) rnd->data.ctx ) == NULL )
+    return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                  "using uninitialized random generator context" );
+ return ak_random_drbg_instantiate( dctx, ptr, ( size_t )size, NULL, 0, NULL, 0 );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_drbg_random( ak_random rnd, const ak_pointer ptr, const ssize_t size )
+{
+  size_t len = 0, offset = 0;
+  int error = ak_error_ok;
+  struct random_drbg *dctx = NULL;
+ #ifdef AK_HAVE_UNISTD_H
+  pid_t pid = 0;
+  ak_uint8 entropy[64];
+ #endif
+
+  if( rnd == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                      "use a null pointer to a random generator" );
+  if( ptr == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                                    "use a null pointer to data" );
+  if( size <= 0 ) return ak_error_message( ak_error_wrong_length, __func__ ,
+                                                           "use a data vector with wrong length" );
+  if(( dctx = ( struct random_drbg * ) rnd->data.ctx ) == NULL )
+    return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                  "using uninitialized random generator context" );
+ #ifdef AK_HAVE_UNISTD_H
+ /* дочерний процесс не должен повторять значения, вырабатываемые родительским процессом */
+  if(( pid = getpid()) != dctx->pid ) {
+    if(( error = ak_random_drbg_get_entropy( dctx, entropy, sizeof( entropy ))) != ak_error_ok )
+      return ak_error_message( error, __func__, "incorrect reading of system entropy" );
+    error = ak_random_drbg_reseed_internal( dctx, entropy, sizeof( entropy ),
+                                                        ( ak_uint8 *)&pid, sizeof( pid ));
+    memset( entropy, 0, sizeof( entropy ));
+    if( error != ak_error_ok )
+      return ak_error_message( error, __func__, "incorrect reseeding after fork" );
+    dctx->pid = pid;
+  }
+ #endif
+
+  while( offset < ( size_t )size ) {
+    if( dctx->count == 0 ) {
+     /* большие объемы данных вырабатываются непосредственно в память пользователя */
+      if(( size_t )size - offset >= ak_drbg_buffer_size )
+        return ak_random_drbg_generate( dctx,
+                                   ( ak_uint8 *)ptr + offset, ( size_t )size - offset, NULL, 0 );
+      if(( error = ak_random_drbg_generate( dctx,
+                                  dctx->buffer, ak_drbg_buffer_size, NULL, 0 )) != ak_error_ok )
+        return ak_error_message( error, __func__ , "incorrect generation of random data" );
+      dctx->count = ak_drbg_buffer_size;
+    }
+   /* выданные данные сразу удаляются из буфера */
+    len = ak_min( dctx->count, ( size_t )size - offset );
+    memcpy( ( ak_uint8 *)ptr + offset, dctx->buffer + ak_drbg_buffer_size - dctx->count, len );
+    memset( dctx->buffer + ak_drbg_buffer_size - dctx->count, 0, len );
+    dctx->count -= len;
+    offset += len;
+  }
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_random_drbg_free( ak_random rnd )
+{
+  struct random_drbg *dctx = NULL;
+
+  if( rnd == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                     "use a null pointer to a random generator" );
+  if(( dctx = ( struct random_drbg * ) rnd->data.ctx ) == NULL ) return ak_error_ok;
+  ak_bckey_destroy( &dctx->key );
+ #ifndef AK_HAVE_SYSRANDOM_H
+  ak_random_destroy( &dctx->entropy );
+ #endif
+  memset( dctx, 0, sizeof( struct random_drbg ));
+  free( dctx );
+  rnd->data.ctx = NULL;
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция создает детерминированный генератор псевдо-случайных чисел, основанный на
+    блочном шифре Кузнечик (ГОСТ Р 34.12-2015), используемом в режиме гаммирования.
+    Генератор реализует механизмы создания (instantiate), обновления (reseed) и
+    выработки (generate) внутреннего состояния, соответствующие механизму выработки
+    псевдо-случайных последовательностей на основе блочного шифра (Р 1323565.1.006-2017,
+    NIST SP 800-90A); внутреннее состояние образуют ключ блочного шифра и 128-ми битный счетчик.
+
+    Начальное заполнение генератора считывается из источника энтропии ОС. Внутреннее
+    состояние автоматически обновляется после \ref ak_drbg_reseed_interval запросов, а также
+    при обнаружении того, что генератор используется в дочернем процессе после вызова fork().
+    Вызов функции ak_random_randomize() приводит к созданию нового внутреннего состояния,
+    зависящего только от переданных данных.
+
+    Небольшие объемы данных генератор вырабатывает блоками по \ref ak_drbg_buffer_size октетов;
+    выданные данные сразу удаляются из буфера. Запросы большего объема выполняются
+    непосредственно в память пользователя. Смена ключа блочного шифра при каждом обновлении
+    состояния выполняется функцией ak_bckey_replace_key() в ранее выделенную память. Контекст генератора не содержит разделяемых
+    данных, поэтому каждый поток может использовать собственный генератор без блокировок.
+
+    @param generator Контекст создаваемого генератора.
+    \return В случае успеха, функция возвращает \ref ak_error_ok. В противном случае
+            возвращается код ошибки.                                                               */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_random_create_drbg( ak_random generator )
+{
+  int error = ak_error_ok;
+  struct random_drbg *dctx = NULL;
+  ak_uint8 entropy[96];
+
+  if(( error = ak_random_create( generator )) != ak_error_ok )
+    return ak_error_message( error, __func__ , "wrong initialization of random generator" );
+  if(( dctx = malloc( sizeof( struct random_drbg ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__ ,
+                                               "incorrect memory allocation for generator state" );
+  memset( dctx, 0, sizeof( struct random_drbg ));
+  if(( error = ak_bckey_create_kuznechik( &dctx->key )) != ak_error_ok ) {
+    free( dctx );
+    return ak_error_message( error, __func__ , "incorrect creation of block cipher key" );
+  }
+  generator->data.ctx = dctx;
+  generator->oid = ak_oid_find_by_name( "drbg" );
+  generator->next = NULL;
+  generator->randomize_ptr = ak_random_drbg_randomize_ptr;
+  generator->random = ak_random_drbg_random;
+  generator->free = ak_random_drbg_free;
+
+ #ifndef AK_HAVE_SYSRANDOM_H
+ /* источник энтропии создается один раз и используется при всех обновлениях состояния */
+  #if defined(__unix__) || defined(__APPLE__)
+   error = ak_random_create_urandom( &dctx->entropy );
+  #elif defined(_WIN32)
+   error = ak_random_create_winrtl( &dctx->entropy );
+  #else
+   error = ak_error_undefined_function;
+  #endif
+  if( error != ak_error_ok ) {
+    ak_random_destroy( generator );
+    return ak_error_message( error, __func__ , "incorrect creation of system entropy source" );
+  }
+ #endif
+
+ /* первые 64 октета используются в качестве энтропии, последние 32 - в качестве nonce */
+  if(( error = ak_random_drbg_get_entropy( dctx, entropy, sizeof( entropy ))) != ak_error_ok ) {
+    ak_random_destroy( generator );
+    return ak_error_message( error, __func__ , "incorrect reading of system entropy" );
+  }
+  error = ak_random_drbg_instantiate( dctx, entropy, 64, entropy + 64, 32,
+                                                        ( const ak_uint8 *)"libakrypt-drbg", 14 );
+  memset( entropy, 0, sizeof( entropy ));
+  if( error != ak_error_ok ) {
+    ak_random_destroy( generator );
+    return ak_error_message( error, __func__ , "incorrect instantiation of generator" );
+  }
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция обновляет внутреннее состояние генератора с использованием новых данных,
+    полученных от источника энтропии ОС, и, при необходимости, дополнительных данных.
+
+    @param generator Контекст генератора, созданного функцией ak_random_create_drbg().
+    @param additional Дополнительные данные (могут принимать значение NULL).
+    @param size Размер дополнительных данных (в октетах).
+    \return В случае успеха, функция возвращает \ref ak_error_ok. В противном случае
+            возвращается код ошибки.                                                               */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_random_drbg_reseed( ak_random generator, const ak_pointer additional, const size_t size )
+{
+  int error = ak_error_ok;
+  ak_uint8 entropy[64];
+
+  if( generator == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                     "use a null pointer to a random generator" );
+  if(( generator->random != ak_random_drbg_random ) || ( generator->data.ctx == NULL ))
+    return ak_error_message( ak_error_undefined_function, __func__ ,
+                                                          "using non drbg random generator" );
+  if(( additional == NULL ) && ( size != 0 )) return ak_error_message( ak_error_null_pointer,
+                                                __func__ , "use a null pointer to additional data" );
+  if(( error = ak_random_drbg_get_entropy( generator->data.ctx,
+                                                  entropy, sizeof( entropy ))) != ak_error_ok )
+    return ak_error_message( error, __func__ , "incorrect reading of system entropy" );
+
+  error = ak_random_drbg_reseed_internal( generator->data.ctx, entropy, sizeof( entropy ),
+                                                                          additional, size );
+  memset( entropy, 0, sizeof( entropy ));
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Контрольные значения генератора drbg: второй запрос после создания состояния. */
+ static ak_uint8 drbg_testvalue_generate[64] = {
+  0x95, 0xa4, 0x22, 0x03, 0x9e, 0xa9, 0x35, 0xb2, 0xf2, 0x72, 0x5d, 0xb2, 0x6d, 0xb2, 0x7f, 0x9b,
+  0x3e, 0x3b, 0xa7, 0xe5, 0x15, 0x16, 0x9f, 0x50, 0x7c, 0xcf, 0xfe, 0xb4, 0x03, 0x22, 0xf3, 0xf9,
+  0x9e, 0xe2, 0x5e, 0xf5, 0x97, 0x04, 0x8d, 0xfe, 0x64, 0xcb, 0x1b, 0xe8, 0x8f, 0xe8, 0x7c, 0xc1,
+  0x95, 0xf9, 0xe6, 0x49, 0xca, 0x81, 0x16, 0x5d, 0x0a, 0xc8, 0xa7, 0x36, 0xbe, 0x75, 0xac, 0x6a };
+
+/*! \brief Контрольные значения генератора drbg: запрос после обновления состояния,
+    выполняемый с дополнительными данными. */
+ static ak_uint8 drbg_testvalue_reseed[64] = {
+  0xef, 0xb9, 0xd0, 0x5e, 0x2d, 0xc7, 0xc5, 0x32, 0x5c, 0x89, 0xfd, 0x50, 0x4b, 0x9f, 0x0e, 0x8e,
+  0xf9, 0xbf, 0x4b, 0xa6, 0x48, 0x18, 0x5e, 0x16, 0xae, 0xe7, 0xab, 0x11, 0x9c, 0xe7, 0xf0, 0x1e,
+  0xd9, 0x1e, 0x63, 0xa7, 0xaa, 0x3c, 0xfb, 0x15, 0xbe, 0xd9, 0x0e, 0x4a, 0x63, 0x7e, 0x18, 0x70,
+  0x3d, 0x39, 0xff, 0xb2, 0x7f, 0xaf, 0x83, 0x8f, 0x0f, 0xf8, 0xf6, 0xd9, 0x4a, 0xed, 0xfa, 0x4d };
+
+/*! \brief Контрольные значения генератора drbg: последние 64 октета из 200, выработанных
+    после вызова функции ak_random_randomize(). */
+ static ak_uint8 drbg_testvalue_randomize[64] = {
+  0x07, 0xa6, 0x87, 0xd3, 0x4c, 0xbe, 0x28, 0x42, 0x56, 0x07, 0xb4, 0xd8, 0xac, 0xfa, 0x8f, 0xb4,
+  0xf8, 0x77, 0xa9, 0x36, 0xf1, 0x32, 0x29, 0x7d, 0xa8, 0x93, 0xb9, 0xe5, 0x2a, 0xc3, 0x79, 0xb0,
+  0x98, 0x79, 0x8b, 0x13, 0x60, 0x32, 0xf9, 0x6d, 0xc7, 0x4d, 0x73, 0x82, 0x3e, 0x53, 0x85, 0x83,
+  0xc3, 0x4f, 0xfd, 0xc3, 0x70, 0x49, 0xeb, 0x83, 0x71, 0xe0, 0x61, 0x15, 0x0b, 0x06, 0x4b, 0x7b };
+
+/*! \brief Контрольные значения генератора drbg для режима совместимости с openssl
+    (второй запрос после создания состояния). */
+ static ak_uint8 oc_drbg_testvalue_generate[64] = {
+  0xcb, 0x84, 0xce, 0xd5, 0xbc, 0x94, 0x7a, 0x10, 0xd0, 0x0c, 0x3c, 0x94, 0xa1, 0x95, 0xf2, 0x63,
+  0x33, 0xea, 0x9e, 0xe8, 0x3d, 0x1d, 0x80, 0xb5, 0x49, 0x67, 0x9f, 0x3a, 0x76, 0xd5, 0x78, 0x95,
+  0x87, 0x52, 0xc9, 0xff, 0x99, 0x0c, 0x5f, 0x75, 0x58, 0x3f, 0xa2, 0x8b, 0xab, 0x7e, 0x67, 0xdd,
+  0x86, 0xe6, 0xb3, 0x19, 0xc8, 0x00, 0x09, 0xf2, 0x02, 0xe5, 0xbc, 0x67, 0x4d, 0x61, 0x03, 0x25 };
+
+/*! \brief Контрольные значения генератора drbg для режима совместимости с openssl
+    (запрос после обновления состояния). */
+ static ak_uint8 oc_drbg_testvalue_reseed[64] = {
+  0x64, 0xcf, 0x25, 0x0d, 0x32, 0x08, 0x19, 0xc7, 0xfb, 0xea, 0x19, 0xef, 0xb9, 0x4a, 0x31, 0x3d,
+  0xca, 0x6b, 0x5a, 0x2d, 0xfd, 0x43, 0x06, 0xf0, 0x6c, 0xcf, 0x36, 0x7a, 0xa7, 0xb1, 0x98, 0x64,
+  0x04, 0x81, 0xc7, 0xfa, 0x40, 0x3b, 0x37, 0xa1, 0xfc, 0x0e, 0x03, 0xf2, 0x3b, 0xd0, 0x4a, 0x9c,
+  0xf1, 0xf4, 0x58, 0x1a, 0xea, 0xde, 0xdf, 0xf0, 0xe7, 0xa3, 0x4b, 0xeb, 0x3a, 0x41, 0x97, 0x7c };
+
+/*! \brief Контрольные значения генератора drbg для режима совместимости с openssl
+    (последние 64 октета из 200, выработанных после вызова функции ak_random_randomize()). */
+ static ak_uint8 oc_drbg_testvalue_randomize[64] = {
+  0x24, 0xad, 0x3a, 0xd9, 0x21, 0xf6, 0xbb, 0x3e, 0xae, 0xa8, 0x38, 0x56, 0x47, 0xea, 0xcc, 0x7b,
+  0x30, 0x31, 0x43, 0x0e, 0x61, 0x53, 0x7f, 0xfd, 0x55, 0x7c, 0x82, 0x05, 0xe8, 0x4c, 0xf9, 0x38,
+  0x2d, 0xee, 0x28, 0xe0, 0x8c, 0x4a, 0x15, 0x49, 0x08, 0xda, 0x49, 0x60, 0xf4, 0x85, 0x96, 0x1a,
+  0xb4, 0x4f, 0xdd, 0x90, 0xa8, 0xd9, 0x33, 0x3d, 0x7f, 0xff, 0x40, 0x5e, 0x86, 0x26, 0x36, 0xea };
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция сравнивает результаты работы механизмов instantiate, reseed и generate генератора
+    drbg, полученные для фиксированных значений энтропии и дополнительных данных, с контрольными
+    значениями, а также проверяет выдачу данных из буфера фрагментами различной длины.
+
+    Опубликованных контрольных примеров для генератора на основе блочного шифра Кузнечик нет.
+    Контрольные значения вычислены независимой реализацией механизма CTR_DRBG с функцией
+    Block_Cipher_df из NIST SP 800-90A, в которой блочный шифр реализован по тексту
+    ГОСТ Р 34.12-2015 и проверен на его контрольном примере; ключ и блоки данных передаются
+    шифру как в каноническом порядке октетов библиотеки, так и в порядке октетов стандарта
+    (опция `openssl_compability` равна единице). Таким образом, функция проверяет соответствие
+    генератора описанию SP 800-90A, но не заменяет сертификационных испытаний.
+
+    @return Если тестирование прошло успешно возвращается \ref ak_true (истина). В противном
+    случае возвращается \ref ak_false.                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_libakrypt_test_drbg( void )
+{
+  size_t i = 0;
+  struct random rnd;
+  bool_t result = ak_true;
+  int error = ak_error_ok;
+  int audit = ak_log_get_level(),
+      oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+  struct random_drbg *dctx = NULL;
+  ak_uint8 entropy[64], nonce[16], additional[16], seed[4] = { 1, 2, 3, 4 }, out[200];
+
+  for( i = 0; i < sizeof( entropy ); i++ ) entropy[i] = ( ak_uint8 )i;
+  for( i = 0; i < sizeof( nonce ); i++ ) nonce[i] = ( ak_uint8 )( 0x20 + i );
+  for( i = 0; i < sizeof( additional ); i++ ) additional[i] = ( ak_uint8 )( 0xa0 + i );
+
+  if(( error = ak_random_create_drbg( &rnd )) != ak_error_ok ) {
+    ak_error_message( error, __func__ , "incorrect creation of drbg generator" );
+    return ak_false;
+  }
+  dctx = ( struct random_drbg * ) rnd.data.ctx;
+
+ /* создание состояния и два последовательных запроса */
+  ak_random_drbg_instantiate( dctx, entropy, sizeof( entropy ), nonce, sizeof( nonce ), NULL, 0 );
+  ak_random_drbg_generate( dctx, out, 64, NULL, 0 );
+  ak_random_drbg_generate( dctx, out, 64, NULL, 0 );
+  if(( result = ak_ptr_is_equal_with_log( out,
+                  oc ? oc_drbg_testvalue_generate : drbg_testvalue_generate, 64 )) != ak_true ) {
+    ak_error_message( ak_error_not_equal_data, __func__ , "the instantiate test is wrong" );
+    goto lab_exit;
+  }
+  if( audit >= ak_log_maximum )
+    ak_error_message( ak_error_ok, __func__ , "the instantiate test is Ok" );
+
+ /* обновление состояния и запрос с дополнительными данными */
+  for( i = 0; i < sizeof( entropy ); i++ ) entropy[i] = ( ak_uint8 )( 0x80 + i );
+  ak_random_drbg_reseed_internal( dctx, entropy, sizeof( entropy ), NULL, 0 );
+  ak_random_drbg_generate( dctx, out, 64, additional, sizeof( additional ));
+  if(( result = ak_ptr_is_equal_with_log( out,
+                  oc ? oc_drbg_testvalue_reseed : drbg_testvalue_reseed, 64 )) != ak_true ) {
+    ak_error_message( ak_error_not_equal_data, __func__ , "the reseed test is wrong" );
+    goto lab_exit;
+  }
+  if( audit >= ak_log_maximum )
+    ak_error_message( ak_error_ok, __func__ , "the reseed test is Ok" );
+
+ /* создание состояния с помощью интерфейса класса random;
+    данные выдаются из буфера фрагментами различной длины */
+  ak_random_randomize( &rnd, seed, sizeof( seed ));
+  for( i = 0; i < sizeof( out ); i += 25 ) ak_random_ptr( &rnd, out + i, 25 );
+  if(( result = ak_ptr_is_equal_with_log( out + 136,
+                oc ? oc_drbg_testvalue_randomize : drbg_testvalue_randomize, 64 )) != ak_true ) {
+    ak_error_message( ak_error_not_equal_data, __func__ , "the randomize test is wrong" );
+    goto lab_exit;
+  }
+  if( audit >= ak_log_maximum )
+    ak_error_message( ak_error_ok, __func__ , "the randomize test is Ok" );
+
+ lab_exit:
+  ak_random_destroy( &rnd );
+ return result;
+}
+
 
 /* ----------------------------------------------------------------------------------------------- */
 /*                                 реализация класса rng_winrtl                                    */
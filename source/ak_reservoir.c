@@ -0,0 +1,433 @@
+/* ----------------------------------------------------------------------------------------------- */
+/*  Copyright (c) 2020 by Axel Kenzo, axelkenzo@mail.ru                                            */
+/*                                                                                                 */
+/*  Файл ak_reservoir.c                                                                            */
+/*  - содержит реализацию буффера предварительно выработанной гаммы для режима гаммирования        */
+/* ----------------------------------------------------------------------------------------------- */
+ #include <libakrypt-internal.h>
+
+#ifdef AK_HAVE_PTHREAD_H
+ #include <pthread.h>
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Максимальный объем гаммы (в октетах), вырабатываемый за один вызов функции ak_bckey_ctr().
+    \details Ограничение позволяет потребителю, ожидающему гамму, получить ее до того,
+    как будет заполнен весь буффер.                                                                */
+ #define ak_ctr_reservoir_batch      (4096)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Максимальный размер буффера (в октетах).
+    \details Выработанная, но еще не использованная гамма хранится в памяти в открытом виде,
+    поэтому ее объем ограничивается: больший размер, переданный в функцию ak_ctr_reservoir_create(),
+    уменьшается до данного значения.                                                              */
+ #define ak_ctr_reservoir_max_size   (65536)
+
+#ifdef AK_HAVE_PTHREAD_H
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Данные, используемые для выработки гаммы в отдельном потоке. */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct ctr_reservoir_sync {
+  /*! \brief Мьютекс, защищающий поля буффера. */
+   pthread_mutex_t mutex;
+  /*! \brief Условная переменная, сигнализирующая об изменении состояния буффера. */
+   pthread_cond_t cond;
+  /*! \brief Поток, вырабатывающий гамму. */
+   pthread_t thread;
+  /*! \brief Флаг того, что поток в данный момент использует ключ. */
+   bool_t filling;
+  /*! \brief Флаг завершения работы потока. */
+   bool_t stop;
+ } *ak_ctr_reservoir_sync;
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_ctr_reservoir_lock( ak_ctr_reservoir rsv )
+{
+#ifdef AK_HAVE_PTHREAD_H
+  if( rsv->sync != NULL ) pthread_mutex_lock( &((ak_ctr_reservoir_sync)rsv->sync)->mutex );
+#else
+  (void) rsv;
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_ctr_reservoir_unlock( ak_ctr_reservoir rsv )
+{
+#ifdef AK_HAVE_PTHREAD_H
+  if( rsv->sync != NULL ) pthread_mutex_unlock( &((ak_ctr_reservoir_sync)rsv->sync)->mutex );
+#else
+  (void) rsv;
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция ожидает, пока поток выработки гаммы не освободит ключ. */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_ctr_reservoir_wait_key( ak_ctr_reservoir rsv )
+{
+#ifdef AK_HAVE_PTHREAD_H
+  ak_ctr_reservoir_sync sync = rsv->sync;
+  if( sync != NULL )
+    while( sync->filling ) pthread_cond_wait( &sync->cond, &sync->mutex );
+#else
+  (void) rsv;
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция дополняет буффер гаммой до тех пор, пока ее объем не достигнет `limit` октетов.
+
+    \details Функция вызывается при захваченном мьютексе; на время зашифрования мьютекс
+    освобождается, поэтому потребитель может использовать уже выработанную гамму. Заполняемая
+    область не пересекается с областью, содержащей еще не использованную гамму.
+
+    @param rsv Контекст буффера.
+    @param limit Требуемый объем гаммы (в октетах).
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_ctr_reservoir_generate( ak_ctr_reservoir rsv, const size_t limit )
+{
+  size_t pos = 0, len = 0;
+  int error = ak_error_ok;
+#ifdef AK_HAVE_PTHREAD_H
+  ak_ctr_reservoir_sync sync = rsv->sync;
+#endif
+
+  while(( rsv->ready ) && ( rsv->error == ak_error_ok ) && ( rsv->count < limit )) {
+   /* все смещения кратны длине блока, поэтому блок гаммы никогда не разрывается */
+    pos = ( rsv->head + rsv->count )%rsv->size;
+    len = ak_min( ak_min( rsv->size - pos, limit - rsv->count ), ak_ctr_reservoir_batch );
+    memset( rsv->buffer + pos, 0, len );
+
+   #ifdef AK_HAVE_PTHREAD_H
+    if( sync != NULL ) { sync->filling = ak_true; pthread_mutex_unlock( &sync->mutex ); }
+   #endif
+    error = ak_bckey_ctr( rsv->bkey, rsv->buffer + pos, rsv->buffer + pos, len, NULL, 0 );
+   #ifdef AK_HAVE_PTHREAD_H
+    if( sync != NULL ) {
+      pthread_mutex_lock( &sync->mutex );
+      sync->filling = ak_false;
+      pthread_cond_broadcast( &sync->cond );
+    }
+   #endif
+
+    if( error != ak_error_ok ) {
+      memset( rsv->buffer + pos, 0, len );
+      rsv->error = error;
+      return ak_error_message( error, __func__, "incorrect generation of keystream" );
+    }
+   /* пока выполнялось зашифрование, гамма могла быть сброшена потребителем;
+      в этом случае только что выработанная гамма не будет использована и сразу уничтожается */
+    if( rsv->ready ) rsv->count += len;
+     else memset( rsv->buffer + pos, 0, len );
+  }
+ return rsv->error;
+}
+
+#ifdef AK_HAVE_PTHREAD_H
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция потока, заполняющего буффер гаммой.
+    \details Поток дополняет буффер, как только объем неиспользованной гаммы становится
+    не больше половины размера буффера.                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+ static void *ak_ctr_reservoir_thread( void *ptr )
+{
+  ak_ctr_reservoir rsv = ptr;
+  ak_ctr_reservoir_sync sync = rsv->sync;
+
+  pthread_mutex_lock( &sync->mutex );
+  while( !sync->stop ) {
+    if(( rsv->ready ) && ( rsv->error == ak_error_ok ) && ( rsv->count <= ( rsv->size >> 1 )))
+      ak_ctr_reservoir_generate( rsv, rsv->size );
+     else pthread_cond_wait( &sync->cond, &sync->mutex );
+  }
+  pthread_mutex_unlock( &sync->mutex );
+ return NULL;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция связывает буффер с ключом блочного шифра и выделяет память под гамму.
+    Размер буффера ограничивается значением \ref ak_ctr_reservoir_max_size и округляется вверх
+    до величины, кратной длине блока.
+
+    Выработанная, но не использованная гамма хранится в буффере в открытом (немаскированном)
+    виде; каждый фрагмент гаммы обнуляется сразу после использования. Поэтому размер буффера
+    следует выбирать не больше объема данных, которые должны быть обработаны без задержки.
+    При использовании отдельного потока буффер поддерживается заполненным не менее чем наполовину.
+
+    Пока буффер существует, ключ `bkey` должен использоваться только через функции
+    ak_ctr_reservoir_xxx(): значение счетчика режима гаммирования хранится в контексте ключа
+    и изменяется при выработке каждой новой порции гаммы.
+
+    Если флаг `background` истинен и библиотека собрана с поддержкой потоков,
+    то создается отдельный поток, заполняющий буффер по мере расходования гаммы.
+    В противном случае гамма вырабатывается вызовом функции ak_ctr_reservoir_fill(),
+    либо большими порциями в момент, когда буффер опустошается.
+
+    @param rsv Контекст буффера.
+    @param bkey Ключ блочного шифра, значение которого должно быть установлено.
+    @param size Размер буффера в октетах.
+    @param background Флаг выработки гаммы в отдельном потоке.
+
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_ctr_reservoir_create( ak_ctr_reservoir rsv, ak_bckey bkey, const size_t size,
+                                                                        const bool_t background )
+{
+#ifdef AK_HAVE_PTHREAD_H
+  ak_ctr_reservoir_sync sync = NULL;
+#endif
+
+  if( rsv == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                           "using null pointer to reservoir" );
+  if( bkey == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                        "using null pointer to block cipher key" );
+  if(( bkey->bsize != 8 ) && ( bkey->bsize != 16 ))
+    return ak_error_message( ak_error_wrong_block_cipher, __func__ ,
+                                                   "incorrect block size of block cipher key" );
+  if( size == 0 ) return ak_error_message( ak_error_zero_length, __func__,
+                                                       "using reservoir with zero length" );
+  memset( rsv, 0, sizeof( struct ctr_reservoir ));
+  rsv->bkey = bkey;
+  rsv->size = ak_min( size, ak_ctr_reservoir_max_size );
+  rsv->size = bkey->bsize*(( rsv->size + bkey->bsize - 1 )/bkey->bsize );
+  rsv->ready = ak_false;
+  rsv->error = ak_error_ok;
+  rsv->sync = NULL;
+  if(( rsv->buffer = ak_aligned_malloc( rsv->size )) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__ ,
+                                                       "memory allocation error for keystream" );
+  memset( rsv->buffer, 0, rsv->size );
+
+#ifdef AK_HAVE_PTHREAD_H
+  if( background ) {
+    if(( sync = malloc( sizeof( struct ctr_reservoir_sync ))) == NULL ) {
+      ak_ctr_reservoir_destroy( rsv );
+      return ak_error_message( ak_error_out_of_memory, __func__ ,
+                                                 "memory allocation error for thread context" );
+    }
+    pthread_mutex_init( &sync->mutex, NULL );
+    pthread_cond_init( &sync->cond, NULL );
+    sync->filling = sync->stop = ak_false;
+    rsv->sync = sync;
+    if( pthread_create( &sync->thread, NULL, ak_ctr_reservoir_thread, rsv ) != 0 ) {
+      pthread_cond_destroy( &sync->cond );
+      pthread_mutex_destroy( &sync->mutex );
+      free( sync );
+      rsv->sync = NULL;
+      ak_error_message( ak_error_ok, __func__ ,
+                                  "background thread is not started, keystream is made on demand" );
+    }
+  }
+#else
+  (void) background;
+#endif
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция останавливает поток выработки гаммы (если он был создан), уничтожает выработанную,
+    но не использованную гамму и освобождает память. Сам ключ блочного шифра не уничтожается.
+
+    @param rsv Контекст буффера.
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_ctr_reservoir_destroy( ak_ctr_reservoir rsv )
+{
+#ifdef AK_HAVE_PTHREAD_H
+  ak_ctr_reservoir_sync sync = NULL;
+#endif
+
+  if( rsv == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                           "using null pointer to reservoir" );
+#ifdef AK_HAVE_PTHREAD_H
+  if(( sync = rsv->sync ) != NULL ) {
+    pthread_mutex_lock( &sync->mutex );
+    sync->stop = ak_true;
+    pthread_cond_broadcast( &sync->cond );
+    pthread_mutex_unlock( &sync->mutex );
+    pthread_join( sync->thread, NULL );
+    pthread_cond_destroy( &sync->cond );
+    pthread_mutex_destroy( &sync->mutex );
+    free( sync );
+  }
+#endif
+  if( rsv->buffer != NULL ) {
+    memset( rsv->buffer, 0, rsv->size );
+    free( rsv->buffer );
+  }
+  memset( rsv, 0, sizeof( struct ctr_reservoir ));
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция уничтожает ранее выработанную гамму и устанавливает в контексте ключа новое значение
+    синхропосылки, так же как это делает функция ak_bckey_ctr() при передаче ей
+    синхропосылки. Требования к длине синхропосылки совпадают с требованиями функции ak_bckey_ctr().
+
+    @param rsv Контекст буффера.
+    @param iv Указатель на синхропосылку.
+    @param iv_size Длина синхропосылки в октетах.
+
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_ctr_reservoir_set_iv( ak_ctr_reservoir rsv, ak_pointer iv, const size_t iv_size )
+{
+  int error = ak_error_ok;
+
+  if( rsv == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                           "using null pointer to reservoir" );
+  if(( iv == NULL ) || ( iv_size == 0 ))
+    return ak_error_message( ak_error_null_pointer, __func__,
+                                                           "using undefined initial vector" );
+  ak_ctr_reservoir_lock( rsv );
+  ak_ctr_reservoir_wait_key( rsv );
+  memset( rsv->buffer, 0, rsv->size );
+  rsv->head = rsv->count = 0;
+  rsv->ready = ak_false;
+  if(( error = ak_bckey_ctr( rsv->bkey, NULL, NULL, 0, iv, iv_size )) != ak_error_ok )
+    ak_error_message( error, __func__, "incorrect initialization of counter" );
+   else {
+     rsv->ready = ak_true;
+     rsv->error = ak_error_ok;
+   }
+#ifdef AK_HAVE_PTHREAD_H
+  if( rsv->sync != NULL ) pthread_cond_broadcast( &((ak_ctr_reservoir_sync)rsv->sync)->cond );
+#endif
+  ak_ctr_reservoir_unlock( rsv );
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция полностью заполняет буффер гаммой в вызывающем потоке. Функция может вызываться
+    в моменты простоя, например, в ожидании очередного пакета данных.
+
+    @param rsv Контекст буффера.
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_ctr_reservoir_fill( ak_ctr_reservoir rsv )
+{
+  int error = ak_error_ok;
+
+  if( rsv == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                           "using null pointer to reservoir" );
+  ak_ctr_reservoir_lock( rsv );
+  if( !rsv->ready ) error = ak_error_message( ak_error_wrong_block_cipher_function, __func__ ,
+                                                 "using reservoir with undefined initial vector" );
+   else {
+     ak_ctr_reservoir_wait_key( rsv );
+     error = ak_ctr_reservoir_generate( rsv, rsv->size );
+   }
+  ak_ctr_reservoir_unlock( rsv );
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция зашифровывает (расшифровывает) данные, складывая их с ранее выработанной гаммой.
+    Если гаммы в буффере недостаточно, то она вырабатывается порциями размером с буффер
+    (либо ожидается от потока выработки гаммы).
+
+    Результат последовательных вызовов функции совпадает с результатом последовательных вызовов
+    функции ak_bckey_ctr() для тех же фрагментов данных: все фрагменты, кроме последнего, должны
+    иметь длину, кратную длине блока; после обработки фрагмента, длина которого не кратна
+    длине блока, оставшаяся гамма уничтожается и для продолжения работы необходимо установить
+    новую синхропосылку.
+
+    Ресурс ключа уменьшается в момент выработки гаммы, поэтому выработанная,
+    но не использованная гамма также расходует ресурс ключа.
+
+    @param rsv Контекст буффера.
+    @param in Указатель на входные данные.
+    @param out Указатель на область памяти для выходных данных (может совпадать с `in`).
+    @param size Размер данных в октетах.
+
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_ctr_reservoir_xor( ak_ctr_reservoir rsv, ak_pointer in, ak_pointer out, const size_t size )
+{
+  size_t i = 0, len = 0, done = 0, tail = 0, bsize = 0;
+  int error = ak_error_ok, oc = 0;
+  ak_uint8 *gamma = NULL;
+
+  if( rsv == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
+                                                           "using null pointer to reservoir" );
+  if( size == 0 ) return ak_error_ok;
+  if(( in == NULL ) || ( out == NULL )) return ak_error_message( ak_error_null_pointer,
+                                                      __func__, "using null pointer to data" );
+  bsize = rsv->bkey->bsize;
+  if(( tail = size%bsize ) != 0 ) {
+    oc = (int) ak_libakrypt_get_option_by_name( "openssl_compability" );
+    if(( oc < 0 ) || ( oc > 1 )) return ak_error_message( ak_error_wrong_option, __func__,
+                                                "wrong value for \"openssl_compability\" option" );
+  }
+
+  ak_ctr_reservoir_lock( rsv );
+  if( !rsv->ready ) {
+    error = ak_error_message( ak_error_wrong_block_cipher_function, __func__ ,
+                                                 "using reservoir with undefined initial vector" );
+    goto exit;
+  }
+
+  while( done < size ) {
+    if( rsv->count == 0 ) {
+      if( rsv->error != ak_error_ok ) {
+        error = ak_error_message( rsv->error, __func__, "reservoir has no keystream" );
+        goto exit;
+      }
+     #ifdef AK_HAVE_PTHREAD_H
+      if( rsv->sync != NULL ) { /* гамму вырабатывает отдельный поток */
+        pthread_cond_broadcast( &((ak_ctr_reservoir_sync)rsv->sync)->cond );
+        pthread_cond_wait( &((ak_ctr_reservoir_sync)rsv->sync)->cond,
+                                                   &((ak_ctr_reservoir_sync)rsv->sync)->mutex );
+        continue;
+      }
+     #endif
+      if(( error = ak_ctr_reservoir_generate( rsv, rsv->size )) != ak_error_ok ) goto exit;
+      continue;
+    }
+
+    gamma = rsv->buffer + rsv->head;
+    if( size - done >= bsize ) { /* полные блоки, расположенные в буффере последовательно */
+      len = ak_min( ak_min( rsv->count, rsv->size - rsv->head ), size - done - tail );
+      for( i = 0; i < ( len >> 3 ); i++ )
+         ((ak_uint64 *)((ak_uint8 *)out + done))[i] =
+                            ((ak_uint64 *)((ak_uint8 *)in + done))[i] ^ ((ak_uint64 *)gamma)[i];
+      memset( gamma, 0, len ); /* использованная гамма сразу уничтожается */
+      rsv->head = ( rsv->head + len )%rsv->size;
+      rsv->count -= len;
+      done += len;
+
+    } else { /* последний неполный блок: используются те же октеты, что и в ak_bckey_ctr() */
+       for( i = 0; i < tail; i++ )
+          ((ak_uint8 *)out)[done+i] = ((ak_uint8 *)in)[done+i] ^
+                                                      ( oc ? gamma[i] : gamma[bsize - tail + i] );
+      /* дальнейшее использование синхропосылки запрещено */
+       for( len = 0; len < rsv->count; len += bsize )
+          memset( rsv->buffer + ( rsv->head + len )%rsv->size, 0, bsize );
+       rsv->head = rsv->count = 0;
+       rsv->ready = ak_false;
+       done = size;
+      }
+  }
+
+  exit:
+  #ifdef AK_HAVE_PTHREAD_H
+   if(( rsv->sync != NULL ) && ( rsv->count <= ( rsv->size >> 1 )))
+     pthread_cond_broadcast( &((ak_ctr_reservoir_sync)rsv->sync)->cond );
+  #endif
+   ak_ctr_reservoir_unlock( rsv );
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*                                                                                 ak_reservoir.c  */
+/* ----------------------------------------------------------------------------------------------- */
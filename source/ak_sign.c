@@ -9,6 +9,78 @@
 #ifdef AK_HAVE_TIME_H
  #include <time.h>
 #endif
+#ifdef AK_HAVE_UNISTD_H
+ #include <unistd.h>
+#endif
+#ifdef AK_HAVE_PTHREAD_H
+ #include <pthread.h>
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество пар вычетов, вырабатываемых для смены маски секретного ключа за один раз. */
+ #define ak_signkey_remask_batch (32)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Выработка набора пар вычетов \f$ (\zeta, \zeta^{-1}) \f$, используемых для смены маски
+    секретного ключа.
+
+    Функция вырабатывает \ref ak_signkey_remask_batch случайных ненулевых вычетов
+    \f$ \zeta_i \f$ по модулю \f$ q \f$ и вычисляет обратные к ним с помощью метода
+    Монтгомери одновременного обращения: вычисляются произведения
+    \f$ \zeta_0\cdots\zeta_i \f$, обращается только последнее из них, после чего обратные
+    элементы восстанавливаются с помощью \f$ 3(n-1) \f$ умножений. Пара с номером \f$ i \f$
+    хранится в массиве `sk->remask` со смещениями \f$ 2i\cdot size \f$ и \f$ (2i+1)size \f$,
+    все значения задаются в представлении Монтгомери.
+
+    @param sk Контекст секретного ключа электронной подписи.
+    @return В случае успеха функция возвращает \ref ak_error_ok. В противном случае
+    возвращается код ошибки.                                                                       */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_signkey_remask_fill( ak_signkey sk )
+{
+  size_t i, size;
+  ak_mpzn512 inv, t;
+  ak_uint64 *zeta = NULL;
+  int error = ak_error_ok;
+  ak_wcurve wc = ( ak_wcurve ) sk->key.data;
+
+  size = wc->size;
+  if( sk->remask == NULL ) {
+    if(( sk->remask = malloc( 2*ak_signkey_remask_batch*size*sizeof( ak_uint64 ))) == NULL )
+      return ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+  }
+  sk->remask_count = 0;
+
+ /* вырабатываем случайные вычеты и считаем, что они заданы в представлении Монтгомери;
+    в ячейки для обратных значений помещаем произведения zeta_0 ... zeta_i */
+  for( i = 0; i < ak_signkey_remask_batch; i++ ) {
+     zeta = sk->remask + 2*i*size;
+     do{
+        if(( error = ak_random_ptr( &sk->key.generator, zeta,
+                                         (ssize_t)( size*sizeof( ak_uint64 )))) != ak_error_ok )
+          return ak_error_message( error, __func__ , "wrong mask generation for key buffer" );
+        ak_mpzn_rem( zeta, zeta, wc->q, size );
+     } while( ak_mpzn_cmp_ui( zeta, size, 0 ));
+     if( i == 0 ) ak_mpzn_set( zeta + size, zeta, size );
+      else ak_mpzn_mul_montgomery( zeta + size, zeta - size, zeta, wc->q, wc->nq, size );
+  }
+
+ /* обращаем произведение всех вычетов и восстанавливаем обратные элементы */
+  ak_mpzn_inverse_montgomery( inv,
+            sk->remask + ( 2*ak_signkey_remask_batch - 1 )*size, wc->q, wc->nq, wc->r2q, size );
+  for( i = ak_signkey_remask_batch - 1; i > 0; i-- ) {
+     zeta = sk->remask + 2*i*size;
+     ak_mpzn_mul_montgomery( t, inv, zeta - size, wc->q, wc->nq, size );
+     ak_mpzn_mul_montgomery( inv, inv, zeta, wc->q, wc->nq, size );
+     ak_mpzn_set( zeta + size, t, size );
+  }
+  ak_mpzn_set( sk->remask + size, inv, size );
+  sk->remask_count = ak_signkey_remask_batch;
+
+  ak_ptr_wipe( inv, sizeof( inv ), &sk->key.generator );
+  ak_ptr_wipe( t, sizeof( t ), &sk->key.generator );
+ return ak_error_ok;
+}
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Установление или изменение маски секретного ключа ассиметричного криптографического
@@ -19,15 +91,18 @@
     и заменяет значение ключа \f$ k \f$ на величину \f$ km^{-1} \pmod{q} \f$.
 
     При смене маски
-    функция вырабатывает случайный вычет \f$ \zeta \f$ из кольца вычетов \f$ \mathbb Z_q\f$
-    и заменяет значение ключа \f$ k \f$ и значение маски \f$ m \f$  на значения
-    \f$ k \equiv k\zeta \pmod{q} \f$ и \f$  m \equiv m\zeta^{-1} \pmod{q} \f$.
+    функция берет очередную пару вычетов \f$ (\zeta, \zeta^{-1}) \f$ из кольца вычетов
+    \f$ \mathbb Z_q\f$ и заменяет значение ключа \f$ k \f$ и значение маски \f$ m \f$  на значения
+    \f$ k \equiv k\zeta \pmod{q} \f$ и \f$  m \equiv m\zeta^{-1} \pmod{q} \f$. Пары вычетов
+    вырабатываются сразу для \ref ak_signkey_remask_batch случайных значений \f$ \zeta \f$
+    функцией ak_signkey_remask_fill(), поэтому смена маски требует только двух умножений,
+    а одно обращение распределяется на весь набор пар.
 
     Величина \f$ q \f$ должна быть простым числом, помещенным в параметры эллиптической кривой,
     на которые указывает `skey->data`.
 
     @param skey Указатель на контекст секретного ключа. Длина ключа (в байтах)
-    должна быть кратна 8.
+    должна быть кратна 8. Контекст должен являться полем `key` контекста \ref signkey.
 
     @return В случае успеха функция возвращает ноль (\ref ak_error_ok). В противном случае,
     возвращается код ошибки.                                                                       */
@@ -37,10 +112,10 @@
 #ifndef AK_LITTLE_ENDIAN
   int i = 0;
 #endif
-  ak_mpznmax u, zeta;
   ak_wcurve wc = NULL;
   int error = ak_error_ok;
-  ak_uint64 *key = NULL, *mask = NULL;
+  ak_uint64 *key = NULL, *mask = NULL, *zeta = NULL;
+  ak_signkey sk = ( ak_signkey ) skey; /* поле key является первым полем контекста signkey */
 
  /* "стандартные" проверки указателей и выделения памяти */
   if( skey == NULL ) return ak_error_message( ak_error_null_pointer,
@@ -80,32 +155,26 @@
      ak_mpzn_mul_montgomery( key, key, mask, wc->q, wc->nq, wc->size);
 
     /* вычисляем обратное значение для маски */
-     ak_mpzn_set_ui( u, wc->size, 2 );
-     ak_mpzn_sub( u, wc->q, u, wc->size );
-     ak_mpzn_modpow_montgomery( mask, // m <- m^{q-2} (mod q)
-                                    mask, u, wc->q, wc->nq, wc->size );
+     ak_mpzn_inverse_montgomery( mask, // m <- m^{-1} (mod q)
+                                    mask, wc->q, wc->nq, wc->r2q, wc->size );
     /* меняем значение флага */
      skey->flags |= ak_key_flag_set_mask;
 
   } else { /* если маска уже установлена, то мы сменяем ее на новую */
 
-    /* создаем маску */
-     if(( error = ak_random_ptr( &skey->generator, zeta,
-                                               (ssize_t)skey->key_size )) != ak_error_ok )
-       return ak_error_message( error, __func__ , "wrong mask generation for key buffer" );
-
-    /* приводим случайное число по модулю q и сразу считаем, что это число в представлении Монтгомери */
-     ak_mpzn_rem( zeta, zeta, wc->q, wc->size );
+    /* берем очередную пару (zeta, zeta^{-1}), при необходимости вырабатывая новый набор пар */
+     if( sk->remask_count == 0 ) {
+       if(( error = ak_signkey_remask_fill( sk )) != ak_error_ok )
+         return ak_error_message( error, __func__ , "wrong generation of key mask values" );
+     }
+     zeta = sk->remask + 2*( --sk->remask_count )*wc->size;
 
-    /* домножаем ключ на случайное число */
+    /* домножаем ключ на случайное число, а маску - на обратное к нему */
      ak_mpzn_mul_montgomery( key, key, zeta, wc->q, wc->nq, wc->size );
-    /* вычисляем обратное значение zeta */
-     ak_mpzn_set_ui( u, wc->size, 2 );
-     ak_mpzn_sub( u, wc->q, u, wc->size );
-     ak_mpzn_modpow_montgomery( zeta, zeta, u, wc->q, wc->nq, wc->size ); // z <- z^{q-2} (mod q)
+     ak_mpzn_mul_montgomery( mask, mask, zeta + wc->size, wc->q, wc->nq, wc->size );
 
-    /* домножаем маску на обратное значение zeta */
-     ak_mpzn_mul_montgomery( mask, mask, zeta, wc->q, wc->nq, wc->size );
+    /* использованная пара больше не нужна */
+     ak_ptr_wipe( zeta, 2*wc->size*sizeof( ak_uint64 ), &skey->generator );
     }
 
  return ak_error_ok;
@@ -295,6 +364,14 @@
   /* устанавливаем ресурс и время жизни ключа по-умолчанию */
    ak_signkey_set_resource_values( sk, key_using_resource,
                                                         "digital_signature_count_resource", 0, 0 );
+  /* создаем генератор, используемый по-умолчанию для выработки одноразовых ключей подписи */
+   if(( error = ak_random_create_drbg( &sk->generator )) != ak_error_ok ) {
+     ak_hash_destroy( &sk->ctx );
+     ak_skey_destroy( &sk->key );
+     return ak_error_message( error, __func__, "wrong creation of random generator" );
+   }
+  /* по-умолчанию маска ключа сменяется после выработки каждой подписи */
+   sk->remask_period = 1;
   /* в заключение определяем указатели на методы */
    sk->key.set_mask = ak_signkey_set_mask_multiplicative;
    sk->key.unmask = ak_signkey_unmask_multiplicative;
@@ -343,7 +420,8 @@
     return ak_error_message_fmt( ak_error_curve_not_supported, __func__ ,
                               "%u bits elliptic curve is not applicable for algorithm %s",
                                                            wc->size << 6, sctx->key.oid->name[0] );
-    else sctx->key.data = wc;
+   sctx->key.data = wc;
+   sctx->remask_count = 0; /* пары вычетов для смены маски выработаны по другому модулю */
  return ak_error_ok;
 }
 
@@ -368,7 +446,8 @@
     return ak_error_message_fmt( ak_error_curve_not_supported, __func__ ,
                               "%u bits elliptic curve is not applicable for algorithm %s",
                                                            wc->size << 6, sctx->key.oid->name[0] );
-   else sctx->key.data = wc;
+  sctx->key.data = wc;
+  sctx->remask_count = 0;
  return ak_error_ok;
 }
 
@@ -407,10 +486,21 @@
   int error = ak_error_ok;
   if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
                            "destroying a null pointer to digital signature secret key context" );
+  if( sctx->remask != NULL ) {
+    ak_ptr_wipe( sctx->remask, 2*ak_signkey_remask_batch*sctx->key.key_size,
+                                                                           &sctx->key.generator );
+    free( sctx->remask );
+    sctx->remask = NULL;
+  }
+  sctx->remask_count = 0;
+  if(( error = ak_signkey_presign_destroy( sctx )) != ak_error_ok )
+    ak_error_message( error, __func__ , "incorrect destroying of precomputed values set" );
   if(( error = ak_skey_destroy( &sctx->key )) != ak_error_ok )
     ak_error_message( error, __func__ , "incorrect destroying of digital signature secret key" );
   if(( error = ak_hash_destroy( &sctx->ctx )) != ak_error_ok )
     ak_error_message( error, __func__ , "incorrect destroying hash function context" );
+  if(( error = ak_random_destroy( &sctx->generator )) != ak_error_ok )
+    ak_error_message( error, __func__ , "incorrect destroying of random generator" );
 
  return error;
 }
@@ -459,7 +549,8 @@
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! @param sctx контекст секретного ключа алгоритма электронной подписи.
-    @param generator контекст генератора случайных чисел.
+    @param generator контекст генератора случайных чисел. Если значение равно NULL, то
+    используется генератор, содержащийся в контексте секретного ключа.
     @return В случае успеха возвращается ноль (\ref ak_error_ok). В противном случае возвращается
     код ошибки.                                                                                    */
 /* ----------------------------------------------------------------------------------------------- */
@@ -472,8 +563,7 @@
                                                      "using null pointer to secret key context" );
   if( sctx->key.key_size == 0 ) return ak_error_message( ak_error_zero_length, __func__ ,
                                                      "using non initialized secret key context" );
-  if( generator == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
-                                                "using null pointer to random number generator" );
+  if( generator == NULL ) generator = &sctx->generator;
  /* присваиваем секретный ключ */
   if(( error = ak_skey_set_key_random( &sctx->key, generator )) != ak_error_ok )
     return ak_error_message( error, __func__ , "wrong generation a secret key context" );
@@ -484,6 +574,26 @@
  return error;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! По-умолчанию маска секретного ключа сменяется после выработки каждой подписи. Увеличение
+    периода уменьшает время выработки подписи, однако одно и то же маскированное значение ключа
+    используется для выработки нескольких подписей.
+
+    @param sctx контекст секретного ключа алгоритма электронной подписи.
+    @param period количество подписей, после выработки которых выполняется смена маски.
+    Нулевое значение означает, что после выработки подписи маска не изменяется.
+    @return В случае успеха возвращается ноль (\ref ak_error_ok). В противном случае возвращается
+    код ошибки.                                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_signkey_set_remask_period( ak_signkey sctx, const size_t period )
+{
+  if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                     "using null pointer to secret key context" );
+  sctx->remask_period = period;
+  sctx->remask_counter = 0;
+ return ak_error_ok;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Присвоение времени происходит следующим образом. Если `not_before` равно нулю, то
     устанавливается текущее время. Если `not_after` равно нулю или меньше, чем `not_before`,
@@ -552,6 +662,64 @@
  return ak_error_ok;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Вычисление второй половинки подписи \f$ s \equiv rd + ke \pmod{q}\f$ и формирование
+    электронной подписи по заданным значениям \f$ r \f$ и \f$ k \f$.
+
+    Функция выполняет ту часть алгоритма выработки подписи, которая зависит от подписываемого
+    сообщения, и после выработки подписи сменяет маску секретного ключа.
+
+    @param sctx контекст секретного ключа алгоритма электронной подписи.
+    @param r значение \f$ r \f$ (в обычной форме).
+    @param km значение \f$ k \f$ в представлении Монтгомери; если значение `unmask` отлично
+    от NULL, то значение \f$ k\mu \f$, маскированное вычетом \f$ \mu \f$.
+    @param unmask значение \f$ \mu^{-1} \f$ в представлении Монтгомери, либо NULL, если значение
+    `km` не маскировано. Маска снимается в составе произведения \f$ (k\mu)(e\mu^{-1}) \f$,
+    поэтому значение \f$ k \f$ в явном виде не вычисляется.
+    @param e целое число, соотвествующее хеш-коду подписываемого сообщения.
+    @param out массив, куда помещается результат.                                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_signkey_sign_finalize( ak_signkey sctx, ak_uint64 *r, ak_uint64 *km,
+                                                ak_uint64 *unmask, ak_uint64 *e, ak_pointer out )
+{
+  ak_mpzn512 s, t, z;
+  ak_wcurve wc = ( ak_wcurve ) sctx->key.data;
+
+ /* приводим r к виду Монтгомери и помещаем во временную переменную t <- r */
+  ak_mpzn_mul_montgomery( t, r, wc->r2q, wc->q, wc->nq, wc->size );
+
+ /* вычисляем значение s <- r*d (mod q) (сначала домножаем на ключ, потом на его маску) */
+  ak_mpzn_mul_montgomery( s, t, (ak_uint64 *)sctx->key.key, wc->q, wc->nq, wc->size );
+  ak_mpzn_mul_montgomery( s, s,
+              (ak_uint64 *)(sctx->key.key+sctx->key.key_size), wc->q, wc->nq, wc->size );
+
+ /* приводим e к виду Монтгомери и помещаем во временную переменную z <- e */
+  ak_mpzn_rem( z, e, wc->q, wc->size );
+  if( ak_mpzn_cmp_ui( z, wc->size, 0 )) ak_mpzn_set_ui( z, wc->size, 1 );
+  ak_mpzn_mul_montgomery( z, z, wc->r2q, wc->q, wc->nq, wc->size );
+  if( unmask != NULL ) ak_mpzn_mul_montgomery( z, z, unmask, wc->q, wc->nq, wc->size );
+
+ /* вычисляем k*e (mod q) и вычисляем s = r*d + k*e (mod q) (в форме Монтгомери) */
+  ak_mpzn_mul_montgomery( t, km, z, wc->q, wc->nq, wc->size ); /* t <- k*e */
+  ak_mpzn_add_montgomery( s, s, t, wc->q, wc->size );
+
+ /* приводим s к обычной форме */
+  ak_mpzn_mul_montgomery( s, s,  wc->point.z, /* для экономии памяти пользуемся равенством z = 1 */
+                                 wc->q, wc->nq, wc->size );
+ /* экспортируем результат */
+  ak_mpzn_to_little_endian( s, wc->size, out, sizeof(ak_uint64)*wc->size, ak_true );
+  ak_mpzn_to_little_endian( r, wc->size, (ak_uint64 *)out + wc->size,
+                                                             sizeof(ak_uint64)*wc->size, ak_true );
+ /* завершаемся */
+  if( sctx->remask_period && ( ++sctx->remask_counter >= sctx->remask_period )) {
+    sctx->remask_counter = 0;
+    sctx->key.set_mask( &sctx->key );
+  }
+  memset( s, 0, sizeof( ak_mpzn512 ));
+  memset( t, 0, sizeof( ak_mpzn512 ));
+  memset( z, 0, sizeof( ak_mpzn512 ));
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция вырабатывает электронную подпись для \f$ e \f$ - вычисленного хеш-кода подписываемого
     сообщения и заданного случайного числа \f$ k \f$. Для этого
@@ -588,57 +756,415 @@
 /* ----------------------------------------------------------------------------------------------- */
  void ak_signkey_sign_const_values( ak_signkey sctx, ak_uint64 *k, ak_uint64 *e, ak_pointer out )
 {
-  ak_mpzn512 r, s;
+  ak_mpzn512 r;
   struct wpoint wr;
   ak_wcurve wc = ( ak_wcurve ) sctx->key.data;
 
  /* поскольку функция не экспортируется, мы оставляем все проверки функциям верхнего уровня */
  /* вычисляем r */
-  ak_wpoint_pow( &wr, &wc->point, k, wc->size, wc );
+  ak_wpoint_pow_base( &wr, k, wc->size, wc );
   ak_wpoint_reduce( &wr, wc );
   ak_mpzn_rem( r, wr.x, wc->q, wc->size );
 
- /* приводим r к виду Монтгомери и помещаем во временную переменную wr.x <- r */
-  ak_mpzn_mul_montgomery( wr.x, r, wc->r2q, wc->q, wc->nq, wc->size );
-
- /* вычисляем значение s <- r*d (mod q) (сначала домножаем на ключ, потом на его маску) */
-  ak_mpzn_mul_montgomery( s, wr.x, (ak_uint64 *)sctx->key.key, wc->q, wc->nq, wc->size );
-  ak_mpzn_mul_montgomery( s, s,
-              (ak_uint64 *)(sctx->key.key+sctx->key.key_size), wc->q, wc->nq, wc->size );
-
  /* приводим k к виду Монтгомери и помещаем во временную переменную wr.y <- k */
   ak_mpzn_mul_montgomery( wr.y, k, wc->r2q, wc->q, wc->nq, wc->size );
 
- /* приводим e к виду Монтгомери и помещаем во временную переменную wr.z <- e */
-  ak_mpzn_rem( wr.z, e, wc->q, wc->size );
-  if( ak_mpzn_cmp_ui( wr.z, wc->size, 0 )) ak_mpzn_set_ui( wr.z, wc->size, 1 );
-  ak_mpzn_mul_montgomery( wr.z, wr.z, wc->r2q, wc->q, wc->nq, wc->size );
-
- /* вычисляем k*e (mod q) и вычисляем s = r*d + k*e (mod q) (в форме Монтгомери) */
-  ak_mpzn_mul_montgomery( wr.y, wr.y, wr.z, wc->q, wc->nq, wc->size ); /* wr.y <- k*e */
-  ak_mpzn_add_montgomery( s, s, wr.y, wc->q, wc->size );
+ /* вычисляем s и формируем подпись */
+  ak_signkey_sign_finalize( sctx, r, wr.y, NULL, e, out );
 
- /* приводим s к обычной форме */
-  ak_mpzn_mul_montgomery( s, s,  wc->point.z, /* для экономии памяти пользуемся равенством z = 1 */
-                                 wc->q, wc->nq, wc->size );
- /* экспортируем результат */
-  ak_mpzn_to_little_endian( s, wc->size, out, sizeof(ak_uint64)*wc->size, ak_true );
-  ak_mpzn_to_little_endian( r, wc->size, (ak_uint64 *)out + wc->size,
-                                                             sizeof(ak_uint64)*wc->size, ak_true );
  /* завершаемся */
   memset( &wr, 0, sizeof( struct wpoint ));
-  sctx->key.set_mask( &sctx->key );
   memset( r, 0, sizeof( ak_mpzn512 ));
-  memset( s, 0, sizeof( ak_mpzn512 ));
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Набор предварительно вычисленных значений \f$ (k, r) \f$ для выработки подписи.
+    \details Все вычисления, выполняемые при выработке подписи, кроме вычисления
+    \f$ s \equiv rd + ke \pmod{q} \f$, не зависят от подписываемого сообщения. Поэтому
+    значения \f$ k \f$ и \f$ r \f$ могут быть вычислены заранее, в моменты простоя
+    или в отдельном потоке. Каждое значение используется только один раз и сразу уничтожается.
+
+    Знание хотя бы одного значения \f$ k \f$ и соответствующей ему подписи позволяет вычислить
+    секретный ключ, поэтому значения \f$ k \f$, так же как и секретный ключ, хранятся
+    маскированными: вместо \f$ k \f$ хранится \f$ k\mu \pmod{q} \f$, где \f$ \mu \f$
+    случайный вычет, вырабатываемый при создании набора. Маска снимается только при вычислении
+    подписи функцией ak_signkey_sign_finalize().                                                  */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct signkey_presign {
+  /*! \brief Массив пар \f$ (k\mu, r) \f$: значение \f$ k\mu \f$ хранится в представлении
+      Монтгомери, значение \f$ r \f$ - в обычной форме. */
+   ak_uint64 *values;
+  /*! \brief Маска \f$ \mu \f$ значений \f$ k \f$ (в представлении Монтгомери). */
+   ak_mpzn512 mask;
+  /*! \brief Значение \f$ \mu^{-1} \pmod{q} \f$ (в представлении Монтгомери). */
+   ak_mpzn512 unmask;
+  /*! \brief Максимальное количество пар в массиве. */
+   size_t size;
+  /*! \brief Количество вычисленных, но не использованных пар. */
+   size_t count;
+  /*! \brief Эллиптическая кривая, для которой вычислены значения. */
+   ak_wcurve wc;
+  /*! \brief Генератор, используемый для выработки значений \f$ k \f$. */
+   struct random generator;
+  /*! \brief Код ошибки, возникшей при вычислении значений. */
+   int error;
+ #ifdef AK_HAVE_UNISTD_H
+  /*! \brief Идентификатор процесса, вычислившего значения. */
+   pid_t pid;
+ #endif
+ #ifdef AK_HAVE_PTHREAD_H
+  /*! \brief Мьютекс, защищающий поля набора. */
+   pthread_mutex_t mutex;
+  /*! \brief Условная переменная, сигнализирующая об изменении количества значений. */
+   pthread_cond_t cond;
+  /*! \brief Поток, вычисляющий значения. */
+   pthread_t thread;
+  /*! \brief Флаг того, что значения вычисляются в отдельном потоке. */
+   bool_t background;
+  /*! \brief Флаг завершения работы потока. */
+   bool_t stop;
+ #endif
+ } *ak_signkey_presign;
+
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_signkey_presign_lock( ak_signkey_presign ps )
+{
+#ifdef AK_HAVE_PTHREAD_H
+  if( ps->background ) pthread_mutex_lock( &ps->mutex );
+#else
+  (void) ps;
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_signkey_presign_unlock( ak_signkey_presign ps )
+{
+#ifdef AK_HAVE_PTHREAD_H
+  if( ps->background ) pthread_mutex_unlock( &ps->mutex );
+#else
+  (void) ps;
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция уничтожает значения, вычисленные родительским процессом.
+
+    \details После вызова fork() дочерний процесс получает копию всех еще не использованных
+    значений \f$ (k, r) \f$; их использование в обоих процессах приводит к выработке подписей
+    с одинаковыми значениями \f$ k \f$ и, как следствие, к компрометации секретного ключа.
+    Поэтому в дочернем процессе значения уничтожаются. Поток, вычисляющий значения,
+    в дочернем процессе отсутствует, а мьютекс мог остаться захваченным, поэтому дальнейшие
+    вычисления выполняются только вызовом функции ak_signkey_presign_fill().
+    Функция вызывается до захвата мьютекса.                                                        */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_signkey_presign_check_fork( ak_signkey_presign ps )
+{
+#ifdef AK_HAVE_UNISTD_H
+  pid_t pid = getpid();
+
+  if( ps->pid == pid ) return;
+ #ifdef AK_HAVE_PTHREAD_H
+  ps->background = ak_false;
+ #endif
+  memset( ps->values, 0, 2*ps->size*ps->wc->size*sizeof( ak_uint64 ));
+  ps->count = 0;
+  ps->pid = pid;
+#else
+  (void) ps;
+#endif
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вычисляет значения \f$ (k, r) \f$ до тех пор, пока их количество
+    не достигнет величины `limit`.
+
+    \details Функция вызывается при захваченном мьютексе; на время вычисления кратной точки
+    мьютекс освобождается, поэтому потребитель может использовать уже вычисленные значения.
+    Случайное значение \f$ k \f$ вырабатывается при захваченном мьютексе, поэтому генератор
+    не используется одновременно несколькими потоками.
+
+    @param ps Контекст набора значений.
+    @param limit Требуемое количество значений.
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_signkey_presign_generate( ak_signkey_presign ps, const size_t limit )
+{
+  ak_mpzn512 k, r;
+  struct wpoint wr;
+  ak_uint64 *ptr = NULL;
+  ak_wcurve wc = ps->wc;
+  int error = ak_error_ok;
+
+  while(( ps->error == ak_error_ok ) && ( ps->count < limit )
+   #ifdef AK_HAVE_PTHREAD_H
+         && ( !ps->stop )
+   #endif
+       ) {
+    memset( k, 0, sizeof( k ));
+    if(( error = ak_mpzn_set_random_modulo( k, wc->q, wc->size,
+                                                              &ps->generator )) != ak_error_ok ) {
+      ps->error = error;
+      ak_error_message( error, __func__ , "invalid generation of random value" );
+      break;
+    }
+    ak_signkey_presign_unlock( ps );
+
+   /* вычисляем r и маскируем k: значение k*r2q*mu в представлении Монтгомери равно k*mu */
+    ak_wpoint_pow_base( &wr, k, wc->size, wc );
+    ak_wpoint_reduce( &wr, wc );
+    ak_mpzn_rem( r, wr.x, wc->q, wc->size );
+    ak_mpzn_mul_montgomery( k, k, wc->r2q, wc->q, wc->nq, wc->size );
+    ak_mpzn_mul_montgomery( k, k, ps->mask, wc->q, wc->nq, wc->size );
+
+    ak_signkey_presign_lock( ps );
+   /* пока выполнялись вычисления, набор мог быть заполнен другим потоком */
+    if( ps->count < ps->size ) {
+      ptr = ps->values + 2*ps->count*wc->size;
+      ak_mpzn_set( ptr, k, wc->size );
+      ak_mpzn_set( ptr + wc->size, r, wc->size );
+      ps->count++;
+    }
+  }
+
+  memset( &wr, 0, sizeof( struct wpoint ));
+  memset( k, 0, sizeof( k ));
+  memset( r, 0, sizeof( r ));
+ return ps->error;
+}
+
+#ifdef AK_HAVE_PTHREAD_H
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция потока, вычисляющего значения \f$ (k, r) \f$.
+    \details Поток дополняет набор, как только количество неиспользованных значений становится
+    не больше половины размера набора.                                                             */
+/* ----------------------------------------------------------------------------------------------- */
+ static void *ak_signkey_presign_thread( void *ptr )
+{
+  ak_signkey_presign ps = ptr;
+
+  pthread_mutex_lock( &ps->mutex );
+  while( !ps->stop ) {
+    if(( ps->error == ak_error_ok ) && ( ps->count <= ( ps->size >> 1 )))
+      ak_signkey_presign_generate( ps, ps->size );
+     else pthread_cond_wait( &ps->cond, &ps->mutex );
+  }
+  pthread_mutex_unlock( &ps->mutex );
+ return NULL;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция извлекает из набора очередную пару \f$ (k, r) \f$.
+
+    @param sctx Контекст секретного ключа.
+    @param km Массив, куда помещается маскированное значение \f$ k\mu \f$
+    (в представлении Монтгомери).
+    @param r Массив, куда помещается значение \f$ r \f$.
+    @param unmask Массив, куда помещается значение \f$ \mu^{-1} \f$.
+    @return Функция возвращает \ref ak_true, если пара извлечена, и \ref ak_false, если набор
+    не создан, пуст, либо вычислен для другой эллиптической кривой.                                */
+/* ----------------------------------------------------------------------------------------------- */
+ static bool_t ak_signkey_presign_get( ak_signkey sctx, ak_uint64 *km, ak_uint64 *r,
+                                                                               ak_uint64 *unmask )
+{
+  ak_uint64 *ptr = NULL;
+  bool_t result = ak_false;
+  ak_signkey_presign ps = sctx->presign;
+
+  if( ps == NULL ) return ak_false;
+  ak_signkey_presign_check_fork( ps );
+  if( ps->wc != ( ak_wcurve ) sctx->key.data ) return ak_false;
+
+  ak_signkey_presign_lock( ps );
+  if( ps->count > 0 ) {
+   /* значения извлекаются с конца массива и сразу уничтожаются */
+    ptr = ps->values + 2*( --ps->count )*ps->wc->size;
+    ak_mpzn_set( km, ptr, ps->wc->size );
+    ak_mpzn_set( r, ptr + ps->wc->size, ps->wc->size );
+    ak_mpzn_set( unmask, ps->unmask, ps->wc->size );
+    memset( ptr, 0, 2*ps->wc->size*sizeof( ak_uint64 ));
+    result = ak_true;
+  }
+#ifdef AK_HAVE_PTHREAD_H
+  if( ps->background && ( ps->count <= ( ps->size >> 1 ))) pthread_cond_broadcast( &ps->cond );
+#endif
+  ak_signkey_presign_unlock( ps );
+ return result;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция создает набор предварительно вычисленных значений \f$ (k, r) \f$ для эллиптической
+    кривой, установленной в контексте секретного ключа. После создания набора функции
+    ak_signkey_sign_hash(), ak_signkey_sign_ptr() и ak_signkey_sign_file() используют
+    вычисленные значения, при этом выработка подписи сводится к нескольким умножениям
+    по модулю \f$ q \f$. Если набор пуст, то подпись вырабатывается обычным образом
+    с использованием генератора, передаваемого в функцию выработки подписи.
+
+    Если флаг `background` истинен и библиотека собрана с поддержкой потоков,
+    то создается отдельный поток, дополняющий набор по мере расходования значений.
+    В противном случае значения вычисляются вызовом функции ak_signkey_presign_fill().
+
+    Значения \f$ k \f$ вырабатываются собственным генератором набора и не зависят от
+    значения секретного ключа, поэтому набор не требуется создавать заново после установки
+    нового значения ключа. После смены эллиптической кривой набор не используется.
+    Ранее созданный набор уничтожается.
+
+    @param sctx Контекст секретного ключа.
+    @param size Максимальное количество значений в наборе.
+    @param background Флаг вычисления значений в отдельном потоке.
+
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_signkey_presign_create( ak_signkey sctx, const size_t size, const bool_t background )
+{
+  int error = ak_error_ok;
+  ak_signkey_presign ps = NULL;
+  ak_wcurve wc = NULL;
+
+  if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                     "using null pointer to secret key context" );
+  if(( wc = ( ak_wcurve ) sctx->key.data ) == NULL )
+    return ak_error_message( ak_error_undefined_value, __func__ ,
+                                            "using secret key with undefined elliptic curve" );
+  if( size == 0 ) return ak_error_message( ak_error_zero_length, __func__,
+                                                 "using precomputed values set with zero size" );
+  ak_signkey_presign_destroy( sctx );
+
+  if(( ps = malloc( sizeof( struct signkey_presign ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__ ,
+                                                 "memory allocation error for values set context" );
+  memset( ps, 0, sizeof( struct signkey_presign ));
+  if(( ps->values = malloc( 2*size*wc->size*sizeof( ak_uint64 ))) == NULL ) {
+    free( ps );
+    return ak_error_message( ak_error_out_of_memory, __func__ ,
+                                                         "memory allocation error for values set" );
+  }
+  memset( ps->values, 0, 2*size*wc->size*sizeof( ak_uint64 ));
+  if(( error = ak_random_create_drbg( &ps->generator )) != ak_error_ok ) {
+    free( ps->values );
+    free( ps );
+    return ak_error_message( error, __func__, "wrong creation of random generator" );
+  }
+  ps->size = size;
+  ps->count = 0;
+  ps->wc = wc;
+  ps->error = ak_error_ok;
+
+ /* вырабатываем маску значений k; случайный вычет считаем заданным в представлении Монтгомери */
+  do{
+     if(( error = ak_mpzn_set_random_modulo( ps->mask, wc->q, wc->size,
+                                                              &ps->generator )) != ak_error_ok ) {
+       ak_random_destroy( &ps->generator );
+       free( ps->values );
+       memset( ps, 0, sizeof( struct signkey_presign ));
+       free( ps );
+       return ak_error_message( error, __func__, "invalid generation of values mask" );
+     }
+  } while( ak_mpzn_cmp_ui( ps->mask, wc->size, 0 ));
+  ak_mpzn_inverse_montgomery( ps->unmask, ps->mask, wc->q, wc->nq, wc->r2q, wc->size );
+ #ifdef AK_HAVE_UNISTD_H
+  ps->pid = getpid();
+ #endif
+  sctx->presign = ps;
+
+#ifdef AK_HAVE_PTHREAD_H
+  if( background ) {
+    pthread_mutex_init( &ps->mutex, NULL );
+    pthread_cond_init( &ps->cond, NULL );
+    ps->stop = ak_false;
+    ps->background = ak_true;
+    if( pthread_create( &ps->thread, NULL, ak_signkey_presign_thread, ps ) != 0 ) {
+      ps->background = ak_false;
+      pthread_cond_destroy( &ps->cond );
+      pthread_mutex_destroy( &ps->mutex );
+      ak_error_message( ak_error_ok, __func__ ,
+                               "background thread is not started, values are made on demand" );
+    }
+  }
+#else
+  (void) background;
+#endif
+
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция полностью заполняет набор предварительно вычисленных значений в вызывающем потоке.
+    Функция может вызываться в моменты простоя, например, в ожидании очередного запроса
+    на выработку подписи.
+
+    @param sctx Контекст секретного ключа.
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_signkey_presign_fill( ak_signkey sctx )
+{
+  int error = ak_error_ok;
+  ak_signkey_presign ps = NULL;
+
+  if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                     "using null pointer to secret key context" );
+  if(( ps = sctx->presign ) == NULL )
+    return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                   "using undefined precomputed values set" );
+  ak_signkey_presign_check_fork( ps );
+  ak_signkey_presign_lock( ps );
+  error = ak_signkey_presign_generate( ps, ps->size );
+  ak_signkey_presign_unlock( ps );
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция останавливает поток вычисления значений (если он был создан), уничтожает
+    вычисленные, но не использованные значения \f$ (k, r) \f$ и освобождает память.
+    Функция вызывается при уничтожении контекста секретного ключа.
+
+    @param sctx Контекст секретного ключа.
+    @return В случае возникновения ошибки функция возвращает ее код, в противном случае
+    возвращается \ref ak_error_ok (ноль)                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_signkey_presign_destroy( ak_signkey sctx )
+{
+  ak_signkey_presign ps = NULL;
+
+  if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                     "using null pointer to secret key context" );
+  if(( ps = sctx->presign ) == NULL ) return ak_error_ok;
+  ak_signkey_presign_check_fork( ps );
+#ifdef AK_HAVE_PTHREAD_H
+  if( ps->background ) {
+    pthread_mutex_lock( &ps->mutex );
+    ps->stop = ak_true;
+    pthread_cond_broadcast( &ps->cond );
+    pthread_mutex_unlock( &ps->mutex );
+    pthread_join( ps->thread, NULL );
+    pthread_cond_destroy( &ps->cond );
+    pthread_mutex_destroy( &ps->mutex );
+  }
+#endif
+  memset( ps->values, 0, 2*ps->size*ps->wc->size*sizeof( ak_uint64 ));
+  free( ps->values );
+  ak_random_destroy( &ps->generator );
+  memset( ps, 0, sizeof( struct signkey_presign ));
+  free( ps );
+  sctx->presign = NULL;
+ return ak_error_ok;
 }
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! @param sctx Контекст секретного ключа алгоритма электронной подписи.
     @param generator Генератор случайной последовательности,
-    используемой в алгоритме подписи
+    используемой в алгоритме подписи. Если значение равно NULL, то используется генератор,
+    содержащийся в контексте секретного ключа.
     @param hash Последовательность байт, содержащая в себе хеш-код
     подписываемого сообщения.
     @param size Размер хеш-кода, в байтах.
+
+    Если для ключа создан набор предварительно вычисленных значений (функция
+    ak_signkey_presign_create()), то используется очередное значение из набора,
+    а генератор используется только в случае, когда набор пуст.
     @param out Область памяти, куда будет помещен результат. Память должна быть заранее выделена.
     @param out_size Размер выделенной под выработанную ЭП памяти.
 
@@ -654,13 +1180,12 @@
   int i = 0;
 #endif
   size_t lb = 0;
-  ak_mpzn512 k, h;
+  ak_mpzn512 k, h, r, u;
   int error = ak_error_ok;
 
   if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                       "using null pointer to secret key context" );
-  if( generator == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
-                                                 "using null pointer to random number generator" );
+  if( generator == NULL ) generator = &sctx->generator;
   if( hash == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                               "using null pointer to hash value" );
   if( size != ( lb = sizeof( ak_uint64 )*(( ak_wcurve )sctx->key.data)->size ))
@@ -669,18 +1194,27 @@
   if( out_size < 2*lb ) return ak_error_message( ak_error_wrong_length, __func__,
                                                        "using small buffer for digital sigature" );
 
- /* вырабатываем случайное число */
-  memset( k, 0, sizeof( ak_uint64 )*ak_mpzn512_size );
-  if(( error = ak_mpzn_set_random_modulo( k, (( ak_wcurve )sctx->key.data)->q,
-                                (( ak_wcurve )sctx->key.data)->size, generator )) != ak_error_ok )
-    return ak_error_message( error, __func__ , "invalid generation of random value");
-
  /* превращаем хеш от сообщения в последовательность 64х битных слов  */
   memcpy( h, hash, sctx->ctx.data.sctx.hsize );
 #ifndef AK_LITTLE_ENDIAN
   for( i = 0; i < (( ak_wcurve )sctx->key.data)->size; i++ ) h[i] = bswap_64( h[i] );
 #endif
 
+ /* используем предварительно вычисленные значения k и r, если они есть */
+  if( ak_signkey_presign_get( sctx, k, r, u )) {
+    ak_signkey_sign_finalize( sctx, r, k, u, h, out );
+    ak_ptr_wipe( k, sizeof( ak_uint64 )*ak_mpzn512_size, &sctx->key.generator );
+    memset( r, 0, sizeof( ak_mpzn512 ));
+    memset( u, 0, sizeof( ak_mpzn512 ));
+    return ak_error_ok;
+  }
+
+ /* вырабатываем случайное число */
+  memset( k, 0, sizeof( ak_uint64 )*ak_mpzn512_size );
+  if(( error = ak_mpzn_set_random_modulo( k, (( ak_wcurve )sctx->key.data)->q,
+                                (( ak_wcurve )sctx->key.data)->size, generator )) != ak_error_ok )
+    return ak_error_message( error, __func__ , "invalid generation of random value");
+
  /* и только теперь вычисляем электронную подпись */
   ak_signkey_sign_const_values( sctx, k, h, out );
   ak_ptr_wipe( k, sizeof( ak_uint64 )*ak_mpzn512_size, &sctx->key.generator );
@@ -690,7 +1224,8 @@
 /* ----------------------------------------------------------------------------------------------- */
 /*! @param sctx Контекст секретного ключа алгоритма электронной подписи.
     @param generator Генератор случайной последовательности,
-    используемой в алгоритме подписи
+    используемой в алгоритме подписи. Если значение равно NULL, то используется генератор,
+    содержащийся в контексте секретного ключа.
     @param in Указатель на входные данные которые подписываются.
     @param size Размер входных данных в байтах.
     @param out Область памяти, куда будет помещен результат. Память должна быть заранее выделена.
@@ -710,8 +1245,7 @@
  /* необходимые проверки */
   if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                  "using null pointer to secret key context" );
-  if( generator == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
-                                                 "using null pointer to random number generator" );
+  if( generator == NULL ) generator = &sctx->generator;
   if( in == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                    "using null pointer to signifying value" );
   if( sctx->ctx.data.sctx.hsize > sizeof( hash )) return ak_error_message( ak_error_wrong_length,
@@ -730,7 +1264,8 @@
 /* ----------------------------------------------------------------------------------------------- */
 /*! @param sctx Kонтекст секретного ключа алгоритма электронной подписи.
     @param generator Генератор случайной последовательности,
-    используемой в алгоритме подписи
+    используемой в алгоритме подписи. Если значение равно NULL, то используется генератор,
+    содержащийся в контексте секретного ключа.
     @param filename Строка с именем файла для которого вычисляется электронная подпись.
     @param out Область памяти, куда будет помещен результат. Память должна быть заранее выделена.
     @param out_size Размер выделенной под выработанную ЭП памяти.
@@ -749,8 +1284,7 @@
  /* необходимые проверки */
   if( sctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                  "using null pointer to secret key context" );
-  if( generator == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
-                                                 "using null pointer to random number generator" );
+  if( generator == NULL ) generator = &sctx->generator;
   if( filename == NULL ) return ak_error_message( ak_error_null_pointer, __func__,
                                                           "using null pointer to file name" );
   if( sctx->ctx.data.sctx.hsize > 64 ) return ak_error_message( ak_error_wrong_length,
@@ -875,7 +1409,7 @@
  /* теперь определяем открытый ключ */
   ak_mpzn_mul_montgomery( k, ( ak_uint64 *)sctx->key.key, one,
                                                       pctx->wc->q, pctx->wc->nq, pctx->wc->size );
-  ak_wpoint_pow( &pctx->qpoint, &pctx->wc->point, k, pctx->wc->size, pctx->wc );
+  ak_wpoint_pow_base( &pctx->qpoint, k, pctx->wc->size, pctx->wc );
 
   ak_mpzn_mul_montgomery( k, ( ak_uint64 *)( sctx->key.key + sctx->key.key_size ),
                                                   one, pctx->wc->q, pctx->wc->nq, pctx->wc->size);
@@ -949,11 +1483,101 @@
 
  /* если обобщенное имя владельца было определено, то удаляем его */
   if( pctx->name != NULL ) pctx->name = ak_tlv_delete( pctx->name );
+ /* удаляем предвычисленные кратные точки */
+  if( pctx->qtable != NULL ) free( pctx->qtable );
 
   memset( pctx, 0, sizeof( struct verifykey ));
  return error;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Ширина окна при вычислении нечетных кратных точки открытого ключа
+    непосредственно в ходе проверки подписи. */
+ #define ak_verifykey_wnaf_width        (5)
+/*! \brief Ширина окна, используемая функцией ak_verifykey_precompute() по умолчанию. */
+ #define ak_verifykey_precompute_width  (7)
+/*! \brief Максимальная ширина окна, допустимая в функции ak_verifykey_precompute(). */
+ #define ak_verifykey_precompute_max_width  (8)
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция вычисляет аффинные координаты нечетных кратных \f$ Q, [3]Q, \ldots, [2^{w-1}-1]Q \f$
+    точки \f$ Q \f$, являющейся открытым ключом, и сохраняет их в контексте ключа.
+    После этого функции ak_verifykey_verify_hash() и ak_verifykey_verify_hash_batch()
+    используют сохраненные точки автоматически, что позволяет не вычислять их при каждой
+    проверке подписи и увеличить ширину окна.
+
+    Вызов функции имеет смысл для ключей, на которых проверяется большое количество подписей.
+    Если значение открытого ключа будет изменено, то сохраненные точки перестанут использоваться
+    до повторного вызова функции.
+
+    @param pctx контекст открытого ключа.
+    @param width ширина окна \f$ w \f$, принимающая значения от 2 до 8; при `width = 0`
+    используется значение по умолчанию, равное 7. Таблица содержит \f$ 2^{w-2} \f$ точек.
+    @return В случае успеха возвращается ноль (\ref ak_error_ok). В противном случае возвращается
+    код ошибки.                                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_verifykey_precompute( ak_verifykey pctx, const size_t width )
+{
+  int error = ak_error_ok;
+  ak_uint64 *table = NULL;
+  size_t w = ( width == 0 ) ? ak_verifykey_precompute_width : width, tail = 0;
+
+  if( pctx == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                      "using null pointer to public key context" );
+  if(( w < 2 ) || ( w > ak_verifykey_precompute_max_width ))
+    return ak_error_message( ak_error_wrong_length, __func__, "using unsupported window width" );
+  if( !( pctx->flags&ak_key_flag_set_key ))
+    return ak_error_message( ak_error_key_value, __func__ , "using public key with undefined value" );
+
+/* после кратных точек в таблице сохраняются координаты точки Q, для которой они вычислены */
+  tail = 3*( (size_t)1 << ( w-2 ))*pctx->wc->size;
+  if(( table = malloc( ( tail + 2*pctx->wc->size )*sizeof( ak_uint64 ))) == NULL )
+    return ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+  if(( error = ak_wpoint_set_affine_multiples( table, &pctx->qpoint, w, pctx->wc )) != ak_error_ok ) {
+    free( table );
+    return ak_error_message( error, __func__, "incorrect computation of public key multiples" );
+  }
+  memcpy( table + tail, pctx->qpoint.x, pctx->wc->size*sizeof( ak_uint64 ));
+  memcpy( table + tail + pctx->wc->size, pctx->qpoint.y, pctx->wc->size*sizeof( ak_uint64 ));
+
+  if( pctx->qtable != NULL ) free( pctx->qtable );
+  pctx->qtable = table;
+  pctx->qwidth = w;
+ return ak_error_ok;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка того, что предвычисленные кратные соответствуют текущему значению ключа.
+    \return Указатель на предвычисленные кратные или NULL, если они не могут быть использованы. */
+/* ----------------------------------------------------------------------------------------------- */
+ static ak_uint64 *ak_verifykey_get_qtable( ak_verifykey pctx )
+{
+  ak_wcurve wc = pctx->wc;
+  ak_uint64 *tail = NULL;
+
+  if( pctx->qtable == NULL ) return NULL;
+  if( ak_mpzn_cmp_ui( pctx->qpoint.z, wc->size, 1 ) != ak_true ) return NULL;
+ /* сравниваем Q с точкой, сохраненной после кратных точек */
+  tail = pctx->qtable + 3*( (size_t)1 << ( pctx->qwidth-2 ))*wc->size;
+  if( ak_mpzn_cmp( tail, pctx->qpoint.x, wc->size ) != 0 ) return NULL;
+  if( ak_mpzn_cmp( tail + wc->size, pctx->qpoint.y, wc->size ) != 0 ) return NULL;
+ return pctx->qtable;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Проверка того, что половины подписи \f$ r \f$ и \f$ s \f$ лежат в интервале
+    \f$ [1, q-1] \f$. Подписи, не удовлетворяющие этому условию, отвергаются до выполнения
+    каких-либо вычислений (ГОСТ Р 34.10-2012, раздел 6.2, шаг 1).                                   */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline bool_t ak_verifykey_check_sign_range( ak_uint64 *r, ak_uint64 *s, ak_wcurve wc )
+{
+  if( ak_mpzn_cmp_ui( r, wc->size, 0 ) || ( ak_mpzn_cmp( r, wc->q, wc->size ) >= 0 ))
+    return ak_false;
+  if( ak_mpzn_cmp_ui( s, wc->size, 0 ) || ( ak_mpzn_cmp( s, wc->q, wc->size ) >= 0 ))
+    return ak_false;
+ return ak_true;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! @param pctx контекст открытого ключа.
     @param hash хеш-код сообщения (последовательность байт), для которого проверяется электронная подпись.
@@ -969,8 +1593,9 @@
 #ifndef AK_LITTLE_ENDIAN
   int i = 0;
 #endif
-  ak_mpzn512 v, z1, z2, u, r, s, h;
-  struct wpoint cpoint, tpoint;
+  ak_mpzn512 v, z1, z2, r, s, h;
+  ak_uint64 *qtable = NULL;
+  struct wpoint cpoint;
 
   if( pctx == NULL ) {
     ak_error_message( ak_error_null_pointer, __func__,
@@ -994,6 +1619,7 @@
   ak_mpzn_set_little_endian( s, pctx->wc->size, sign, sizeof(ak_uint64)*pctx->wc->size, ak_true );
   ak_mpzn_set_little_endian( r, pctx->wc->size, ( ak_uint64* )sign + pctx->wc->size,
                                                       sizeof(ak_uint64)*pctx->wc->size, ak_true );
+  if( !ak_verifykey_check_sign_range( r, s, pctx->wc )) return ak_false;
 
   memcpy( h, hash, sizeof( ak_uint64 )*pctx->wc->size );
 #ifndef AK_LITTLE_ENDIAN
@@ -1006,9 +1632,8 @@
   ak_mpzn_mul_montgomery( v, v, pctx->wc->r2q, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
 
   /* вычисляем v (в представлении Монтгомери) */
-  ak_mpzn_set_ui( u, pctx->wc->size, 2 );
-  ak_mpzn_sub( u, pctx->wc->q, u, pctx->wc->size );
-  ak_mpzn_modpow_montgomery( v, v, u, pctx->wc->q, pctx->wc->nq, pctx->wc->size ); // v <- v^{q-2} (mod q)
+  ak_mpzn_inverse_montgomery_var( v, v, pctx->wc->q,
+                              pctx->wc->nq, pctx->wc->r2q, pctx->wc->size ); // v <- v^{-1} (mod q)
 
   /* вычисляем z1 */
   ak_mpzn_mul_montgomery( z1, s, pctx->wc->r2q, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
@@ -1022,9 +1647,12 @@
   ak_mpzn_mul_montgomery( z2, z2, pctx->wc->point.z, pctx->wc->q, pctx->wc->nq, pctx->wc->size );
 
  /* сложение точек и проверка */
-  ak_wpoint_pow( &cpoint, &pctx->wc->point, z1, pctx->wc->size, pctx->wc );
-  ak_wpoint_pow( &tpoint, &pctx->qpoint, z2, pctx->wc->size, pctx->wc );
-  ak_wpoint_add( &cpoint, &tpoint, pctx->wc );
+  if(( qtable = ak_verifykey_get_qtable( pctx )) != NULL )
+    ak_wpoint_pow2_affine_multiples( &cpoint, z1, qtable, pctx->qwidth, z2,
+                                                                    pctx->wc->size, pctx->wc );
+   else ak_wpoint_pow2( &cpoint, z1, &pctx->qpoint, z2, pctx->wc->size, pctx->wc );
+ /* для бесконечно удаленной точки C подпись неверна */
+  if( ak_mpzn_cmp_ui( cpoint.z, pctx->wc->size, 0 )) return ak_false;
   ak_wpoint_reduce( &cpoint, pctx->wc );
   ak_mpzn_rem( cpoint.x, cpoint.x, pctx->wc->q, pctx->wc->size );
 
@@ -1035,6 +1663,246 @@
  return ak_true;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Промежуточные значения, вычисляемые при пакетной проверке электронной подписи. */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct verify_batch_item {
+  /*! \brief Первая половина подписи. */
+   ak_mpzn512 r;
+  /*! \brief Вторая половина подписи. */
+   ak_mpzn512 s;
+  /*! \brief Хеш-код сообщения по модулю q (в представлении Монтгомери) и обратный к нему. */
+   ak_mpzn512 v;
+  /*! \brief Произведение обращаемых величин, используемое для одновременного обращения. */
+   ak_mpzn512 prod;
+  /*! \brief Точка \f$ C = [z_1]P + [z_2]Q \f$. */
+   struct wpoint cpoint;
+  /*! \brief Номер элемента во входных массивах. */
+   size_t idx;
+ } *ak_verify_batch_item;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Одновременное обращение вычетов методом Монтгомери.
+
+    Вместо `count` обращений функция выполняет одно обращение
+    и \f$ 3(count-1) \f$ умножений. Все вычеты задаются в представлении Монтгомери и должны быть
+    отличны от нуля.
+
+    @param items массив промежуточных значений
+    @param count количество элементов массива
+    @param first указатель на обращаемый вычет первого элемента массива; вычеты остальных
+    элементов расположены с шагом, равным размеру структуры \ref verify_batch_item
+    @param m модуль, по которому производятся вычисления
+    @param n0 константа, используемая в арифметике Монтгомери по модулю m
+    @param r2 величина \f$ r^2 \pmod{m} \f$
+    @param size размер модуля в машинных словах                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_verify_batch_invert( ak_verify_batch_item items, const size_t count,
+          ak_uint64 *first, ak_uint64 *m, ak_uint64 n0, ak_uint64 *r2, const size_t size )
+{
+  size_t i;
+  ak_mpzn512 u, inv;
+  #define ak_batch_value( i ) (( ak_uint64 *)(( ak_uint8 *)first + \
+                                                      (i)*sizeof( struct verify_batch_item )))
+
+  if( count == 0 ) return;
+  ak_mpzn_set( items[0].prod, ak_batch_value( 0 ), size );
+  for( i = 1; i < count; i++ )
+     ak_mpzn_mul_montgomery( items[i].prod, items[i-1].prod, ak_batch_value( i ), m, n0, size );
+
+  ak_mpzn_inverse_montgomery_var( inv, items[count-1].prod, m, n0, r2, size );
+
+  for( i = count-1; i > 0; i-- ) {
+     ak_mpzn_mul_montgomery( u, inv, items[i-1].prod, m, n0, size );
+     ak_mpzn_mul_montgomery( inv, inv, ak_batch_value( i ), m, n0, size );
+     ak_mpzn_set( ak_batch_value( i ), u, size );
+  }
+  ak_mpzn_set( ak_batch_value( 0 ), inv, size );
+  #undef ak_batch_value
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Пакетная проверка подписей, вычисленных на одной эллиптической кривой.
+
+    Элементы массива `items` упорядочены так, что подписи, проверяемые на одном и том же
+    открытом ключе, следуют друг за другом.                                                        */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_verifykey_verify_batch_curve( ak_verify_batch_item items, size_t count,
+              ak_verifykey *keys, ak_pointer *hashes, ak_pointer *signs, bool_t *results )
+{
+#ifndef AK_LITTLE_ENDIAN
+  size_t j = 0;
+#endif
+  size_t i, n, zcount;
+  ak_verifykey key = NULL;
+  ak_uint64 *qtable = NULL;
+  ak_mpzn512 h, z1, z2, one = ak_mpzn512_one;
+  ak_wcurve wc = keys[items[0].idx]->wc;
+  struct wpoint tq[ 1 << ( ak_verifykey_wnaf_width-1 )];
+
+ /* импортируем подписи и вычисляем v = e (mod q) в представлении Монтгомери;
+    подписи, значения r или s которых не лежат в интервале [1, q-1], сразу отвергаются
+    и исключаются из массива, сохраняя порядок оставшихся элементов */
+  for( i = 0, n = 0; i < count; i++ ) {
+     items[n].idx = items[i].idx;
+     ak_mpzn_set_little_endian( items[n].s, wc->size,
+                                 signs[items[n].idx], sizeof(ak_uint64)*wc->size, ak_true );
+     ak_mpzn_set_little_endian( items[n].r, wc->size,
+       ( ak_uint64* )signs[items[n].idx] + wc->size, sizeof(ak_uint64)*wc->size, ak_true );
+     if( !ak_verifykey_check_sign_range( items[n].r, items[n].s, wc )) {
+       results[items[n].idx] = ak_false;
+       continue;
+     }
+
+     memcpy( h, hashes[items[n].idx], sizeof( ak_uint64 )*wc->size );
+#ifndef AK_LITTLE_ENDIAN
+     for( j = 0; j < wc->size; j++ ) h[j] = bswap_64( h[j] );
+#endif
+     ak_mpzn_rem( items[n].v, h, wc->q, wc->size );
+     if( ak_mpzn_cmp_ui( items[n].v, wc->size, 0 )) ak_mpzn_set_ui( items[n].v, wc->size, 1 );
+     ak_mpzn_mul_montgomery( items[n].v, items[n].v, wc->r2q, wc->q, wc->nq, wc->size );
+     n++;
+  }
+  if(( count = n ) == 0 ) return;
+
+ /* одновременно обращаем все значения v */
+  ak_verify_batch_invert( items, count, items[0].v, wc->q, wc->nq, wc->r2q, wc->size );
+
+ /* вычисляем точки C = [z1]P + [z2]Q, нечетные кратные Q вычисляются один раз для каждого ключа */
+  for( i = 0; i < count; i++ ) {
+     ak_mpzn_mul_montgomery( z1, items[i].s, wc->r2q, wc->q, wc->nq, wc->size );
+     ak_mpzn_mul_montgomery( z1, z1, items[i].v, wc->q, wc->nq, wc->size );
+     ak_mpzn_mul_montgomery( z1, z1, one, wc->q, wc->nq, wc->size );
+
+     ak_mpzn_mul_montgomery( z2, items[i].r, wc->r2q, wc->q, wc->nq, wc->size );
+     ak_mpzn_sub( z2, wc->q, z2, wc->size );
+     ak_mpzn_mul_montgomery( z2, z2, items[i].v, wc->q, wc->nq, wc->size );
+     ak_mpzn_mul_montgomery( z2, z2, one, wc->q, wc->nq, wc->size );
+
+     if( key != keys[items[i].idx] ) {
+       key = keys[items[i].idx];
+       if(( qtable = ak_verifykey_get_qtable( key )) == NULL )
+         ak_wpoint_set_odd_multiples( tq, &key->qpoint, ak_verifykey_wnaf_width, wc );
+     }
+     if( qtable != NULL ) ak_wpoint_pow2_affine_multiples( &items[i].cpoint, z1, qtable,
+                                                                 key->qwidth, z2, wc->size, wc );
+      else ak_wpoint_pow2_odd_multiples( &items[i].cpoint, z1, tq,
+                                               ak_verifykey_wnaf_width, z2, wc->size, wc );
+  }
+
+ /* одновременно приводим к аффинной форме все точки, отличные от бесконечно удаленной;
+    для этого переносим их в начало массива */
+  for( i = 0, zcount = 0; i < count; i++ ) {
+     if( ak_mpzn_cmp_ui( items[i].cpoint.z, wc->size, 0 )) {
+       results[items[i].idx] = ak_false;
+       continue;
+     }
+     if( zcount != i ) memcpy( items+zcount, items+i, sizeof( struct verify_batch_item ));
+     zcount++;
+  }
+  ak_verify_batch_invert( items, zcount, items[0].cpoint.z, wc->p, wc->n, wc->r2, wc->size );
+
+  for( i = 0; i < zcount; i++ ) {
+     ak_mpzn_mul_montgomery( items[i].cpoint.z, items[i].cpoint.z, one, wc->p, wc->n, wc->size );
+     ak_mpzn_mul_montgomery( items[i].cpoint.x,
+                             items[i].cpoint.x, items[i].cpoint.z, wc->p, wc->n, wc->size );
+     ak_mpzn_rem( items[i].cpoint.x, items[i].cpoint.x, wc->q, wc->size );
+     results[items[i].idx] = ( ak_mpzn_cmp( items[i].cpoint.x, items[i].r, wc->size ) == 0 );
+  }
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция проверяет `count` электронных подписей, заданных тройками
+    (открытый ключ, хеш-код сообщения, подпись), и помещает результат проверки каждой подписи
+    в массив `results`.
+
+    По сравнению с последовательным вызовом функции ak_verifykey_verify_hash()
+    функция экономит вычисления следующим образом:
+     - для подписей, вычисленных на одной эллиптической кривой, все обращения вычетов
+       по модулю \f$ q \f$ и по модулю \f$ p \f$ выполняются одновременно (методом Монтгомери),
+       т.е. с помощью одного возведения в степень для каждого модуля;
+     - для подписей, проверяемых на одном открытом ключе, нечетные кратные
+       точки \f$ Q \f$ вычисляются только один раз (или берутся из контекста ключа,
+       если была вызвана функция ak_verifykey_precompute()).
+
+    Функция не изменяет контексты открытых ключей, поэтому различные пакеты подписей
+    могут проверяться одновременно в нескольких потоках.
+
+    @param keys массив указателей на контексты открытых ключей.
+    @param hashes массив указателей на хеш-коды сообщений.
+    @param hsize размер каждого хеш-кода, в байтах; должен совпадать с размером параметров
+    эллиптической кривой открытого ключа.
+    @param signs массив указателей на электронные подписи.
+    @param results массив, в который помещаются результаты проверки подписей.
+    @param count количество проверяемых подписей.
+    @return Функция возвращает истину, если все подписи верны. Если хотя бы одна подпись не верна
+    или если возникла ошибка, то возвращается ложь. Код ошибки может получен с помощью
+    вызова функции ak_error_get_value().                                                           */
+/* ----------------------------------------------------------------------------------------------- */
+ bool_t ak_verifykey_verify_hash_batch( ak_verifykey *keys, ak_pointer *hashes,
+                      const size_t hsize, ak_pointer *signs, bool_t *results, const size_t count )
+{
+  ak_wcurve wc = NULL;
+  bool_t result = ak_true;
+  size_t i, j, k, group = 0;
+  ak_uint8 *used = NULL;
+  ak_verify_batch_item items = NULL;
+
+  if(( keys == NULL ) || ( hashes == NULL ) || ( signs == NULL ) || ( results == NULL )) {
+    ak_error_message( ak_error_null_pointer, __func__, "using a null pointer to batch arrays" );
+    return ak_false;
+  }
+  if( count == 0 ) return ak_true;
+
+  if(( items = malloc( count*sizeof( struct verify_batch_item ))) == NULL ) {
+    ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+    return ak_false;
+  }
+  if(( used = calloc( count, 1 )) == NULL ) {
+    free( items );
+    ak_error_message( ak_error_out_of_memory, __func__, "incorrect memory allocation" );
+    return ak_false;
+  }
+
+ /* отбрасываем некорректные элементы */
+  for( i = 0; i < count; i++ ) {
+     results[i] = ak_false;
+     if(( keys[i] == NULL ) || ( hashes[i] == NULL ) || ( signs[i] == NULL )) {
+       ak_error_message( ak_error_null_pointer, __func__, "using a null pointer to batch element" );
+       used[i] = 1;
+       continue;
+     }
+     if( hsize != sizeof( ak_uint64 )*( keys[i]->wc->size )) {
+       ak_error_message( ak_error_wrong_length, __func__, "using hash value with wrong length" );
+       used[i] = 1;
+     }
+  }
+
+ /* формируем группы подписей, вычисленных на одной кривой;
+    внутри группы подписи, проверяемые на одном ключе, следуют друг за другом */
+  for( i = 0; i < count; i++ ) {
+     if( used[i] ) continue;
+     wc = keys[i]->wc;
+     group = 0;
+     for( j = i; j < count; j++ ) {
+        if( used[j] || ( keys[j]->wc != wc )) continue;
+        for( k = j; k < count; k++ ) {
+           if( used[k] || ( keys[k] != keys[j] )) continue;
+           items[group++].idx = k;
+           used[k] = 1;
+        }
+     }
+     ak_verifykey_verify_batch_curve( items, group, keys, hashes, signs, results );
+  }
+
+  for( i = 0; i < count; i++ ) result &= results[i];
+  memset( items, 0, count*sizeof( struct verify_batch_item ));
+  free( items );
+  free( used );
+
+ return result;
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*! @param pctx контекст открытого ключа.
     @param in область памяти для которой проверяется электронная подпись.
@@ -294,7 +294,10 @@
   memset( &(skey->resource), 0, sizeof( struct resource )); /* ресурс ключа не определен */
 
  /* инициализируем генератор масок */
-  if(( error = ak_random_create_lcg( &skey->generator )) != ak_error_ok ) {
+  if( ak_libakrypt_get_option_by_name( "skey_mask_generator" ) == 1 )
+    error = ak_random_create_xoshiro256( &skey->generator );
+   else error = ak_random_create_lcg( &skey->generator );
+  if( error != ak_error_ok ) {
     ak_error_message( error, __func__ , "wrong creation of random generator" );
     ak_skey_destroy( skey );
     return error;
@@ -11,6 +11,12 @@
 #ifdef AK_HAVE_STDALIGN_H
  #include <stdalign.h>
 #endif
+#ifdef AK_HAVE_PTHREAD_H
+ #include <pthread.h>
+
+/*! \brief Максимальное количество потоков, используемых для шифрования секторов. */
+ #define ak_xts_max_threads             (64)
+#endif
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! Функция реализует алгоритм двухключевого шифрования, описываемый в стандарте IEEE P 1619.
@@ -271,6 +277,271 @@
   return error;
 }
 
+/* ----------------------------------------------------------------------------------------------- */
+/*                         реализация секторного интерфейса режима xts                             */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Количество 128-ми битных значений tweak, вырабатываемых за один проход. */
+ #define ak_xts_sector_chunk_size       (64)
+
+/*! \brief Структура, содержащая параметры обработки последовательности секторов
+    (передается в отдельный поток). */
+ typedef struct xts_sectors {
+  /*! \brief Ключ, используемый для шифрования информации. */
+   ak_bckey encryptionKey;
+  /*! \brief Ключ, используемый для преобразования номера сектора. */
+   ak_bckey authenticationKey;
+  /*! \brief Указатель на входные данные первого сектора. */
+   ak_uint8 *in;
+  /*! \brief Указатель на выходные данные первого сектора. */
+   ak_uint8 *out;
+  /*! \brief Размер одного сектора (в октетах). */
+   size_t sector_size;
+  /*! \brief Номер первого сектора. */
+   ak_uint64 first_sector;
+  /*! \brief Количество обрабатываемых секторов. */
+   size_t sector_count;
+  /*! \brief Функция зашифрования или расшифрования одного блока. */
+   ak_function_bckey *cipher;
+ } *ak_xts_sectors;
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция вырабатывает начальное значение tweak по номеру сектора.
+    \details Номер сектора записывается в порядке little endian и дополняется нулями до
+    128 бит (IEEE P 1619), то есть результат совпадает с результатом функции
+    ak_bckey_encrypt_xts(), если в качестве синхропосылки ей передан номер сектора.                */
+/* ----------------------------------------------------------------------------------------------- */
+ static inline void ak_xts_sector_tweak( ak_bckey authenticationKey,
+                                                           ak_uint64 sector, ak_uint64 *tweak )
+{
+ #ifdef AK_LITTLE_ENDIAN
+  tweak[0] = sector;
+ #else
+  tweak[0] = bswap_64( sector );
+ #endif
+  tweak[1] = 0;
+
+  if( authenticationKey->bsize == 8 ) {
+    authenticationKey->encrypt( &authenticationKey->key, tweak, tweak );
+    tweak[1] ^= tweak[0];
+    authenticationKey->encrypt( &authenticationKey->key, tweak+1, tweak+1 );
+  } else
+      authenticationKey->encrypt( &authenticationKey->key, tweak, tweak );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция обрабатывает заданную последовательность секторов.
+    \details Для каждого сектора данные обрабатываются фрагментами по
+    \ref ak_xts_sector_chunk_size значений tweak: сначала за один проход вырабатываются
+    все значения tweak фрагмента, потом выполняется маскирование входных данных,
+    шифрование всех блоков фрагмента и повторное маскирование. Функция не изменяет
+    ресурс ключей и не выполняет их перемаскирование, поэтому может одновременно
+    вызываться из нескольких потоков.                                                              */
+/* ----------------------------------------------------------------------------------------------- */
+ static void ak_xts_sectors_update( ak_xts_sectors ctx )
+{
+  size_t i = 0, k = 0, len = 0, offset = 0, tcount = 0;
+  const size_t bsize = ctx->encryptionKey->bsize;
+  ak_uint64 *inptr = NULL, *outptr = NULL, t[2];
+#ifdef AK_HAVE_STDALIGN_H
+  alignas(16)
+#endif
+  ak_uint64 tweak[2], mask[2*ak_xts_sector_chunk_size];
+
+  for( i = 0; i < ctx->sector_count; i++ ) {
+     ak_xts_sector_tweak( ctx->authenticationKey, ctx->first_sector + i, tweak );
+
+     for( offset = 0; offset < ctx->sector_size; offset += len ) {
+        len = ak_min( ctx->sector_size - offset, 16*ak_xts_sector_chunk_size );
+        inptr = ( ak_uint64 *)( ctx->in + i*ctx->sector_size + offset );
+        outptr = ( ak_uint64 *)( ctx->out + i*ctx->sector_size + offset );
+
+       /* вырабатываем значения tweak для всего фрагмента */
+        tcount = ( len + 15 ) >> 4;
+        for( k = 0; k < tcount; k++ ) {
+           mask[2*k] = tweak[0]; mask[2*k+1] = tweak[1];
+           t[0] = tweak[0] >> 63; t[1] = tweak[1] >> 63;
+           tweak[0] <<= 1; tweak[1] <<= 1;
+           tweak[1] ^= t[0];
+           if( t[1] ) tweak[0] ^= 0x87;
+        }
+
+       /* маскируем, шифруем и снова маскируем */
+        for( k = 0; k < ( len >> 3 ); k++ ) outptr[k] = inptr[k]^mask[k];
+        for( k = 0; k < len; k += bsize )
+           ctx->cipher( &ctx->encryptionKey->key,
+                                      ( ak_uint8 *)outptr + k, ( ak_uint8 *)outptr + k );
+        for( k = 0; k < ( len >> 3 ); k++ ) outptr[k] ^= mask[k];
+     }
+  }
+
+ /* ключевой генератор не может использоваться одновременно из нескольких потоков,
+    поэтому временные значения очищаются без его участия */
+  memset( tweak, 0, sizeof( tweak ));
+  memset( mask, 0, sizeof( mask ));
+}
+
+#ifdef AK_HAVE_PTHREAD_H
+/* ----------------------------------------------------------------------------------------------- */
+ static void *ak_xts_sectors_thread( void *ptr )
+{
+  ak_xts_sectors_update(( ak_xts_sectors )ptr );
+ return NULL;
+}
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция проверяет параметры и выполняет зашифрование/расшифрование секторов. */
+/* ----------------------------------------------------------------------------------------------- */
+ static int ak_bckey_xts_sectors( ak_bckey encryptionKey, ak_bckey authenticationKey,
+                          ak_pointer in, ak_pointer out, size_t sector_size,
+                                  ak_uint64 first_sector, size_t sector_count, bool_t encrypt )
+{
+  int error = ak_error_ok;
+  struct xts_sectors ctx;
+  ak_int64 blocks = 0, tweaks = 0;
+#ifdef AK_HAVE_PTHREAD_H
+  size_t idx = 0, part = 0, rest = 0, count = 0;
+  pthread_t threads[ak_xts_max_threads];
+  struct xts_sectors parts[ak_xts_max_threads];
+  bool_t started[ak_xts_max_threads];
+#endif
+
+ /* выполняем стандартные проверки */
+  if( encryptionKey == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                          "using null pointer to encryption key" );
+  if( authenticationKey == NULL ) return ak_error_message( ak_error_null_pointer, __func__ ,
+                                                      "using null pointer to authentication key" );
+  if(( in == NULL ) || ( out == NULL )) return ak_error_message( ak_error_null_pointer,
+                                                       __func__ , "using null pointer to data" );
+  if( !sector_size || !sector_count ) return ak_error_message( ak_error_zero_length,
+                                              __func__ , "using zero sector size or sector count" );
+  if(( sector_size%encryptionKey->bsize ) != 0 ) return ak_error_message(
+         ak_error_wrong_block_cipher_length, __func__ , "sector size is not divided by block length" );
+
+ /* проверяем целостность ключа */
+  if( encryptionKey->key.check_icode( &encryptionKey->key ) != ak_true )
+    return ak_error_message( ak_error_wrong_key_icode, __func__,
+                                               "incorrect integrity code of encryption key value" );
+  if( authenticationKey->key.check_icode( &authenticationKey->key ) != ak_true )
+    return ak_error_message( ak_error_wrong_key_icode, __func__,
+                                           "incorrect integrity code of authentication key value" );
+
+ /* проверяем и изменяем ресурсы ключей */
+  tweaks = ( ak_int64 )( sector_count*( authenticationKey->bsize >> 3 ));
+  blocks = ( ak_int64 )( sector_count*( sector_size/encryptionKey->bsize ));
+  if( authenticationKey->key.resource.value.counter < tweaks )
+    return ak_error_message( ak_error_low_key_resource,
+                                              __func__ , "low resource of authentication cipher key" );
+  if( encryptionKey->key.resource.value.counter < blocks )
+    return ak_error_message( ak_error_low_key_resource,
+                                              __func__ , "low resource of encryption cipher key" );
+  authenticationKey->key.resource.value.counter -= tweaks;
+  encryptionKey->key.resource.value.counter -= blocks;
+
+  ctx.encryptionKey = encryptionKey;
+  ctx.authenticationKey = authenticationKey;
+  ctx.in = in;
+  ctx.out = out;
+  ctx.sector_size = sector_size;
+  ctx.first_sector = first_sector;
+  ctx.sector_count = sector_count;
+  ctx.cipher = encrypt ? encryptionKey->encrypt : encryptionKey->decrypt;
+
+#ifdef AK_HAVE_PTHREAD_H
+ /* распределяем сектора между потоками: каждый поток получает непрерывную
+    последовательность секторов, первая последовательность обрабатывается текущим потоком */
+  count = ( size_t ) ak_libakrypt_get_option_by_name( "xts_sector_threads" );
+  if(( count < 1 ) || ( count > ak_xts_max_threads )) count = 1;
+  if( count > sector_count ) count = sector_count;
+  if( count > 1 ) {
+    part = sector_count/count; rest = sector_count%count;
+    for( idx = 0; idx < count; idx++ ) {
+       parts[idx] = ctx;
+       parts[idx].sector_count = part + ( idx < rest ? 1 : 0 );
+       if( idx > 0 ) {
+         parts[idx].first_sector = parts[idx-1].first_sector + parts[idx-1].sector_count;
+         parts[idx].in = parts[idx-1].in + parts[idx-1].sector_count*sector_size;
+         parts[idx].out = parts[idx-1].out + parts[idx-1].sector_count*sector_size;
+        /* если поток не создан, то сектора обрабатываются текущим потоком */
+         started[idx] = ( pthread_create( threads+idx, NULL,
+                                      ak_xts_sectors_thread, parts+idx ) == 0 ) ? ak_true : ak_false;
+       }
+    }
+    ak_xts_sectors_update( parts );
+    for( idx = 1; idx < count; idx++ ) {
+       if( started[idx] ) pthread_join( threads[idx], NULL );
+        else ak_xts_sectors_update( parts+idx );
+    }
+  } else
+#endif
+     ak_xts_sectors_update( &ctx );
+
+ /* перемаскируем ключ */
+  if(( error = encryptionKey->key.set_mask( &encryptionKey->key )) != ak_error_ok )
+    ak_error_message( error, __func__ , "wrong remasking of encryption key" );
+  if(( error = authenticationKey->key.set_mask( &authenticationKey->key )) != ak_error_ok )
+    ak_error_message( error, __func__ , "wrong remasking of authentication key" );
+
+ return error;
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция зашифровывает последовательность секторов (блоков данных одинаковой длины,
+    например, секторов блочного устройства или страниц базы данных) в режиме `XTS`.
+    Значение tweak каждого сектора вырабатывается из его номера, поэтому результат
+    зашифрования сектора с номером `n` совпадает с результатом функции
+    ak_bckey_encrypt_xts(), вызванной для данных этого сектора с синхропосылкой,
+    содержащей 64-х битное значение `n` в порядке little endian.
+
+    В отличие от последовательных вызовов функции ak_bckey_encrypt_xts(), проверка ключей,
+    изменение их ресурса и перемаскирование выполняются один раз для всех секторов.
+    Если библиотека собрана с поддержкой потоков, то сектора распределяются между
+    потоками, количество которых задается опцией библиотеки `xts_sector_threads`.
+
+    @param encryptionKey Ключ, используемый для шифрования информации
+    @param authenticationKey Ключ, используемый для преобразования номера сектора
+    @param in Указатель на область памяти, где хранятся входные (открытые) данные
+    @param out Указатель на область памяти, куда будут помещены зашифрованные данные;
+    может совпадать с `in`.
+    @param sector_size Размер одного сектора (в октетах), должен быть кратен длине блока.
+    @param first_sector Номер первого сектора.
+    @param sector_count Количество секторов.
+
+    @return В случае успеха функция возвращает \ref ak_error_ok (ноль). В случае возникновения
+    ошибки возвращается ее код.                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_encrypt_xts_sectors( ak_bckey encryptionKey, ak_bckey authenticationKey,
+                                 ak_pointer in, ak_pointer out, size_t sector_size,
+                                                    ak_uint64 first_sector, size_t sector_count )
+{
+  return ak_bckey_xts_sectors( encryptionKey, authenticationKey,
+                                    in, out, sector_size, first_sector, sector_count, ak_true );
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! Функция реализует обратное преобразование к алгоритму, реализуемому с помощью
+    функции ak_bckey_encrypt_xts_sectors().
+
+    @param encryptionKey Ключ, используемый для шифрования информации
+    @param authenticationKey Ключ, используемый для преобразования номера сектора
+    @param in Указатель на область памяти, где хранятся входные (зашифрованные) данные
+    @param out Указатель на область памяти, куда будут помещены расшифрованные данные;
+    может совпадать с `in`.
+    @param sector_size Размер одного сектора (в октетах), должен быть кратен длине блока.
+    @param first_sector Номер первого сектора.
+    @param sector_count Количество секторов.
+
+    @return В случае успеха функция возвращает \ref ak_error_ok (ноль). В случае возникновения
+    ошибки возвращается ее код.                                                                    */
+/* ----------------------------------------------------------------------------------------------- */
+ int ak_bckey_decrypt_xts_sectors( ak_bckey encryptionKey, ak_bckey authenticationKey,
+                                 ak_pointer in, ak_pointer out, size_t sector_size,
+                                                    ak_uint64 first_sector, size_t sector_count )
+{
+  return ak_bckey_xts_sectors( encryptionKey, authenticationKey,
+                                   in, out, sector_size, first_sector, sector_count, ak_false );
+}
+
 /* ----------------------------------------------------------------------------------------------- */
 /*                 реализация режима аутентифицирующего шифрования xtsmac                          */
 /* ----------------------------------------------------------------------------------------------- */
@@ -14,6 +14,16 @@
 /** \addtogroup mac-doc
  @{ */
  extern const ak_uint64 streebog_Areverse_expand_with_pi[8][256];
+/*! \brief Перестановка Keccak-f[1600], применяемая к внутреннему состоянию губки. */
+ void ak_keccak_permutation( ak_uint64 * );
+/*! \brief Инициализация контекста функции cSHAKE128 или cSHAKE256 (NIST SP 800-185). */
+ int ak_keccak_create_cshake( ak_keccak , const size_t ,
+                               const ak_pointer , const size_t , const ak_pointer , const size_t );
+/*! \brief Впитывание строки вида bytepad( encode_string( K ), rate ) для секретного ключа,
+    хранящегося в маскированном виде. */
+ int ak_keccak_absorb_skey( ak_keccak , ak_skey );
+/*! \brief Впитывание натурального числа в формате right_encode (NIST SP 800-185). */
+ int ak_keccak_absorb_right_encode( ak_keccak , const size_t );
 /** @} */
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -28,6 +38,8 @@
  int ak_bckey_create( ak_bckey , size_t , size_t );
 /*! \brief Инициализация ключа алгоритма блочного шифрования значением другого ключа */
  int ak_bckey_create_and_set_bckey( ak_bckey , ak_bckey );
+/*! \brief Замена значения ключа алгоритма блочного шифрования без перераспределения памяти. */
+ int ak_bckey_replace_key( ak_bckey , const ak_uint8 * );
 /*! \brief Процедура вычисления производного ключа в соответствии с алгоритмом ACPKM
     из рекомендаций Р 1323565.1.012-2018. */
  int ak_bckey_next_acpkm_key( ak_bckey );
@@ -51,6 +63,33 @@
                                                                 const sbox , ak_kuznechik_params );
 /*! \brief Инициализация внутренних переменных значениями, регламентируемыми ГОСТ Р 34.12-2015. */
  int ak_bckey_kuznechik_init_gost_tables( void );
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Текущее положение в последовательности фрагментов данных. */
+ typedef struct iov_cursor {
+  /*! \brief Указатель на текущий фрагмент. */
+   const struct iovec *iov;
+  /*! \brief Количество фрагментов, включая текущий. */
+   size_t count;
+  /*! \brief Смещение внутри текущего фрагмента. */
+   size_t offset;
+ } *ak_iov_cursor;
+
+/*! \brief Функция обработки непрерывной области памяти, используемая при обработке
+    последовательностей фрагментов. */
+ typedef int ( ak_function_iov )( ak_pointer , const ak_uint8 * , ak_uint8 * , const size_t );
+
+/*! \brief Вычисление суммарной длины последовательности фрагментов. */
+ int ak_iov_length( const struct iovec * , const size_t , size_t * );
+/*! \brief Установка курсора на начало последовательности фрагментов. */
+ void ak_iov_cursor_set( ak_iov_cursor , const struct iovec * , const size_t );
+/*! \brief Копирование данных из последовательности фрагментов в область памяти. */
+ int ak_iov_cursor_gather( ak_iov_cursor , ak_uint8 * , const size_t );
+/*! \brief Копирование данных из области памяти в последовательность фрагментов. */
+ int ak_iov_cursor_scatter( ak_iov_cursor , const ak_uint8 * , const size_t );
+/*! \brief Поблочная обработка данных, расположенных в последовательностях фрагментов. */
+ int ak_iov_cursor_process( ak_iov_cursor , ak_iov_cursor , size_t , const size_t ,
+                                                                ak_function_iov * , ak_pointer );
 /** @} */
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -74,6 +113,40 @@
  int ak_mac_file( ak_mac , const char* , ak_pointer , const size_t );
 /** @} */
 
+/** \addtogroup curves-doc
+ @{ */
+/*! \brief Параметры искривленной кривой Эдвардса \f$ u^2 + v^2 = 1 + du^2v^2 \f$,
+    эквивалентной кривой в форме Вейерштрасса (все значения в обычной форме). */
+ typedef struct wcurve_edwards {
+  /*! \brief Эквивалентная кривая в форме Вейерштрасса. */
+   const struct wcurve *wc;
+  /*! \brief Коэффициент \f$ d \f$ кривой Эдвардса. */
+   ak_uint64 d[ak_mpzn512_size];
+  /*! \brief Константа \f$ s = (1-d)/4 \pmod{p} \f$. */
+   ak_uint64 s[ak_mpzn512_size];
+  /*! \brief Константа \f$ t = (1+d)/6 \pmod{p} \f$. */
+   ak_uint64 t[ak_mpzn512_size];
+ } *ak_wcurve_edwards;
+/*! \brief Параметры кривых Эдвардса для кривых, поддерживаемых библиотекой;
+    массив завершается элементом с нулевым указателем на кривую. */
+ extern const struct wcurve_edwards ak_wcurve_edwards_params[];
+
+/*! \brief Удаление таблиц кратных образующих точек эллиптических кривых. */
+ void ak_wcurve_tables_destroy( void );
+/*! \brief Вычисление нечетных кратных точки эллиптической кривой. */
+ void ak_wpoint_set_odd_multiples( ak_wpoint , ak_wpoint , const size_t , ak_wcurve );
+/*! \brief Вычисление суммы кратных образующей точки и точки, для которой заранее вычислены
+    нечетные кратные. */
+ void ak_wpoint_pow2_odd_multiples( ak_wpoint , ak_uint64 *, ak_wpoint ,
+                                              const size_t , ak_uint64 *, size_t , ak_wcurve );
+/*! \brief Вычисление аффинных координат нечетных кратных точки эллиптической кривой. */
+ int ak_wpoint_set_affine_multiples( ak_uint64 *, ak_wpoint , const size_t , ak_wcurve );
+/*! \brief Вычисление суммы кратных образующей точки и точки, для которой заранее вычислены
+    аффинные координаты нечетных кратных. */
+ void ak_wpoint_pow2_affine_multiples( ak_wpoint , ak_uint64 *, ak_uint64 * ,
+                                              const size_t , ak_uint64 *, size_t , ak_wcurve );
+/** @} */
+
 /** \addtogroup aead-doc
  @{ */
  #define ak_aead_assosiated_data_bit  (0x1)
@@ -154,6 +154,16 @@ extern "C" {
  dll_export bool_t ak_libakrypt_test_streebog256( void );
 /*! \brief Проверка корректной работы функции хеширования Стрибог-512 */
  dll_export bool_t ak_libakrypt_test_streebog512( void );
+/*! \brief Проверка корректной работы функций хеширования семейства SHA-3 (FIPS 202). */
+ dll_export bool_t ak_libakrypt_test_sha3( void );
+/*! \brief Проверка корректной работы функций с расширяемым выходом SHAKE128 и SHAKE256. */
+ dll_export bool_t ak_libakrypt_test_shake( void );
+/*! \brief Проверка совпадения результатов многопоточной (4-way) и обычной реализаций Keccak. */
+ dll_export bool_t ak_libakrypt_test_keccak_x4( void );
+/*! \brief Проверка корректной работы генератора псевдо-случайных чисел drbg. */
+ dll_export bool_t ak_libakrypt_test_drbg( void );
+/*! \brief Функция проверяет корректность реализации генераторов псевдо-случайных чисел. */
+ dll_export bool_t ak_libakrypt_test_random_generators( void );
 /*! \brief Функция проверяет корректность реализации алгоритмов хэширования. */
  dll_export bool_t ak_libakrypt_test_hash_functions( void );
 /*! \brief Функция проверяет корректность реализации алгоритмов выработки имитовставки. */
@@ -163,17 +173,25 @@ extern "C" {
  dll_export bool_t ak_libakrypt_test_hmac_streebog( void );
 /*! \brief Тестирование алгоритма PBKDF2, регламентируемого Р 50.1.113-2016. */
  dll_export bool_t ak_libakrypt_test_pbkdf2( void );
+/*! \brief Тестирование алгоритмов выработки имитовставки KMAC128 и KMAC256 (NIST SP 800-185). */
+ dll_export bool_t ak_libakrypt_test_kmac( void );
 /*! \brief Функция тестирует корректность реализации блочных шифрова и режимов их использования. */
  dll_export bool_t ak_libakrypt_test_block_ciphers( void ); 
 /*! \brief Тестирование корректной работы алгоритма блочного шифрования Магма (ГОСТ Р 34.12-2015). */
  dll_export bool_t ak_libakrypt_test_magma( void );
 /*! \brief Тестирование корректной работы алгоритма блочного шифрования Кузнечик (ГОСТ Р 34.12-2015). */
  dll_export bool_t ak_libakrypt_test_kuznechik( void );
+/*! \brief Тестирование корректной работы алгоритма блочного шифрования AES (FIPS 197). */
+ dll_export bool_t ak_libakrypt_test_aes( void );
 /*! \brief Функция тестирует корректность реаличных реализаций алгоритма cmac. */
  dll_export bool_t ak_libakrypt_test_cmac( void );
 /*! \brief Тестирование корректной работы режима блочного шифрования с одновременной
     выработкой имитовставки. */
  dll_export bool_t ak_libakrypt_test_mgm( void );
+/*! \brief Тестирование корректной работы режима аутентифицированного шифрования `OCB`. */
+ dll_export bool_t ak_libakrypt_test_ocb( void );
+/*! \brief Тестирование корректной работы режима аутентифицированного шифрования `GCM`. */
+ dll_export bool_t ak_libakrypt_test_gcm( void );
 /*! \brief Тестирование корректной работы режима шифрования `ACPKM`, регламентируемого Р 1323565.1.017—2018. */
  dll_export bool_t ak_libakrypt_test_acpkm( void );
 /*! \brief Выполнение тестовых примеров для алгоритмов выработки и проверки электронной подписи */
@@ -406,6 +424,8 @@ extern "C" {
        ak_uint64 val;
      /*! \brief Внутреннее состояние xorshift32 генератора */
        ak_uint32 value;
+     /*! \brief Внутреннее состояние генератора xoshiro256** */
+       ak_uint64 xs[4];
      /*! \brief Файловый дескриптор */
        int fd;
     #ifdef AK_HAVE_WINDOWS_H
@@ -420,6 +440,8 @@ extern "C" {
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Инициализация контекста линейного конгруэнтного генератора псевдо-случайных чисел. */
  dll_export int ak_random_create_lcg( ak_random );
+/*! \brief Инициализация контекста генератора xoshiro256**, вырабатывающего маски секретных ключей. */
+ dll_export int ak_random_create_xoshiro256( ak_random );
  /*! \brief Инициализация контекста генератора, считывающего случайные значения из заданного файла. */
  dll_export int ak_random_create_file( ak_random , const char * );
 #if defined(__unix__) || defined(__APPLE__)
@@ -428,10 +450,19 @@ extern "C" {
 /*! \brief Инициализация контекста генератора, считывающего случайные значения из /dev/urandom. */
  dll_export int ak_random_create_urandom( ak_random );
 #endif
+#ifdef AK_HAVE_SYSRANDOM_H
+/*! \brief Инициализация контекста генератора, использующего системный вызов getrandom(). */
+ dll_export int ak_random_create_getrandom( ak_random );
+#endif
 #ifdef _WIN32
 /*! \brief Инициализация контекста, реализующего интерфейс доступа к генератору псевдо-случайных чисел, предоставляемому ОС Windows. */
  dll_export int ak_random_create_winrtl( ak_random );
 #endif
+/*! \brief Инициализация контекста генератора, основанного на блочном шифре Кузнечик
+    в режиме гаммирования (Р 1323565.1.006-2017, NIST SP 800-90A). */
+ dll_export int ak_random_create_drbg( ak_random );
+/*! \brief Обновление внутреннего состояния генератора drbg с использованием источника энтропии ОС. */
+ dll_export int ak_random_drbg_reseed( ak_random , const ak_pointer , const size_t );
 /*! \brief Инициализация контекста генератора по заданному OID алгоритма генерации псевдо-случайных чисел. */
  dll_export int ak_random_create_oid( ak_random, ak_oid );
 /*! \brief Установка внутреннего состояния генератора псевдо-случайных чисел. */
@@ -648,6 +679,8 @@ extern "C" {
  typedef int ( ak_function_bckey_create ) ( ak_bckey );
 /*! \brief Функция зашифрования/расширования одного блока информации. */
  typedef void ( ak_function_bckey )( ak_skey, ak_pointer, ak_pointer );
+/*! \brief Функция зашифрования/расшифрования последовательности блоков в режиме гаммирования. */
+ typedef void ( ak_function_bckey_ctr )( ak_skey, ak_pointer, ak_pointer, ak_pointer, size_t );
 /*! \brief Функция, предназначенная для зашифрования/расшифрования области памяти заданного размера */
  typedef int ( ak_function_bckey_encrypt )( ak_bckey, ak_pointer, ak_pointer, size_t,
                                                                                 ak_pointer, size_t );
@@ -668,6 +701,9 @@ extern "C" {
    ak_function_bckey *encrypt;
   /*! \brief Функция расширования одного блока информации. */
    ak_function_bckey *decrypt;
+  /*! \brief Функция выработки гаммы и зашифрования последовательности блоков в режиме
+      гаммирования (может принимать значение NULL). */
+   ak_function_bckey_ctr *ctr;
   /*! \brief Функция развертки ключа. */
    ak_function_skey *schedule_keys;
   /*! \brief Функция уничтожения развернутых ключей. */
@@ -679,6 +715,10 @@ extern "C" {
  dll_export int ak_bckey_create_magma( ak_bckey );
 /*! \brief Инициализация секретного ключа алгоритма блочного шифрования Кузнечик. */
  dll_export int ak_bckey_create_kuznechik( ak_bckey );
+/*! \brief Инициализация секретного ключа алгоритма блочного шифрования AES с длиной ключа 128 бит. */
+ dll_export int ak_bckey_create_aes128( ak_bckey );
+/*! \brief Инициализация секретного ключа алгоритма блочного шифрования AES с длиной ключа 256 бит. */
+ dll_export int ak_bckey_create_aes256( ak_bckey );
 /*! \brief Инициализация секретного ключа алгоритма блочного шифрования по его OID. */
  dll_export int ak_bckey_create_oid( ak_bckey , ak_oid );
 /*! \brief Очистка ключа алгоритма блочного шифрования. */
@@ -721,6 +761,8 @@ extern "C" {
    sbox pinv;
   /*! \brief Развернутые таблицы, используемые для эффективного расшифрования */
    expanded_table dec;
+  /*! \brief Итерационные константы, используемые в процедуре развертки ключа */
+   ak_uint64 cons[32][2];
  } *ak_kuznechik_params;
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -739,6 +781,10 @@ extern "C" {
 /*! \brief Шифрование данных в режиме гаммирования из ГОСТ Р 34.13-2015
    (counter mode, ctr). */
  dll_export int ak_bckey_ctr( ak_bckey , ak_pointer , ak_pointer , size_t , ak_pointer , size_t );
+/*! \brief Шифрование в режиме гаммирования из ГОСТ Р 34.13-2015 данных, расположенных
+    в последовательности фрагментов. */
+ dll_export int ak_bckey_ctr_iov( ak_bckey , const struct iovec * , const size_t ,
+                           const struct iovec * , const size_t , ak_pointer , const size_t );
 /*! \brief Шифрование данных в режиме гаммирования с обратной связью по выходу
    (output feedback, ofb). */
  dll_export int ak_bckey_ofb( ak_bckey , ak_pointer , ak_pointer , size_t , ak_pointer , size_t );
@@ -759,6 +805,53 @@ extern "C" {
 /*! \brief Расшифрование данных в режиме `XTS`. */
  dll_export int ak_bckey_decrypt_xts( ak_bckey ,  ak_bckey , ak_pointer , ak_pointer , size_t ,
                                                                              ak_pointer , size_t );
+/*! \brief Зашифрование последовательности секторов в режиме `XTS`. */
+ dll_export int ak_bckey_encrypt_xts_sectors( ak_bckey , ak_bckey , ak_pointer , ak_pointer ,
+                                                                  size_t , ak_uint64 , size_t );
+/*! \brief Расшифрование последовательности секторов в режиме `XTS`. */
+ dll_export int ak_bckey_decrypt_xts_sectors( ak_bckey , ak_bckey , ak_pointer , ak_pointer ,
+                                                                  size_t , ak_uint64 , size_t );
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Буффер предварительно выработанной гаммы режима гаммирования.
+    \details Гамма режима гаммирования зависит только от ключа и синхропосылки, поэтому
+    может быть выработана до поступления данных; зашифрование сводится к сложению данных
+    с гаммой, хранящейся в кольцевом буффере. Значение счетчика хранится в контексте ключа,
+    ресурс ключа расходуется в момент выработки гаммы. Неиспользованная гамма хранится
+    в открытом виде, поэтому размер буффера ограничен (не более 64 килобайт), а каждый
+    использованный фрагмент гаммы сразу обнуляется.                                                */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct ctr_reservoir {
+  /*! \brief Ключ блочного шифра, используемый для выработки гаммы. */
+   ak_bckey bkey;
+  /*! \brief Кольцевой буффер, содержащий выработанную гамму. */
+   ak_uint8 *buffer;
+  /*! \brief Размер буффера в октетах (кратен длине блока). */
+   size_t size;
+  /*! \brief Смещение первого неиспользованного октета гаммы. */
+   size_t head;
+  /*! \brief Количество выработанных, но не использованных октетов гаммы. */
+   size_t count;
+  /*! \brief Флаг того, что синхропосылка установлена и гамма может вырабатываться. */
+   bool_t ready;
+  /*! \brief Код ошибки, возникшей при выработке гаммы. */
+   int error;
+  /*! \brief Данные потока, вырабатывающего гамму (NULL, если поток не используется). */
+   ak_pointer sync;
+ } *ak_ctr_reservoir;
+
+/*! \brief Создание буффера предварительно выработанной гаммы. */
+ dll_export int ak_ctr_reservoir_create( ak_ctr_reservoir , ak_bckey , const size_t ,
+                                                                                  const bool_t );
+/*! \brief Уничтожение буффера предварительно выработанной гаммы. */
+ dll_export int ak_ctr_reservoir_destroy( ak_ctr_reservoir );
+/*! \brief Установка синхропосылки и сброс ранее выработанной гаммы. */
+ dll_export int ak_ctr_reservoir_set_iv( ak_ctr_reservoir , ak_pointer , const size_t );
+/*! \brief Заполнение буффера гаммой. */
+ dll_export int ak_ctr_reservoir_fill( ak_ctr_reservoir );
+/*! \brief Зашифрование (расшифрование) данных с использованием выработанной гаммы. */
+ dll_export int ak_ctr_reservoir_xor( ak_ctr_reservoir , ak_pointer , ak_pointer ,
+                                                                                  const size_t );
 /** @} */
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -774,6 +867,10 @@ extern "C" {
 /*! \brief Завершение вычисления имитовставки согласно ГОСТ Р 34.13-2015. */
  dll_export int ak_bckey_cmac_finalize( ak_bckey , const ak_pointer , const size_t ,
                                                                        ak_pointer , const size_t );
+/*! \brief Вычисление имитовставки согласно ГОСТ Р 34.13-2015 от данных, расположенных
+    в последовательности фрагментов. */
+ dll_export int ak_bckey_cmac_iov( ak_bckey , const struct iovec * , const size_t ,
+                                                                       ak_pointer , const size_t );
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Функция очистки контекста хеширования. */
  typedef int ( ak_function_clean )( ak_pointer );
@@ -787,7 +884,7 @@ extern "C" {
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Максимальный размер блока входных данных в октетах (байтах). */
- #define ak_mac_max_buffer_size (64)
+ #define ak_mac_max_buffer_size (168)
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Контекст алгоритма итерационного сжатия. */
@@ -815,60 +912,72 @@ extern "C" {
 /*! \brief Структура для хранения внутренних данных функций хеширования семейства Стрибог. */
 /* ----------------------------------------------------------------------------------------------- */
  typedef struct streebog {
+ /*! \brief Размер блока выходных данных (хеш-кода)*/
+  size_t hsize;
  /*! \brief Вектор h - временный */
   ak_uint64 h[8];
  /*! \brief Вектор n - временный */
   ak_uint64 n[8];
  /*! \brief Вектор  \f$ \Sigma \f$ - контрольная сумма */
   ak_uint64 sigma[8];
- /*! \brief Размер блока выходных данных (хеш-кода)*/
-  size_t hsize;
 } *ak_streebog;
 
- /* ----------------------------------------------------------------------------------------------- */
-/*! \brief Структура для хранения внутренних данных функции хеширования KECCAK SHA-3               */
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Структура для хранения внутреннего состояния губки Keccak (SHA-3, SHAKE, cSHAKE). */
+/*! Состояние губки хранится в виде 25 64-х битных слов (lanes), слово с индексом \f$ x + 5y \f$
+    соответствует элементу \f$ A[x,y] \f$ из FIPS 202. Помимо функций хеширования SHA-3, контекст
+    используется функциями с расширяемым выходом SHAKE128/SHAKE256, для которых выработка
+    выходной последовательности (squeeze) может производиться фрагментами произвольной длины. */
 /* ----------------------------------------------------------------------------------------------- */
  typedef struct keccak {
- 
-         /*! \brief Переменная, определяющая вид функции - SHA-224, 256, 384, 512? Соответственно,
-         переменная должна быть равна 224, 256, 384 или же 512.                                        */
-         int ftype;
-
-         /*! \brief Указатель на имеющееся сообщение                                                   */
-         ak_uint8* msg;
-
-         /*! \brief Блок размером в 1600 бит - содержит от r = 576 бит сообщения и 1024 нулевых бит
-         (для SHA3-512 при условии полного заполнения) до r = 1152 бит сообщения и 448 нулевых бит
-         (для SHA3-224 при условии полного заполнения) при условии, что сообщение целиком не помещается
-         в блок*/
-         ak_uint8 block[200];
-
-         /*! \brief Идентификатор байта сообщения, используемый при заполнении очередного блока        */
-         long long int bn;
-
-         /*! \brief Размер сообщения в байтах                                                          */
-         long long int msg_size;
-
-         /*! \brief Блок для хранения итогового результата размером в 1600 бит - из него извлекается
-         результат - от 224 до 512 бит, в зависимости от выбранной функции. Также служит для сохранения
-         промежуточного результата выполнения функции                                                  */
-         ak_uint8 res[200];
-
- } ak_keccak;
-
+ /*! \brief Размер блока выходных данных (хеш-кода); поле должно быть первым,
+     поскольку размер хеш-кода считывается через любой элемент объединения в struct hash */
+  size_t hsize;
+ /*! \brief Внутреннее состояние губки (1600 бит) */
+  ak_uint64 st[25];
+ /*! \brief Размер блока входных данных, равный \f$ r/8 \f$ (в октетах) */
+  size_t rate;
+ /*! \brief Текущая позиция внутри блока при впитывании или отжимании данных */
+  size_t pos;
+ /*! \brief Октет, содержащий суффикс домена и первый бит дополнения */
+  ak_uint8 padding;
+ /*! \brief Флаг функции с расширяемым выходом */
+  bool_t xof;
+ /*! \brief Флаг того, что контекст переведен в режим выработки выходной последовательности */
+  bool_t squeezing;
+} *ak_keccak;
+
+/*! \brief Инициализация контекста функции с расширяемым выходом SHAKE128. */
+ dll_export int ak_keccak_create_shake128( ak_keccak );
+/*! \brief Инициализация контекста функции с расширяемым выходом SHAKE256. */
+ dll_export int ak_keccak_create_shake256( ak_keccak );
+/*! \brief Уничтожение контекста губки Keccak. */
+ dll_export int ak_keccak_destroy( ak_keccak );
+/*! \brief Возвращение контекста губки Keccak в начальное состояние. */
+ dll_export int ak_keccak_clean( ak_keccak );
+/*! \brief Впитывание (absorb) данных произвольной длины. */
+ dll_export int ak_keccak_absorb( ak_keccak , const ak_pointer , const size_t );
+/*! \brief Выработка (squeeze) очередного фрагмента выходной последовательности. */
+ dll_export int ak_keccak_squeeze( ak_keccak , ak_pointer , const size_t );
+/*! \brief Одновременное вычисление хеш-кодов SHA-3 для четырех независимых сообщений. */
+ dll_export int ak_keccak_sha3_x4( const size_t , const ak_pointer [4], const size_t [4],
+                                                                                 ak_pointer [4] );
+/*! \brief Одновременная выработка выходов SHAKE128 для четырех независимых сообщений. */
+ dll_export int ak_keccak_shake128_x4( const ak_pointer [4], const size_t [4],
+                                                                 ak_pointer [4], const size_t );
+/*! \brief Одновременная выработка выходов SHAKE256 для четырех независимых сообщений. */
+ dll_export int ak_keccak_shake256_x4( const ak_pointer [4], const size_t [4],
+                                                                 ak_pointer [4], const size_t );
 
- /*! \brief Единая функция для получения хеша, включающая SHA-224, 256, 384, 512                   */
- dll_export int ak_sha3_function( ak_keccak, ak_uint8[]);
- dll_export int ak_sha3_tests();
- //*dll_export void ak_sha3_get_hash(); не нужна*/
- 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Контекст бесключевой функции хеширования. */
 /*! \details Класс предоставляет интерфейс для реализации бесключевых функций хеширования, построенных
     с использованием итеративных сжимающих отображений. В настоящее время
-    с использованием класса \ref hash реализованы следующие отечественные алгоритмы хеширования
+    с использованием класса \ref hash реализованы следующие алгоритмы хеширования
      - Стрибог256,
-     - Стрибог512.
+     - Стрибог512,
+     - SHA3-224, SHA3-256, SHA3-384, SHA3-512,
+     - SHAKE128, SHAKE256 (с фиксированной длиной хеш-кода 256 и 512 бит соответственно).
 
   Перед началом работы контекст функции хеширования должен быть инициализирован
   вызовом одной из функций инициализации, например, функции ak_hash_create_streebog256()
@@ -885,6 +994,8 @@ extern "C" {
    union {
    /*! \brief Структура алгоритмов семейства Стрибог. */
     struct streebog sctx;
+   /*! \brief Структура алгоритмов семейства SHA-3. */
+    struct keccak kctx;
    } data;
  } *ak_hash;
 
@@ -893,6 +1004,18 @@ extern "C" {
  dll_export int ak_hash_create_streebog256( ak_hash );
 /*! \brief Инициализация контекста функции бесключевого хеширования ГОСТ Р 34.11-2012 (Стрибог512). */
  dll_export int ak_hash_create_streebog512( ak_hash );
+/*! \brief Инициализация контекста функции бесключевого хеширования SHA3-224. */
+ dll_export int ak_hash_create_sha3_224( ak_hash );
+/*! \brief Инициализация контекста функции бесключевого хеширования SHA3-256. */
+ dll_export int ak_hash_create_sha3_256( ak_hash );
+/*! \brief Инициализация контекста функции бесключевого хеширования SHA3-384. */
+ dll_export int ak_hash_create_sha3_384( ak_hash );
+/*! \brief Инициализация контекста функции бесключевого хеширования SHA3-512. */
+ dll_export int ak_hash_create_sha3_512( ak_hash );
+/*! \brief Инициализация контекста функции хеширования SHAKE128 (длина хеш-кода 256 бит). */
+ dll_export int ak_hash_create_shake128( ak_hash );
+/*! \brief Инициализация контекста функции хеширования SHAKE256 (длина хеш-кода 512 бит). */
+ dll_export int ak_hash_create_shake256( ak_hash );
 /*! \brief Инициализация контекста функции бесключевого хеширования по заданному OID алгоритма. */
  dll_export int ak_hash_create_oid( ak_hash, ak_oid );
 /*! \brief Уничтожение контекста функции хеширования. */
@@ -957,6 +1080,39 @@ extern "C" {
 /*! \brief Присвоение секретному ключу значения, выработанного из пароля */
  dll_export int ak_hmac_set_key_from_password( ak_hmac , const ak_pointer , const size_t ,
                                                                  const ak_pointer , const size_t );
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Секретный ключ алгоритма выработки имитовставки KMAC. */
+/*!  Алгоритмы KMAC128 и KMAC256 описываются документом NIST SP 800-185 и построены на основе
+     функций cSHAKE128 и cSHAKE256 соответственно. Состояние губки после впитывания имени функции
+     и строки настройки (customization string) не зависит от ключа, поэтому вычисляется
+     один раз и хранится в поле `iv`.                                                              */
+/* ----------------------------------------------------------------------------------------------- */
+ typedef struct kmac {
+  /*! \brief Контекст секретного ключа */
+   struct skey key;
+  /*! \brief Контекст итерационного сжатия. */
+   struct mac mctx;
+  /*! \brief Контекст губки Keccak */
+   struct keccak kctx;
+  /*! \brief Состояние губки после впитывания строки настройки */
+   ak_uint64 iv[25];
+} *ak_kmac;
+
+/*! \brief Создание секретного ключа алгоритма выработки имитовставки KMAC128. */
+ dll_export int ak_kmac_create_kmac128( ak_kmac );
+/*! \brief Создание секретного ключа алгоритма выработки имитовставки KMAC256. */
+ dll_export int ak_kmac_create_kmac256( ak_kmac );
+/*! \brief Создание секретного ключа алгоритма выработки имитовставки KMAC c помощью заданного oid. */
+ dll_export int ak_kmac_create_oid( ak_kmac , ak_oid );
+/*! \brief Уничтожение секретного ключа. */
+ dll_export int ak_kmac_destroy( ak_kmac );
+/*! \brief Присвоение секретному ключу константного значения. */
+ dll_export int ak_kmac_set_key( ak_kmac , const ak_pointer , const size_t );
+/*! \brief Присвоение секретному ключу случайного значения. */
+ dll_export int ak_kmac_set_key_random( ak_kmac , ak_random );
+/*! \brief Присвоение алгоритму KMAC строки настройки (customization string). */
+ dll_export int ak_kmac_set_customization( ak_kmac , const ak_pointer , const size_t );
 /** @} */
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -983,6 +1139,25 @@ extern "C" {
 /*! \brief Развертка ключевого вектора из пароля (согласно Р 50.1.111-2016, раздел 4) */
  dll_export int ak_hmac_pbkdf2_streebog512( const ak_pointer , const size_t ,
                    const ak_pointer , const size_t, const size_t , const size_t , ak_pointer );
+
+/* ----------------------------------------------------------------------------------------------- */
+/*! \brief Функция возвращает размер вырабатываемой имитовставки. */
+ dll_export size_t ak_kmac_get_tag_size( ak_kmac );
+/*! \brief Функция возвращает размер блока входных данных, обрабатываемого функцией выработки имитовставки. */
+ dll_export size_t ak_kmac_get_block_size( ak_kmac );
+/*! \brief Очистка контекста секретного ключа алгоритма выработки имитовставки KMAC, а также
+    проверка ресурса ключа. */
+ dll_export int ak_kmac_clean( ak_kmac );
+/*! \brief Обновление текущего состояния контекста алгоритма выработки имитовставки KMAC. */
+ dll_export int ak_kmac_update( ak_kmac , const ak_pointer , const size_t );
+/*! \brief Завершение алгоритма выработки имитовставки KMAC. */
+ dll_export int ak_kmac_finalize( ak_kmac , const ak_pointer , const size_t ,
+                                                                       ak_pointer , const size_t );
+/*! \brief Вычисление имитовставки для заданной области памяти. */
+ dll_export int ak_kmac_ptr( ak_kmac , const ak_pointer , const size_t ,
+                                                                       ak_pointer , const size_t );
+/*! \brief Вычисление имитовставки для заданного файла. */
+ dll_export int ak_kmac_file( ak_kmac , const char* , ak_pointer , const size_t );
 /** @} */
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -1011,6 +1186,35 @@ extern "C" {
  dll_export int ak_bckey_decrypt_xtsmac( ak_pointer , ak_pointer , const ak_pointer ,
     const size_t , const ak_pointer , ak_pointer , const size_t , const ak_pointer , const size_t ,
                                                                           ak_pointer, const size_t );
+/*! \brief Зашифрование в режиме `mgm` данных, расположенных в последовательностях фрагментов. */
+ dll_export int ak_bckey_encrypt_mgm_iov( ak_pointer , ak_pointer , const struct iovec * ,
+       const size_t , const struct iovec * , const size_t , const struct iovec * , const size_t ,
+                          const ak_pointer , const size_t , ak_pointer , const size_t );
+/*! \brief Расшифрование в режиме `mgm` данных, расположенных в последовательностях фрагментов. */
+ dll_export int ak_bckey_decrypt_mgm_iov( ak_pointer , ak_pointer , const struct iovec * ,
+       const size_t , const struct iovec * , const size_t , const struct iovec * , const size_t ,
+                          const ak_pointer , const size_t , ak_pointer , const size_t );
+
+/*! \brief Зашифрование данных в режиме `ocb` с одновременной выработкой имитовставки
+    согласно RFC 7253. */
+ dll_export int ak_bckey_encrypt_ocb( ak_pointer , ak_pointer , const ak_pointer ,
+    const size_t , const ak_pointer , ak_pointer , const size_t , const ak_pointer , const size_t ,
+                                                                         ak_pointer , const size_t );
+/*! \brief Расшифрование данных в режиме `ocb` с одновременной проверкой имитовставки
+    согласно RFC 7253. */
+ dll_export int ak_bckey_decrypt_ocb( ak_pointer , ak_pointer , const ak_pointer ,
+    const size_t , const ak_pointer , ak_pointer , const size_t , const ak_pointer , const size_t ,
+                                                                          ak_pointer, const size_t );
+/*! \brief Зашифрование данных в режиме `gcm` с одновременной выработкой имитовставки
+    согласно NIST SP 800-38D. */
+ dll_export int ak_bckey_encrypt_gcm( ak_pointer , ak_pointer , const ak_pointer ,
+    const size_t , const ak_pointer , ak_pointer , const size_t , const ak_pointer , const size_t ,
+                                                                         ak_pointer , const size_t );
+/*! \brief Расшифрование данных в режиме `gcm` с одновременной проверкой имитовставки
+    согласно NIST SP 800-38D. */
+ dll_export int ak_bckey_decrypt_gcm( ak_pointer , ak_pointer , const ak_pointer ,
+    const size_t , const ak_pointer , ak_pointer , const size_t , const ak_pointer , const size_t ,
+                                                                          ak_pointer, const size_t );
 
 /*! \brief Зашифрование данных с одновременной выработкой имитовставки согласно ГОСТ Р 34.13-2015. */
  dll_export int ak_bckey_encrypt_ctr_cmac( ak_pointer , ak_pointer , const ak_pointer ,
@@ -1109,9 +1313,18 @@ extern "C" {
 /*! \brief Умножение двух вычетов в представлении Монтгомери. */
  dll_export void ak_mpzn_mul_montgomery( ak_uint64 *, ak_uint64 *, ak_uint64 *,
                                                            ak_uint64 *, ak_uint64, const size_t );
+/*! \brief Возведение в квадрат в представлении Монтгомери. */
+ dll_export void ak_mpzn_sqr_montgomery( ak_uint64 *, ak_uint64 *,
+                                                           ak_uint64 *, ak_uint64, const size_t );
 /*! \brief Модульное возведение в степень в представлении Монтгомери. */
  dll_export void ak_mpzn_modpow_montgomery( ak_uint64 *, ak_uint64 *, ak_uint64 *,
                                                            ak_uint64 *, ak_uint64, const size_t );
+/*! \brief Обращение вычета в представлении Монтгомери за постоянное время. */
+ dll_export void ak_mpzn_inverse_montgomery( ak_uint64 *, ak_uint64 *, ak_uint64 *,
+                                                ak_uint64, ak_uint64 *, const size_t );
+/*! \brief Обращение открытого вычета в представлении Монтгомери. */
+ dll_export void ak_mpzn_inverse_montgomery_var( ak_uint64 *, ak_uint64 *, ak_uint64 *,
+                                                ak_uint64, ak_uint64 *, const size_t );
 /* ----------------------------------------------------------------------------------------------- */
 #ifdef AK_HAVE_GMP_H
 /*! \brief Преобразование ak_mpznxxx в mpz_t. */
@@ -1169,6 +1382,13 @@ extern "C" {
  dll_export void ak_wpoint_reduce( ak_wpoint , ak_wcurve );
 /*! \brief Вычисление кратной точки эллиптической кривой. */
  dll_export void ak_wpoint_pow( ak_wpoint , ak_wpoint , ak_uint64 *, size_t , ak_wcurve );
+/*! \brief Вычисление кратной образующей точки эллиптической кривой с использованием
+    предвычисленной таблицы. */
+ dll_export void ak_wpoint_pow_base( ak_wpoint , ak_uint64 *, size_t , ak_wcurve );
+/*! \brief Вычисление суммы кратных образующей точки и заданной точки эллиптической кривой
+    (функция не является постоянной по времени). */
+ dll_export void ak_wpoint_pow2( ak_wpoint , ak_uint64 *, ak_wpoint , ak_uint64 *,
+                                                                           size_t , ak_wcurve );
 
 /* ----------------------------------------------------------------------------------------------- */
 /*! \brief Класс, реализующий эллиптическую кривую, заданную в короткой форме Вейерштрасса
@@ -1649,6 +1869,22 @@ extern "C" {
   struct hash ctx;
  /*! \brief номер открытого ключа, выработанного из данного секретного ключа. */
   ak_uint8 verifykey_number[32];
+ /*! \brief генератор псевдо-случайных чисел, используемый по-умолчанию для выработки
+     одноразовых ключей подписи и значения секретного ключа */
+  struct random generator;
+ /*! \brief массив пар вычетов \f$ (\zeta, \zeta^{-1}) \f$, используемых для смены маски
+     секретного ключа; вырабатывается функцией ak_signkey_set_mask_multiplicative() */
+  ak_uint64 *remask;
+ /*! \brief количество неиспользованных пар в массиве remask */
+  size_t remask_count;
+ /*! \brief количество подписей, после выработки которых выполняется смена маски ключа
+     (нулевое значение означает, что маска после выработки подписи не изменяется) */
+  size_t remask_period;
+ /*! \brief количество подписей, выработанных после последней смены маски ключа */
+  size_t remask_counter;
+ /*! \brief набор предварительно вычисленных значений \f$ (k, r) \f$, используемых
+     при выработке подписи (NULL, если набор не создан) */
+  ak_pointer presign;
 } *ak_signkey;
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -1686,6 +1922,14 @@ extern "C" {
  dll_export int ak_signkey_set_key( ak_signkey , const ak_pointer , const size_t );
 /*! \brief Присвоение секретному ключу электронной подписи случайного значения. */
  dll_export int ak_signkey_set_key_random( ak_signkey , ak_random );
+/*! \brief Установка периодичности смены маски секретного ключа электронной подписи. */
+ dll_export int ak_signkey_set_remask_period( ak_signkey , const size_t );
+/*! \brief Создание набора предварительно вычисленных значений для выработки подписи. */
+ dll_export int ak_signkey_presign_create( ak_signkey , const size_t , const bool_t );
+/*! \brief Заполнение набора предварительно вычисленных значений для выработки подписи. */
+ dll_export int ak_signkey_presign_fill( ak_signkey );
+/*! \brief Уничтожение набора предварительно вычисленных значений для выработки подписи. */
+ dll_export int ak_signkey_presign_destroy( ak_signkey );
 /** @} */
 
 /* ----------------------------------------------------------------------------------------------- */
@@ -1718,6 +1962,11 @@ extern "C" {
   ak_oid oid;
  /*! \brief точка кривой, являющаяся открытым ключом электронной подписи */
   struct wpoint qpoint;
+ /*! \brief аффинные координаты (в представлении Монтгомери) нечетных кратных точки qpoint,
+    вычисленные функцией ak_verifykey_precompute(), или NULL */
+  ak_uint64 *qtable;
+ /*! \brief ширина окна, с которой вычислены кратные точки qtable */
+  size_t qwidth;
  /*! \brief временной интервал использования ключа  */
   struct time_interval time;
  /*! \brief ASN.1 дерево, содержащее в себе последовательность расширенных имен
@@ -1809,6 +2058,8 @@ extern "C" {
  dll_export int ak_verifykey_add_name_string( ak_verifykey , const char * , const char * );
 /*! \brief Уничтожение контекста открытого ключа. */
  dll_export int ak_verifykey_destroy( ak_verifykey );
+/*! \brief Предвычисление нечетных кратных точки открытого ключа для ускорения проверки подписей. */
+ dll_export int ak_verifykey_precompute( ak_verifykey , const size_t );
 /** \addtogroup cert-export-doc Функции экспорта и импорта открытых ключей
  @{ */
 /*! \brief Функция экспортирует открытый ключ асиметричного криптографического алгоритма
@@ -1867,6 +2118,9 @@ extern "C" {
 /*! \brief Проверка электронной подписи для вычисленного заранее значения хеш-функции. */
  dll_export bool_t ak_verifykey_verify_hash( ak_verifykey , const ak_pointer ,
                                                                        const size_t , ak_pointer );
+/*! \brief Пакетная проверка электронных подписей для вычисленных заранее значений хеш-функции. */
+ dll_export bool_t ak_verifykey_verify_hash_batch( ak_verifykey * , ak_pointer * ,
+                                           const size_t , ak_pointer * , bool_t * , const size_t );
 /*! \brief Проверка электронной подписи для заданной области памяти. */
  dll_export bool_t ak_verifykey_verify_ptr( ak_verifykey , const ak_pointer ,
                                                                        const size_t , ak_pointer );